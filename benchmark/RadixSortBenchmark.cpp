@@ -0,0 +1,69 @@
+//  Copyright 2025, University of Freiburg,
+//                  Chair of Algorithms and Data Structures.
+
+#include "../benchmark/infrastructure/Benchmark.h"
+#include "../test/util/IdTableHelpers.h"
+#include "../test/util/IdTestHelpers.h"
+#include "engine/Engine.h"
+#include "util/Random.h"
+
+namespace ad_benchmark {
+
+// Compare the radix sort of `Engine::radixSort` with the comparison-based
+// sort (`ad_utility::parallel_sort`) that `Engine::sort` uses otherwise.
+class RadixSortBenchmark : public BenchmarkInterface {
+  std::string name() const final {
+    return "Radix sort vs. comparison-based sort of IdTables";
+  }
+
+  BenchmarkResults runAllBenchmarks() final {
+    constexpr size_t numRows = 10'000'000;
+    BenchmarkResults results{};
+
+    // Create a table with three columns: Random `VocabIndex` IDs, random
+    // `VocabIndex` IDs with only few distinct values, and random (also
+    // negative) integers.
+    ad_utility::FastRandomIntGenerator<uint64_t> random;
+    IdTable input{3, ad_utility::testing::makeAllocator()};
+    input.reserve(numRows);
+    for ([[maybe_unused]] auto i : ad_utility::integerRange(numRows)) {
+      uint64_t value = random();
+      input.push_back({ad_utility::testing::VocabId(value >> 4),
+                       ad_utility::testing::VocabId(value % 100),
+                       ad_utility::testing::IntId(
+                           static_cast<int64_t>(value >> 8) - (1LL << 40))});
+    }
+
+    using enum Engine::RadixKey;
+    auto addComparison = [&](std::string_view description,
+                             const std::vector<Engine::RadixSortColumn>&
+                                 sortColumns) {
+      auto comparator = [&sortColumns](const auto& a, const auto& b) {
+        for (const auto& [column, key, isDescending] : sortColumns) {
+          auto order =
+              key == Bits ? a[column] <=> b[column]
+                          : a[column].getInt() <=> b[column].getInt();
+          if (order != 0) {
+            return isDescending ? order > 0 : order < 0;
+          }
+        }
+        return false;
+      };
+      IdTable table = input.clone();
+      results.addMeasurement(absl::StrCat(description, " (comparison)"),
+                             [&]() { Engine::sort<3>(&table, comparator); });
+      table = input.clone();
+      results.addMeasurement(absl::StrCat(description, " (radix)"), [&]() {
+        Engine::radixSort(table, sortColumns);
+      });
+    };
+
+    addComparison("single column, many distinct values", {{0, Bits, false}});
+    addComparison("single column, few distinct values", {{1, Bits, false}});
+    addComparison("signed integers, descending", {{2, SignedInt, true}});
+    addComparison("two columns", {{1, Bits, false}, {0, Bits, false}});
+    return results;
+  }
+};
+AD_REGISTER_BENCHMARK(RadixSortBenchmark);
+}  // namespace ad_benchmark
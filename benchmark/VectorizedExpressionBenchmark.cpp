@@ -0,0 +1,111 @@
+//  Copyright 2025, University of Freiburg,
+//                  Chair of Algorithms and Data Structures.
+
+#include "../benchmark/infrastructure/Benchmark.h"
+#include "../test/util/IdTestHelpers.h"
+#include "engine/sparqlExpressions/SparqlExpressionValueGetters.h"
+#include "engine/sparqlExpressions/VectorizedKernels.h"
+#include "util/OverloadCallOperator.h"
+#include "util/Random.h"
+
+namespace ad_benchmark {
+
+namespace vectorized = sparqlExpression::vectorized;
+using vectorized::BinaryOperation;
+using vectorized::Comparison;
+
+// Compare the vectorized kernels for the binary expressions with a loop that
+// dispatches on the datatype of each single value (like the generic
+// evaluation of the expressions does).
+class VectorizedExpressionBenchmark : public BenchmarkInterface {
+  std::string name() const final {
+    return "Vectorized vs. per-value evaluation of binary expressions";
+  }
+
+  // The numeric value of a single `Id`, dispatched at runtime.
+  static double getNumericValue(Id id) {
+    return id.getDatatype() == Datatype::Int ? static_cast<double>(id.getInt())
+                                             : id.getDouble();
+  }
+
+  BenchmarkResults runAllBenchmarks() final {
+    constexpr size_t numRows = 10'000'000;
+    BenchmarkResults results{};
+
+    ad_utility::FastRandomIntGenerator<uint64_t> random;
+    std::vector<Id> ints;
+    std::vector<Id> doubles;
+    ints.reserve(numRows);
+    doubles.reserve(numRows);
+    for ([[maybe_unused]] auto i : ad_utility::integerRange(numRows)) {
+      uint64_t value = random();
+      ints.push_back(ad_utility::testing::IntId(
+          static_cast<int64_t>(value >> 24) - (1LL << 39)));
+      doubles.push_back(ad_utility::testing::DoubleId(
+          static_cast<double>(value >> 11) / (1ULL << 20)));
+    }
+    std::vector<Id> result(numRows);
+
+    auto addComparison = [&](std::string_view description,
+                             const vectorized::Operand& a,
+                             const vectorized::Operand& b, auto kernel,
+                             auto perValue) {
+      auto get = [](const vectorized::Operand& operand, size_t i) {
+        return std::visit(
+            ad_utility::OverloadCallOperator{
+                [i](std::span<const Id> column) { return column[i]; },
+                [](Id id) { return id; }},
+            operand);
+      };
+      results.addMeasurement(absl::StrCat(description, " (per value)"), [&]() {
+        for (size_t i = 0; i < numRows; ++i) {
+          result[i] = perValue(get(a, i), get(b, i));
+        }
+      });
+      results.addMeasurement(absl::StrCat(description, " (vectorized)"),
+                             [&]() { AD_CORRECTNESS_CHECK(kernel(a, b)); });
+    };
+
+    auto binary = [&result](BinaryOperation op) {
+      return [op, &result](const auto& a, const auto& b) {
+        return vectorized::evaluateBinaryOperation(op, a, b, result);
+      };
+    };
+    auto numericPerValue = [](auto f) {
+      return [f](Id a, Id b) {
+        if (a.getDatatype() == Datatype::Int &&
+            b.getDatatype() == Datatype::Int) {
+          return sparqlExpression::detail::makeNumericId(
+              f(a.getInt(), b.getInt()));
+        }
+        return sparqlExpression::detail::makeNumericId(
+            f(getNumericValue(a), getNumericValue(b)));
+      };
+    };
+
+    std::span<const Id> intColumn{ints};
+    std::span<const Id> doubleColumn{doubles};
+    addComparison("Int + Int", intColumn, intColumn,
+                  binary(BinaryOperation::Add), numericPerValue(std::plus<>{}));
+    addComparison("Double * Double", doubleColumn, doubleColumn,
+                  binary(BinaryOperation::Multiply),
+                  numericPerValue(std::multiplies<>{}));
+    addComparison("Int - Double", intColumn, doubleColumn,
+                  binary(BinaryOperation::Subtract),
+                  numericPerValue(std::minus<>{}));
+
+    auto lessThan = [&result](const auto& a, const auto& b) {
+      return vectorized::evaluateComparison(Comparison::LT, a, b, result);
+    };
+    auto lessThanPerValue = [](Id a, Id b) {
+      return Id::makeFromBool(getNumericValue(a) < getNumericValue(b));
+    };
+    addComparison("Int < constant", intColumn,
+                  ad_utility::testing::IntId(0), lessThan, lessThanPerValue);
+    addComparison("Double < Double", doubleColumn, doubleColumn, lessThan,
+                  lessThanPerValue);
+    return results;
+  }
+};
+AD_REGISTER_BENCHMARK(VectorizedExpressionBenchmark);
+}  // namespace ad_benchmark
@@ -47,6 +47,8 @@ int main(int argc, char** argv) {
   bool noPatterns;
   bool noPatternTrick;
   bool onlyPsoAndPosPermutations;
+  bool persistUpdates;
+  std::string persistentCacheDirectory;
 
   ad_utility::MemorySize memoryMaxSize;
 
@@ -108,6 +110,17 @@ int main(int argc, char** argv) {
       po::bool_switch(&onlyPsoAndPosPermutations),
       "Only load the PSO and POS permutations. This disables queries with "
       "predicate variables.");
+  add("persist-updates", po::bool_switch(&persistUpdates),
+      "Persist all SPARQL updates in a write-ahead log next to the index "
+      "files, and restore the updates from this log when the server is "
+      "started. Each update is synced to disk before it is acknowledged. "
+      "The log is only consolidated by rebuilding the index. Without this "
+      "option, all updates are lost when the server is restarted.");
+  add("persistent-cache-dir",
+      po::value<std::string>(&persistentCacheDirectory)->default_value(""),
+      "Store the results that are evicted from or pinned in the cache in this "
+      "directory, and read them from there on a cache miss. These results "
+      "survive a restart of the server. Default: no persistent cache.");
   add("default-query-timeout,s",
       optionFactory.getProgramOption<"default-query-timeout">(),
       "Set the default timeout in seconds after which queries are cancelled"
@@ -143,8 +156,10 @@ int main(int argc, char** argv) {
 
   try {
     Server server(port, numSimultaneousQueries, memoryMaxSize,
-                  std::move(accessToken), !noPatternTrick);
-    server.run(indexBasename, text, !noPatterns, !onlyPsoAndPosPermutations);
+                  std::move(accessToken), !noPatternTrick,
+                  std::move(persistentCacheDirectory));
+    server.run(indexBasename, text, !noPatterns, !onlyPsoAndPosPermutations,
+               persistUpdates);
   } catch (const std::exception& e) {
     // This code should never be reached as all exceptions should be handled
     // within server.run()
@@ -0,0 +1,255 @@
+//  Copyright 2025, University of Freiburg,
+//                  Chair of Algorithms and Data Structures.
+
+#include "engine/AdaptiveJoinTree.h"
+
+#include <absl/cleanup/cleanup.h>
+#include <absl/strings/str_cat.h>
+
+#include <algorithm>
+#include <bit>
+
+#include "engine/Engine.h"
+#include "util/Exception.h"
+
+namespace {
+// An operation that holds the already computed result of an `operation`, such
+// that the result can be reused when the `operation` is substituted by this
+// operation in the current plan, or when its subtree becomes an input of a new
+// plan. Its size estimate is the actual size of the result and its cost is
+// zero.
+class MaterializedSubtree : public Operation {
+ private:
+  std::shared_ptr<Operation> operation_;
+  std::shared_ptr<const Result> result_;
+  size_t size_;
+
+ public:
+  MaterializedSubtree(QueryExecutionContext* qec,
+                      std::shared_ptr<Operation> operation,
+                      std::shared_ptr<const Result> result)
+      : Operation{qec},
+        operation_{std::move(operation)},
+        result_{std::move(result)} {
+    AD_CONTRACT_CHECK(result_->isFullyMaterialized());
+    size_ = result_->idTable().size();
+  }
+
+ protected:
+  // The result is the same as that of the `operation_`.
+  string getCacheKeyImpl() const override { return operation_->getCacheKey(); }
+
+ public:
+  string getDescriptor() const override {
+    return absl::StrCat("Materialized result of ",
+                        operation_->getDescriptor());
+  }
+
+  size_t getResultWidth() const override {
+    return operation_->getResultWidth();
+  }
+
+  std::vector<ColumnIndex> resultSortedOn() const override {
+    return operation_->getResultSortedOn();
+  }
+
+ private:
+  uint64_t getSizeEstimateBeforeLimit() override { return size_; }
+
+ public:
+  size_t getCostEstimate() override { return 0; }
+
+  float getMultiplicity(size_t col) override {
+    return operation_->getMultiplicity(col);
+  }
+
+  bool knownEmptyResult() override { return size_ == 0; }
+
+  vector<QueryExecutionTree*> getChildren() override {
+    return operation_->getChildren();
+  }
+
+ private:
+  // The result is shared with the cache and with the plan in which it was
+  // computed, so it is copied.
+  ProtoResult computeResult([[maybe_unused]] bool requestLaziness) override {
+    return {result_->idTable().clone(), resultSortedOn(),
+            result_->getSharedLocalVocab()};
+  }
+
+  VariableToColumnMap computeVariableToColumnMap() const override {
+    return operation_->getExternallyVisibleVariableColumns();
+  }
+};
+
+// Return true iff `a` is a subset of `b` (as bitmasks).
+bool isSubset(uint64_t a, uint64_t b) { return (a & b) == a; }
+}  // namespace
+
+// _____________________________________________________________________________
+AdaptiveJoinTree::AdaptiveJoinTree(
+    QueryExecutionContext* qec, std::shared_ptr<QueryExecutionTree> initialPlan,
+    std::shared_ptr<const IdsOfSubtrees> idsOfSubtrees, Replanner replanner,
+    double reoptimizationFactor)
+    : Operation{qec},
+      initialPlan_{std::move(initialPlan)},
+      initialIdsOfSubtrees_{std::move(idsOfSubtrees)},
+      replanner_{std::move(replanner)},
+      reoptimizationFactor_{reoptimizationFactor},
+      executedPlan_{initialPlan_} {
+  AD_CONTRACT_CHECK(initialPlan_ != nullptr);
+  AD_CONTRACT_CHECK(initialIdsOfSubtrees_ != nullptr);
+  AD_CONTRACT_CHECK(reoptimizationFactor_ > 0.0);
+}
+
+// _____________________________________________________________________________
+string AdaptiveJoinTree::getCacheKeyImpl() const {
+  // The result is the same as that of the initial plan, but the cache key has
+  // to be different, because the initial plan might be computed as part of
+  // this operation.
+  return absl::StrCat("ADAPTIVE JOIN TREE\n", initialPlan_->getCacheKey());
+}
+
+// _____________________________________________________________________________
+string AdaptiveJoinTree::getDescriptor() const {
+  return absl::StrCat("Adaptive ",
+                      initialPlan_->getRootOperation()->getDescriptor());
+}
+
+// _____________________________________________________________________________
+bool AdaptiveJoinTree::estimateIsOff(size_t estimatedSize, size_t actualSize,
+                                     double factor) {
+  auto [smaller, larger] = std::minmax(estimatedSize, actualSize);
+  return static_cast<double>(larger) >
+         factor * static_cast<double>(std::max(smaller, size_t{1}));
+}
+
+// _____________________________________________________________________________
+ProtoResult AdaptiveJoinTree::computeResult(
+    [[maybe_unused]] bool requestLaziness) {
+  std::shared_ptr<QueryExecutionTree> plan = initialPlan_;
+  IdsOfSubtrees replannedIds;
+  const IdsOfSubtrees* ids = initialIdsOfSubtrees_.get();
+  std::vector<ExecutedSubtree> executed;
+
+  auto isExecuted = [&executed, &ids](const QueryExecutionTree* tree) {
+    auto it = ids->find(tree);
+    return ql::ranges::any_of(executed, [tree, it, ids](const auto& subtree) {
+      return subtree.tree_.get() == tree ||
+             (it != ids->end() && isSubset(it->second, subtree.ids_));
+    });
+  };
+
+  // Find the first join of the `plan` (in post-order) that hasn't been
+  // executed yet, together with its ids.
+  auto findNextJoin = [&](auto& self, QueryExecutionTree* tree)
+      -> std::optional<std::pair<QueryExecutionTree*, uint64_t>> {
+    if (isExecuted(tree)) {
+      return std::nullopt;
+    }
+    for (QueryExecutionTree* child : tree->getRootOperation()->getChildren()) {
+      if (child == nullptr) {
+        continue;
+      }
+      if (auto join = self(self, child)) {
+        return join;
+      }
+    }
+    auto it = ids->find(tree);
+    if (it != ids->end() && std::popcount(it->second) >= 2) {
+      return std::pair{tree, it->second};
+    }
+    return std::nullopt;
+  };
+
+  // The executed joins are substituted by `MaterializedSubtree`s in the
+  // current plan, such that their parents reuse their results (even if they
+  // are not in the query cache). The original operations are restored as soon
+  // as the results are no longer needed, at the latest when this operation is
+  // done, s.t. the plans don't hold the results and can be computed again.
+  ad_utility::HashMap<QueryExecutionTree*, std::shared_ptr<Operation>>
+      originalOperations;
+  auto restore = [&originalOperations](QueryExecutionTree* tree) {
+    auto it = originalOperations.find(tree);
+    AD_CORRECTNESS_CHECK(it != originalOperations.end());
+    tree->replaceRootOperation(std::move(it->second));
+    originalOperations.erase(it);
+  };
+  absl::Cleanup restoreAll{[&originalOperations]() {
+    for (auto& [tree, operation] : originalOperations) {
+      tree->replaceRootOperation(std::move(operation));
+    }
+  }};
+
+  size_t numReoptimizations = 0;
+  while (true) {
+    checkCancellation();
+    executedPlan_ = plan;
+    auto next = findNextJoin(findNextJoin, plan.get());
+    if (!next.has_value() || next->first == plan.get()) {
+      break;
+    }
+    auto [join, joinIds] = next.value();
+    std::shared_ptr<const Result> joinResult = join->getResult();
+    bool estimateWasOff =
+        estimateIsOff(join->getSizeEstimate(), joinResult->idTable().size(),
+                      reoptimizationFactor_);
+    // The executed subtrees that are part of this join are no longer needed.
+    std::erase_if(executed, [joinIds, &restore](const auto& subtree) {
+      if (!isSubset(subtree.ids_, joinIds)) {
+        return false;
+      }
+      restore(subtree.tree_.get());
+      return true;
+    });
+    originalOperations[join] =
+        join->replaceRootOperation(std::make_shared<MaterializedSubtree>(
+            getExecutionContext(), join->getRootOperation(),
+            std::move(joinResult)));
+    // The subtree has to stay alive as long as it is part of `executed`, so we
+    // share the ownership of the complete plan.
+    executed.push_back({std::shared_ptr<QueryExecutionTree>{plan, join},
+                        joinIds});
+    if (!estimateWasOff) {
+      continue;
+    }
+    Plan replanned = replanner_(executed);
+    AD_CORRECTNESS_CHECK(replanned.tree_ != nullptr);
+    plan = std::move(replanned.tree_);
+    replannedIds = std::move(replanned.idsOfSubtrees_);
+    ids = &replannedIds;
+    ++numReoptimizations;
+  }
+  runtimeInfo().addDetail("numReoptimizations", numReoptimizations);
+
+  std::shared_ptr<const Result> result = plan->getResult();
+  auto localVocab = result->getSharedLocalVocab();
+  IdTable table = result->idTable().clone();
+  if (plan == initialPlan_) {
+    return {std::move(table), resultSortedOn(), std::move(localVocab)};
+  }
+  // Bring the columns into the order of the initial plan and restore its sort
+  // order.
+  std::vector<ColumnIndex> permutation(getResultWidth());
+  for (const auto& [var, info] : initialPlan_->getVariableColumns()) {
+    permutation.at(info.columnIndex_) = plan->getVariableColumn(var);
+  }
+  table.setColumnSubset(permutation);
+  std::vector<ColumnIndex> sortedOn = resultSortedOn();
+  std::vector<ColumnIndex> sortedOnAfterPermutation;
+  for (ColumnIndex col : plan->resultSortedOn()) {
+    auto it = ql::ranges::find(permutation, col);
+    if (it == permutation.end()) {
+      break;
+    }
+    sortedOnAfterPermutation.push_back(it - permutation.begin());
+  }
+  bool isStillSorted =
+      sortedOnAfterPermutation.size() >= sortedOn.size() &&
+      std::equal(sortedOn.begin(), sortedOn.end(),
+                 sortedOnAfterPermutation.begin());
+  if (!isStillSorted) {
+    Engine::sort(table, sortedOn);
+  }
+  return {std::move(table), std::move(sortedOn), std::move(localVocab)};
+}
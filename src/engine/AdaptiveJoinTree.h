@@ -0,0 +1,114 @@
+//  Copyright 2025, University of Freiburg,
+//                  Chair of Algorithms and Data Structures.
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "engine/Operation.h"
+#include "engine/QueryExecutionTree.h"
+#include "util/HashMap.h"
+
+// The joins of a connected component of a query (as planned by the
+// `QueryPlanner`), which are re-planned during their execution if the
+// estimates of the planner turn out to be wrong.
+//
+// The joins of the current plan are computed one after the other (children
+// before parents). After each join, its actual size is compared to its size
+// estimate. If they differ by more than the `reoptimizationFactor`, the joins
+// that haven't been computed yet are re-planned: The subtrees that were
+// already computed become the inputs of the new plan (with their exact size,
+// and their results are reused), together with the inputs of the component
+// that are not yet part of a computed subtree. Either way, each computed join
+// is substituted by its result in the current plan, s.t. its parent reuses the
+// result even if it is not stored in the query cache.
+//
+// The result has the same columns and the same sort order as the result of
+// the initial plan, so for the rest of the query it doesn't matter whether the
+// joins were re-planned. All the estimates are those of the initial plan.
+class AdaptiveJoinTree : public Operation {
+ public:
+  // The inputs of the component that are joined by a subtree of a plan as a
+  // bitmask (like `QueryPlanner::SubtreePlan::_idsOfIncludedNodes`). Each
+  // subtree of a plan that joins at least two inputs has an entry.
+  using IdsOfSubtrees =
+      ad_utility::HashMap<const QueryExecutionTree*, uint64_t>;
+
+  struct Plan {
+    std::shared_ptr<QueryExecutionTree> tree_;
+    IdsOfSubtrees idsOfSubtrees_;
+  };
+
+  // A subtree that has already been computed (with its materialized result)
+  // and the inputs that it joins.
+  struct ExecutedSubtree {
+    std::shared_ptr<QueryExecutionTree> tree_;
+    uint64_t ids_;
+  };
+
+  // Create a new plan for the complete component from the given (disjoint)
+  // executed subtrees and the remaining inputs of the component.
+  using Replanner =
+      std::function<Plan(const std::vector<ExecutedSubtree>& executed)>;
+
+ private:
+  std::shared_ptr<QueryExecutionTree> initialPlan_;
+  std::shared_ptr<const IdsOfSubtrees> initialIdsOfSubtrees_;
+  Replanner replanner_;
+  double reoptimizationFactor_;
+  // The plan that was (or is being) executed, which is used as the child of
+  // this operation for the runtime information.
+  std::shared_ptr<QueryExecutionTree> executedPlan_;
+
+ public:
+  AdaptiveJoinTree(QueryExecutionContext* qec,
+                   std::shared_ptr<QueryExecutionTree> initialPlan,
+                   std::shared_ptr<const IdsOfSubtrees> idsOfSubtrees,
+                   Replanner replanner, double reoptimizationFactor);
+
+ protected:
+  string getCacheKeyImpl() const override;
+
+ public:
+  string getDescriptor() const override;
+
+  size_t getResultWidth() const override {
+    return initialPlan_->getResultWidth();
+  }
+
+  std::vector<ColumnIndex> resultSortedOn() const override {
+    return initialPlan_->resultSortedOn();
+  }
+
+ private:
+  uint64_t getSizeEstimateBeforeLimit() override {
+    return initialPlan_->getSizeEstimate();
+  }
+
+ public:
+  size_t getCostEstimate() override { return initialPlan_->getCostEstimate(); }
+
+  float getMultiplicity(size_t col) override {
+    return initialPlan_->getMultiplicity(col);
+  }
+
+  bool knownEmptyResult() override { return initialPlan_->knownEmptyResult(); }
+
+  vector<QueryExecutionTree*> getChildren() override {
+    return {executedPlan_.get()};
+  }
+
+  // Return true iff the `actualSize` of a result differs from its
+  // `estimatedSize` by more than the `factor` (in either direction).
+  static bool estimateIsOff(size_t estimatedSize, size_t actualSize,
+                            double factor);
+
+ private:
+  ProtoResult computeResult(bool requestLaziness) override;
+
+  VariableToColumnMap computeVariableToColumnMap() const override {
+    return initialPlan_->getVariableColumns();
+  }
+};
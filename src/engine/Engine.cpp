@@ -4,6 +4,10 @@
 
 #include "engine/Engine.h"
 
+#include <array>
+#include <numeric>
+#include <thread>
+
 #include "engine/CallFixedSize.h"
 #include "util/ChunkedForLoop.h"
 #include "util/Exception.h"
@@ -13,6 +17,25 @@
 void Engine::sort(IdTable& idTable, const std::vector<ColumnIndex>& sortCols) {
   size_t width = idTable.numColumns();
 
+  // For large inputs, use a radix sort on the bits of the IDs, unless a sort
+  // column contains `LocalVocabIndex` or `InlineString` IDs, the order of
+  // which is not the order of their bits.
+  auto isNotOrderedByBits = [](Id id) {
+    auto type = id.getDatatype();
+    return type == Datatype::LocalVocabIndex || type == Datatype::InlineString;
+  };
+  if (idTable.numRows() >= RADIX_SORT_MIN_NUM_ROWS &&
+      ql::ranges::none_of(sortCols, [&](ColumnIndex col) {
+        return ql::ranges::any_of(idTable.getColumn(col), isNotOrderedByBits);
+      })) {
+    std::vector<RadixSortColumn> sortColumns;
+    for (ColumnIndex col : sortCols) {
+      sortColumns.push_back({col});
+    }
+    radixSort(idTable, sortColumns);
+    return;
+  }
+
   // Instantiate specialized comparison lambdas for one and two sort columns
   // and use a generic comparison for a higher number of sort columns.
   // TODO<joka921> As soon as we have merged the benchmark, measure whether
@@ -52,6 +75,133 @@ void Engine::sort(IdTable& idTable, const std::vector<ColumnIndex>& sortCols) {
   }
 }
 
+namespace {
+// Sort the `keys` and apply the same permutation to the `rowIndices` via one
+// pass of an LSD radix sort for each of the 8-bit digits in which the keys
+// differ. Both vectors are used as buffers, the result is stored in them.
+template <typename Vec>
+void radixSortKeys(Vec& keys, Vec& rowIndices, Vec& keysBuffer,
+                   Vec& rowIndicesBuffer) {
+  size_t numRows = keys.size();
+  if (numRows == 0) {
+    return;
+  }
+  uint64_t differingBits = 0;
+  for (uint64_t key : keys) {
+    differingBits |= key ^ keys.front();
+  }
+
+  constexpr size_t numDigitValues = 256;
+  size_t numThreads = USE_PARALLEL_SORT ? NUM_SORT_THREADS : 1;
+  size_t chunkSize = (numRows + numThreads - 1) / numThreads;
+  auto chunkRange = [&](size_t t) {
+    return std::pair{std::min(t * chunkSize, numRows),
+                     std::min((t + 1) * chunkSize, numRows)};
+  };
+  // Run `f(t)` for all chunks `t`, each in its own thread.
+  auto forAllChunks = [numThreads](const auto& f) {
+    std::vector<std::thread> threads;
+    for (size_t t = 1; t < numThreads; ++t) {
+      threads.emplace_back(f, t);
+    }
+    f(0);
+    ql::ranges::for_each(threads, &std::thread::join);
+  };
+
+  std::vector<std::array<size_t, numDigitValues>> offsets(numThreads);
+  for (size_t shift = 0; shift < 64; shift += 8) {
+    if (((differingBits >> shift) & 0xFF) == 0) {
+      continue;
+    }
+    auto digit = [shift](uint64_t key) { return (key >> shift) & 0xFF; };
+    // Count the digits in each chunk.
+    forAllChunks([&](size_t t) {
+      auto& counts = offsets.at(t);
+      counts.fill(0);
+      auto [begin, end] = chunkRange(t);
+      for (size_t i = begin; i < end; ++i) {
+        ++counts[digit(keys[i])];
+      }
+    });
+    // Turn the counts into the positions at which each chunk writes the keys
+    // with a given digit. The chunks write in their order to keep the sort
+    // stable.
+    size_t position = 0;
+    for (size_t d = 0; d < numDigitValues; ++d) {
+      for (size_t t = 0; t < numThreads; ++t) {
+        size_t count = offsets[t][d];
+        offsets[t][d] = position;
+        position += count;
+      }
+    }
+    forAllChunks([&](size_t t) {
+      auto& positions = offsets.at(t);
+      auto [begin, end] = chunkRange(t);
+      for (size_t i = begin; i < end; ++i) {
+        size_t target = positions[digit(keys[i])]++;
+        keysBuffer[target] = keys[i];
+        rowIndicesBuffer[target] = rowIndices[i];
+      }
+    });
+    std::swap(keys, keysBuffer);
+    std::swap(rowIndices, rowIndicesBuffer);
+  }
+}
+}  // namespace
+
+// ___________________________________________________________________________
+void Engine::radixSort(IdTable& idTable,
+                       const std::vector<RadixSortColumn>& sortColumns) {
+  LOG(DEBUG) << "Radix sorting " << idTable.size() << " elements.\n";
+  size_t numRows = idTable.numRows();
+  using Vec = std::vector<uint64_t, ad_utility::AllocatorWithLimit<uint64_t>>;
+  auto allocator = idTable.getAllocator();
+  Vec rowIndices(numRows, allocator);
+  std::iota(rowIndices.begin(), rowIndices.end(), 0);
+  Vec keys(numRows, allocator);
+  Vec keysBuffer(numRows, allocator);
+  Vec rowIndicesBuffer(numRows, allocator);
+
+  // The least significant column is sorted first. As each pass is stable,
+  // this yields the lexicographic order.
+  for (const auto& [column, keyType, isDescending] :
+       sortColumns | ql::views::reverse) {
+    auto ids = idTable.getColumn(column);
+    uint64_t invert = isDescending ? std::numeric_limits<uint64_t>::max() : 0;
+    auto computeKeys = [&](auto getKey) {
+      for (size_t i = 0; i < numRows; ++i) {
+        keys[i] = getKey(ids[rowIndices[i]]) ^ invert;
+      }
+    };
+    if (keyType == RadixKey::Bits) {
+      computeKeys([](Id id) { return id.getBits(); });
+    } else {
+      AD_CORRECTNESS_CHECK(keyType == RadixKey::SignedInt);
+      // Shift the range of the integers to the unsigned integers, `Undefined`
+      // IDs are mapped to zero.
+      computeKeys([](Id id) -> uint64_t {
+        if (id.getDatatype() == Datatype::Undefined) {
+          return 0;
+        }
+        AD_EXPENSIVE_CHECK(id.getDatatype() == Datatype::Int);
+        return static_cast<uint64_t>(id.getInt()) ^ (uint64_t{1} << 63);
+      });
+    }
+    radixSortKeys(keys, rowIndices, keysBuffer, rowIndicesBuffer);
+  }
+
+  // Apply the permutation to all the columns.
+  std::vector<Id, ad_utility::AllocatorWithLimit<Id>> buffer(numRows,
+                                                             allocator);
+  for (auto column : idTable.getColumns()) {
+    for (size_t i = 0; i < numRows; ++i) {
+      buffer[i] = column[rowIndices[i]];
+    }
+    ql::ranges::copy(buffer, column.begin());
+  }
+  LOG(DEBUG) << "Radix sort done.\n";
+}
+
 // ___________________________________________________________________________
 size_t Engine::countDistinct(IdTableView<0> input,
                              const std::function<void()>& checkCancellation) {
@@ -56,6 +56,31 @@ class Engine {
 
   static void sort(IdTable& idTable, const std::vector<ColumnIndex>& sortCols);
 
+  // How the IDs of a column are mapped to the unsigned 64-bit keys by which
+  // `radixSort` (see below) sorts. `Bits` uses the bits of the ID, which
+  // yields the internal order of the IDs, except for `LocalVocabIndex` and
+  // `InlineString` IDs (which are compared by their contents). `SignedInt`
+  // yields the order of the integer values for columns that only contain `Int`
+  // and `Undefined` IDs (the latter come first).
+  enum class RadixKey { Bits, SignedInt };
+  struct RadixSortColumn {
+    ColumnIndex column_;
+    RadixKey key_ = RadixKey::Bits;
+    bool isDescending_ = false;
+  };
+
+  // Sort the `idTable` lexicographically by the keys of the `sortColumns`
+  // (see `RadixKey` above) using an LSD radix sort with 8-bit digits. The
+  // digits are sorted in parallel on `NUM_SORT_THREADS` threads and the
+  // digits on which all keys of a column agree are skipped. The sort is
+  // stable.
+  static void radixSort(IdTable& idTable,
+                        const std::vector<RadixSortColumn>& sortColumns);
+
+  // Inputs with fewer rows are sorted by comparisons also if a radix sort
+  // would be possible.
+  static constexpr size_t RADIX_SORT_MIN_NUM_ROWS = 50'000;
+
   // Return the number of distinct rows in the `input`. The input must have all
   // duplicates adjacent to each other (e.g. by being sorted), otherwise the
   // behavior is undefined. `checkCancellation()` is invoked regularly and can
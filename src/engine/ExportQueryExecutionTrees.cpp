@@ -356,6 +356,9 @@ ExportQueryExecutionTrees::getLiteralOrIriFromVocabIndex(
   switch (id.getDatatype()) {
     case Datatype::LocalVocabIndex:
       return localVocab.getWord(id.getLocalVocabIndex()).asLiteralOrIri();
+    case Datatype::InlineString:
+      return LiteralOrIri::fromStringRepresentation(
+          std::string{id.getInlineString().view()});
     case Datatype::VocabIndex: {
       auto entity = index.indexToString(id.getVocabIndex());
       return LiteralOrIri::fromStringRepresentation(entity);
@@ -375,7 +378,8 @@ ExportQueryExecutionTrees::idToStringAndType(const Index& index, Id id,
   using enum Datatype;
   auto datatype = id.getDatatype();
   if constexpr (onlyReturnLiterals) {
-    if (!(datatype == VocabIndex || datatype == LocalVocabIndex)) {
+    if (!(datatype == VocabIndex || datatype == LocalVocabIndex ||
+          datatype == InlineString)) {
       return std::nullopt;
     }
   }
@@ -403,6 +407,7 @@ ExportQueryExecutionTrees::idToStringAndType(const Index& index, Id id,
     }
     case VocabIndex:
     case LocalVocabIndex:
+    case InlineString:
       return handleIriOrLiteral(
           getLiteralOrIriFromVocabIndex(index, id, localVocab));
     case TextRecordIndex:
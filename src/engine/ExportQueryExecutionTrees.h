@@ -70,7 +70,8 @@ class ExportQueryExecutionTrees {
   idToStringAndTypeForEncodedValue(Id id);
 
   // Acts as a helper to retrieve an LiteralOrIri object
-  // from an Id, where the Id is of type `VocabIndex` or `LocalVocabIndex`.
+  // from an Id, where the Id is of type `VocabIndex`, `LocalVocabIndex`, or
+  // `InlineString`.
   // This function should only be called with suitable `Datatype` Id's,
   // otherwise `AD_FAIL()` is called.
   static ad_utility::triple_component::LiteralOrIri
@@ -0,0 +1,141 @@
+//  Copyright 2025, University of Freiburg,
+//                  Chair of Algorithms and Data Structures.
+
+#pragma once
+
+#include <optional>
+#include <span>
+
+#include "engine/Result.h"
+#include "engine/SpillFile.h"
+#include "engine/idTable/CompressedExternalIdTable.h"
+#include "global/RuntimeParameters.h"
+#include "util/CancellationHandle.h"
+
+// Helpers for the `Sort` and `OrderBy` operations to sort inputs that are too
+// large to be sorted in RAM. Such inputs are split into presorted blocks that
+// are written to disk (via the `CompressedExternalIdTableSorter`) and the
+// sorted result is then yielded lazily by merging these blocks.
+namespace externalSort {
+
+// Return the maximal size of an input that is sorted in RAM. It is bounded
+// by the runtime parameter `sort-in-memory-threshold` and by half of the
+// memory that is still left in the `allocator` (the other half is reserved
+// for the sort itself and the rest of the query).
+inline ad_utility::MemorySize getMaxSizeForSortInMemory(
+    const ad_utility::AllocatorWithLimit<Id>& allocator) {
+  auto threshold = RuntimeParameters().get<"sort-in-memory-threshold">();
+  return ad_utility::MemorySize::bytes(std::min(
+      threshold.getBytes(), allocator.amountMemoryLeft().getBytes() / 2));
+}
+
+// Return true iff an `IdTable` with `numRows` rows and `numColumns` columns is
+// larger than `getMaxSizeForSortInMemory(allocator)`.
+inline bool isTooLargeForSortInMemory(
+    size_t numRows, size_t numColumns,
+    const ad_utility::AllocatorWithLimit<Id>& allocator) {
+  return numRows * numColumns * sizeof(Id) >
+         getMaxSizeForSortInMemory(allocator).getBytes();
+}
+
+// The input of a sort operation, as far as it has been read.
+struct SortInput {
+  // The input. If it is lazy, then the blocks up to `nextBlock_` have already
+  // been consumed and are stored in `readRows_`.
+  std::shared_ptr<const Result> result_;
+  IdTable readRows_;
+  // The merged local vocabs of all the consumed blocks (or the local vocab of
+  // a fully materialized `result_`).
+  LocalVocab localVocab_;
+  // The blocks of a lazy `result_` (which can be obtained from `result_` only
+  // once) and the position of the first block that has not been consumed yet,
+  // `std::nullopt` if there is no such block.
+  Result::LazyResult* blocks_ = nullptr;
+  std::optional<Result::LazyResult::iterator> nextBlock_ = std::nullopt;
+
+  // Return true iff all the rows of a lazy `result_` are stored in
+  // `readRows_`.
+  bool isCompletelyRead() const { return !nextBlock_.has_value(); }
+};
+
+// Consume the blocks of the lazy `result` until either all blocks have been
+// consumed or the next block would make the consumed rows too large to be
+// sorted in RAM (see `isTooLargeForSortInMemory` above). The consumed rows are
+// allocated by the `allocator`, so the memory that is left shrinks while they
+// are read, and the input is handed to the external sort long before it
+// exhausts the memory limit.
+inline SortInput readLazyInput(std::shared_ptr<const Result> result,
+                               size_t numColumns,
+                               ad_utility::AllocatorWithLimit<Id> allocator) {
+  AD_CONTRACT_CHECK(!result->isFullyMaterialized());
+  auto& blocks = result->idTables();
+  SortInput input{std::move(result), IdTable{numColumns, std::move(allocator)},
+                  LocalVocab{}, &blocks};
+  for (auto it = blocks.begin(); it != blocks.end(); ++it) {
+    auto& [idTable, localVocab] = *it;
+    if (isTooLargeForSortInMemory(input.readRows_.numRows() + idTable.numRows(),
+                                  numColumns,
+                                  input.readRows_.getAllocator())) {
+      input.nextBlock_ = std::move(it);
+      break;
+    }
+    input.readRows_.insertAtEnd(idTable);
+    input.localVocab_.mergeWith(std::span{&localVocab, 1});
+  }
+  return input;
+}
+
+// Return the amount of memory that the external sort may use for its
+// presorted blocks, see `getMaxSizeForSortInMemory` above.
+inline ad_utility::MemorySize getMemoryForExternalSort(
+    const ad_utility::AllocatorWithLimit<Id>& allocator, size_t numColumns) {
+  size_t numBytes = getMaxSizeForSortInMemory(allocator).getBytes();
+  // Each of the presorted blocks must contain at least one row.
+  return ad_utility::MemorySize::bytes(
+      std::max(numBytes, 2 * numColumns * sizeof(Id)));
+}
+
+// Sort all the rows of the `input` according to the `comparator` (which has
+// to be a strict weak ordering on rows) by writing presorted blocks to the
+// file `filename` (see `getSpillFilename`), and lazily yield the sorted result
+// in blocks. The file is deleted when the returned generator is destroyed.
+template <typename Comparator>
+Result::Generator sortExternally(
+    SortInput input, Comparator comparator, std::string filename,
+    ad_utility::SharedCancellationHandle cancellationHandle) {
+  size_t numColumns = input.readRows_.numColumns();
+  auto allocator = input.readRows_.getAllocator();
+  ad_utility::CompressedExternalIdTableSorter<Comparator, 0> sorter{
+      std::move(filename),
+      numColumns,
+      getMemoryForExternalSort(allocator, numColumns),
+      allocator,
+      ad_utility::DEFAULT_BLOCKSIZE_EXTERNAL_ID_TABLE,
+      comparator};
+  auto pushBlock = [&sorter, &cancellationHandle](const IdTable& block) {
+    cancellationHandle->throwIfCancelled();
+    sorter.pushBlock(block);
+  };
+
+  if (input.result_->isFullyMaterialized()) {
+    pushBlock(input.result_->idTable());
+  }
+  {
+    // Free the memory of the already read rows as soon as they are pushed.
+    IdTable readRows = std::move(input.readRows_);
+    pushBlock(readRows);
+  }
+  if (input.nextBlock_.has_value()) {
+    for (auto& it = input.nextBlock_.value(); it != input.blocks_->end();
+         ++it) {
+      pushBlock(it->idTable_);
+      input.localVocab_.mergeWith(std::span{&it->localVocab_, 1});
+    }
+  }
+
+  for (auto& block : sorter.getSortedBlocks()) {
+    cancellationHandle->throwIfCancelled();
+    co_yield {std::move(block), input.localVocab_.clone()};
+  }
+}
+}  // namespace externalSort
@@ -6,14 +6,18 @@
 
 #include "./Filter.h"
 
+#include <cmath>
 #include <sstream>
 
 #include "backports/algorithm.h"
 #include "engine/CallFixedSize.h"
 #include "engine/QueryExecutionTree.h"
+#include "engine/sparqlExpressions/ChunkedEvaluation.h"
 #include "engine/sparqlExpressions/SparqlExpression.h"
 #include "engine/sparqlExpressions/SparqlExpressionGenerators.h"
 #include "engine/sparqlExpressions/SparqlExpressionValueGetters.h"
+#include "global/RuntimeParameters.h"
+#include "index/PredicateStatistics.h"
 
 using std::endl;
 using std::string;
@@ -138,10 +142,9 @@ CPP_template_def(int WIDTH, typename Table)(
   evaluationContext._columnsByWhichResultIsSorted = std::move(sortedBy);
   const auto input =
       evaluationContext._inputTable.asStaticView<static_cast<size_t>(WIDTH)>();
-  sparqlExpression::ExpressionResult expressionResult =
-      _expression.getPimpl()->evaluate(&evaluationContext);
 
-  // Filter `input` by `expressionResult` and store the result in `resultTable`.
+  // Filter the rows `[chunkBegin, chunkEnd)` of `input` by the
+  // `expressionResult` for these rows and store the result in `resultTable`.
   // This is a lambda because `expressionResult` is a `std::variant`.
   //
   // NOTE: the explicit (seemingly redundant) capture of `resultTable` is
@@ -151,33 +154,36 @@ CPP_template_def(int WIDTH, typename Table)(
       [this, &resultTable = resultTable, &input, &inputTable,
        &dynamicResultTable,
        &evaluationContext]<sparqlExpression::SingleExpressionResult T>(
-          T&& singleResult) {
+          T&& singleResult, size_t chunkBegin, size_t chunkEnd) {
+        const size_t chunkSize = chunkEnd - chunkBegin;
         if constexpr (std::is_same_v<T, ad_utility::SetOfIntervals>) {
-          AD_CONTRACT_CHECK(input.size() == evaluationContext.size());
-          // If the expression result is given as a set of intervals, we copy
-          // the corresponding parts of `input` to `resultTable`.
+          // If the expression result is given as a set of intervals (relative
+          // to the `chunkBegin`), we copy the corresponding parts of `input` to
+          // `resultTable`.
           //
-          // NOTE: One of the interval ends may be larger than `input.size()`
+          // NOTE: One of the interval ends may be larger than `chunkSize`
           // (as the result of a negation).
           auto totalSize = std::accumulate(
               singleResult._intervals.begin(), singleResult._intervals.end(),
               resultTable.size(),
-              [&input](const auto& sum, const auto& interval) {
+              [chunkSize](const auto& sum, const auto& interval) {
                 size_t intervalBegin = interval.first;
-                size_t intervalEnd = std::min(interval.second, input.size());
+                size_t intervalEnd = std::min(interval.second, chunkSize);
                 return sum + (intervalEnd - intervalBegin);
               });
           if (resultTable.empty() && totalSize == inputTable.size()) {
-            // The binary filter contains all elements of the input, and we have
-            // no previous results, so we can simply copy or move the complete
+            // The binary filter contains all elements of the input (which is
+            // only possible if the chunk is the complete input), and we have no
+            // previous results, so we can simply copy or move the complete
             // table.
             dynamicResultTable = AD_FWD(inputTable).moveOrClone();
             return;
           }
           checkCancellation();
           for (auto [intervalBegin, intervalEnd] : singleResult._intervals) {
-            intervalEnd = std::min(intervalEnd, input.size());
-            resultTable.insertAtEnd(inputTable, intervalBegin, intervalEnd);
+            intervalEnd = std::min(intervalEnd, chunkSize);
+            resultTable.insertAtEnd(inputTable, chunkBegin + intervalBegin,
+                                    chunkBegin + intervalEnd);
             checkCancellation();
           }
           AD_CORRECTNESS_CHECK(resultTable.size() == totalSize);
@@ -195,8 +201,8 @@ CPP_template_def(int WIDTH, typename Table)(
           // intervals above. This depends on how expensive the evaluation with
           // the `EffectiveBooleanValueGetter` is.
           auto resultGenerator = sparqlExpression::detail::makeGenerator(
-              std::forward<T>(singleResult), input.size(), &evaluationContext);
-          size_t i = 0;
+              std::forward<T>(singleResult), chunkSize, &evaluationContext);
+          size_t i = chunkBegin;
 
           using ValueGetter =
               sparqlExpression::detail::EffectiveBooleanValueGetter;
@@ -211,7 +217,20 @@ CPP_template_def(int WIDTH, typename Table)(
           }
         }
       };
-  std::visit(computeResult, std::move(expressionResult));
+
+  // Evaluate the expression in chunks of rows (see `evaluateInChunks`) and
+  // filter each chunk directly after its evaluation.
+  sparqlExpression::evaluateInChunks(
+      *_expression.getPimpl(), &evaluationContext,
+      RuntimeParameters().get<"expression-evaluation-chunk-size">(),
+      [&computeResult](sparqlExpression::ExpressionResult expressionResult,
+                       size_t chunkBegin, size_t chunkEnd) {
+        std::visit(
+            [&computeResult, chunkBegin, chunkEnd](auto&& singleResult) {
+              computeResult(AD_FWD(singleResult), chunkBegin, chunkEnd);
+            },
+            std::move(expressionResult));
+      });
 
   // Detect the case that we have directly written the `dynamicResultTable`
   // in the binary search filter case.
@@ -223,6 +242,9 @@ CPP_template_def(int WIDTH, typename Table)(
 
 // _____________________________________________________________________________
 uint64_t Filter::getSizeEstimateBeforeLimit() {
+  if (auto estimate = getSizeEstimateFromHistograms(); estimate.has_value()) {
+    return estimate.value();
+  }
   return _expression
       .getEstimatesForFilterExpression(
           _subtree->getSizeEstimate(),
@@ -230,6 +252,39 @@ uint64_t Filter::getSizeEstimateBeforeLimit() {
       .sizeEstimate;
 }
 
+// _____________________________________________________________________________
+std::optional<uint64_t> Filter::getSizeEstimateFromHistograms() {
+  const uint64_t inputSize = _subtree->getSizeEstimate();
+  double fraction = 1.0;
+  bool foundHistogram = false;
+  for (const auto& [prefilter, variable] :
+       _expression.getPrefilterExpressionForMetadata()) {
+    auto column = _subtree->getVariableColumnOrNullopt(variable);
+    if (!column.has_value()) {
+      continue;
+    }
+    const ValueHistogram* histogram =
+        _subtree->getRootOperation()->getValueHistogram(column.value());
+    if (histogram == nullptr || histogram->numValues() == 0) {
+      continue;
+    }
+    foundHistogram = true;
+    // The histogram might be for a larger set of values than the input (for
+    // example, if the predicate of a scan is fixed, but not its subject).
+    double numRelevantValues = prefilter->estimateSelectivity(*histogram) *
+                               static_cast<double>(histogram->numValues());
+    fraction *= std::min(
+        1.0, numRelevantValues /
+                 static_cast<double>(std::max(inputSize, uint64_t{1})));
+  }
+  if (!foundHistogram) {
+    return std::nullopt;
+  }
+  // A non-empty input is never estimated to have an empty result.
+  return std::max(uint64_t{inputSize > 0},
+                  static_cast<uint64_t>(std::round(inputSize * fraction)));
+}
+
 // _____________________________________________________________________________
 size_t Filter::getCostEstimate() {
   return _subtree->getCostEstimate() +
@@ -5,6 +5,7 @@
 //   2020-     Johannes Kalmbach (kalmbach@informatik.uni-freiburg.de)
 #pragma once
 
+#include <optional>
 #include <utility>
 #include <vector>
 
@@ -59,6 +60,14 @@ class Filter : public Operation {
     return _subtree->getVariableColumns();
   }
 
+  // Estimate the size of the result from the histograms of the columns of the
+  // `_subtree` (see `Operation::getValueHistogram`): For each
+  // `PrefilterExpression` of the `_expression` whose variable has a histogram,
+  // the fraction of the rows that pass the prefilter is estimated from the
+  // histogram, and the fractions are multiplied. Returns `std::nullopt` if
+  // none of the variables has a histogram.
+  std::optional<uint64_t> getSizeEstimateFromHistograms();
+
   // The method is directly invoked with the construction of this `Filter`
   // object. Its implementation retrieves <PrefilterExpression, Variable> pairs
   // from the corresponding `SparqlExpression` and uses them to call
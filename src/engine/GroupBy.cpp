@@ -6,13 +6,21 @@
 
 #include "engine/GroupBy.h"
 
+#include <absl/hash/hash.h>
 #include <absl/strings/str_join.h>
 
+#include <atomic>
+#include <shared_mutex>
+#include <thread>
+
 #include "engine/CallFixedSize.h"
+#include "engine/Engine.h"
 #include "engine/IndexScan.h"
 #include "engine/Join.h"
 #include "engine/LazyGroupBy.h"
 #include "engine/Sort.h"
+#include "engine/SpillFile.h"
+#include "engine/idTable/CompressedExternalIdTable.h"
 #include "engine/sparqlExpressions/AggregateExpression.h"
 #include "engine/sparqlExpressions/CountStarExpression.h"
 #include "engine/sparqlExpressions/GroupConcatExpression.h"
@@ -26,6 +34,7 @@
 #include "index/IndexImpl.h"
 #include "parser/Alias.h"
 #include "util/HashSet.h"
+#include "util/RunTasksInParallel.h"
 #include "util/Timer.h"
 
 using groupBy::detail::VectorOfAggregationData;
@@ -1167,13 +1176,17 @@ GroupBy::getHashMapAggregationResults(
 }
 
 // _____________________________________________________________________________
-void GroupBy::substituteGroupVariable(
+std::vector<std::unique_ptr<sparqlExpression::SparqlExpression>>
+GroupBy::substituteGroupVariable(
     const std::vector<ParentAndChildIndex>& occurrences, IdTable* resultTable,
     size_t beginIndex, size_t count, size_t columnIndex,
     const Allocator& allocator) {
   decltype(auto) groupValues =
       resultTable->getColumn(columnIndex).subspan(beginIndex, count);
 
+  std::vector<std::unique_ptr<sparqlExpression::SparqlExpression>>
+      originalChildren;
+  originalChildren.reserve(occurrences.size());
   for (const auto& occurrence : occurrences) {
     sparqlExpression::VectorWithMemoryLimit<ValueId> values(allocator);
     values.resize(groupValues.size());
@@ -1182,9 +1195,10 @@ void GroupBy::substituteGroupVariable(
     auto newExpression = std::make_unique<sparqlExpression::VectorIdExpression>(
         std::move(values));
 
-    occurrence.parent_->replaceChild(occurrence.nThChild_,
-                                     std::move(newExpression));
+    originalChildren.push_back(occurrence.parent_->replaceChild(
+        occurrence.nThChild_, std::move(newExpression)));
   }
+  return originalChildren;
 }
 
 // _____________________________________________________________________________
@@ -1366,13 +1380,16 @@ void GroupBy::evaluateAlias(
         sparqlExpression::copyExpressionResult(
             sparqlExpression::ExpressionResult{std::move(aggregateResults)});
   } else {
+    std::vector<std::unique_ptr<sparqlExpression::SparqlExpression>>
+        originalGroupVariables;
     for (const auto& substitution : substitutions) {
       const auto& occurrences =
           get<std::vector<ParentAndChildIndex>>(substitution.occurrences_);
       // Substitute in the values of the grouped variable
-      substituteGroupVariable(
+      auto replaced = substituteGroupVariable(
           occurrences, result, evaluationContext._beginIndex,
           evaluationContext.size(), substitution.resultColumnIndex_, allocator);
+      ql::ranges::move(replaced, std::back_inserter(originalGroupVariables));
     }
 
     // Substitute in the results of all aggregates contained in the
@@ -1386,8 +1403,9 @@ void GroupBy::evaluateAlias(
     sparqlExpression::ExpressionResult expressionResult =
         alias.expr_.getPimpl()->evaluate(&evaluationContext);
 
-    // Restore original children. Only necessary when the expression will be
-    // used in the future (not the case for the hash map optimization).
+    // Restore original children. This is necessary because the hash map
+    // optimization may aggregate further rows (e.g. of a spilled partition)
+    // and create further results after this evaluation.
     // TODO<C++23> Use `ql::views::zip(info, originalChildren)`.
     for (size_t i = 0; i < info.size(); ++i) {
       auto& aggregate = info.at(i);
@@ -1395,6 +1413,15 @@ void GroupBy::evaluateAlias(
       parentAndIndex.parent_->replaceChild(parentAndIndex.nThChild_,
                                            std::move(originalChildren.at(i)));
     }
+    size_t groupVariableIndex = 0;
+    for (const auto& substitution : substitutions) {
+      for (const auto& occurrence :
+           get<std::vector<ParentAndChildIndex>>(substitution.occurrences_)) {
+        occurrence.parent_->replaceChild(
+            occurrence.nThChild_,
+            std::move(originalGroupVariables.at(groupVariableIndex++)));
+      }
+    }
 
     // Copy the result so that future aliases may reuse it
     evaluationContext._previousResultsFromSameGroup.at(alias.outCol_) =
@@ -1500,6 +1527,210 @@ static constexpr auto makeProcessGroupsVisitor =
       };
     };
 
+// _____________________________________________________________________________
+template <size_t NUM_GROUP_COLUMNS>
+size_t
+GroupBy::HashMapAggregationData<NUM_GROUP_COLUMNS>::getEstimatedMemory() const {
+  // The hash map stores the key and the offset, and has some slack.
+  size_t perGroup = 2 * (numOfGroupedColumns_ * sizeof(Id) + sizeof(size_t));
+  size_t result = 0;
+  for (const auto& aggregation : aggregationData_) {
+    std::visit(
+        [&perGroup, &result]<VectorOfAggregationData T>(const T& data) {
+          perGroup += sizeof(typename T::value_type);
+          // The strings of `GROUP_CONCAT` grow with the size of the groups.
+          if constexpr (std::is_same_v<typename T::value_type,
+                                       GroupConcatAggregationData>) {
+            for (const auto& groupConcat : data) {
+              result += groupConcat.currentValue_.capacity();
+            }
+          }
+        },
+        aggregation);
+  }
+  return result + perGroup * getNumberOfGroups();
+}
+
+// _____________________________________________________________________________
+template <size_t NUM_GROUP_COLUMNS>
+struct GroupBy::HashMapPartition {
+  // The groups of this partition that are aggregated in RAM.
+  std::optional<HashMapAggregationData<NUM_GROUP_COLUMNS>> aggregationData_;
+  // Set as soon as `aggregationData_` has exceeded its memory budget. From
+  // then on, rows of groups that are not contained in `aggregationData_` are
+  // first collected in `spillBuffer_` and then written to `spilledRows_`.
+  std::unique_ptr<ad_utility::CompressedExternalIdTableWriter> spilledRows_;
+  std::optional<IdTable> spillBuffer_;
+
+  bool isSpilled() const { return spilledRows_ != nullptr; }
+
+  // Write the `spillBuffer_` to the `spilledRows_` and clear it.
+  void flushSpillBuffer() {
+    if (spillBuffer_.has_value() && !spillBuffer_->empty()) {
+      spilledRows_->writeIdTable(spillBuffer_.value());
+      spillBuffer_->clear();
+    }
+  }
+};
+
+namespace {
+// Seed for the hash function that assigns the groups to the partitions. It
+// makes the partitioning independent of the hash maps within the partitions,
+// which use the same hash function.
+constexpr size_t PARTITION_HASH_SEED = 0x5eed'9a27'1710'4b17;
+}  // namespace
+
+// _____________________________________________________________________________
+ad_utility::MemorySize GroupBy::getMemoryForHashMapGroupBy() const {
+  auto threshold =
+      RuntimeParameters().get<"group-by-hash-map-memory-threshold">();
+  return ad_utility::MemorySize::bytes(
+      std::min(threshold.getBytes(),
+               allocator().amountMemoryLeft().getBytes() / 2));
+}
+
+// _____________________________________________________________________________
+template <size_t NUM_GROUP_COLUMNS>
+void GroupBy::aggregateIntoHashMap(
+    HashMapAggregationData<NUM_GROUP_COLUMNS>& aggregationData,
+    const std::vector<HashMapAliasInformation>& aggregateAliases,
+    const IdTable& inputTable, const LocalVocab& localVocab,
+    const std::vector<size_t>& columnIndices) const {
+  // Setup the `EvaluationContext` for this input block.
+  sparqlExpression::EvaluationContext evaluationContext(
+      *getExecutionContext(), _subtree->getVariableColumns(), inputTable,
+      getExecutionContext()->getAllocator(), localVocab, cancellationHandle_,
+      deadline_);
+  evaluationContext._groupedVariables = ad_utility::HashSet<Variable>{
+      _groupByVariables.begin(), _groupByVariables.end()};
+  evaluationContext._isPartOfGroupBy = true;
+
+  // Iterate of the rows of this input block. Process (up to)
+  // `GROUP_BY_HASH_MAP_BLOCK_SIZE` rows at a time.
+  for (size_t i = 0; i < inputTable.size(); i += GROUP_BY_HASH_MAP_BLOCK_SIZE) {
+    checkCancellation();
+
+    evaluationContext._beginIndex = i;
+    evaluationContext._endIndex =
+        std::min(i + GROUP_BY_HASH_MAP_BLOCK_SIZE, inputTable.size());
+
+    auto currentBlockSize = evaluationContext.size();
+
+    // Perform HashMap lookup once for all groups in current block
+    using U = HashMapAggregationData<
+        NUM_GROUP_COLUMNS>::template ArrayOrVector<std::span<const Id>>;
+    U groupValues;
+    resizeIfVector(groupValues, columnIndices.size());
+
+    // TODO<C++23> use views::enumerate
+    size_t j = 0;
+    for (auto& idx : columnIndices) {
+      groupValues[j] = inputTable.getColumn(idx).subspan(
+          evaluationContext._beginIndex, currentBlockSize);
+      ++j;
+    }
+    auto hashEntries = aggregationData.getHashEntries(groupValues);
+
+    for (const auto& aggregateAlias : aggregateAliases) {
+      for (const auto& aggregate : aggregateAlias.aggregateInfo_) {
+        sparqlExpression::ExpressionResult expressionResult =
+            GroupBy::evaluateChildExpressionOfAggregateFunction(
+                aggregate, evaluationContext);
+
+        auto& aggregationDataVariant =
+            aggregationData.getAggregationDataVariant(
+                aggregate.aggregateDataIndex_);
+
+        std::visit(makeProcessGroupsVisitor(currentBlockSize,
+                                            &evaluationContext, hashEntries),
+                   std::move(expressionResult), aggregationDataVariant);
+      }
+    }
+  }
+}
+
+// _____________________________________________________________________________
+template <size_t NUM_GROUP_COLUMNS>
+std::vector<IdTable> GroupBy::splitIntoPartitions(
+    const IdTable& inputTable, const std::vector<size_t>& columnIndices,
+    size_t numPartitions) const {
+  using Key =
+      HashMapAggregationData<NUM_GROUP_COLUMNS>::template ArrayOrVector<Id>;
+  std::vector<std::vector<size_t>> rowsPerPartition(numPartitions);
+  Key key;
+  resizeIfVector(key, columnIndices.size());
+  for (size_t row = 0; row < inputTable.numRows(); ++row) {
+    for (size_t i = 0; i < columnIndices.size(); ++i) {
+      key[i] = inputTable(row, columnIndices[i]);
+    }
+    rowsPerPartition[absl::HashOf(key, PARTITION_HASH_SEED) % numPartitions]
+        .push_back(row);
+  }
+  checkCancellation();
+
+  std::vector<IdTable> partitions;
+  partitions.reserve(numPartitions);
+  for (const auto& rows : rowsPerPartition) {
+    IdTable& partition =
+        partitions.emplace_back(inputTable.numColumns(), allocator());
+    partition.resize(rows.size());
+    for (size_t col = 0; col < inputTable.numColumns(); ++col) {
+      ql::ranges::transform(
+          rows, partition.getColumn(col).begin(),
+          [input = inputTable.getColumn(col)](size_t row) {
+            return input[row];
+          });
+    }
+  }
+  return partitions;
+}
+
+// _____________________________________________________________________________
+template <size_t NUM_GROUP_COLUMNS>
+void GroupBy::addRowsToPartition(
+    HashMapPartition<NUM_GROUP_COLUMNS>& partition,
+    const std::vector<HashMapAliasInformation>& aggregateAliases,
+    const IdTable& rows, const LocalVocab& localVocab,
+    const std::vector<size_t>& columnIndices,
+    size_t maxMemoryPerPartition) const {
+  auto& aggregationData = partition.aggregationData_.value();
+  if (!partition.isSpilled()) {
+    aggregateIntoHashMap(aggregationData, aggregateAliases, rows, localVocab,
+                         columnIndices);
+    if (aggregationData.getEstimatedMemory() > maxMemoryPerPartition) {
+      partition.spilledRows_ =
+          std::make_unique<ad_utility::CompressedExternalIdTableWriter>(
+              getSpillFilename(getIndex(), "group-by-partition"),
+              rows.numColumns(), allocator());
+      partition.spillBuffer_.emplace(rows.numColumns(), allocator());
+    }
+    return;
+  }
+
+  // The hash map is full, so only the rows of groups that it already contains
+  // are aggregated, all other rows are spilled.
+  IdTable knownRows{rows.numColumns(), allocator()};
+  auto& spillBuffer = partition.spillBuffer_.value();
+  typename HashMapAggregationData<NUM_GROUP_COLUMNS>::template ArrayOrVector<Id>
+      key;
+  resizeIfVector(key, columnIndices.size());
+  for (size_t row = 0; row < rows.numRows(); ++row) {
+    for (size_t i = 0; i < columnIndices.size(); ++i) {
+      key[i] = rows(row, columnIndices[i]);
+    }
+    auto& target = aggregationData.contains(key) ? knownRows : spillBuffer;
+    target.push_back(rows[row]);
+  }
+  aggregateIntoHashMap(aggregationData, aggregateAliases, knownRows,
+                       localVocab, columnIndices);
+  // Write the spilled rows in blocks that are large enough for the
+  // compression.
+  if (spillBuffer.numRows() * sizeof(Id) >=
+      DEFAULT_BLOCKSIZE_EXTERNAL_ID_TABLE.getBytes()) {
+    partition.flushSpillBuffer();
+  }
+}
+
 // _____________________________________________________________________________
 template <size_t NUM_GROUP_COLUMNS>
 Result GroupBy::computeGroupByForHashMapOptimization(
@@ -1509,15 +1740,22 @@ Result GroupBy::computeGroupByForHashMapOptimization(
                        NUM_GROUP_COLUMNS == 0);
   LocalVocab localVocab;
 
+  const size_t numPartitions = std::max(
+      size_t{1}, RuntimeParameters().get<"group-by-hash-map-num-partitions">());
+  const size_t numThreads = ad_utility::getNumThreadsForTasks(numPartitions);
+  const size_t maxMemoryPerPartition =
+      getMemoryForHashMapGroupBy().getBytes() / numPartitions;
+
   // Initialize the data for the aggregates of the GROUP BY operation.
-  HashMapAggregationData<NUM_GROUP_COLUMNS> aggregationData(
-      getExecutionContext()->getAllocator(), aggregateAliases,
-      columnIndices.size());
+  std::vector<HashMapPartition<NUM_GROUP_COLUMNS>> partitions(numPartitions);
+  for (auto& partition : partitions) {
+    partition.aggregationData_.emplace(getExecutionContext()->getAllocator(),
+                                       aggregateAliases, columnIndices.size());
+  }
 
   // Process the input blocks (pairs of `IdTable` and `LocalVocab`) one after
   // the other.
-  ad_utility::Timer lookupTimer{ad_utility::Timer::Stopped};
-  ad_utility::Timer aggregationTimer{ad_utility::Timer::Stopped};
+  ad_utility::Timer aggregationTimer{ad_utility::Timer::Started};
   for (const auto& [inputTableRef, inputLocalVocabRef] : subresults) {
     const IdTable& inputTable = inputTableRef;
     const LocalVocab& inputLocalVocab = inputLocalVocabRef;
@@ -1528,68 +1766,88 @@ Result GroupBy::computeGroupByForHashMapOptimization(
     // local vocabs, no deduplication is performed.
     localVocab.mergeWith(std::span{&inputLocalVocab, 1});
 
-    // Setup the `EvaluationContext` for this input block.
-    sparqlExpression::EvaluationContext evaluationContext(
-        *getExecutionContext(), _subtree->getVariableColumns(), inputTable,
-        getExecutionContext()->getAllocator(), localVocab, cancellationHandle_,
-        deadline_);
-    evaluationContext._groupedVariables = ad_utility::HashSet<Variable>{
-        _groupByVariables.begin(), _groupByVariables.end()};
-    evaluationContext._isPartOfGroupBy = true;
-
-    // Iterate of the rows of this input block. Process (up to)
-    // `GROUP_BY_HASH_MAP_BLOCK_SIZE` rows at a time.
-    for (size_t i = 0; i < inputTable.size();
-         i += GROUP_BY_HASH_MAP_BLOCK_SIZE) {
-      checkCancellation();
-
-      evaluationContext._beginIndex = i;
-      evaluationContext._endIndex =
-          std::min(i + GROUP_BY_HASH_MAP_BLOCK_SIZE, inputTable.size());
-
-      auto currentBlockSize = evaluationContext.size();
-
-      // Perform HashMap lookup once for all groups in current block
-      using U = HashMapAggregationData<
-          NUM_GROUP_COLUMNS>::template ArrayOrVector<std::span<const Id>>;
-      U groupValues;
-      resizeIfVector(groupValues, columnIndices.size());
-
-      // TODO<C++23> use views::enumerate
-      size_t j = 0;
-      for (auto& idx : columnIndices) {
-        groupValues[j] = inputTable.getColumn(idx).subspan(
-            evaluationContext._beginIndex, currentBlockSize);
-        ++j;
-      }
-      lookupTimer.cont();
-      auto hashEntries = aggregationData.getHashEntries(groupValues);
-      lookupTimer.stop();
-
-      aggregationTimer.cont();
-      for (auto& aggregateAlias : aggregateAliases) {
-        for (auto& aggregate : aggregateAlias.aggregateInfo_) {
-          sparqlExpression::ExpressionResult expressionResult =
-              GroupBy::evaluateChildExpressionOfAggregateFunction(
-                  aggregate, evaluationContext);
-
-          auto& aggregationDataVariant =
-              aggregationData.getAggregationDataVariant(
-                  aggregate.aggregateDataIndex_);
-
-          std::visit(makeProcessGroupsVisitor(currentBlockSize,
-                                              &evaluationContext, hashEntries),
-                     std::move(expressionResult), aggregationDataVariant);
+    if (numPartitions == 1) {
+      addRowsToPartition(partitions.at(0), aggregateAliases, inputTable,
+                         localVocab, columnIndices, maxMemoryPerPartition);
+      continue;
+    }
+    auto rowsPerPartition = splitIntoPartitions<NUM_GROUP_COLUMNS>(
+        inputTable, columnIndices, numPartitions);
+    ad_utility::runTasksInParallel(numPartitions, numThreads, [&](size_t i) {
+      addRowsToPartition(partitions.at(i), aggregateAliases,
+                         rowsPerPartition.at(i), localVocab, columnIndices,
+                         maxMemoryPerPartition);
+    });
+  }
+  runtimeInfo().addDetail("timeAggregation", aggregationTimer.msecs());
+
+  // Create the results of all partitions. The creation of a result temporarily
+  // modifies the `aggregateAliases` and adds to the `localVocab`, so it must
+  // not run concurrently with any other aggregation or result creation.
+  std::shared_mutex mutex;
+  std::vector<IdTable> results;
+  auto createResult =
+      [&](const HashMapAggregationData<NUM_GROUP_COLUMNS>& aggregationData) {
+        std::unique_lock lock{mutex};
+        results.push_back(createResultFromHashMap(
+            aggregationData, aggregateAliases, &localVocab));
+      };
+  size_t numSpilledPartitions = 0;
+  for (auto& partition : partitions) {
+    createResult(partition.aggregationData_.value());
+    partition.aggregationData_.reset();
+    numSpilledPartitions += partition.isSpilled();
+  }
+
+  // Aggregate the spilled rows of each partition. They belong to groups that
+  // are disjoint from the ones above, so no partial results have to be
+  // merged. The spilled rows are aggregated with the same memory budget per
+  // partition as above: If the hash map exceeds it again, the rows of the
+  // remaining groups are spilled again and aggregated in the next round. Each
+  // round completely aggregates at least the groups of the first spilled
+  // block, so the number of rounds is finite.
+  ad_utility::Timer spilledTimer{ad_utility::Timer::Started};
+  std::atomic<size_t> numSpillRounds = 0;
+  ad_utility::runTasksInParallel(numPartitions, numThreads, [&](size_t i) {
+    auto& partition = partitions.at(i);
+    while (partition.isSpilled()) {
+      ++numSpillRounds;
+      partition.flushSpillBuffer();
+      auto spilledRows = std::move(partition.spilledRows_);
+      partition.spillBuffer_.reset();
+      partition.aggregationData_.emplace(getExecutionContext()->getAllocator(),
+                                         aggregateAliases,
+                                         columnIndices.size());
+      for (auto& generator : spilledRows->getAllGenerators()) {
+        for (const IdTable& block : generator) {
+          std::shared_lock lock{mutex};
+          addRowsToPartition(partition, aggregateAliases, block, localVocab,
+                             columnIndices, maxMemoryPerPartition);
         }
       }
-      aggregationTimer.stop();
+      // Delete the file of the rows that have just been aggregated.
+      spilledRows.reset();
+      createResult(partition.aggregationData_.value());
+      partition.aggregationData_.reset();
+    }
+  });
+  runtimeInfo().addDetail("numPartitions", numPartitions);
+  runtimeInfo().addDetail("numSpilledPartitions", numSpilledPartitions);
+  if (numSpilledPartitions > 0) {
+    runtimeInfo().addDetail("numSpillRounds", numSpillRounds.load());
+    runtimeInfo().addDetail("timeSpilledPartitions", spilledTimer.msecs());
+  }
+
+  // Each of the `results` is sorted by the groups, so they only have to be
+  // combined if there are several of them.
+  IdTable resultTable = std::move(results.at(0));
+  if (results.size() > 1) {
+    for (const auto& result : results | ql::views::drop(1)) {
+      resultTable.insertAtEnd(result);
     }
+    Engine::sort(resultTable, resultSortedOn());
+    checkCancellation();
   }
-
-  runtimeInfo().addDetail("timeMapLookup", lookupTimer.msecs());
-  runtimeInfo().addDetail("timeAggregation", aggregationTimer.msecs());
-  IdTable resultTable =
-      createResultFromHashMap(aggregationData, aggregateAliases, &localVocab);
   return {std::move(resultTable), resultSortedOn(), std::move(localVocab)};
 }
 
@@ -313,7 +313,13 @@ class GroupBy : public Operation {
   };
 
   // Create result IdTable by using a HashMap mapping groups to aggregation data
-  // and subsequently calling `createResultFromHashMap`.
+  // and subsequently calling `createResultFromHashMap`. The rows of the
+  // `subresults` are split into `group-by-hash-map-num-partitions` partitions
+  // by the hash of their groups, and the partitions are aggregated in
+  // parallel. When the hash map of a partition exceeds its share of the
+  // memory budget (see `getMemoryForHashMapGroupBy`), then the rows of groups
+  // that are not yet contained in it are written to disk and aggregated
+  // separately after the complete input has been read.
   template <size_t NUM_GROUP_COLUMNS>
   Result computeGroupByForHashMapOptimization(
       std::vector<HashMapAliasInformation>& aggregateAliases, auto subresults,
@@ -403,6 +409,16 @@ class GroupBy : public Operation {
     // Returns the number of groups.
     [[nodiscard]] size_t getNumberOfGroups() const { return map_.size(); }
 
+    // Return true iff the group `ids` is already contained.
+    [[nodiscard]] bool contains(const ArrayOrVector<Id>& ids) const {
+      return map_.contains(ids);
+    }
+
+    // Return an estimate of the memory that is used by the hash map and the
+    // aggregation data of all groups, including the strings of the
+    // `GROUP_CONCAT` aggregates.
+    [[nodiscard]] size_t getEstimatedMemory() const;
+
     // How many columns we are grouping by, important in case
     // `NUM_GROUP_COLUMNS` == 0.
     size_t numOfGroupedColumns_;
@@ -454,6 +470,47 @@ class GroupBy : public Operation {
       std::vector<HashMapAliasInformation>& aggregateAliases,
       LocalVocab* localVocab) const;
 
+  // One of the partitions of `computeGroupByForHashMapOptimization`. Defined
+  // in `GroupBy.cpp`.
+  template <size_t NUM_GROUP_COLUMNS>
+  struct HashMapPartition;
+
+  // Aggregate all the rows of the `inputTable` into the `aggregationData`.
+  // The `localVocab` has to contain the local vocab entries of the
+  // `inputTable`.
+  template <size_t NUM_GROUP_COLUMNS>
+  void aggregateIntoHashMap(
+      HashMapAggregationData<NUM_GROUP_COLUMNS>& aggregationData,
+      const std::vector<HashMapAliasInformation>& aggregateAliases,
+      const IdTable& inputTable, const LocalVocab& localVocab,
+      const std::vector<size_t>& columnIndices) const;
+
+  // Split the rows of the `inputTable` into `numPartitions` tables by the
+  // hash of their values in the `columnIndices`, s.t. all the rows of the
+  // same group end up in the same partition. The order of the rows within a
+  // partition is the order in the `inputTable`.
+  template <size_t NUM_GROUP_COLUMNS>
+  std::vector<IdTable> splitIntoPartitions(
+      const IdTable& inputTable, const std::vector<size_t>& columnIndices,
+      size_t numPartitions) const;
+
+  // Add the `rows` to the `partition`. Rows of groups that are not yet
+  // contained in the hash map of the `partition` are written to disk if the
+  // hash map already uses more than `maxMemoryPerPartition` bytes.
+  template <size_t NUM_GROUP_COLUMNS>
+  void addRowsToPartition(
+      HashMapPartition<NUM_GROUP_COLUMNS>& partition,
+      const std::vector<HashMapAliasInformation>& aggregateAliases,
+      const IdTable& rows, const LocalVocab& localVocab,
+      const std::vector<size_t>& columnIndices,
+      size_t maxMemoryPerPartition) const;
+
+  // Return the memory budget for the hash maps of
+  // `computeGroupByForHashMapOptimization`. It is bounded by the runtime
+  // parameter `group-by-hash-map-memory-threshold` and by half of the memory
+  // that is still left in the allocator.
+  ad_utility::MemorySize getMemoryForHashMapGroupBy() const;
+
   // Reusable implementation of `checkIfHashMapOptimizationPossible`.
   static std::optional<HashMapOptimizationData>
   computeUnsequentialProcessingMetadata(
@@ -476,7 +533,9 @@ class GroupBy : public Operation {
       IdTable* resultTable, LocalVocab* localVocab, size_t outCol);
 
   // Substitute the group values for all occurrences of a group variable.
-  static void substituteGroupVariable(
+  // Return the replaced `SparqlExpression`s to put them back afterwards.
+  static std::vector<std::unique_ptr<sparqlExpression::SparqlExpression>>
+  substituteGroupVariable(
       const std::vector<ParentAndChildIndex>& occurrences, IdTable* resultTable,
       size_t beginIndex, size_t count, size_t columnIndex,
       const Allocator& allocator);
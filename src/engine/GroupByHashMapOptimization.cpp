@@ -52,10 +52,9 @@ template struct ExtremumAggregationData<valueIdComparators::Comparison::GT>;
     LocalVocab* localVocab) const {
   using namespace ad_utility::triple_component;
   using Lit = ad_utility::triple_component::Literal;
-  auto localVocabIndex = localVocab->getIndexAndAddIfNotContained(
+  return localVocab->getIdAndAddIfNotContained(
       LiteralOrIri{Lit::literalWithNormalizedContent(
           asNormalizedStringViewUnsafe(currentValue_))});
-  return ValueId::makeFromLocalVocabIndex(localVocabIndex);
 }
 
 // _____________________________________________________________________________
@@ -0,0 +1,336 @@
+//  Copyright 2025, University of Freiburg,
+//                  Chair of Algorithms and Data Structures.
+
+#include "engine/HashJoin.h"
+
+#include <absl/strings/str_cat.h>
+
+#include <algorithm>
+#include <array>
+#include <numeric>
+
+#include "global/RuntimeParameters.h"
+#include "index/LocalVocabEntry.h"
+#include "util/BitUtils.h"
+#include "util/HashMap.h"
+#include "util/RunTasksInParallel.h"
+#include "util/Timer.h"
+
+namespace {
+// The temporary data structures of the join are allocated with the allocator
+// of the operation, s.t. they count against the memory limit.
+template <typename T>
+using VectorWithLimit = std::vector<T, ad_utility::AllocatorWithLimit<T>>;
+
+// The indices of the rows of a table, grouped by the partition of their join
+// column. The rows of partition `i` are `rows_[offsets_[i], offsets_[i + 1])`.
+struct PartitionedRows {
+  VectorWithLimit<size_t> offsets_;
+  VectorWithLimit<size_t> rows_;
+
+  std::span<const size_t> partition(size_t i) const {
+    return std::span{rows_}.subspan(offsets_[i], offsets_[i + 1] - offsets_[i]);
+  }
+};
+
+// Partition the rows by the highest `numRadixBits` bits of the hash of their
+// entry in the `joinColumn`. This requires two passes over the `joinColumn`,
+// one to compute the size of the partitions and one to scatter the rows.
+PartitionedRows partitionRows(
+    std::span<const Id> joinColumn, size_t numRadixBits,
+    const ad_utility::AllocatorWithLimit<Id>& allocator) {
+  auto getPartition = [numRadixBits](Id id) -> size_t {
+    // The highest bits of the hash, which makes the partitioning independent
+    // of the hash maps within the partitions.
+    return numRadixBits == 0
+               ? 0
+               : ad_utility::mixBits(id.getBits()) >> (64 - numRadixBits);
+  };
+  const size_t numPartitions = size_t{1} << numRadixBits;
+  PartitionedRows result{VectorWithLimit<size_t>(allocator),
+                         VectorWithLimit<size_t>(allocator)};
+  result.offsets_.assign(numPartitions + 1, 0);
+  for (Id id : joinColumn) {
+    ++result.offsets_[getPartition(id) + 1];
+  }
+  std::partial_sum(result.offsets_.begin(), result.offsets_.end(),
+                   result.offsets_.begin());
+  VectorWithLimit<size_t> nextRow{result.offsets_.begin(),
+                                  result.offsets_.end() - 1, allocator};
+  result.rows_.resize(joinColumn.size());
+  for (size_t i = 0; i < joinColumn.size(); ++i) {
+    result.rows_[nextRow[getPartition(joinColumn[i])]++] = i;
+  }
+  return result;
+}
+
+// `LocalVocabIndex` and `InlineString` `Id`s are compared by their string
+// values, so equal `Id`s can have different bits (for example, the same IRI
+// in the `LocalVocab`s of both inputs, or an `InlineString` that is equal to a
+// word from the vocabulary). The partitioning and the hash maps however use
+// the bits. If one of the join columns contains such `Id`s, return copies of
+// both columns in which each of these `Id`s is replaced by an equal canonical
+// `Id`: The `VocabIndex` of the equal word from the vocabulary if there is
+// one, else the first `Id` with the same string. Equal `Id`s then have equal
+// bits. Return `std::nullopt` if there are no such `Id`s (the common case), in
+// which the join columns can be used as they are.
+std::optional<std::array<VectorWithLimit<Id>, 2>> canonicalizeJoinColumns(
+    std::span<const Id> leftColumn, std::span<const Id> rightColumn,
+    const ad_utility::AllocatorWithLimit<Id>& allocator) {
+  auto isComparedByString = [](Id id) {
+    auto datatype = id.getDatatype();
+    return datatype == Datatype::LocalVocabIndex ||
+           datatype == Datatype::InlineString;
+  };
+  if (ql::ranges::none_of(leftColumn, isComparedByString) &&
+      ql::ranges::none_of(rightColumn, isComparedByString)) {
+    return std::nullopt;
+  }
+  ad_utility::HashMapWithMemoryLimit<std::string, Id> canonicalIds{allocator};
+  auto canonicalize = [&isComparedByString, &canonicalIds](Id id) {
+    if (!isComparedByString(id)) {
+      return id;
+    }
+    std::string word =
+        id.getDatatype() == Datatype::LocalVocabIndex
+            ? id.getLocalVocabIndex()->toStringRepresentation()
+            : std::string{id.getInlineString().view()};
+    auto [it, isNew] = canonicalIds.try_emplace(std::move(word), id);
+    if (isNew) {
+      auto position =
+          id.getDatatype() == Datatype::LocalVocabIndex
+              ? id.getLocalVocabIndex()->positionInVocab()
+              : LocalVocabEntry::positionInVocab(id.getInlineString());
+      if (position.lowerBound_ < position.upperBound_) {
+        it->second = Id::makeFromVocabIndex(position.lowerBound_);
+      }
+    }
+    return it->second;
+  };
+  std::array<VectorWithLimit<Id>, 2> result{VectorWithLimit<Id>(allocator),
+                                            VectorWithLimit<Id>(allocator)};
+  result[0].reserve(leftColumn.size());
+  result[1].reserve(rightColumn.size());
+  ql::ranges::transform(leftColumn, std::back_inserter(result[0]),
+                        canonicalize);
+  ql::ranges::transform(rightColumn, std::back_inserter(result[1]),
+                        canonicalize);
+  return result;
+}
+}  // namespace
+
+// _____________________________________________________________________________
+HashJoin::HashJoin(QueryExecutionContext* qec,
+                   std::shared_ptr<QueryExecutionTree> t1,
+                   std::shared_ptr<QueryExecutionTree> t2,
+                   ColumnIndex t1JoinColumn, ColumnIndex t2JoinColumn)
+    : Operation{qec} {
+  AD_CONTRACT_CHECK(t1 && t2);
+  // Make the order of the two subtrees deterministic (compare `Join`).
+  if (t1->getCacheKey() > t2->getCacheKey()) {
+    std::swap(t1, t2);
+    std::swap(t1JoinColumn, t2JoinColumn);
+  }
+  left_ = std::move(t1);
+  right_ = std::move(t2);
+  leftJoinColumn_ = t1JoinColumn;
+  rightJoinColumn_ = t2JoinColumn;
+
+  auto getJoinVariable = [](const QueryExecutionTree& tree,
+                            ColumnIndex joinColumn) {
+    const auto& [variable, info] =
+        tree.getVariableAndInfoByColumnIndex(joinColumn);
+    // UNDEF values would have to match all the values of the other input,
+    // which is not supported by the hash maps.
+    AD_CONTRACT_CHECK(info.mightContainUndef_ ==
+                      ColumnIndexAndTypeInfo::AlwaysDefined);
+    return variable;
+  };
+  joinVariable_ = getJoinVariable(*left_, leftJoinColumn_);
+  AD_CONTRACT_CHECK(joinVariable_ ==
+                    getJoinVariable(*right_, rightJoinColumn_));
+}
+
+// _____________________________________________________________________________
+string HashJoin::getCacheKeyImpl() const {
+  return absl::StrCat("HASH JOIN\n", left_->getCacheKey(), " join-column: [",
+                      leftJoinColumn_, "]\n|X|\n", right_->getCacheKey(),
+                      " join-column: [", rightJoinColumn_, "]");
+}
+
+// _____________________________________________________________________________
+string HashJoin::getDescriptor() const {
+  return "HashJoin on " + joinVariable_.name();
+}
+
+// _____________________________________________________________________________
+size_t HashJoin::getResultWidth() const {
+  return left_->getResultWidth() + right_->getResultWidth() - 1;
+}
+
+// _____________________________________________________________________________
+VariableToColumnMap HashJoin::computeVariableToColumnMap() const {
+  return makeVarToColMapForJoinOperation(
+      left_->getVariableColumns(), right_->getVariableColumns(),
+      {{leftJoinColumn_, rightJoinColumn_}}, BinOpType::Join,
+      left_->getResultWidth());
+}
+
+// _____________________________________________________________________________
+const Join::SizeEstimateAndMultiplicities& HashJoin::getEstimates() {
+  if (!estimates_.has_value()) {
+    estimates_ = Join::computeSizeEstimateAndMultiplicities(
+        _executionContext, *left_, leftJoinColumn_, *right_, rightJoinColumn_);
+  }
+  return estimates_.value();
+}
+
+// _____________________________________________________________________________
+size_t HashJoin::getCostEstimate() {
+  size_t leftSize = left_->getSizeEstimate();
+  size_t rightSize = right_->getSizeEstimate();
+  size_t buildSize = std::min(leftSize, rightSize);
+  size_t probeSize = std::max(leftSize, rightSize);
+  double costJoin =
+      buildSize * _executionContext->getCostFactor("HASH_JOIN_BUILD_COST") +
+      probeSize * _executionContext->getCostFactor("HASH_JOIN_PROBE_COST");
+  return getSizeEstimateBeforeLimit() + static_cast<size_t>(costJoin) +
+         left_->getCostEstimate() + right_->getCostEstimate();
+}
+
+// _____________________________________________________________________________
+ProtoResult HashJoin::computeResult([[maybe_unused]] bool requestLaziness) {
+  if (left_->knownEmptyResult() || right_->knownEmptyResult()) {
+    left_->getRootOperation()->updateRuntimeInformationWhenOptimizedOut();
+    right_->getRootOperation()->updateRuntimeInformationWhenOptimizedOut();
+    return {IdTable{getResultWidth(), allocator()}, resultSortedOn(),
+            LocalVocab{}};
+  }
+  std::shared_ptr<const Result> leftResult = left_->getResult();
+  checkCancellation();
+  std::shared_ptr<const Result> rightResult = right_->getResult();
+  checkCancellation();
+
+  const size_t numRadixBits = std::min(
+      size_t{16}, RuntimeParameters().get<"hash-join-num-radix-bits">());
+  const size_t numThreads =
+      ad_utility::getNumThreadsForTasks(size_t{1} << numRadixBits);
+  IdTable result{getResultWidth(), allocator()};
+  join(leftResult->idTable(), leftJoinColumn_, rightResult->idTable(),
+       rightJoinColumn_, numRadixBits, numThreads, result);
+  return {std::move(result), resultSortedOn(),
+          Result::getMergedLocalVocab(*leftResult, *rightResult)};
+}
+
+// _____________________________________________________________________________
+void HashJoin::join(const IdTable& left, ColumnIndex leftJoinColumn,
+                    const IdTable& right, ColumnIndex rightJoinColumn,
+                    size_t numRadixBits, size_t numThreads, IdTable& result) {
+  AD_CONTRACT_CHECK(result.empty() &&
+                    result.numColumns() ==
+                        left.numColumns() + right.numColumns() - 1);
+  const bool buildIsLeft = left.size() <= right.size();
+  const IdTable& build = buildIsLeft ? left : right;
+  const IdTable& probe = buildIsLeft ? right : left;
+  const ColumnIndex buildJoinColumn =
+      buildIsLeft ? leftJoinColumn : rightJoinColumn;
+  const ColumnIndex probeJoinColumn =
+      buildIsLeft ? rightJoinColumn : leftJoinColumn;
+  const size_t numPartitions = size_t{1} << numRadixBits;
+  auto& info = runtimeInfo();
+  info.addDetail("buildSide", buildIsLeft ? "left" : "right");
+  info.addDetail("numBuildRows", build.size());
+  info.addDetail("numProbeRows", probe.size());
+  info.addDetail("numPartitions", numPartitions);
+  info.addDetail("numThreads", numThreads);
+
+  ad_utility::Timer timer{ad_utility::Timer::Started};
+  // The keys by which the rows are partitioned and joined.
+  std::span<const Id> buildKeys = build.getColumn(buildJoinColumn);
+  std::span<const Id> probeKeys = probe.getColumn(probeJoinColumn);
+  auto canonicalKeys =
+      canonicalizeJoinColumns(buildKeys, probeKeys, allocator());
+  info.addDetail("canonicalizedJoinColumns", canonicalKeys.has_value());
+  if (canonicalKeys.has_value()) {
+    buildKeys = canonicalKeys.value()[0];
+    probeKeys = canonicalKeys.value()[1];
+  }
+  checkCancellation();
+  auto buildPartitions = partitionRows(buildKeys, numRadixBits, allocator());
+  checkCancellation();
+  auto probePartitions = partitionRows(probeKeys, numRadixBits, allocator());
+  checkCancellation();
+  info.addDetail("timePartitioning", timer.msecs());
+
+  timer.start();
+  std::vector<std::optional<IdTable>> partitionResults(numPartitions);
+  ad_utility::runTasksInParallel(numPartitions, numThreads, [&](size_t i) {
+    partitionResults[i] = joinPartition(
+        build, buildKeys, buildPartitions.partition(i), probe, probeKeys,
+        probePartitions.partition(i), rightJoinColumn, buildIsLeft);
+  });
+  info.addDetail("timeBuildAndProbe", timer.msecs());
+
+  size_t totalSize = 0;
+  for (const auto& partitionResult : partitionResults) {
+    totalSize += partitionResult.value().size();
+  }
+  result.reserve(totalSize);
+  for (auto& partitionResult : partitionResults) {
+    result.insertAtEnd(partitionResult.value());
+    partitionResult.reset();
+  }
+}
+
+// _____________________________________________________________________________
+IdTable HashJoin::joinPartition(
+    const IdTable& build, std::span<const Id> buildKeys,
+    std::span<const size_t> buildRows, const IdTable& probe,
+    std::span<const Id> probeKeys, std::span<const size_t> probeRows,
+    ColumnIndex rightJoinColumn, bool buildIsLeft) const {
+  IdTable result{build.numColumns() + probe.numColumns() - 1, allocator()};
+  if (buildRows.empty() || probeRows.empty()) {
+    return result;
+  }
+  ad_utility::HashMapWithMemoryLimit<Id, VectorWithLimit<size_t>> hashMap{
+      allocator()};
+  for (size_t row : buildRows) {
+    hashMap.try_emplace(buildKeys[row], allocator())
+        .first->second.push_back(row);
+  }
+  checkCancellation();
+
+  const IdTable& left = buildIsLeft ? build : probe;
+  const IdTable& right = buildIsLeft ? probe : build;
+  auto addRow = [&](size_t leftRow, size_t rightRow) {
+    result.emplace_back();
+    size_t resultRow = result.size() - 1;
+    for (size_t col = 0; col < left.numColumns(); ++col) {
+      result(resultRow, col) = left(leftRow, col);
+    }
+    size_t resultCol = left.numColumns();
+    for (size_t col = 0; col < right.numColumns(); ++col) {
+      if (col != rightJoinColumn) {
+        result(resultRow, resultCol++) = right(rightRow, col);
+      }
+    }
+  };
+
+  for (size_t i = 0; i < probeRows.size(); ++i) {
+    size_t probeRow = probeRows[i];
+    auto it = hashMap.find(probeKeys[probeRow]);
+    if (it != hashMap.end()) {
+      for (size_t buildRow : it->second) {
+        if (buildIsLeft) {
+          addRow(buildRow, probeRow);
+        } else {
+          addRow(probeRow, buildRow);
+        }
+      }
+    }
+    if (i % 16384 == 0) {
+      checkCancellation();
+    }
+  }
+  return result;
+}
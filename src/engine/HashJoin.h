@@ -0,0 +1,109 @@
+//  Copyright 2025, University of Freiburg,
+//                  Chair of Algorithms and Data Structures.
+
+#pragma once
+
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "engine/Join.h"
+#include "engine/Operation.h"
+#include "engine/QueryExecutionTree.h"
+
+// A join on a single column that, unlike `Join`, doesn't require its inputs to
+// be sorted. Both inputs are fully materialized and radix-partitioned by the
+// hash of their join column. The partitions are then joined in parallel: For
+// each partition, the rows of the smaller input (the build side) are stored in
+// a hash map, which is then probed with the rows of the larger input. The
+// result consists of the columns of the left input, followed by the columns of
+// the right input without the join column (just like for `Join`), but it is
+// not sorted.
+//
+// The join columns must not contain UNDEF values. `LocalVocabIndex` and
+// `InlineString` values, which are compared by their strings and not by their
+// bits, are replaced by canonical values for the hash maps. The `QueryPlanner`
+// only considers this operation for large inputs that are not sorted on the
+// join column and whose build side fits into the memory budget, see the
+// runtime parameters `hash-join-min-input-size` and
+// `hash-join-max-build-side-size`.
+class HashJoin : public Operation {
+ private:
+  std::shared_ptr<QueryExecutionTree> left_;
+  std::shared_ptr<QueryExecutionTree> right_;
+  ColumnIndex leftJoinColumn_;
+  ColumnIndex rightJoinColumn_;
+  Variable joinVariable_{"?notSet"};
+
+  // The estimates are the same as for a `Join` and computed lazily.
+  std::optional<Join::SizeEstimateAndMultiplicities> estimates_;
+
+ public:
+  HashJoin(QueryExecutionContext* qec, std::shared_ptr<QueryExecutionTree> t1,
+           std::shared_ptr<QueryExecutionTree> t2, ColumnIndex t1JoinColumn,
+           ColumnIndex t2JoinColumn);
+
+ protected:
+  string getCacheKeyImpl() const override;
+
+ public:
+  string getDescriptor() const override;
+
+  size_t getResultWidth() const override;
+
+  // The order of the result depends on the partitioning and the hash maps.
+  std::vector<ColumnIndex> resultSortedOn() const override { return {}; }
+
+ private:
+  uint64_t getSizeEstimateBeforeLimit() override {
+    return getEstimates().sizeEstimate_;
+  }
+
+ public:
+  // Each row of the build side is inserted into a hash map and each row of
+  // the probe side leads to a lookup in this hash map. The costs of these
+  // operations are the cost factors `HASH_JOIN_BUILD_COST` and
+  // `HASH_JOIN_PROBE_COST` (per row).
+  size_t getCostEstimate() override;
+
+  float getMultiplicity(size_t col) override {
+    return getEstimates().multiplicities_.at(col);
+  }
+
+  bool knownEmptyResult() override {
+    return left_->knownEmptyResult() || right_->knownEmptyResult();
+  }
+
+  vector<QueryExecutionTree*> getChildren() override {
+    return {left_.get(), right_.get()};
+  }
+
+  // Join the `left` and `right` table on the given columns using
+  // `2^numRadixBits` partitions, which are joined by (at most) `numThreads`
+  // threads. The `result` must be empty and have the width of the result of
+  // the join. The rows of the `result` are in no particular order. Public for
+  // testing.
+  void join(const IdTable& left, ColumnIndex leftJoinColumn,
+            const IdTable& right, ColumnIndex rightJoinColumn,
+            size_t numRadixBits, size_t numThreads, IdTable& result);
+
+ private:
+  ProtoResult computeResult(bool requestLaziness) override;
+
+  VariableToColumnMap computeVariableToColumnMap() const override;
+
+  const Join::SizeEstimateAndMultiplicities& getEstimates();
+
+  // Join the rows `buildRows` of the `build` table with the rows `probeRows`
+  // of the `probe` table, where `buildIsLeft` determines the order of the
+  // columns in the result and `rightJoinColumn` is the join column of the
+  // right one of the two tables (which is not part of the result). The rows
+  // are joined by their `buildKeys` and `probeKeys`, which are the join
+  // columns with canonical `Id`s (see `canonicalizeJoinColumns` in
+  // `HashJoin.cpp`).
+  IdTable joinPartition(const IdTable& build, std::span<const Id> buildKeys,
+                        std::span<const size_t> buildRows, const IdTable& probe,
+                        std::span<const Id> probeKeys,
+                        std::span<const size_t> probeRows,
+                        ColumnIndex rightJoinColumn, bool buildIsLeft) const;
+};
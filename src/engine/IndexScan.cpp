@@ -11,6 +11,8 @@
 #include <sstream>
 #include <string>
 
+#include "engine/JoinFilter.h"
+#include "global/RuntimeParameters.h"
 #include "index/IndexImpl.h"
 #include "parser/ParsedQuery.h"
 
@@ -167,12 +169,20 @@ IndexScan::setPrefilterGetUpdatedQueryExecutionTree(
   if (!optSortedVarColIdxPair.has_value()) {
     return std::nullopt;
   }
-  const auto& [sortedVar, colIdx] = optSortedVarColIdxPair.value();
-  auto it =
-      ql::ranges::find(prefilterVariablePairs, sortedVar, ad_utility::second);
-  if (it != prefilterVariablePairs.end()) {
-    return makeCopyWithAddedPrefilters(
-        std::make_pair(it->first->clone(), colIdx));
+  // Prefer the first sorted variable, for which the blocks can be filtered by
+  // their first and last triple, and the rows of the blocks can be filtered
+  // as well. For the other variables only the column summaries of the blocks
+  // can be used (see `applyPrefilter`).
+  const auto& permutedTriple = getPermutedTriple();
+  for (size_t colIdx = optSortedVarColIdxPair.value().second; colIdx < 3;
+       ++colIdx) {
+    const auto& variable = permutedTriple.at(colIdx)->getVariable();
+    auto it =
+        ql::ranges::find(prefilterVariablePairs, variable, ad_utility::second);
+    if (it != prefilterVariablePairs.end()) {
+      return makeCopyWithAddedPrefilters(
+          std::make_pair(it->first->clone(), colIdx));
+    }
   }
   return std::nullopt;
 }
@@ -222,9 +232,9 @@ Result::Generator IndexScan::chunkedIndexScan() const {
 // _____________________________________________________________________________
 IdTable IndexScan::materializedIndexScan() const {
   IdTable idTable = getScanPermutation().scan(
-      getScanSpecification(), additionalColumns(), cancellationHandle_,
-      locatedTriplesSnapshot(), getLimit(),
-      getBlockMetadataOptionallyPrefiltered());
+      getScanSpecificationWithRowFilter(), additionalColumns(),
+      cancellationHandle_, locatedTriplesSnapshot(), getLimit(),
+      applyJoinFilters(getBlockMetadataOptionallyPrefiltered()));
   AD_CORRECTNESS_CHECK(idTable.numColumns() == getResultWidth());
   LOG(DEBUG) << "IndexScan result computation done.\n";
   checkCancellation();
@@ -293,6 +303,24 @@ void IndexScan::determineMultiplicities() {
   AD_CONTRACT_CHECK(multiplicity_.size() == getResultWidth());
 }
 
+// _____________________________________________________________________________
+const ValueHistogram* IndexScan::getValueHistogram(size_t col) const {
+  const PredicateStatistics* statistics = getIndex().getPredicateStatistics();
+  if (statistics == nullptr || predicate_.isVariable() ||
+      !object_.isVariable() || !subject_.isVariable() || subject_ == object_) {
+    return nullptr;
+  }
+  const auto& varToCol = getInternallyVisibleVariableColumns();
+  auto it = varToCol.find(object_.getVariable());
+  if (it == varToCol.end() || it->second.columnIndex_ != col) {
+    return nullptr;
+  }
+  std::optional<Id> predicateId = predicate_.toValueId(getIndex().getVocab());
+  return predicateId.has_value()
+             ? statistics->getObjectHistogram(predicateId.value())
+             : nullptr;
+}
+
 // _____________________________________________________________________________
 std::array<const TripleComponent* const, 3> IndexScan::getPermutedTriple()
     const {
@@ -308,6 +336,38 @@ ScanSpecification IndexScan::getScanSpecification() const {
   return getScanSpecificationTc().toScanSpecification(index);
 }
 
+// _____________________________________________________________________________
+ScanSpecification IndexScan::getScanSpecificationWithRowFilter() const {
+  auto scanSpec = getScanSpecification();
+  // The rows can only be filtered if the scan is not constrained by a LIMIT or
+  // OFFSET, because these are applied to the unfiltered rows.
+  if (!getLimit().isUnconstrained()) {
+    return scanSpec;
+  }
+  if (prefilter_.has_value() &&
+      RuntimeParameters().get<"index-scan-filter-rows-by-prefilter">() &&
+      prefilterIsOnSortedColumn()) {
+    // The prefilter is applied to the first free column of the permutation,
+    // which is the first column of the decompressed blocks.
+    std::shared_ptr<const PrefilterExpression> expression =
+        prefilter_.value().first->clone();
+    scanSpec.addRowFilter(std::make_shared<const ScanSpecification::RowFilter>(
+        [expression](std::span<const Id> ids) {
+          return expression->evaluateOnIds(ids);
+        }));
+  }
+  // The filters keep the `JoinFilter`s alive until the scan is complete.
+  for (auto& [column, filter] : getActiveJoinFilters()) {
+    scanSpec.addRowFilter(
+        std::make_shared<const ScanSpecification::RowFilter>(
+            [filter](std::span<const Id> ids) {
+              return filter->evaluate(ids);
+            }),
+        column);
+  }
+  return scanSpec;
+}
+
 // _____________________________________________________________________________
 ScanSpecificationAsTripleComponent IndexScan::getScanSpecificationTc() const {
   auto permutedTriple = getPermutedTriple();
@@ -358,9 +418,67 @@ IndexScan::getBlockMetadataOptionallyPrefiltered() const {
 std::vector<CompressedBlockMetadata> IndexScan::applyPrefilter(
     std::span<const CompressedBlockMetadata> blocks) const {
   AD_CORRECTNESS_CHECK(prefilter_.has_value() && getLimit().isUnconstrained());
-  // Apply the prefilter on given blocks.
+  // Apply the prefilter on given blocks. The blocks are only sorted by the
+  // first free column, for the other columns only the column summaries of the
+  // blocks can be used.
   auto& [prefilterExpr, columnIndex] = prefilter_.value();
-  return prefilterExpr->evaluate(blocks, columnIndex);
+  if (prefilterIsOnSortedColumn()) {
+    return prefilterExpr->evaluate(blocks, columnIndex);
+  }
+  return prefilterExpr->evaluateOnColumnSummaries(blocks, columnIndex);
+}
+
+// _____________________________________________________________________________
+bool IndexScan::prefilterIsOnSortedColumn() const {
+  AD_CORRECTNESS_CHECK(prefilter_.has_value());
+  return prefilter_.value().second ==
+         getSortedVariableAndMetadataColumnIndexForPrefiltering()
+             .value()
+             .second;
+}
+
+// _____________________________________________________________________________
+std::vector<std::pair<ColumnIndex, std::shared_ptr<const JoinFilter>>>
+IndexScan::getActiveJoinFilters() const {
+  std::vector<std::pair<ColumnIndex, std::shared_ptr<const JoinFilter>>>
+      result;
+  if (!getLimit().isUnconstrained()) {
+    return result;
+  }
+  for (const auto& [column, weakFilter] : joinFilters_) {
+    if (auto filter = weakFilter.lock()) {
+      result.emplace_back(column, std::move(filter));
+    }
+  }
+  return result;
+}
+
+// _____________________________________________________________________________
+std::optional<std::vector<CompressedBlockMetadata>> IndexScan::applyJoinFilters(
+    std::optional<std::vector<CompressedBlockMetadata>> blocks) const {
+  for (const auto& [column, filter] : getActiveJoinFilters()) {
+    // The blocks are only sorted by the first column of the result.
+    const std::vector<Id>* keys = filter->sortedKeys();
+    if (column != 0 || keys == nullptr) {
+      continue;
+    }
+    auto metadata = getMetadataForScan();
+    if (!metadata.has_value()) {
+      return blocks;
+    }
+    if (!blocks.has_value()) {
+      auto relevantBlocks =
+          CompressedRelationReader::getBlocksFromMetadata(metadata.value());
+      blocks.emplace(relevantBlocks.begin(), relevantBlocks.end());
+    }
+    CompressedRelationReader::ScanSpecAndBlocksAndBounds metadataAndBlocks{
+        {metadata.value().scanSpec_, blocks.value()},
+        metadata.value().firstAndLastTriple_};
+    auto blocksForJoin =
+        CompressedRelationReader::getBlocksForJoin(*keys, metadataAndBlocks);
+    blocks = std::move(blocksForJoin);
+  }
+  return blocks;
 }
 
 // _____________________________________________________________________________
@@ -380,9 +498,12 @@ Permutation::IdTableGenerator IndexScan::getLazyScan(
     // be applied.
     filteredBlocks = applyPrefilter(filteredBlocks.value());
   }
-  return getScanPermutation().lazyScan(getScanSpecification(), filteredBlocks,
-                                       additionalColumns(), cancellationHandle_,
-                                       locatedTriplesSnapshot(), getLimit());
+  if (filteredBlocks.has_value()) {
+    filteredBlocks = applyJoinFilters(std::move(filteredBlocks));
+  }
+  return getScanPermutation().lazyScan(
+      getScanSpecificationWithRowFilter(), filteredBlocks, additionalColumns(),
+      cancellationHandle_, locatedTriplesSnapshot(), getLimit());
 };
 
 // _____________________________________________________________________________
@@ -453,11 +574,14 @@ Permutation::IdTableGenerator IndexScan::lazyScanForJoinOfColumnWithScan(
   if (!metaBlocks.has_value()) {
     return {};
   }
-  auto blocks = CompressedRelationReader::getBlocksForJoin(joinColumn,
-                                                           metaBlocks.value());
+  size_t numBlocksSkippedBecauseOfBloomFilter = 0;
+  auto blocks = CompressedRelationReader::getBlocksForJoin(
+      joinColumn, metaBlocks.value(), &numBlocksSkippedBecauseOfBloomFilter);
 
   auto result = getLazyScan(blocks);
   result.details().numBlocksAll_ = metaBlocks.value().blockMetadata_.size();
+  result.details().numBlocksSkippedBecauseOfBloomFilter_ =
+      numBlocksSkippedBecauseOfBloomFilter;
   return result;
 }
 
@@ -480,9 +604,15 @@ void IndexScan::updateRuntimeInfoForLazyScan(const LazyScanMetadata& metadata) {
   };
   updateIfPositive(metadata.numBlocksSkippedBecauseOfGraph_,
                    "num-blocks-skipped-graph");
+  updateIfPositive(metadata.numBlocksSkippedBecauseOfBloomFilter_,
+                   "num-blocks-skipped-bloom-filter");
   updateIfPositive(metadata.numBlocksPostprocessed_,
                    "num-blocks-postprocessed");
   updateIfPositive(metadata.numBlocksWithUpdate_, "num-blocks-with-update");
+  updateIfPositive(metadata.numElementsFilteredOut_,
+                   "num-elements-filtered-in-scan");
+  updateIfPositive(metadata.poolTaskTime_.count(), "scan-pool-task-time-ms");
+  updateIfPositive(metadata.poolUtilization_, "scan-pool-utilization");
 }
 
 // Store a Generator and its corresponding iterator as well as unconsumed values
@@ -646,6 +776,24 @@ Result::Generator IndexScan::createPrefilteredIndexScanSide(
   }
 }
 
+// _____________________________________________________________________________
+bool IndexScan::addJoinFilter(const Variable& variable,
+                              std::weak_ptr<const JoinFilter> filter) {
+  if (!getLimit().isUnconstrained()) {
+    return false;
+  }
+  const auto& variableColumns = getInternallyVisibleVariableColumns();
+  auto it = variableColumns.find(variable);
+  if (it == variableColumns.end()) {
+    return false;
+  }
+  std::erase_if(joinFilters_, [](const auto& joinFilter) {
+    return joinFilter.second.expired();
+  });
+  joinFilters_.emplace_back(it->second.columnIndex_, std::move(filter));
+  return true;
+}
+
 // _____________________________________________________________________________
 std::pair<Result::Generator, Result::Generator> IndexScan::prefilterTables(
     Result::LazyResult input, ColumnIndex joinColumn) {
@@ -10,6 +10,7 @@
 
 class SparqlTriple;
 class SparqlTripleSimple;
+class JoinFilter;
 
 class IndexScan final : public Operation {
   using Graphs = ScanSpecificationAsTripleComponent::Graphs;
@@ -36,6 +37,13 @@ class IndexScan final : public Operation {
   std::vector<ColumnIndex> additionalColumns_;
   std::vector<Variable> additionalVariables_;
 
+  // The filters of joins that were pushed down into this scan during the
+  // computation of a join (see `JoinFilter`), together with the column of the
+  // result to which they are applied. Filters that are no longer alive are
+  // ignored.
+  std::vector<std::pair<ColumnIndex, std::weak_ptr<const JoinFilter>>>
+      joinFilters_;
+
  public:
   IndexScan(QueryExecutionContext* qec, Permutation::Enum permutation,
             const SparqlTriple& triple, Graphs graphsToFilter = std::nullopt,
@@ -108,6 +116,16 @@ class IndexScan final : public Operation {
   std::pair<Result::Generator, Result::Generator> prefilterTables(
       Result::LazyResult input, ColumnIndex joinColumn);
 
+  // Add a filter for the values of the `variable`, that is applied to the rows
+  // of this scan directly after the blocks have been decompressed, as long as
+  // the `filter` is alive. If the `variable` is the first column of the
+  // result, then the blocks that can't contain a value of a filter with
+  // sorted keys are not read at all. Return false (and don't add the filter)
+  // if the `variable` is not a column of the result or if this scan has a
+  // LIMIT or OFFSET.
+  bool addJoinFilter(const Variable& variable,
+                     std::weak_ptr<const JoinFilter> filter);
+
  private:
   // Implementation detail that allows to consume a generator from two other
   // cooperating generators. Needs to be forward declared as it is used by
@@ -146,6 +164,11 @@ class IndexScan final : public Operation {
     return sizeEstimateIsExact_ && sizeEstimate_ == 0;
   }
 
+  // For a scan with a fixed predicate and a variable subject and object, the
+  // object column has the histogram of the objects of this predicate (if the
+  // index has `PredicateStatistics`).
+  const ValueHistogram* getValueHistogram(size_t col) const override;
+
   bool isIndexScanWithNumVariables(size_t target) const override {
     return numVariables() == target;
   }
@@ -168,6 +191,13 @@ class IndexScan final : public Operation {
   // {&predicate_, &subject_, &object_}
   std::array<const TripleComponent* const, 3> getPermutedTriple() const;
   ScanSpecification getScanSpecification() const;
+  // Same as `getScanSpecification`, but if this scan has a `prefilter_` or
+  // join filters (and no LIMIT or OFFSET), the returned specification
+  // additionally has row filters that remove the rows for which the prefilter
+  // expression is false or which don't pass the join filters while the blocks
+  // are decompressed. Only used to compute the result, not for the size
+  // estimates.
+  ScanSpecification getScanSpecificationWithRowFilter() const;
   ScanSpecificationAsTripleComponent getScanSpecificationTc() const;
 
   // Set the runtime info of the `scanTree` when it was lazily executed during a
@@ -228,6 +258,23 @@ class IndexScan final : public Operation {
   std::vector<CompressedBlockMetadata> applyPrefilter(
       std::span<const CompressedBlockMetadata> blocks) const;
 
+  // Return true iff the `prefilter_` (which must exist) is applied to the first
+  // sorted column (see above). Otherwise, it is applied to one of the later
+  // columns, for which only the column summaries of the blocks can be used.
+  bool prefilterIsOnSortedColumn() const;
+
+  // Return the `joinFilters_` that are still alive (if this scan has no LIMIT
+  // or OFFSET, else nothing).
+  std::vector<std::pair<ColumnIndex, std::shared_ptr<const JoinFilter>>>
+  getActiveJoinFilters() const;
+
+  // Remove the `blocks` that can't contain a value of one of the active join
+  // filters with sorted keys on the first column of the result. If `blocks` is
+  // `std::nullopt` (which means "all the blocks"), then the relevant blocks of
+  // the scan are used.
+  std::optional<std::vector<CompressedBlockMetadata>> applyJoinFilters(
+      std::optional<std::vector<CompressedBlockMetadata>> blocks) const;
+
   // Helper functions for the public `getLazyScanFor...` methods and
   // `chunkedIndexScan` (see above).
   Permutation::IdTableGenerator getLazyScan(
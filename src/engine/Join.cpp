@@ -18,6 +18,7 @@
 #include "global/Constants.h"
 #include "global/Id.h"
 #include "global/RuntimeParameters.h"
+#include "index/PredicateStatistics.h"
 #include "util/Exception.h"
 #include "util/Generators.h"
 #include "util/HashMap.h"
@@ -189,6 +190,64 @@ ProtoResult Join::computeResult(bool requestLaziness) {
   auto rightResIfCached = getCachedOrSmallResult(*_right);
   checkCancellation();
 
+  auto joinFilter = pushDownJoinFilter(leftResIfCached, rightResIfCached);
+  ProtoResult result =
+      computeResultForInputs(requestLaziness, std::move(leftResIfCached),
+                             std::move(rightResIfCached));
+  if (joinFilter == nullptr || result.isFullyMaterialized()) {
+    return result;
+  }
+  // The `IndexScan`s only apply the filter as long as it is alive, so a lazy
+  // result has to keep it alive until it is completely consumed.
+  auto sortedBy = result.sortedBy();
+  return {[](Result::LazyResult idTables,
+             std::shared_ptr<const JoinFilter>) -> Result::Generator {
+            for (auto& pair : idTables) {
+              co_yield pair;
+            }
+          }(std::move(result.idTables()), std::move(joinFilter)),
+          std::move(sortedBy)};
+}
+
+// _____________________________________________________________________________
+std::shared_ptr<const JoinFilter> Join::pushDownJoinFilter(
+    const std::shared_ptr<const Result>& leftResIfCached,
+    const std::shared_ptr<const Result>& rightResIfCached) {
+  size_t maxBuildSize = RuntimeParameters().get<"join-filter-max-build-size">();
+  if (maxBuildSize == 0 ||
+      (leftResIfCached == nullptr) == (rightResIfCached == nullptr)) {
+    return nullptr;
+  }
+  bool buildSideIsLeft = leftResIfCached != nullptr;
+  const Result& buildSide =
+      buildSideIsLeft ? *leftResIfCached : *rightResIfCached;
+  if (!buildSide.isFullyMaterialized() ||
+      buildSide.idTable().numRows() > maxBuildSize) {
+    return nullptr;
+  }
+  auto filter = JoinFilter::fromJoinColumn(
+      buildSide.idTable().getColumn(buildSideIsLeft ? _leftJoinCol
+                                                    : _rightJoinCol),
+      RuntimeParameters().get<"join-filter-max-sorted-keys">());
+  if (!filter.has_value()) {
+    return nullptr;
+  }
+  auto sharedFilter =
+      std::make_shared<const JoinFilter>(std::move(filter.value()));
+  size_t numScans = JoinFilter::pushDown(sharedFilter, _joinVar,
+                                         buildSideIsLeft ? *_right : *_left);
+  if (numScans == 0) {
+    return nullptr;
+  }
+  runtimeInfo().addDetail("join-filter", sharedFilter->getDescriptor());
+  runtimeInfo().addDetail("num-scans-with-join-filter", numScans);
+  return sharedFilter;
+}
+
+// _____________________________________________________________________________
+ProtoResult Join::computeResultForInputs(
+    bool requestLaziness, std::shared_ptr<const Result> leftResIfCached,
+    std::shared_ptr<const Result> rightResIfCached) {
   auto leftIndexScan =
       std::dynamic_pointer_cast<IndexScan>(_left->getRootOperation());
   if (leftIndexScan &&
@@ -275,71 +334,100 @@ size_t Join::getCostEstimate() {
 
 // _____________________________________________________________________________
 void Join::computeSizeEstimateAndMultiplicities() {
-  _multiplicities.clear();
-  if (_left->getSizeEstimate() == 0 || _right->getSizeEstimate() == 0) {
-    for (size_t i = 0; i < getResultWidth(); ++i) {
-      _multiplicities.emplace_back(1);
-    }
-    return;
+  auto [sizeEstimate, multiplicities] = computeSizeEstimateAndMultiplicities(
+      _executionContext, *_left, _leftJoinCol, *_right, _rightJoinCol);
+  _sizeEstimate = sizeEstimate;
+  _multiplicities = std::move(multiplicities);
+  assert(_multiplicities.size() == getResultWidth());
+}
+
+// _____________________________________________________________________________
+Join::SizeEstimateAndMultiplicities Join::computeSizeEstimateAndMultiplicities(
+    QueryExecutionContext* qec, QueryExecutionTree& left,
+    ColumnIndex leftJoinCol, QueryExecutionTree& right,
+    ColumnIndex rightJoinCol) {
+  SizeEstimateAndMultiplicities result;
+  auto& multiplicities = result.multiplicities_;
+  if (left.getSizeEstimate() == 0 || right.getSizeEstimate() == 0) {
+    multiplicities.resize(
+        left.getResultWidth() + right.getResultWidth() - 1, 1.0f);
+    return result;
   }
 
   size_t nofDistinctLeft = std::max(
-      size_t(1), static_cast<size_t>(_left->getSizeEstimate() /
-                                     _left->getMultiplicity(_leftJoinCol)));
+      size_t(1), static_cast<size_t>(left.getSizeEstimate() /
+                                     left.getMultiplicity(leftJoinCol)));
   size_t nofDistinctRight = std::max(
-      size_t(1), static_cast<size_t>(_right->getSizeEstimate() /
-                                     _right->getMultiplicity(_rightJoinCol)));
-
-  size_t nofDistinctInResult = std::min(nofDistinctLeft, nofDistinctRight);
+      size_t(1), static_cast<size_t>(right.getSizeEstimate() /
+                                     right.getMultiplicity(rightJoinCol)));
+
+  // If both join columns have a histogram of their values, only the values
+  // that lie within the range of the values of the other column can have a
+  // join partner.
+  double fractionInRangeLeft = 1.0;
+  double fractionInRangeRight = 1.0;
+  const ValueHistogram* histogramLeft =
+      left.getRootOperation()->getValueHistogram(leftJoinCol);
+  const ValueHistogram* histogramRight =
+      right.getRootOperation()->getValueHistogram(rightJoinCol);
+  if (histogramLeft != nullptr && histogramRight != nullptr) {
+    fractionInRangeLeft =
+        histogramLeft->estimateFractionInRangeOf(*histogramRight);
+    fractionInRangeRight =
+        histogramRight->estimateFractionInRangeOf(*histogramLeft);
+  }
+  size_t nofDistinctInResult = std::max(
+      size_t(1),
+      static_cast<size_t>(std::min(nofDistinctLeft * fractionInRangeLeft,
+                                   nofDistinctRight * fractionInRangeRight)));
 
   double adaptSizeLeft =
-      _left->getSizeEstimate() *
+      left.getSizeEstimate() *
       (static_cast<double>(nofDistinctInResult) / nofDistinctLeft);
   double adaptSizeRight =
-      _right->getSizeEstimate() *
+      right.getSizeEstimate() *
       (static_cast<double>(nofDistinctInResult) / nofDistinctRight);
 
-  double corrFactor = _executionContext
-                          ? _executionContext->getCostFactor(
-                                "JOIN_SIZE_ESTIMATE_CORRECTION_FACTOR")
-                          : 1.0;
+  double corrFactor =
+      qec ? qec->getCostFactor("JOIN_SIZE_ESTIMATE_CORRECTION_FACTOR") : 1.0;
 
-  double jcMultiplicityInResult = _left->getMultiplicity(_leftJoinCol) *
-                                  _right->getMultiplicity(_rightJoinCol);
-  _sizeEstimate = std::max(
+  double jcMultiplicityInResult =
+      left.getMultiplicity(leftJoinCol) * right.getMultiplicity(rightJoinCol);
+  size_t& sizeEstimate = result.sizeEstimate_;
+  sizeEstimate = std::max(
       size_t(1), static_cast<size_t>(corrFactor * jcMultiplicityInResult *
                                      nofDistinctInResult));
 
-  LOG(TRACE) << "Estimated size as: " << _sizeEstimate << " := " << corrFactor
+  LOG(TRACE) << "Estimated size as: " << sizeEstimate << " := " << corrFactor
              << " * " << jcMultiplicityInResult << " * " << nofDistinctInResult
              << std::endl;
 
-  for (auto i = ColumnIndex{0}; i < _left->getResultWidth(); ++i) {
-    double oldMult = _left->getMultiplicity(i);
+  for (auto i = ColumnIndex{0}; i < left.getResultWidth(); ++i) {
+    double oldMult = left.getMultiplicity(i);
     double m = std::max(
-        1.0, oldMult * _right->getMultiplicity(_rightJoinCol) * corrFactor);
-    if (i != _leftJoinCol && nofDistinctLeft != nofDistinctInResult) {
-      double oldDist = _left->getSizeEstimate() / oldMult;
+        1.0, oldMult * right.getMultiplicity(rightJoinCol) * corrFactor);
+    if (i != leftJoinCol && nofDistinctLeft != nofDistinctInResult) {
+      double oldDist = left.getSizeEstimate() / oldMult;
       double newDist = std::min(oldDist, adaptSizeLeft);
-      m = (_sizeEstimate / corrFactor) / newDist;
+      m = (sizeEstimate / corrFactor) / newDist;
     }
-    _multiplicities.emplace_back(m);
+    multiplicities.emplace_back(m);
   }
-  for (auto i = ColumnIndex{0}; i < _right->getResultWidth(); ++i) {
-    if (i == _rightJoinCol) {
+  for (auto i = ColumnIndex{0}; i < right.getResultWidth(); ++i) {
+    if (i == rightJoinCol) {
       continue;
     }
-    double oldMult = _right->getMultiplicity(i);
+    double oldMult = right.getMultiplicity(i);
     double m = std::max(
-        1.0, oldMult * _left->getMultiplicity(_leftJoinCol) * corrFactor);
-    if (i != _rightJoinCol && nofDistinctRight != nofDistinctInResult) {
-      double oldDist = _right->getSizeEstimate() / oldMult;
+        1.0, oldMult * left.getMultiplicity(leftJoinCol) * corrFactor);
+    if (i != rightJoinCol && nofDistinctRight != nofDistinctInResult) {
+      double oldDist = right.getSizeEstimate() / oldMult;
       double newDist = std::min(oldDist, adaptSizeRight);
-      m = (_sizeEstimate / corrFactor) / newDist;
+      m = (sizeEstimate / corrFactor) / newDist;
     }
-    _multiplicities.emplace_back(m);
+    multiplicities.emplace_back(m);
   }
-  assert(_multiplicities.size() == getResultWidth());
+  return result;
 }
 
 // ______________________________________________________________________________
@@ -8,6 +8,7 @@
 
 #include "engine/AddCombinedRowToTable.h"
 #include "engine/IndexScan.h"
+#include "engine/JoinFilter.h"
 #include "engine/Operation.h"
 #include "engine/QueryExecutionTree.h"
 #include "util/JoinAlgorithms/JoinColumnMapping.h"
@@ -62,6 +63,18 @@ class Join : public Operation {
 
   void computeSizeEstimateAndMultiplicities();
 
+  // The estimated size and the multiplicities of the result of joining `left`
+  // and `right` on the given columns, with the columns in the order of the
+  // result of a `Join`. Also used by other join operations like `HashJoin`.
+  struct SizeEstimateAndMultiplicities {
+    size_t sizeEstimate_ = 0;
+    std::vector<float> multiplicities_;
+  };
+  static SizeEstimateAndMultiplicities computeSizeEstimateAndMultiplicities(
+      QueryExecutionContext* qec, QueryExecutionTree& left,
+      ColumnIndex leftJoinCol, QueryExecutionTree& right,
+      ColumnIndex rightJoinCol);
+
   float getMultiplicity(size_t col) override;
 
   vector<QueryExecutionTree*> getChildren() override {
@@ -149,6 +162,22 @@ class Join : public Operation {
 
   VariableToColumnMap computeVariableToColumnMap() const override;
 
+  // If exactly one of the inputs has already been materialized and it has at
+  // most `join-filter-max-build-size` rows, then build a `JoinFilter` from its
+  // join column and push it down into the `IndexScan`s of the other input.
+  // Return the filter, which has to be kept alive while the other input is
+  // computed, or `nullptr` if no filter was pushed down.
+  std::shared_ptr<const JoinFilter> pushDownJoinFilter(
+      const std::shared_ptr<const Result>& leftResIfCached,
+      const std::shared_ptr<const Result>& rightResIfCached);
+
+  // The part of `computeResult` after the inputs that are cached or small have
+  // been materialized (the `...IfCached` results are `nullptr` for the other
+  // inputs).
+  ProtoResult computeResultForInputs(
+      bool requestLaziness, std::shared_ptr<const Result> leftResIfCached,
+      std::shared_ptr<const Result> rightResIfCached);
+
   // A special implementation that is called when both children are
   // `IndexScan`s. Uses the lazy scans to only retrieve the subset of the
   // `IndexScan`s that is actually needed without fully materializing them.
@@ -0,0 +1,136 @@
+//  Copyright 2025, University of Freiburg,
+//                  Chair of Algorithms and Data Structures.
+
+#include "engine/JoinFilter.h"
+
+#include <absl/strings/str_cat.h>
+
+#include <algorithm>
+
+#include "engine/Filter.h"
+#include "engine/HashJoin.h"
+#include "engine/IndexScan.h"
+#include "engine/Join.h"
+#include "engine/LeapfrogTriejoin.h"
+#include "engine/MultiColumnJoin.h"
+#include "engine/QueryExecutionTree.h"
+#include "engine/Sort.h"
+#include "util/Algorithm.h"
+#include "util/Exception.h"
+
+namespace {
+// The budget of the Bloom filters, which have a false positive rate of about
+// one percent for this number of bits per key.
+const ad_utility::BloomFilterBudget bloomFilterBudget{
+    10, ad_utility::MemorySize::megabytes(64)};
+
+// Return true iff a row of the result of the `operation` can only be
+// produced from rows of its children with the same values for the variables
+// that the row has in common with these children.
+bool preservesValuesOfChildren(const Operation& operation) {
+  if (!operation.getLimit().isUnconstrained()) {
+    return false;
+  }
+  return dynamic_cast<const Join*>(&operation) != nullptr ||
+         dynamic_cast<const MultiColumnJoin*>(&operation) != nullptr ||
+         dynamic_cast<const HashJoin*>(&operation) != nullptr ||
+         dynamic_cast<const LeapfrogTriejoin*>(&operation) != nullptr ||
+         dynamic_cast<const Sort*>(&operation) != nullptr ||
+         dynamic_cast<const Filter*>(&operation) != nullptr;
+}
+}  // namespace
+
+// _____________________________________________________________________________
+std::optional<JoinFilter> JoinFilter::fromJoinColumn(
+    std::span<const Id> joinColumn, size_t maxNumSortedKeys) {
+  if (ql::ranges::any_of(joinColumn, [](Id id) { return id.isUndefined(); })) {
+    return std::nullopt;
+  }
+  std::vector<Id> keys;
+  keys.reserve(joinColumn.size());
+  std::copy_if(joinColumn.begin(), joinColumn.end(), std::back_inserter(keys),
+               [](Id id) {
+                 return id.getDatatype() != Datatype::LocalVocabIndex;
+               });
+  bool hasLocalVocabValues = keys.size() < joinColumn.size();
+  // The `Id`s are sorted and deduplicated by their values, so equal strings of
+  // different types are only stored once.
+  ql::ranges::sort(keys);
+  keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+  if (keys.size() <= maxNumSortedKeys) {
+    size_t numKeys = keys.size();
+    return JoinFilter{std::move(keys), numKeys, hasLocalVocabValues};
+  }
+  size_t numKeysBeforeErase = keys.size();
+  std::erase_if(keys, [](Id id) {
+    return id.getDatatype() == Datatype::InlineString;
+  });
+  bool allStringsPass =
+      hasLocalVocabValues || keys.size() < numKeysBeforeErase;
+  size_t numKeys = keys.size();
+  auto bloomFilter =
+      ad_utility::BloomFilter::forNumKeys(numKeys, bloomFilterBudget);
+  AD_CORRECTNESS_CHECK(bloomFilter.has_value());
+  for (Id key : keys) {
+    bloomFilter->add(key.getBits());
+  }
+  return JoinFilter{std::move(bloomFilter.value()), numKeys, allStringsPass};
+}
+
+// _____________________________________________________________________________
+bool JoinFilter::mayContain(Id id) const {
+  auto datatype = id.getDatatype();
+  bool isString = ad_utility::contains(Id::stringTypes_, datatype);
+  if (isString && allStringsPass_) {
+    return true;
+  }
+  if (const auto* keys = std::get_if<std::vector<Id>>(&keys_)) {
+    // The comparison is by value, so this also finds strings of other types.
+    return std::binary_search(keys->begin(), keys->end(), id);
+  }
+  // The Bloom filter only contains the `VocabIndex` of a string, so the same
+  // string from a local vocabulary or as an inline string is not found.
+  if (isString && datatype != Datatype::VocabIndex) {
+    return true;
+  }
+  return std::get<ad_utility::BloomFilter>(keys_).mayContain(id.getBits());
+}
+
+// _____________________________________________________________________________
+std::vector<uint8_t> JoinFilter::evaluate(std::span<const Id> ids) const {
+  std::vector<uint8_t> result;
+  result.reserve(ids.size());
+  for (Id id : ids) {
+    result.push_back(static_cast<uint8_t>(mayContain(id)));
+  }
+  return result;
+}
+
+// _____________________________________________________________________________
+std::string JoinFilter::getDescriptor() const {
+  bool isSorted = std::holds_alternative<std::vector<Id>>(keys_);
+  return absl::StrCat(isSorted ? "sorted list" : "Bloom filter", " of ",
+                      numKeys_, " values");
+}
+
+// _____________________________________________________________________________
+size_t JoinFilter::pushDown(const std::shared_ptr<const JoinFilter>& filter,
+                            const Variable& variable,
+                            QueryExecutionTree& tree) {
+  AD_CONTRACT_CHECK(filter != nullptr);
+  auto operation = tree.getRootOperation();
+  size_t numScans = 0;
+  if (auto scan = std::dynamic_pointer_cast<IndexScan>(operation)) {
+    numScans = static_cast<size_t>(scan->addJoinFilter(variable, filter));
+  } else if (preservesValuesOfChildren(*operation)) {
+    for (QueryExecutionTree* child : operation->getChildren()) {
+      if (child != nullptr && child->isVariableCovered(variable)) {
+        numScans += pushDown(filter, variable, *child);
+      }
+    }
+  }
+  if (numScans > 0) {
+    operation->disableStoringInCache();
+  }
+  return numScans;
+}
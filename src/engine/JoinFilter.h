@@ -0,0 +1,95 @@
+//  Copyright 2025, University of Freiburg,
+//                  Chair of Algorithms and Data Structures.
+
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <variant>
+#include <vector>
+
+#include "global/Id.h"
+#include "parser/data/Variable.h"
+#include "util/BloomFilter.h"
+
+class QueryExecutionTree;
+
+// A filter on the values of a join column ("sideways information passing"):
+// When one input of a `Join` is small and already materialized, the values of
+// its join column are known before the other input is computed. Only the rows
+// of the other input that have one of these values can contribute to the
+// result of the join. The filter is therefore pushed down into the
+// `IndexScan`s of the other input (see `pushDown` below), which remove the
+// rows that don't pass the filter directly after decompressing the blocks, and
+// not only after several joins.
+//
+// The filter either stores the distinct values as a sorted list (which is
+// exact and can also be used to skip complete blocks of a scan, like the
+// existing prefiltering for the join of a column with a scan, see
+// `IndexScan::lazyScanForJoinOfColumnWithScan`) or, if there are many distinct
+// values, as a Bloom filter (which has false positives).
+class JoinFilter {
+ private:
+  using Keys = std::variant<std::vector<Id>, ad_utility::BloomFilter>;
+  Keys keys_;
+  size_t numKeys_;
+  // True iff the join column contains strings that are not part of the
+  // `keys_` (values from a local vocabulary, and inline strings if the filter
+  // is a Bloom filter). These are compared by their string value (see
+  // `ValueId::operator<=>`), so they might be equal to any string `Id`, and
+  // all string `Id`s pass the filter.
+  bool allStringsPass_;
+
+  JoinFilter(Keys keys, size_t numKeys, bool allStringsPass)
+      : keys_{std::move(keys)},
+        numKeys_{numKeys},
+        allStringsPass_{allStringsPass} {}
+
+ public:
+  // Create the filter for the values of the `joinColumn` (which need not be
+  // sorted). If there are at most `maxNumSortedKeys` distinct values, they are
+  // stored as a sorted list, else in a Bloom filter. Return `std::nullopt` if
+  // the `joinColumn` contains UNDEF values, because these match every value.
+  // Values from a local vocabulary are not stored, instead all string `Id`s
+  // (see `ValueId::stringTypes_`) pass the filter. The same holds for inline
+  // strings if the filter is a Bloom filter, which hashes the bits of the
+  // `Id`s and thus only works for `Id`s that are equal iff their bits are.
+  static std::optional<JoinFilter> fromJoinColumn(
+      std::span<const Id> joinColumn, size_t maxNumSortedKeys);
+
+  // Return false if the `id` is definitely not equal to one of the values of
+  // the join column.
+  bool mayContain(Id id) const;
+
+  // Return `mayContain` for each of the `ids`, in the format of a
+  // `ScanSpecification::RowFilter`.
+  std::vector<uint8_t> evaluate(std::span<const Id> ids) const;
+
+  // The sorted distinct values of the join column, or `nullptr` if the filter
+  // is a Bloom filter or if the join column contains values from a local
+  // vocabulary (which are not stored).
+  const std::vector<Id>* sortedKeys() const {
+    return allStringsPass_ ? nullptr : std::get_if<std::vector<Id>>(&keys_);
+  }
+
+  // The number of distinct values of the join column that are stored (see
+  // `fromJoinColumn`).
+  size_t numKeys() const { return numKeys_; }
+
+  // A short description of the filter for the runtime information.
+  std::string getDescriptor() const;
+
+  // Add the `filter` for the `variable` to all the `IndexScan`s in the `tree`
+  // whose rows can only contribute to rows of the result of the `tree` with
+  // the same value for the `variable`. This is the case for scans that are
+  // only connected to the root of the `tree` via (inner) joins, sorts, and
+  // filters without a LIMIT or OFFSET. The scans only hold a weak reference to
+  // the `filter`, so it is only applied while the caller keeps it alive. The
+  // operations between the root and the scans (including both) no longer
+  // store their results in the cache, because these are incomplete. Return
+  // the number of scans to which the `filter` was added.
+  static size_t pushDown(const std::shared_ptr<const JoinFilter>& filter,
+                         const Variable& variable, QueryExecutionTree& tree);
+};
@@ -0,0 +1,441 @@
+//  Copyright 2025, University of Freiburg,
+//                  Chair of Algorithms and Data Structures.
+
+#include "engine/LeapfrogTriejoin.h"
+
+#include <absl/strings/str_cat.h>
+#include <absl/strings/str_join.h>
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+#include "util/Exception.h"
+#include "util/HashMap.h"
+
+namespace {
+// A trie over the rows of a table that is sorted by its `columns`: Level `i`
+// of the trie consists of the values of the column `columns[i]`. A level is
+// entered via `open` (the values are then restricted to the rows that have
+// the current values on all the previous levels) and left via `up`.
+class TrieIterator {
+ private:
+  const IdTable& table_;
+  std::span<const ColumnIndex> columns_;
+  // For each opened level the range of rows that have the same values in the
+  // columns of all the previous levels.
+  std::vector<std::pair<size_t, size_t>> ranges_;
+  // The current row.
+  size_t pos_ = 0;
+
+ public:
+  TrieIterator(const IdTable& table, std::span<const ColumnIndex> columns)
+      : table_{table}, columns_{columns} {
+    ranges_.reserve(columns_.size());
+  }
+
+  Id key() const { return column()[pos_]; }
+  bool atEnd() const { return pos_ >= ranges_.back().second; }
+
+  // Enter the next level (for the current value of the current level).
+  void open() {
+    AD_CORRECTNESS_CHECK(ranges_.size() < columns_.size());
+    if (ranges_.empty()) {
+      ranges_.emplace_back(0, table_.numRows());
+    } else {
+      Id current = key();
+      ranges_.emplace_back(pos_, gallop([current](Id id) {
+                             return id <= current;
+                           }));
+    }
+    pos_ = ranges_.back().first;
+  }
+
+  // Return to the previous level (to the value from which the current level
+  // was opened).
+  void up() {
+    pos_ = ranges_.back().first;
+    ranges_.pop_back();
+  }
+
+  // Move to the next distinct value of the current level.
+  void next() {
+    Id current = key();
+    pos_ = gallop([current](Id id) { return id <= current; });
+  }
+
+  // Move to the first value of the current level that is `>= target`.
+  void seek(Id target) {
+    pos_ = gallop([target](Id id) { return id < target; });
+  }
+
+  // The number of rows with the current value. On the last level, these are
+  // the duplicates of the current row.
+  size_t numRowsWithKey() const {
+    Id current = key();
+    return gallop([current](Id id) { return id <= current; }) - pos_;
+  }
+
+ private:
+  std::span<const Id> column() const {
+    return table_.getColumn(columns_[ranges_.size() - 1]);
+  }
+
+  // Return the first row in `[pos_, end)` of the current level for which
+  // `isBefore` is false (`isBefore` has to be true for a prefix of the rows).
+  // The exponential search makes small steps (which are frequent when the
+  // inputs have similar values) cheap and large steps logarithmic.
+  size_t gallop(const auto& isBefore) const {
+    auto col = column();
+    const size_t end = ranges_.back().second;
+    size_t lo = pos_;
+    size_t step = 1;
+    while (lo + step < end && isBefore(col[lo + step])) {
+      lo += step;
+      step *= 2;
+    }
+    size_t hi = std::min(lo + step, end);
+    return std::partition_point(col.begin() + lo, col.begin() + hi,
+                                isBefore) -
+           col.begin();
+  }
+};
+
+// The variables of the `tree` as pairs of the index of the variable in the
+// `variableOrder` and the column of the variable, sorted by the former.
+std::vector<std::pair<size_t, ColumnIndex>> getVariablesAndColumns(
+    const QueryExecutionTree& tree, const std::vector<Variable>& order) {
+  std::vector<std::pair<size_t, ColumnIndex>> result;
+  for (const auto& [variable, info] : tree.getVariableColumns()) {
+    auto it = ql::ranges::find(order, variable);
+    AD_CORRECTNESS_CHECK(it != order.end());
+    result.emplace_back(it - order.begin(), info.columnIndex_);
+  }
+  ql::ranges::sort(result);
+  return result;
+}
+}  // namespace
+
+// _____________________________________________________________________________
+LeapfrogTriejoin::LeapfrogTriejoin(
+    QueryExecutionContext* qec,
+    std::vector<std::shared_ptr<QueryExecutionTree>> children)
+    : Operation{qec} {
+  AD_CONTRACT_CHECK(children.size() >= 2);
+  for (const auto& child : children) {
+    AD_CONTRACT_CHECK(child != nullptr);
+    const auto& variables = child->getVariableColumns();
+    AD_CONTRACT_CHECK(variables.size() == child->getResultWidth(),
+                      "All the columns of the inputs of a Leapfrog Triejoin "
+                      "must be variables");
+    for (const auto& info : variables | ql::views::values) {
+      AD_CONTRACT_CHECK(info.mightContainUndef_ ==
+                        ColumnIndexAndTypeInfo::AlwaysDefined);
+    }
+  }
+  variableOrder_ = computeVariableOrder(children);
+  for (auto& child : children) {
+    std::vector<ColumnIndex> sortColumns;
+    for (auto [variable, column] :
+         getVariablesAndColumns(*child, variableOrder_)) {
+      sortColumns.push_back(column);
+    }
+    child = QueryExecutionTree::createSortedTree(std::move(child), sortColumns);
+  }
+  // Make the order of the children deterministic (compare `Join`).
+  ql::ranges::sort(children, std::less<>{},
+                   [](const auto& child) { return child->getCacheKey(); });
+  children_ = std::move(children);
+}
+
+// _____________________________________________________________________________
+std::vector<Variable> LeapfrogTriejoin::computeVariableOrder(
+    const std::vector<std::shared_ptr<QueryExecutionTree>>& children) {
+  ad_utility::HashMap<Variable, size_t> numOccurrences;
+  for (const auto& child : children) {
+    for (const auto& variable : child->getVariableColumns() | ql::views::keys) {
+      ++numOccurrences[variable];
+    }
+  }
+  std::vector<Variable> order;
+  for (const auto& variable : numOccurrences | ql::views::keys) {
+    order.push_back(variable);
+  }
+  ql::ranges::sort(order, [&numOccurrences](const Variable& a,
+                                            const Variable& b) {
+    size_t numA = numOccurrences.at(a);
+    size_t numB = numOccurrences.at(b);
+    return numA != numB ? numA > numB : a.name() < b.name();
+  });
+  return order;
+}
+
+// _____________________________________________________________________________
+size_t LeapfrogTriejoin::getVariableIndex(const Variable& variable) const {
+  auto it = ql::ranges::find(variableOrder_, variable);
+  AD_CORRECTNESS_CHECK(it != variableOrder_.end());
+  return it - variableOrder_.begin();
+}
+
+// _____________________________________________________________________________
+string LeapfrogTriejoin::getCacheKeyImpl() const {
+  // The columns of the result depend on the variable order, so the indices of
+  // the variables of each child are part of the cache key.
+  std::string key = "LEAPFROG TRIEJOIN\n";
+  for (const auto& child : children_) {
+    std::vector<size_t> variableOfColumn(child->getResultWidth());
+    for (const auto& [variable, info] : child->getVariableColumns()) {
+      variableOfColumn.at(info.columnIndex_) = getVariableIndex(variable);
+    }
+    absl::StrAppend(&key, child->getCacheKey(), " variables: [",
+                    absl::StrJoin(variableOfColumn, ", "), "]\n");
+  }
+  return key;
+}
+
+// _____________________________________________________________________________
+string LeapfrogTriejoin::getDescriptor() const {
+  return absl::StrCat(
+      "Leapfrog Triejoin on ",
+      absl::StrJoin(variableOrder_, " ",
+                    [](std::string* out, const Variable& variable) {
+                      out->append(variable.name());
+                    }));
+}
+
+// _____________________________________________________________________________
+std::vector<ColumnIndex> LeapfrogTriejoin::resultSortedOn() const {
+  std::vector<ColumnIndex> result(getResultWidth());
+  std::iota(result.begin(), result.end(), ColumnIndex{0});
+  return result;
+}
+
+// _____________________________________________________________________________
+VariableToColumnMap LeapfrogTriejoin::computeVariableToColumnMap() const {
+  VariableToColumnMap result;
+  for (size_t i = 0; i < variableOrder_.size(); ++i) {
+    result[variableOrder_[i]] = makeAlwaysDefinedColumn(i);
+  }
+  return result;
+}
+
+// _____________________________________________________________________________
+const LeapfrogTriejoin::Estimates& LeapfrogTriejoin::getEstimates() {
+  if (estimates_.has_value()) {
+    return estimates_.value();
+  }
+  const size_t numVariables = variableOrder_.size();
+  if (ql::ranges::any_of(children_, [](const auto& child) {
+        return child->getSizeEstimate() == 0;
+      })) {
+    estimates_ = Estimates{0, std::vector<float>(numVariables, 1.0f)};
+    return estimates_.value();
+  }
+
+  // The AGM bound (the worst-case size of the result) for the fractional edge
+  // cover where each child has the weight `1 / n`, where `n` is the smallest
+  // number of children that one of its variables occurs in.
+  std::vector<size_t> numOccurrences(numVariables, 0);
+  for (const auto& child : children_) {
+    for (const auto& variable : child->getVariableColumns() | ql::views::keys) {
+      ++numOccurrences[getVariableIndex(variable)];
+    }
+  }
+  double logAgmBound = 0;
+  for (const auto& child : children_) {
+    size_t minOccurrences = numVariables;
+    for (const auto& variable : child->getVariableColumns() | ql::views::keys) {
+      minOccurrences =
+          std::min(minOccurrences, numOccurrences[getVariableIndex(variable)]);
+    }
+    logAgmBound += std::log(static_cast<double>(child->getSizeEstimate())) /
+                   static_cast<double>(minOccurrences);
+  }
+
+  // The usual estimate for a sequence of joins, which assumes that the values
+  // of the join columns are independent. The children are added such that
+  // each one (if possible) shares a variable with one of the previous ones.
+  std::vector<std::optional<double>> numDistinct(numVariables);
+  std::vector<bool> isAdded(children_.size(), false);
+  double estimate = 1.0;
+  for (size_t numAdded = 0; numAdded < children_.size(); ++numAdded) {
+    auto sharesVariable = [&](size_t i) {
+      return !isAdded[i] &&
+             ql::ranges::any_of(
+                 children_[i]->getVariableColumns() | ql::views::keys,
+                 [&](const Variable& variable) {
+                   return numDistinct[getVariableIndex(variable)].has_value();
+                 });
+    };
+    size_t next = 0;
+    while (next < children_.size() && !sharesVariable(next)) {
+      ++next;
+    }
+    if (next == children_.size()) {
+      next = ql::ranges::find(isAdded, false) - isAdded.begin();
+    }
+    isAdded[next] = true;
+    auto& child = *children_[next];
+    double size = static_cast<double>(child.getSizeEstimate());
+    estimate *= size;
+    for (const auto& [variable, info] : child.getVariableColumns()) {
+      double distinct = std::max(
+          1.0, size / std::max(1.0f, child.getMultiplicity(info.columnIndex_)));
+      auto& current = numDistinct[getVariableIndex(variable)];
+      if (current.has_value()) {
+        estimate /= std::max(current.value(), distinct);
+        current = std::min(current.value(), distinct);
+      } else {
+        current = distinct;
+      }
+    }
+  }
+
+  double sizeEstimate =
+      std::max(1.0, std::round(std::min(estimate, std::exp(logAgmBound))));
+  Estimates result{static_cast<uint64_t>(sizeEstimate), {}};
+  for (const auto& distinct : numDistinct) {
+    double numDistinctInResult = std::min(sizeEstimate, distinct.value());
+    result.multiplicities_.push_back(
+        static_cast<float>(std::max(1.0, sizeEstimate / numDistinctInResult)));
+  }
+  estimates_ = std::move(result);
+  return estimates_.value();
+}
+
+// _____________________________________________________________________________
+size_t LeapfrogTriejoin::getCostEstimate() {
+  size_t cost = getSizeEstimateBeforeLimit();
+  for (const auto& child : children_) {
+    cost += child->getSizeEstimate() + child->getCostEstimate();
+  }
+  return cost;
+}
+
+// _____________________________________________________________________________
+bool LeapfrogTriejoin::knownEmptyResult() {
+  return ql::ranges::any_of(children_, [](const auto& child) {
+    return child->knownEmptyResult();
+  });
+}
+
+// _____________________________________________________________________________
+vector<QueryExecutionTree*> LeapfrogTriejoin::getChildren() {
+  vector<QueryExecutionTree*> result;
+  for (const auto& child : children_) {
+    result.push_back(child.get());
+  }
+  return result;
+}
+
+// _____________________________________________________________________________
+ProtoResult LeapfrogTriejoin::computeResult(
+    [[maybe_unused]] bool requestLaziness) {
+  if (knownEmptyResult()) {
+    for (const auto& child : children_) {
+      child->getRootOperation()->updateRuntimeInformationWhenOptimizedOut();
+    }
+    return {IdTable{getResultWidth(), allocator()}, resultSortedOn(),
+            LocalVocab{}};
+  }
+  std::vector<std::shared_ptr<const Result>> results;
+  std::vector<Input> inputs;
+  for (const auto& child : children_) {
+    results.push_back(child->getResult());
+    checkCancellation();
+    Input input{&results.back()->idTable(), {}, {}};
+    for (auto [variable, column] :
+         getVariablesAndColumns(*child, variableOrder_)) {
+      input.variables_.push_back(variable);
+      input.columns_.push_back(column);
+    }
+    inputs.push_back(std::move(input));
+  }
+  IdTable result{getResultWidth(), allocator()};
+  join(inputs, getResultWidth(), result, [this] { checkCancellation(); });
+  auto localVocab = Result::getMergedLocalVocab(
+      results | ql::views::transform([](const auto& childResult)
+                                         -> const Result& {
+        return *childResult;
+      }));
+  return {std::move(result), resultSortedOn(), std::move(localVocab)};
+}
+
+// _____________________________________________________________________________
+void LeapfrogTriejoin::join(std::span<const Input> inputs, size_t numVariables,
+                            IdTable& result,
+                            const std::function<void()>& checkCancellation) {
+  AD_CONTRACT_CHECK(result.numColumns() == numVariables);
+  // For each variable the indices of the inputs that contain it.
+  std::vector<std::vector<size_t>> inputsOfVariable(numVariables);
+  std::vector<TrieIterator> iterators;
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    const auto& [table, columns, variables] = inputs[i];
+    AD_CONTRACT_CHECK(columns.size() == variables.size());
+    AD_CONTRACT_CHECK(std::adjacent_find(variables.begin(), variables.end(),
+                                         std::greater_equal<>{}) ==
+                      variables.end());
+    for (size_t variable : variables) {
+      AD_CONTRACT_CHECK(variable < numVariables);
+      inputsOfVariable[variable].push_back(i);
+    }
+    iterators.emplace_back(*table, columns);
+  }
+  AD_CONTRACT_CHECK(ql::ranges::none_of(
+      inputsOfVariable, [](const auto& indices) { return indices.empty(); }));
+
+  std::vector<Id> row(numVariables);
+  auto bindVariable = [&](auto& self, size_t variable) -> void {
+    if (variable == numVariables) {
+      // Duplicate rows of the inputs lead to duplicate rows in the result,
+      // just like for a sequence of binary joins.
+      size_t numDuplicates = 1;
+      for (const auto& iterator : iterators) {
+        numDuplicates *= iterator.numRowsWithKey();
+      }
+      for (size_t i = 0; i < numDuplicates; ++i) {
+        result.push_back(row);
+      }
+      return;
+    }
+    const auto& indices = inputsOfVariable[variable];
+    for (size_t i : indices) {
+      iterators[i].open();
+    }
+    auto isAtEnd = [&iterators](size_t i) { return iterators[i].atEnd(); };
+    bool isDone = ql::ranges::any_of(indices, isAtEnd);
+    while (!isDone) {
+      Id max = iterators[indices[0]].key();
+      for (size_t i : indices) {
+        max = std::max(max, iterators[i].key());
+      }
+      // All the inputs that are behind leapfrog to the maximum. If one of
+      // them overshoots, we need another round.
+      bool allEqual = true;
+      for (size_t i : indices) {
+        if (iterators[i].key() < max) {
+          iterators[i].seek(max);
+          allEqual = false;
+          if (iterators[i].atEnd()) {
+            isDone = true;
+            break;
+          }
+        }
+      }
+      if (!allEqual) {
+        continue;
+      }
+      row[variable] = max;
+      self(self, variable + 1);
+      if (variable == 0) {
+        checkCancellation();
+      }
+      iterators[indices[0]].next();
+      isDone = iterators[indices[0]].atEnd();
+    }
+    for (size_t i : indices) {
+      iterators[i].up();
+    }
+  };
+  bindVariable(bindVariable, 0);
+}
@@ -0,0 +1,114 @@
+//  Copyright 2025, University of Freiburg,
+//                  Chair of Algorithms and Data Structures.
+
+#pragma once
+
+#include <functional>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "engine/Operation.h"
+#include "engine/QueryExecutionTree.h"
+
+// A worst-case optimal join of an arbitrary number of inputs on all their
+// variables at once (Veldhuizen's "Leapfrog Triejoin"). The variables are
+// bound one after the other in a global `variableOrder`. Each input is sorted
+// by its variables in this order (which makes it a trie over its variables,
+// for an `IndexScan` this is just the choice of the permutation). For each
+// variable, the inputs that contain it are intersected by "leapfrogging":
+// The input with the smallest current value seeks to the largest current
+// value of the other inputs (via a galloping search), until all the inputs
+// agree on a value. Unlike a sequence of binary joins, this never creates
+// intermediate results that are larger than the worst-case size of the final
+// result, which makes a difference for cyclic patterns like triangles.
+//
+// The result has one column per variable (in the `variableOrder`) and is
+// sorted by all its columns. Like for `Join`, duplicate rows in the inputs
+// lead to duplicate rows in the result. All the columns of the inputs must be
+// variables and must not contain UNDEF values. The `QueryPlanner` uses this
+// operation for cyclic connected components that consist of `IndexScan`s with
+// two variables each.
+class LeapfrogTriejoin : public Operation {
+ private:
+  std::vector<std::shared_ptr<QueryExecutionTree>> children_;
+  // The order in which the variables are bound, which is also the order of
+  // the columns of the result.
+  std::vector<Variable> variableOrder_;
+
+  // The estimates are computed lazily.
+  struct Estimates {
+    uint64_t sizeEstimate_;
+    std::vector<float> multiplicities_;
+  };
+  std::optional<Estimates> estimates_;
+
+ public:
+  // An input of `join`: The `table_` is sorted by its `columns_`, where
+  // `columns_[i]` contains the values of the variable with index
+  // `variables_[i]` in the variable order. The `variables_` must be strictly
+  // increasing.
+  struct Input {
+    const IdTable* table_;
+    std::vector<ColumnIndex> columns_;
+    std::vector<size_t> variables_;
+  };
+
+  // The `children` are sorted by their variables (in the order of
+  // `computeVariableOrder`) if they aren't sorted accordingly already.
+  LeapfrogTriejoin(QueryExecutionContext* qec,
+                   std::vector<std::shared_ptr<QueryExecutionTree>> children);
+
+  // The order in which the variables of the `children` are bound: Variables
+  // that are contained in more inputs come first (ties are broken by the name
+  // of the variable), because they restrict the search space the most.
+  static std::vector<Variable> computeVariableOrder(
+      const std::vector<std::shared_ptr<QueryExecutionTree>>& children);
+
+ protected:
+  string getCacheKeyImpl() const override;
+
+ public:
+  string getDescriptor() const override;
+
+  size_t getResultWidth() const override { return variableOrder_.size(); }
+
+  std::vector<ColumnIndex> resultSortedOn() const override;
+
+ private:
+  uint64_t getSizeEstimateBeforeLimit() override {
+    return getEstimates().sizeEstimate_;
+  }
+
+ public:
+  // The inputs are read once, and each result row is written once.
+  size_t getCostEstimate() override;
+
+  float getMultiplicity(size_t col) override {
+    return getEstimates().multiplicities_.at(col);
+  }
+
+  bool knownEmptyResult() override;
+
+  vector<QueryExecutionTree*> getChildren() override;
+
+  const std::vector<Variable>& variableOrder() const { return variableOrder_; }
+
+  // Join the `inputs` and append the result to `result`, which must have
+  // `numVariables` columns. Each of the variables must be contained in at
+  // least one input. The `checkCancellation` callback is called regularly.
+  // Public for testing.
+  static void join(std::span<const Input> inputs, size_t numVariables,
+                   IdTable& result,
+                   const std::function<void()>& checkCancellation = [] {});
+
+ private:
+  ProtoResult computeResult(bool requestLaziness) override;
+
+  VariableToColumnMap computeVariableToColumnMap() const override;
+
+  const Estimates& getEstimates();
+
+  // The index of the `variable` in the `variableOrder_`.
+  size_t getVariableIndex(const Variable& variable) const;
+};
@@ -45,6 +45,23 @@ LocalVocabIndex LocalVocab::getIndexAndAddIfNotContained(
   return getIndexAndAddIfNotContainedImpl(std::move(word));
 }
 
+// _____________________________________________________________________________
+Id LocalVocab::getIdAndAddIfNotContained(const LocalVocabEntry& word) {
+  if (auto inlineString = InlineString::make(word.toStringRepresentation())) {
+    return Id::makeFromInlineString(inlineString.value());
+  }
+  return Id::makeFromLocalVocabIndex(getIndexAndAddIfNotContainedImpl(word));
+}
+
+// _____________________________________________________________________________
+Id LocalVocab::getIdAndAddIfNotContained(LocalVocabEntry&& word) {
+  if (auto inlineString = InlineString::make(word.toStringRepresentation())) {
+    return Id::makeFromInlineString(inlineString.value());
+  }
+  return Id::makeFromLocalVocabIndex(
+      getIndexAndAddIfNotContainedImpl(std::move(word)));
+}
+
 // _____________________________________________________________________________
 std::optional<LocalVocabIndex> LocalVocab::getIndexOrNullopt(
     const LocalVocabEntry& word) const {
@@ -16,6 +16,7 @@
 #include <vector>
 
 #include "backports/algorithm.h"
+#include "global/Id.h"
 #include "index/LocalVocabEntry.h"
 #include "util/BlankNodeManager.h"
 #include "util/Exception.h"
@@ -80,6 +81,12 @@ class LocalVocab {
   LocalVocabIndex getIndexAndAddIfNotContained(const LocalVocabEntry& word);
   LocalVocabIndex getIndexAndAddIfNotContained(LocalVocabEntry&& word);
 
+  // Like `getIndexAndAddIfNotContained`, but return an `Id` for the
+  // `LocalVocabEntry`. Words that are short enough are stored directly in the
+  // `Id` (see `InlineString`) and are not added to the local vocabulary.
+  Id getIdAndAddIfNotContained(const LocalVocabEntry& word);
+  Id getIdAndAddIfNotContained(LocalVocabEntry&& word);
+
   // Like `getIndexAndAddIfNotContained`, but if the `LocalVocabEntry` is not
   // contained in any of the sets, do not add it and return `std::nullopt`.
   std::optional<LocalVocabIndex> getIndexOrNullopt(
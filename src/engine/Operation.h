@@ -22,6 +22,7 @@
 
 // forward declaration needed to break dependencies
 class QueryExecutionTree;
+class ValueHistogram;
 
 enum class ComputationMode {
   FULLY_MATERIALIZED,
@@ -200,6 +201,16 @@ class Operation {
   virtual float getMultiplicity(size_t col) = 0;
   virtual bool knownEmptyResult() = 0;
 
+  // Return a histogram of the values in the column `col` of the result (see
+  // `PredicateStatistics`), or `nullptr` if none is available. This is used
+  // for better estimates of the selectivity of FILTERs and of join sizes. The
+  // default is `nullptr`, operations that don't change the values of a column
+  // (like `Sort`) pass on the histogram of their child.
+  virtual const ValueHistogram* getValueHistogram(
+      [[maybe_unused]] size_t col) const {
+    return nullptr;
+  }
+
   // Get the mapping from variables to columns but without the variables that
   // are not visible to the outside because they were not selected by a
   // subquery.
@@ -5,13 +5,15 @@
 
 #include "engine/OrderBy.h"
 
+#include <optional>
+#include <span>
 #include <sstream>
 
 #include "engine/CallFixedSize.h"
 #include "engine/Engine.h"
+#include "engine/ExternalSort.h"
 #include "engine/QueryExecutionTree.h"
 #include "global/RuntimeParameters.h"
-#include "global/ValueIdComparators.h"
 #include "util/TransparentFunctors.h"
 
 // _____________________________________________________________________________
@@ -63,70 +65,213 @@ std::string OrderBy::getDescriptor() const {
 }
 
 // _____________________________________________________________________________
-ProtoResult OrderBy::computeResult([[maybe_unused]] bool requestLaziness) {
+ProtoResult OrderBy::computeResult(bool requestLaziness) {
   using std::endl;
   LOG(DEBUG) << "Getting sub-result for OrderBy result computation..." << endl;
-  std::shared_ptr<const Result> subRes = subtree_->getResult();
+  std::shared_ptr<const Result> subRes = subtree_->getResult(requestLaziness);
 
-  // TODO<joka921> proper timeout for sorting operations
-  const auto& subTable = subRes->idTable();
-  getExecutionContext()->getSortPerformanceEstimator().throwIfEstimateTooLong(
-      subTable.numRows(), subTable.numColumns(), deadline_,
-      "Sort for COUNT(DISTINCT *)");
+  // Sort the `input` externally and return the lazy result.
+  auto sortExternally = [this](externalSort::SortInput input) -> ProtoResult {
+    LOG(DEBUG) << "Sorting the input of the OrderBy externally..." << endl;
+    runtimeInfo().addDetail("external-sort", true);
+    return {externalSort::sortExternally(
+                std::move(input), makeComparator(sortIndices_),
+                getSpillFilename(getIndex(), "external-sort"),
+                cancellationHandle_),
+            resultSortedOn()};
+  };
 
-  LOG(DEBUG) << "OrderBy result computation..." << endl;
-  IdTable idTable = subRes->idTable().clone();
+  if (!subRes->isFullyMaterialized()) {
+    // If the input is already sorted on a prefix of the `sortIndices_`, it
+    // suffices to sort each run of rows that are equal on this prefix.
+    auto prefixColumns = getSortedPrefixColumns();
+    if (!prefixColumns.empty()) {
+      runtimeInfo().addDetail("num-presorted-columns", prefixColumns.size());
+      return {sortRunsLazily(std::move(subRes->idTables()),
+                             std::move(prefixColumns)),
+              resultSortedOn()};
+    }
+    auto input = externalSort::readLazyInput(std::move(subRes),
+                                             getResultWidth(), allocator());
+    if (!input.isCompletelyRead()) {
+      return sortExternally(std::move(input));
+    }
+    sortInMemory(input.readRows_);
+    return {std::move(input.readRows_), resultSortedOn(),
+            std::move(input.localVocab_)};
+  }
 
-  size_t width = idTable.numColumns();
+  const auto& subTable = subRes->idTable();
+  if (requestLaziness && externalSort::isTooLargeForSortInMemory(
+                             subTable.numRows(), subTable.numColumns(),
+                             allocator())) {
+    return sortExternally({subRes, IdTable{getResultWidth(), allocator()},
+                           subRes->localVocab().clone()});
+  }
 
-  // TODO<joka921> Measure (as soon as we have the benchmark merged)
-  // whether it is beneficial to manually instantiate the comparison when
-  // sorting by only one or two columns.
+  LOG(DEBUG) << "OrderBy result computation..." << endl;
+  IdTable idTable = subTable.clone();
+  sortInMemory(idTable);
+  LOG(DEBUG) << "OrderBy result computation done." << endl;
+  return {std::move(idTable), resultSortedOn(), subRes->getSharedLocalVocab()};
+}
 
-  // TODO<joka921> In the case of a single variable, it might be more efficient
-  // to first sort by the ID values and then "repair" the resulting range by
-  // some O(n) algorithms, or even by returning lazy generators that yield
-  // the repaired order.
+// _____________________________________________________________________________
+std::vector<ColumnIndex> OrderBy::getSortedPrefixColumns() const {
+  std::vector<ColumnIndex> prefixColumns;
+  auto sortedOn = subtree_->resultSortedOn();
+  for (size_t i = 0; i < std::min(sortIndices_.size(), sortedOn.size()); ++i) {
+    auto [column, isDescending] = sortIndices_.at(i);
+    if (isDescending || column != sortedOn.at(i)) {
+      break;
+    }
+    prefixColumns.push_back(column);
+  }
+  return prefixColumns;
+}
 
-  // TODO<joka921> For proper sorting of the local vocab we also need to
-  // add some logic for the proper sorting.
+namespace {
+// For the values of some datatypes, the internal order of the IDs differs
+// from the semantic order of ORDER BY (e.g. negative integers come after the
+// positive ones). For such a value, return its group; all the values of a
+// group have to be sorted together. `Int` and `Double` form a single group,
+// because they are compared by their numeric value. For all other values, the
+// internal order is the semantic order, and `std::nullopt` is returned.
+std::optional<Datatype> getGroupWithDifferentOrder(Id id) {
+  auto type = id.getDatatype();
+  if (type == Datatype::Int || type == Datatype::Double) {
+    return Datatype::Int;
+  }
+  if (type == Datatype::Date || type == Datatype::GeoPoint) {
+    return type;
+  }
+  return std::nullopt;
+}
 
-  // TODO<joka921> Undefined values should always be at the end, no matter
-  // if the ordering is ascending or descending.
+// Return true iff `rowA` and `rowB` belong to the same run w.r.t. the
+// `prefixColumns`, i.e. if they are equal on these columns. As an exception,
+// all values from the same group (see above) count as equal, and the columns
+// after such a value are ignored.
+bool belongToSameRun(const auto& rowA, const auto& rowB,
+                     const std::vector<ColumnIndex>& prefixColumns) {
+  for (ColumnIndex column : prefixColumns) {
+    Id a = rowA[column];
+    Id b = rowB[column];
+    auto groupA = getGroupWithDifferentOrder(a);
+    auto groupB = getGroupWithDifferentOrder(b);
+    if (groupA.has_value() || groupB.has_value()) {
+      return groupA == groupB;
+    }
+    if (a != b) {
+      return false;
+    }
+  }
+  return true;
+}
 
-  // TODO<joka921> If we know, that all the sort columns contain only datatypes
-  // for which the `internal` order is also the `semantic` order, or if a column
-  // only contains a single datatype, then we can use more efficient
-  // implementations here.
+// Return the columns for a radix sort of the `idTable` (see
+// `Engine::radixSort`) if the order of the radix keys is the order specified
+// by the `sortIndices`. This is the case if each sort column only contains
+// values for which the internal order is the semantic order (see above), or
+// only integers and undefined values. Else return `std::nullopt`.
+std::optional<std::vector<Engine::RadixSortColumn>> getRadixSortColumns(
+    const IdTable& idTable, const OrderBy::SortIndices& sortIndices) {
+  auto isOrderedByBits = [](Id id) {
+    return !getGroupWithDifferentOrder(id).has_value() &&
+           id.getDatatype() != Datatype::LocalVocabIndex &&
+           id.getDatatype() != Datatype::InlineString;
+  };
+  auto isIntOrUndefined = [](Id id) {
+    auto type = id.getDatatype();
+    return type == Datatype::Int || type == Datatype::Undefined;
+  };
+  std::vector<Engine::RadixSortColumn> radixSortColumns;
+  for (auto [column, isDescending] : sortIndices) {
+    auto ids = idTable.getColumn(column);
+    using enum Engine::RadixKey;
+    if (ql::ranges::all_of(ids, isOrderedByBits)) {
+      radixSortColumns.push_back({column, Bits, isDescending});
+    } else if (ql::ranges::all_of(ids, isIntOrUndefined)) {
+      radixSortColumns.push_back({column, SignedInt, isDescending});
+    } else {
+      return std::nullopt;
+    }
+  }
+  return radixSortColumns;
+}
+}  // namespace
 
-  // Return true iff `rowA` comes before `rowB` in the sort order specified by
-  // `sortIndices_`.
-  auto comparison = [this](const auto& row1, const auto& row2) -> bool {
-    for (auto& [column, isDescending] : sortIndices_) {
-      if (row1[column] == row2[column]) {
-        continue;
+// _____________________________________________________________________________
+Result::Generator OrderBy::sortRunsLazily(
+    Result::LazyResult input, std::vector<ColumnIndex> prefixColumns) {
+  IdTable currentRun{getResultWidth(), allocator()};
+  // The merged local vocabs of all the blocks that contain rows which have not
+  // been yielded yet.
+  LocalVocab localVocab;
+  for (auto& [block, blockVocab] : input) {
+    if (block.empty()) {
+      continue;
+    }
+    localVocab.mergeWith(std::span{&blockVocab, 1});
+    IdTable finishedRuns{getResultWidth(), allocator()};
+    bool runStartedInThisBlock = currentRun.empty();
+    size_t runBegin = 0;
+    for (size_t i = 0; i < block.numRows(); ++i) {
+      bool isNewRun =
+          i == 0 ? !currentRun.empty() &&
+                       !belongToSameRun(currentRun.back(), block[0],
+                                        prefixColumns)
+                 : !belongToSameRun(block[i - 1], block[i], prefixColumns);
+      if (isNewRun) {
+        currentRun.insertAtEnd(block, runBegin, i);
+        sortInMemory(currentRun);
+        finishedRuns.insertAtEnd(currentRun);
+        currentRun.clear();
+        runBegin = i;
+        runStartedInThisBlock = true;
       }
-      bool isLessThan =
-          toBoolNotUndef(valueIdComparators::compareIds<
-                         valueIdComparators::ComparisonForIncompatibleTypes::
-                             CompareByType>(
-              row1[column], row2[column], valueIdComparators::Comparison::LT));
-      return isLessThan != isDescending;
     }
-    return false;
-  };
+    currentRun.insertAtEnd(block, runBegin, block.numRows());
+    if (!finishedRuns.empty()) {
+      co_yield {std::move(finishedRuns), localVocab.clone()};
+      // The remaining rows only stem from this block.
+      if (runStartedInThisBlock) {
+        localVocab = blockVocab.clone();
+      }
+    }
+  }
+  if (!currentRun.empty()) {
+    sortInMemory(currentRun);
+    co_yield {std::move(currentRun), std::move(localVocab)};
+  }
+}
+
+// _____________________________________________________________________________
+void OrderBy::sortInMemory(IdTable& idTable) {
+  // TODO<joka921> proper timeout for sorting operations
+  getExecutionContext()->getSortPerformanceEstimator().throwIfEstimateTooLong(
+      idTable.numRows(), idTable.numColumns(), deadline_,
+      "Sort for COUNT(DISTINCT *)");
 
-  // We cannot use the `CALL_FIXED_SIZE` macro here because the `sort` function
-  // is templated not only on the integer `I` (which the `callFixedSize`
-  // function deals with) but also on the `comparison`.
-  ad_utility::callFixedSize(width, [&idTable, &comparison]<size_t I>() {
-    Engine::sort<I>(&idTable, comparison);
-  });
+  std::optional<std::vector<Engine::RadixSortColumn>> radixSortColumns;
+  if (idTable.numRows() >= Engine::RADIX_SORT_MIN_NUM_ROWS) {
+    radixSortColumns = getRadixSortColumns(idTable, sortIndices_);
+  }
+  if (radixSortColumns.has_value()) {
+    Engine::radixSort(idTable, radixSortColumns.value());
+  } else {
+    // We cannot use the `CALL_FIXED_SIZE` macro here because the `sort`
+    // function is templated not only on the integer `I` (which the
+    // `callFixedSize` function deals with) but also on the `comparison`.
+    ad_utility::callFixedSize(
+        idTable.numColumns(),
+        [&idTable, comparison = makeComparator(sortIndices_)]<size_t I>() {
+          Engine::sort<I>(&idTable, comparison);
+        });
+  }
   // We can't check during sort, so reset status here
   cancellationHandle_->resetWatchDogState();
   checkCancellation();
-  LOG(DEBUG) << "OrderBy result computation done." << endl;
-  return {std::move(idTable), resultSortedOn(), subRes->getSharedLocalVocab()};
 }
 
 // ___________________________________________________________________
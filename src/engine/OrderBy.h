@@ -9,6 +9,7 @@
 
 #include "engine/Operation.h"
 #include "engine/QueryExecutionTree.h"
+#include "global/ValueIdComparators.h"
 
 // The implementation of the SPARQL `ORDER BY` operation.
 //
@@ -49,6 +50,48 @@ class OrderBy : public Operation {
   using SortedVariables = std::vector<std::pair<Variable, AscOrDesc>>;
   SortedVariables getSortedVariables() const;
 
+  // Return the comparator on rows that implements the `sortIndices`. The
+  // comparator stores the `sortIndices` by value, s.t. it can also be used by
+  // a lazy result that outlives the operation.
+  static auto makeComparator(SortIndices sortIndices) {
+    // TODO<joka921> Measure (as soon as we have the benchmark merged)
+    // whether it is beneficial to manually instantiate the comparison when
+    // sorting by only one or two columns.
+
+    // TODO<joka921> In the case of a single variable, it might be more
+    // efficient to first sort by the ID values and then "repair" the resulting
+    // range by some O(n) algorithms, or even by returning lazy generators that
+    // yield the repaired order.
+
+    // TODO<joka921> For proper sorting of the local vocab we also need to
+    // add some logic for the proper sorting.
+
+    // TODO<joka921> Undefined values should always be at the end, no matter
+    // if the ordering is ascending or descending.
+
+    // TODO<joka921> If we know, that all the sort columns contain only
+    // datatypes for which the `internal` order is also the `semantic` order, or
+    // if a column only contains a single datatype, then we can use more
+    // efficient implementations here.
+
+    // Return true iff `rowA` comes before `rowB` in the sort order specified by
+    // `sortIndices`.
+    return [sortIndices = std::move(sortIndices)](const auto& row1,
+                                                  const auto& row2) -> bool {
+      for (auto& [column, isDescending] : sortIndices) {
+        if (row1[column] == row2[column]) {
+          continue;
+        }
+        using namespace valueIdComparators;
+        bool isLessThan = toBoolNotUndef(
+            compareIds<ComparisonForIncompatibleTypes::CompareByType>(
+                row1[column], row2[column], Comparison::LT));
+        return isLessThan != isDescending;
+      }
+      return false;
+    };
+  }
+
  private:
   uint64_t getSizeEstimateBeforeLimit() override {
     return subtree_->getSizeEstimate();
@@ -78,7 +121,22 @@ class OrderBy : public Operation {
   }
 
  private:
-  ProtoResult computeResult([[maybe_unused]] bool requestLaziness) override;
+  ProtoResult computeResult(bool requestLaziness) override;
+
+  // Sort the `idTable` in RAM according to the `sortIndices_`.
+  void sortInMemory(IdTable& idTable);
+
+  // Return the longest prefix of the columns of the `sortIndices_` that are
+  // all sorted in ascending order and on which the input is already sorted
+  // (according to `resultSortedOn()` of the `subtree_`).
+  std::vector<ColumnIndex> getSortedPrefixColumns() const;
+
+  // Lazily sort the `input`, which has to be sorted on the `prefixColumns`.
+  // It suffices to sort each run of consecutive rows that are equal on the
+  // `prefixColumns` separately. The sorted runs are yielded as soon as they
+  // are complete, so only the largest run has to fit into memory.
+  Result::Generator sortRunsLazily(Result::LazyResult input,
+                                   std::vector<ColumnIndex> prefixColumns);
 
   VariableToColumnMap computeVariableToColumnMap() const override {
     return subtree_->getVariableColumns();
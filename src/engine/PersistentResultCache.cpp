@@ -0,0 +1,358 @@
+//  Copyright 2025, University of Freiburg,
+//                  Chair of Algorithms and Data Structures.
+
+#include "engine/PersistentResultCache.h"
+
+#include <absl/cleanup/cleanup.h>
+#include <absl/strings/str_cat.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <filesystem>
+
+#include "util/CompressionUsingZstd/ZstdWrapper.h"
+#include "util/File.h"
+#include "util/Log.h"
+#include "util/Serializer/ByteBufferSerializer.h"
+#include "util/Serializer/SerializeString.h"
+#include "util/Serializer/SerializeVector.h"
+
+namespace {
+// Files with a different version are ignored. Increment this whenever the
+// format of the files changes.
+constexpr uint64_t FORMAT_VERSION = 2;
+
+// The IDs of `LocalVocab` entries are stored as the position of their word in
+// the stored list of words, disguised as a (properly aligned) pointer.
+Id localVocabPositionToId(size_t position) {
+  return Id::makeFromLocalVocabIndex(reinterpret_cast<LocalVocabIndex>(
+      position * alignof(LocalVocabEntry)));
+}
+size_t idToLocalVocabPosition(Id id) {
+  return reinterpret_cast<uintptr_t>(id.getLocalVocabIndex()) /
+         alignof(LocalVocabEntry);
+}
+
+// The header of a stored result. In the file, the header is preceded by its
+// size in bytes and followed by the zstd-compressed columns.
+struct Header {
+  uint64_t version_ = FORMAT_VERSION;
+  std::string indexId_;
+  std::string cacheKey_;
+  uint64_t snapshotIndex_ = 0;
+  // The (stripped down) `RuntimeInformation` of the result.
+  std::string descriptor_;
+  int64_t totalTimeMicroseconds_ = 0;
+  std::string details_;
+  // The `IdTable`, its `LocalVocab`, and its sortedness.
+  uint64_t numRows_ = 0;
+  uint64_t numColumns_ = 0;
+  std::vector<uint64_t> sortedBy_;
+  std::vector<std::string> words_;
+  std::vector<uint64_t> compressedColumnSizes_;
+
+  AD_SERIALIZE_FRIEND_FUNCTION(Header) {
+    serializer | arg.version_;
+    // Make sure that no other field is read for an unknown version.
+    if (arg.version_ != FORMAT_VERSION) {
+      return;
+    }
+    serializer | arg.indexId_;
+    serializer | arg.cacheKey_;
+    serializer | arg.snapshotIndex_;
+    serializer | arg.descriptor_;
+    serializer | arg.totalTimeMicroseconds_;
+    serializer | arg.details_;
+    serializer | arg.numRows_;
+    serializer | arg.numColumns_;
+    serializer | arg.sortedBy_;
+    serializer | arg.words_;
+    serializer | arg.compressedColumnSizes_;
+  }
+};
+
+// A read-only memory mapping of a complete file.
+class MappedFile {
+  const char* data_ = nullptr;
+  size_t size_ = 0;
+
+ public:
+  explicit MappedFile(const std::string& filename) {
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+      throw std::runtime_error{absl::StrCat("Could not open \"", filename,
+                                            "\" for reading")};
+    }
+    absl::Cleanup closeFile{[fd]() { ::close(fd); }};
+    struct stat fileStatus;
+    AD_CORRECTNESS_CHECK(::fstat(fd, &fileStatus) == 0);
+    size_ = static_cast<size_t>(fileStatus.st_size);
+    if (size_ == 0) {
+      return;
+    }
+    void* ptr = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (ptr == MAP_FAILED) {
+      throw std::runtime_error{
+          absl::StrCat("Could not memory-map \"", filename, "\"")};
+    }
+    ::madvise(ptr, size_, MADV_SEQUENTIAL);
+    data_ = static_cast<const char*>(ptr);
+  }
+  ~MappedFile() {
+    if (data_ != nullptr) {
+      ::munmap(const_cast<char*>(data_), size_);
+    }
+  }
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  const char* data() const { return data_; }
+  size_t size() const { return size_; }
+};
+
+// 64-bit FNV-1a hash. Unlike `absl::Hash`, it is stable across runs of the
+// program, which is required for the filenames.
+uint64_t stableHash(std::string_view input) {
+  uint64_t hash = 14695981039346656037ull;
+  for (char c : input) {
+    hash ^= static_cast<uint8_t>(c);
+    hash *= 1099511628211ull;
+  }
+  return hash;
+}
+}  // namespace
+
+// _____________________________________________________________________________
+PersistentResultCache::PersistentResultCache(
+    std::string directory, std::string indexId,
+    ad_utility::AllocatorWithLimit<Id> allocator)
+    : directory_{std::move(directory)},
+      indexId_{std::move(indexId)},
+      allocator_{std::move(allocator)} {
+  std::filesystem::create_directories(directory_);
+  writerThread_ = ad_utility::JThread{[this]() { runWriterThread(); }};
+}
+
+// _____________________________________________________________________________
+PersistentResultCache::~PersistentResultCache() {
+  {
+    std::lock_guard lock{mutex_};
+    finish_ = true;
+  }
+  pendingWritesChanged_.notify_all();
+  writerThread_.join();
+}
+
+// _____________________________________________________________________________
+std::string PersistentResultCache::getFilename(const QueryCacheKey& key) const {
+  auto hash = stableHash(absl::StrCat(indexId_, "\n", key.key_, "\n",
+                                      key.locatedTriplesSnapshotIndex_));
+  return absl::StrCat(directory_, "/", absl::Hex(hash, absl::kZeroPad16),
+                      ".result");
+}
+
+// _____________________________________________________________________________
+void PersistentResultCache::store(const QueryCacheKey& key,
+                                  std::shared_ptr<const CacheValue> value) {
+  if (key.locatedTriplesSnapshotIndex_ != 0 ||
+      !value->resultTable().isFullyMaterialized()) {
+    return;
+  }
+  std::lock_guard lock{mutex_};
+  if (finish_ || pendingWrites_.size() >= MAX_NUM_PENDING_WRITES) {
+    return;
+  }
+  pendingWrites_.emplace_back(key, std::move(value));
+  pendingWritesChanged_.notify_all();
+}
+
+// _____________________________________________________________________________
+void PersistentResultCache::waitForPendingWrites() {
+  std::unique_lock lock{mutex_};
+  pendingWritesChanged_.wait(
+      lock, [this]() { return pendingWrites_.empty() && !isWriting_; });
+}
+
+// _____________________________________________________________________________
+void PersistentResultCache::runWriterThread() {
+  std::unique_lock lock{mutex_};
+  while (true) {
+    pendingWritesChanged_.wait(
+        lock, [this]() { return finish_ || !pendingWrites_.empty(); });
+    if (pendingWrites_.empty()) {
+      return;
+    }
+    auto [key, value] = std::move(pendingWrites_.front());
+    pendingWrites_.pop_front();
+    isWriting_ = true;
+    lock.unlock();
+    try {
+      write(key, *value);
+    } catch (const std::exception& e) {
+      AD_LOG_WARN << "Could not write a result to the persistent cache: "
+                  << e.what() << std::endl;
+    }
+    lock.lock();
+    isWriting_ = false;
+    pendingWritesChanged_.notify_all();
+  }
+}
+
+// _____________________________________________________________________________
+void PersistentResultCache::write(const QueryCacheKey& key,
+                                  const CacheValue& value) const {
+  auto filename = getFilename(key);
+  if (std::filesystem::exists(filename)) {
+    return;
+  }
+  const Result& result = value.resultTable();
+  const IdTable& idTable = result.idTable();
+  const auto& localVocab = result.localVocab();
+
+  Header header;
+  header.indexId_ = indexId_;
+  header.cacheKey_ = key.key_;
+  header.snapshotIndex_ = key.locatedTriplesSnapshotIndex_;
+  header.descriptor_ = value.runtimeInfo().descriptor_;
+  header.totalTimeMicroseconds_ = value.runtimeInfo().totalTime_.count();
+  header.details_ = value.runtimeInfo().details_.dump();
+  header.numRows_ = idTable.numRows();
+  header.numColumns_ = idTable.numColumns();
+  header.sortedBy_.assign(result.sortedBy().begin(), result.sortedBy().end());
+
+  // Replace the IDs of the local vocab entries by their position in the
+  // `words_`, and compress the columns.
+  ad_utility::HashMap<LocalVocabIndex, size_t> wordPositions;
+  std::vector<std::vector<char>> compressedColumns;
+  std::vector<Id> column;
+  for (const auto& inputColumn : idTable.getColumns()) {
+    column.assign(inputColumn.begin(), inputColumn.end());
+    for (Id& id : column) {
+      if (id.getDatatype() == Datatype::LocalVocabIndex) {
+        auto [it, isNew] = wordPositions.try_emplace(id.getLocalVocabIndex(),
+                                                     header.words_.size());
+        if (isNew) {
+          header.words_.push_back(
+              id.getLocalVocabIndex()->toStringRepresentation());
+        }
+        id = localVocabPositionToId(it->second);
+      } else if (id.getDatatype() == Datatype::BlankNodeIndex &&
+                 localVocab.isBlankNodeIndexContained(id.getBlankNodeIndex())) {
+        // Blank nodes of the local vocab are only valid in this process.
+        return;
+      }
+    }
+    compressedColumns.push_back(
+        ZstdWrapper::compress(column.data(), column.size() * sizeof(Id)));
+    header.compressedColumnSizes_.push_back(compressedColumns.back().size());
+  }
+
+  ad_utility::serialization::ByteBufferWriteSerializer serializer;
+  serializer << header;
+  const auto& headerData = serializer.data();
+  uint64_t headerSize = headerData.size();
+
+  // Write to a temporary file first, s.t. incompletely written files are never
+  // read (e.g. if the server is terminated while writing).
+  auto temporaryFilename = absl::StrCat(filename, ".tmp");
+  {
+    ad_utility::File file{temporaryFilename, "w"};
+    AD_CORRECTNESS_CHECK(file.isOpen());
+    file.write(&headerSize, sizeof(headerSize));
+    file.write(headerData.data(), headerData.size());
+    for (const auto& compressedColumn : compressedColumns) {
+      file.write(compressedColumn.data(), compressedColumn.size());
+    }
+  }
+  std::filesystem::rename(temporaryFilename, filename);
+}
+
+// _____________________________________________________________________________
+std::shared_ptr<CacheValue> PersistentResultCache::load(
+    const QueryCacheKey& key) {
+  if (key.locatedTriplesSnapshotIndex_ != 0) {
+    return nullptr;
+  }
+  auto filename = getFilename(key);
+  if (!std::filesystem::exists(filename)) {
+    return nullptr;
+  }
+  try {
+    MappedFile file{filename};
+    uint64_t headerSize;
+    AD_CORRECTNESS_CHECK(file.size() >= sizeof(headerSize));
+    std::memcpy(&headerSize, file.data(), sizeof(headerSize));
+    const char* position = file.data() + sizeof(headerSize);
+    AD_CORRECTNESS_CHECK(headerSize <= file.size() - sizeof(headerSize));
+    ad_utility::serialization::ByteBufferReadSerializer serializer{
+        std::vector<char>(position, position + headerSize)};
+    position += headerSize;
+    Header header;
+    serializer >> header;
+    // The file might belong to a different index or (in the case of a hash
+    // collision) to a different key.
+    if (header.version_ != FORMAT_VERSION || header.indexId_ != indexId_ ||
+        header.cacheKey_ != key.key_ ||
+        header.snapshotIndex_ != key.locatedTriplesSnapshotIndex_) {
+      return nullptr;
+    }
+    AD_CORRECTNESS_CHECK(header.compressedColumnSizes_.size() ==
+                         header.numColumns_);
+
+    LocalVocab localVocab;
+    std::vector<Id> wordIds;
+    wordIds.reserve(header.words_.size());
+    for (auto& word : header.words_) {
+      wordIds.push_back(
+          Id::makeFromLocalVocabIndex(localVocab.getIndexAndAddIfNotContained(
+              LocalVocabEntry{ad_utility::triple_component::LiteralOrIri::
+                                  fromStringRepresentation(std::move(word))})));
+    }
+
+    // The columns are decompressed directly from the memory-mapped file.
+    IdTable idTable{header.numColumns_, allocator_};
+    idTable.resize(header.numRows_);
+    const char* end = file.data() + file.size();
+    for (size_t i = 0; i < header.numColumns_; ++i) {
+      auto compressedSize = header.compressedColumnSizes_[i];
+      AD_CORRECTNESS_CHECK(compressedSize <=
+                           static_cast<size_t>(end - position));
+      auto column = idTable.getColumn(i);
+      auto numBytes = ZstdWrapper::decompressToBuffer(
+          position, compressedSize, column.data(), column.size() * sizeof(Id));
+      AD_CORRECTNESS_CHECK(numBytes == column.size() * sizeof(Id));
+      position += compressedSize;
+      for (Id& id : column) {
+        if (id.getDatatype() == Datatype::LocalVocabIndex) {
+          id = wordIds.at(idToLocalVocabPosition(id));
+        }
+      }
+    }
+
+    RuntimeInformation runtimeInfo;
+    runtimeInfo.descriptor_ = std::move(header.descriptor_);
+    runtimeInfo.totalTime_ =
+        std::chrono::microseconds{header.totalTimeMicroseconds_};
+    runtimeInfo.details_ = nlohmann::json::parse(header.details_);
+    runtimeInfo.numRows_ = header.numRows_;
+    runtimeInfo.numCols_ = header.numColumns_;
+    runtimeInfo.status_ = RuntimeInformation::Status::fullyMaterialized;
+    std::vector<ColumnIndex> sortedBy(header.sortedBy_.begin(),
+                                      header.sortedBy_.end());
+    return std::make_shared<CacheValue>(
+        Result{std::move(idTable), std::move(sortedBy), std::move(localVocab)},
+        std::move(runtimeInfo));
+  } catch (const ad_utility::detail::AllocationExceedsLimitException&) {
+    // Not enough memory for the result, it is computed instead.
+    return nullptr;
+  } catch (const std::exception& e) {
+    AD_LOG_WARN << "Could not read \"" << filename
+                << "\" from the persistent cache, the file is removed: "
+                << e.what() << std::endl;
+    std::filesystem::remove(filename);
+    return nullptr;
+  }
+}
@@ -0,0 +1,87 @@
+//  Copyright 2025, University of Freiburg,
+//                  Chair of Algorithms and Data Structures.
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+
+#include "engine/QueryExecutionContext.h"
+#include "util/AllocatorWithLimit.h"
+#include "util/ConcurrentCache.h"
+#include "util/jthread.h"
+
+// A second level for the `QueryResultCache` (see `SecondLevelCache` in
+// `ConcurrentCache.h`) that stores results in files in a local directory, so
+// that they survive a restart of the server. Results that are evicted from or
+// pinned in the cache are written to this directory by a background thread,
+// and they are read from it (via a memory mapping) on a cache miss.
+//
+// Each result is stored in a single file together with its `LocalVocab` and
+// the cache key, the index ID, and the index of the `LocatedTriplesSnapshot`.
+// Only results for the snapshot with index 0 (which is the index without any
+// updates) are stored. The indices of all later snapshots are not stable across
+// restarts of the server, and their results could therefore be confused.
+// Results that contain blank nodes from a `LocalVocab` are also never stored.
+//
+// NOTE: The directory is never cleaned up automatically, files that belong to
+// a different index are simply ignored.
+class PersistentResultCache
+    : public ad_utility::SecondLevelCache<QueryCacheKey, CacheValue> {
+ public:
+  // The maximal number of results that are waiting to be written. If the
+  // writing thread falls behind, then further results are not stored.
+  static constexpr size_t MAX_NUM_PENDING_WRITES = 32;
+
+ private:
+  std::string directory_;
+  std::string indexId_;
+  ad_utility::AllocatorWithLimit<Id> allocator_;
+
+  // The results that have not been written yet.
+  std::mutex mutex_;
+  std::condition_variable pendingWritesChanged_;
+  std::deque<std::pair<QueryCacheKey, std::shared_ptr<const CacheValue>>>
+      pendingWrites_;
+  bool isWriting_ = false;
+  bool finish_ = false;
+  ad_utility::JThread writerThread_;
+
+ public:
+  // Store the results for the index with the given `indexId` in the
+  // `directory`, which is created if it does not exist yet. The `allocator` is
+  // used for the results that are read.
+  PersistentResultCache(std::string directory, std::string indexId,
+                        ad_utility::AllocatorWithLimit<Id> allocator);
+
+  // Write all the pending results before destruction.
+  ~PersistentResultCache() override;
+
+  PersistentResultCache(const PersistentResultCache&) = delete;
+  PersistentResultCache& operator=(const PersistentResultCache&) = delete;
+
+  // Schedule the `value` to be written, see `SecondLevelCache`.
+  void store(const QueryCacheKey& key,
+             std::shared_ptr<const CacheValue> value) override;
+
+  // Read the value for the `key`, `nullptr` if it has not been stored (or
+  // the stored file is corrupt).
+  std::shared_ptr<CacheValue> load(const QueryCacheKey& key) override;
+
+  // Block until all the results that were passed to `store` have been written.
+  void waitForPendingWrites();
+
+  // Return the file in which the value for the `key` is stored.
+  std::string getFilename(const QueryCacheKey& key) const;
+
+ private:
+  // Write the `value` to the file for the `key`, unless it already exists.
+  void write(const QueryCacheKey& key, const CacheValue& value) const;
+
+  // The loop of the `writerThread_`.
+  void runWriterThread();
+};
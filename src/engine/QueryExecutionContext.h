@@ -5,6 +5,7 @@
 
 #pragma once
 
+#include <chrono>
 #include <memory>
 #include <string>
 
@@ -60,6 +61,16 @@ class CacheValue {
       }
     }
   };
+
+  // The cost of computing the `result_` (its total time in milliseconds),
+  // which is used by the eviction policy of the `QueryResultCache`.
+  struct CostGetter {
+    double operator()(const CacheValue& cacheValue) const {
+      return std::chrono::duration<double, std::milli>(
+                 cacheValue.runtimeInfo_.totalTime_)
+          .count();
+    }
+  };
 };
 
 // The key for the `QueryResultCache` below. It consists of a `string` (the
@@ -80,11 +91,12 @@ struct QueryCacheKey {
   }
 };
 
-// Threadsafe LRU cache for (partial) query results, that
-// checks on insertion, if the result is currently being computed
-// by another query.
+// Threadsafe cache for (partial) query results, that checks on insertion, if
+// the result is currently being computed by another query. The eviction policy
+// (LRU or cost-aware) is set via the runtime parameter `cache-eviction-policy`.
 using QueryResultCache = ad_utility::ConcurrentCache<
-    ad_utility::LRUCache<QueryCacheKey, CacheValue, CacheValue::SizeGetter>>;
+    ad_utility::CostAwareCache<QueryCacheKey, CacheValue,
+                               CacheValue::SizeGetter, CacheValue::CostGetter>>;
 
 // Execution context for queries.
 // Holds references to index and engine, implements caching.
@@ -8,6 +8,7 @@
 #include <memory>
 #include <optional>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "engine/Operation.h"
@@ -217,6 +218,19 @@ class QueryExecutionTree {
     sizeEstimate_ = getRootOperation()->getSizeEstimate();
   }
 
+  // Replace the root operation by the `operation`, which has to compute the
+  // same result (for example, because it holds the already computed result of
+  // the current root operation, see `AdaptiveJoinTree`). Return the previous
+  // root operation.
+  std::shared_ptr<Operation> replaceRootOperation(
+      std::shared_ptr<Operation> operation) {
+    AD_CONTRACT_CHECK(operation != nullptr);
+    AD_CONTRACT_CHECK(operation->getResultWidth() == getResultWidth());
+    // The size estimate of the new operation might be different.
+    sizeEstimate_ = std::nullopt;
+    return std::exchange(rootOperation_, std::move(operation));
+  }
+
  private:
   QueryExecutionContext* qec_;  // No ownership
   std::shared_ptr<Operation> rootOperation_ =
@@ -24,8 +24,10 @@
 #include "engine/Filter.h"
 #include "engine/GroupBy.h"
 #include "engine/HasPredicateScan.h"
+#include "engine/HashJoin.h"
 #include "engine/IndexScan.h"
 #include "engine/Join.h"
+#include "engine/LeapfrogTriejoin.h"
 #include "engine/Minus.h"
 #include "engine/MultiColumnJoin.h"
 #include "engine/NeutralElementOperation.h"
@@ -39,6 +41,7 @@
 #include "engine/TextIndexScanForEntity.h"
 #include "engine/TextIndexScanForWord.h"
 #include "engine/TextLimit.h"
+#include "engine/TopK.h"
 #include "engine/TransitivePathBase.h"
 #include "engine/Union.h"
 #include "engine/Values.h"
@@ -435,8 +438,15 @@ vector<QueryPlanner::SubtreePlan> QueryPlanner::getOrderByRow(
       AD_CONTRACT_CHECK(pq._isInternalSort == IsInternalSort::False);
       // Note: As the internal ordering is different from the semantic ordering
       // needed by `OrderBy`, we always have to instantiate the `OrderBy`
-      // operation.
-      tree = makeExecutionTree<OrderBy>(_qec, parent._qet, sortIndices);
+      // operation (or the `TopK` operation if there is a small LIMIT).
+      const auto& limitOffset = pq._limitOffset;
+      if (limitOffset._limit.has_value() &&
+          limitOffset.upperBound(std::numeric_limits<uint64_t>::max()) <=
+              RuntimeParameters().get<"top-k-max-num-rows">()) {
+        tree = makeExecutionTree<TopK>(_qec, parent._qet, sortIndices);
+      } else {
+        tree = makeExecutionTree<OrderBy>(_qec, parent._qet, sortIndices);
+      }
     }
     added.push_back(plan);
   }
@@ -1311,6 +1321,17 @@ QueryPlanner::runDynamicProgrammingOnConnectedComponent(
     std::vector<SubtreePlan> connectedComponent,
     const vector<SparqlFilter>& filters, const TextLimitVec& textLimits,
     const TripleGraph& tg) const {
+  return runDynamicProgrammingOnConnectedComponentImpl(
+      std::move(connectedComponent), filters, textLimits, tg, nullptr);
+}
+
+// _____________________________________________________________________________
+std::vector<QueryPlanner::SubtreePlan>
+QueryPlanner::runDynamicProgrammingOnConnectedComponentImpl(
+    std::vector<SubtreePlan> connectedComponent,
+    const vector<SparqlFilter>& filters, const TextLimitVec& textLimits,
+    const TripleGraph& tg,
+    AdaptiveJoinTree::IdsOfSubtrees* idsOfSubtrees) const {
   vector<vector<QueryPlanner::SubtreePlan>> dpTab;
   // find the unique number of nodes in the current connected component
   // (there might be duplicates because we already have multiple candidates
@@ -1338,9 +1359,171 @@ QueryPlanner::runDynamicProgrammingOnConnectedComponent(
   auto& result = dpTab.back();
   applyFiltersIfPossible<true>(result, filters);
   applyTextLimitsIfPossible(result, textLimits, true);
+  if (idsOfSubtrees != nullptr) {
+    // Only the subtrees of the returned plans are kept alive, so we only
+    // store their ids.
+    ad_utility::HashSet<const QueryExecutionTree*> reachable;
+    for (const auto& plan : result) {
+      reachable.insert(plan._qet.get());
+      std::as_const(*plan._qet).forAllDescendants(
+          [&reachable](const QueryExecutionTree* tree) {
+            reachable.insert(tree);
+          });
+    }
+    for (const auto& plan : dpTab | ql::views::join) {
+      if (std::popcount(plan._idsOfIncludedNodes) >= 2 &&
+          reachable.contains(plan._qet.get())) {
+        (*idsOfSubtrees)[plan._qet.get()] = plan._idsOfIncludedNodes;
+      }
+    }
+  }
   return std::move(result);
 }
 
+// _____________________________________________________________________________
+std::vector<QueryPlanner::SubtreePlan>
+QueryPlanner::runAdaptivePlanningOnConnectedComponent(
+    std::vector<SubtreePlan> connectedComponent, const TripleGraph& tg,
+    double reoptimizationFactor) const {
+  auto idsOfSubtrees = std::make_shared<AdaptiveJoinTree::IdsOfSubtrees>();
+  auto seeds = connectedComponent;
+  auto result = runDynamicProgrammingOnConnectedComponentImpl(
+      std::move(connectedComponent), {}, {}, tg, idsOfSubtrees.get());
+  // The re-planning happens during the query execution, so the `replanner`
+  // must not refer to this `QueryPlanner`.
+  AdaptiveJoinTree::Replanner replanner =
+      [qec = _qec, cancellationHandle = cancellationHandle_,
+       seeds = std::move(seeds)](const auto& executed) {
+        return QueryPlanner{qec, cancellationHandle}.replanJoinTree(seeds,
+                                                                    executed);
+      };
+  for (auto& plan : result) {
+    plan._qet = ad_utility::makeExecutionTree<AdaptiveJoinTree>(
+        _qec, std::move(plan._qet), idsOfSubtrees, replanner,
+        reoptimizationFactor);
+  }
+  return result;
+}
+
+// _____________________________________________________________________________
+std::optional<QueryPlanner::SubtreePlan> QueryPlanner::createLeapfrogTriejoin(
+    const std::vector<SubtreePlan>& connectedComponent) const {
+  auto isScanWithTwoVariables = [](const SubtreePlan& plan) {
+    const auto& qet = *plan._qet;
+    return plan.type == SubtreePlan::BASIC &&
+           qet.getRootOperation()->isIndexScanWithNumVariables(2) &&
+           qet.getResultWidth() == 2 && qet.getVariableColumns().size() == 2;
+  };
+  if (!ql::ranges::all_of(connectedComponent, isScanWithTwoVariables) ||
+      findUniqueNodeIds(connectedComponent) < 3 ||
+      !QueryGraph::hasCycleOfVariables(connectedComponent)) {
+    return std::nullopt;
+  }
+
+  // The alternative scans (permutations) for each triple.
+  std::vector<uint64_t> nodeIds;
+  ad_utility::HashMap<uint64_t, std::vector<const SubtreePlan*>> scansOfNode;
+  for (const auto& plan : connectedComponent) {
+    auto& scans = scansOfNode[plan._idsOfIncludedNodes];
+    if (scans.empty()) {
+      nodeIds.push_back(plan._idsOfIncludedNodes);
+    }
+    scans.push_back(&plan);
+  }
+  std::vector<std::shared_ptr<QueryExecutionTree>> children;
+  for (uint64_t nodeId : nodeIds) {
+    children.push_back(scansOfNode.at(nodeId).front()->_qet);
+  }
+  auto variableOrder = LeapfrogTriejoin::computeVariableOrder(children);
+  auto getRank = [&variableOrder](const Variable& variable) {
+    return ql::ranges::find(variableOrder, variable) - variableOrder.begin();
+  };
+  // A scan matches the variable order if its first sort column is the
+  // variable that comes first in the order.
+  auto matchesVariableOrder = [&getRank](const SubtreePlan* plan) {
+    const auto& qet = *plan->_qet;
+    auto sortedOn = qet.resultSortedOn();
+    if (sortedOn.empty()) {
+      return false;
+    }
+    auto firstRank =
+        getRank(qet.getVariableAndInfoByColumnIndex(sortedOn.at(0)).first);
+    return ql::ranges::all_of(
+        qet.getVariableColumns() | ql::views::keys,
+        [&](const Variable& variable) {
+          return getRank(variable) >= firstRank;
+        });
+  };
+  children.clear();
+  uint64_t idsOfIncludedNodes = 0;
+  for (uint64_t nodeId : nodeIds) {
+    const auto& scans = scansOfNode.at(nodeId);
+    auto it = ql::ranges::find_if(scans, matchesVariableOrder);
+    children.push_back((it != scans.end() ? *it : scans.front())->_qet);
+    idsOfIncludedNodes |= nodeId;
+  }
+  auto plan = makeSubtreePlan<LeapfrogTriejoin>(_qec, std::move(children));
+  plan._idsOfIncludedNodes = idsOfIncludedNodes;
+  return plan;
+}
+
+// _____________________________________________________________________________
+AdaptiveJoinTree::Plan QueryPlanner::replanJoinTree(
+    const std::vector<SubtreePlan>& seeds,
+    const std::vector<AdaptiveJoinTree::ExecutedSubtree>& executed) const {
+  // The new seeds are the `executed` subtrees followed by the `seeds` that are
+  // not contained in any of them. Each new seed gets a new single bit, the
+  // `originalIds` map these bits back to the ids of the original seeds.
+  std::vector<SubtreePlan> newSeeds;
+  std::vector<uint64_t> originalIds;
+  uint64_t idsOfExecuted = 0;
+  for (const auto& [tree, ids] : executed) {
+    AD_CONTRACT_CHECK((ids & idsOfExecuted) == 0);
+    idsOfExecuted |= ids;
+    SubtreePlan plan{_qec};
+    plan._qet = tree;
+    plan._idsOfIncludedNodes = uint64_t{1} << originalIds.size();
+    newSeeds.push_back(std::move(plan));
+    originalIds.push_back(ids);
+  }
+  ad_utility::HashMap<uint64_t, uint64_t> newIdOfSeed;
+  for (const auto& seed : seeds) {
+    uint64_t ids = seed._idsOfIncludedNodes;
+    if ((ids & idsOfExecuted) != 0) {
+      continue;
+    }
+    auto [it, isNew] =
+        newIdOfSeed.try_emplace(ids, uint64_t{1} << originalIds.size());
+    if (isNew) {
+      originalIds.push_back(ids);
+    }
+    SubtreePlan plan = seed;
+    plan._idsOfIncludedNodes = it->second;
+    newSeeds.push_back(std::move(plan));
+  }
+
+  // The `TripleGraph` is empty, so the join candidates are determined by the
+  // variables that the subtrees have in common.
+  AdaptiveJoinTree::IdsOfSubtrees newIds;
+  auto result = runDynamicProgrammingOnConnectedComponentImpl(
+      std::move(newSeeds), {}, {}, TripleGraph{}, &newIds);
+  auto translate = [&originalIds](uint64_t ids) {
+    uint64_t translated = 0;
+    for (size_t i = 0; i < originalIds.size(); ++i) {
+      if ((ids >> i) & 1) {
+        translated |= originalIds[i];
+      }
+    }
+    return translated;
+  };
+  AdaptiveJoinTree::Plan plan;
+  plan.tree_ = std::move(result.at(findCheapestExecutionTree(result))._qet);
+  for (const auto& [tree, ids] : newIds) {
+    plan.idsOfSubtrees_[tree] = translate(ids);
+  }
+  return plan;
+}
+
 // _____________________________________________________________________________
 size_t QueryPlanner::countSubgraphs(
     std::vector<const QueryPlanner::SubtreePlan*> graph,
@@ -1518,11 +1701,44 @@ vector<vector<QueryPlanner::SubtreePlan>> QueryPlanner::fillDpTab(
           << "Using the greedy query planner for a large connected component"
           << std::endl;
     }
-    auto impl = useGreedyPlanning
-                    ? &QueryPlanner::runGreedyPlanningOnConnectedComponent
-                    : &QueryPlanner::runDynamicProgrammingOnConnectedComponent;
-    lastDpRowFromComponents.push_back(std::invoke(
-        impl, this, std::move(component), filters, textLimitVec, tg));
+    // The joins of a component can only be re-planned if the component
+    // consists of at least three inputs and doesn't contain filters or text
+    // limits, which would have to be re-planned as well.
+    const double reoptimizationFactor =
+        RuntimeParameters().get<"adaptive-reoptimization-factor">();
+    bool useAdaptivePlanning =
+        reoptimizationFactor > 0.0 && !useGreedyPlanning && filters.empty() &&
+        textLimitVec.empty() && !isInTestMode() &&
+        ql::ranges::all_of(component,
+                           [](const SubtreePlan& plan) {
+                             return plan.type == SubtreePlan::BASIC;
+                           }) &&
+        findUniqueNodeIds(component) >= 3;
+    std::optional<SubtreePlan> leapfrogTriejoin =
+        createLeapfrogTriejoin(component);
+    if (useAdaptivePlanning) {
+      lastDpRowFromComponents.push_back(runAdaptivePlanningOnConnectedComponent(
+          std::move(component), tg, reoptimizationFactor));
+    } else {
+      auto impl =
+          useGreedyPlanning
+              ? &QueryPlanner::runGreedyPlanningOnConnectedComponent
+              : &QueryPlanner::runDynamicProgrammingOnConnectedComponent;
+      lastDpRowFromComponents.push_back(std::invoke(
+          impl, this, std::move(component), filters, textLimitVec, tg));
+    }
+    if (leapfrogTriejoin.has_value()) {
+      std::vector<SubtreePlan> candidates{std::move(leapfrogTriejoin.value())};
+      applyFiltersIfPossible<true>(candidates, filters);
+      applyTextLimitsIfPossible(candidates, textLimitVec, true);
+      // The multiway join is only added if it is strictly cheaper than the
+      // binary joins, s.t. ties are resolved as before.
+      auto& lastRow = lastDpRowFromComponents.back();
+      if (candidates.front().getCostEstimate() <
+          lastRow.at(findCheapestExecutionTree(lastRow)).getCostEstimate()) {
+        lastRow.push_back(std::move(candidates.front()));
+      }
+    }
     checkCancellation();
   }
   size_t numConnectedComponents = lastDpRowFromComponents.size();
@@ -1977,6 +2193,12 @@ std::vector<QueryPlanner::SubtreePlan> QueryPlanner::createJoinCandidates(
     candidates.push_back(std::move(opt.value()));
   }
 
+  // If both inputs would have to be sorted for a `Join`, then a `HashJoin`
+  // might be cheaper.
+  if (auto opt = createHashJoin(a, b, jcs)) {
+    candidates.push_back(std::move(opt.value()));
+  }
+
   // "NORMAL" CASE:
   // The join class takes care of sorting the subtrees if necessary
   SubtreePlan plan =
@@ -1987,6 +2209,41 @@ std::vector<QueryPlanner::SubtreePlan> QueryPlanner::createJoinCandidates(
   return candidates;
 }
 
+// _____________________________________________________________________________
+auto QueryPlanner::createHashJoin(
+    const SubtreePlan& a, const SubtreePlan& b,
+    const std::vector<std::array<ColumnIndex, 2>>& jcs) const
+    -> std::optional<SubtreePlan> {
+  AD_CORRECTNESS_CHECK(jcs.size() == 1);
+  auto isSuitable = [](const SubtreePlan& plan, ColumnIndex joinColumn) {
+    const auto& qet = *plan._qet;
+    auto sortedOn = qet.resultSortedOn();
+    bool isSorted = !sortedOn.empty() && sortedOn.at(0) == joinColumn;
+    return !isSorted &&
+           qet.getVariableAndInfoByColumnIndex(joinColumn)
+                   .second.mightContainUndef_ ==
+               ColumnIndexAndTypeInfo::AlwaysDefined;
+  };
+  if (!isSuitable(a, jcs[0][0]) || !isSuitable(b, jcs[0][1])) {
+    return std::nullopt;
+  }
+  // The smaller input is the build side, which has to fit into the memory.
+  const auto& build =
+      a._qet->getSizeEstimate() <= b._qet->getSizeEstimate() ? a : b;
+  size_t buildSize = build._qet->getSizeEstimate();
+  size_t buildMemory = buildSize * build._qet->getResultWidth() * sizeof(Id);
+  auto maxBuildMemory =
+      RuntimeParameters().get<"hash-join-max-build-side-size">();
+  if (buildSize < RuntimeParameters().get<"hash-join-min-input-size">() ||
+      buildMemory > maxBuildMemory.getBytes()) {
+    return std::nullopt;
+  }
+  SubtreePlan plan =
+      makeSubtreePlan<HashJoin>(_qec, a._qet, b._qet, jcs[0][0], jcs[0][1]);
+  mergeSubtreePlanIds(plan, a, b);
+  return plan;
+}
+
 // _____________________________________________________________________________
 std::pair<bool, bool> QueryPlanner::checkSpatialJoin(const SubtreePlan& a,
                                                      const SubtreePlan& b) {
@@ -2290,6 +2547,38 @@ std::vector<size_t> QueryPlanner::QueryGraph::dfsForAllNodes() {
   return result;
 }
 
+// _____________________________________________________________________________
+bool QueryPlanner::QueryGraph::hasCycleOfVariables(
+    const std::vector<SubtreePlan>& nodes) {
+  // A union-find structure on the variables, where `parent` only contains the
+  // variables that are not the root of their set. Two variables are in the
+  // same set iff they are connected by the nodes seen so far, so a node that
+  // connects two variables of the same set closes a cycle.
+  ad_utility::HashMap<Variable, Variable> parent;
+  auto findRoot = [&parent](Variable variable) {
+    for (auto it = parent.find(variable); it != parent.end();
+         it = parent.find(variable)) {
+      variable = it->second;
+    }
+    return variable;
+  };
+  ad_utility::HashSet<uint64_t> seenNodeIds;
+  for (const auto& node : nodes) {
+    if (!seenNodeIds.insert(node._idsOfIncludedNodes).second) {
+      continue;
+    }
+    const auto& variables = node._qet->getVariableColumns();
+    AD_CONTRACT_CHECK(variables.size() == 2);
+    Variable first = findRoot(variables.begin()->first);
+    Variable second = findRoot(std::next(variables.begin())->first);
+    if (first == second) {
+      return true;
+    }
+    parent.emplace(std::move(first), std::move(second));
+  }
+  return false;
+}
+
 // _______________________________________________________________
 void QueryPlanner::checkCancellation(
     ad_utility::source_location location) const {
@@ -9,6 +9,7 @@
 #include <boost/optional.hpp>
 #include <vector>
 
+#include "engine/AdaptiveJoinTree.h"
 #include "engine/CheckUsePatternTrick.h"
 #include "engine/QueryExecutionTree.h"
 #include "parser/GraphPattern.h"
@@ -190,6 +191,12 @@ class QueryPlanner {
       return graph.dfsForAllNodes();
     }
 
+    // Return true iff the `nodes` form a cycle of variables, when each node is
+    // seen as an edge between its variables. Each node must have exactly two
+    // variables. Nodes with the same `_idsOfIncludedNodes` (alternative plans
+    // for the same triple) are only counted once.
+    static bool hasCycleOfVariables(const std::vector<SubtreePlan>& nodes);
+
    private:
     // The actual implementation of `setupGraph`. First build a
     // graph from the `leafOperations` and then run DFS and return the result.
@@ -226,6 +233,17 @@ class QueryPlanner {
   [[nodiscard]] std::vector<SubtreePlan> createExecutionTrees(
       ParsedQuery& pq, bool isSubquery = false);
 
+  // Plan the joins of the `seeds` (the initial plans of a connected component
+  // without filters and text limits, with the same `_idsOfIncludedNodes` as
+  // during the initial planning), where the `executed` subtrees (the already
+  // computed joins of some of the seeds) are used instead of the seeds that
+  // they contain. Return the cheapest plan, together with the
+  // `_idsOfIncludedNodes` of all its subtrees (in terms of the original
+  // seeds). This is used by the `AdaptiveJoinTree`.
+  AdaptiveJoinTree::Plan replanJoinTree(
+      const std::vector<SubtreePlan>& seeds,
+      const std::vector<AdaptiveJoinTree::ExecutedSubtree>& executed) const;
+
  private:
   QueryExecutionContext* _qec;
 
@@ -351,6 +369,15 @@ class QueryPlanner {
       const SubtreePlan& a, const SubtreePlan& b,
       const std::vector<std::array<ColumnIndex, 2>>& jcs);
 
+  // Used internally by `createJoinCandidates`. If neither `a` nor `b` is
+  // sorted on the (single) join column, if both join columns are always
+  // defined, and if the smaller input is large but fits into the memory budget
+  // (see the runtime parameters `hash-join-...`), then returns a `HashJoin` of
+  // `a` and `b`. Else returns `std::nullopt`.
+  [[nodiscard]] std::optional<SubtreePlan> createHashJoin(
+      const SubtreePlan& a, const SubtreePlan& b,
+      const std::vector<std::array<ColumnIndex, 2>>& jcs) const;
+
   // Helper that returns `true` for each of the subtree plans `a` and `b` iff
   // the subtree plan is a spatial join and it is not yet fully constructed
   // (it does not have both children set)
@@ -476,6 +503,33 @@ class QueryPlanner {
       const vector<SparqlFilter>& filters, const TextLimitVec& textLimits,
       const TripleGraph& tg) const;
 
+  // Implementation of `runDynamicProgrammingOnConnectedComponent`. If
+  // `idsOfSubtrees` is not null, it is filled with the `_idsOfIncludedNodes`
+  // of all the subtrees of the returned plans that join at least two seeds.
+  std::vector<QueryPlanner::SubtreePlan>
+  runDynamicProgrammingOnConnectedComponentImpl(
+      std::vector<SubtreePlan> connectedComponent,
+      const vector<SparqlFilter>& filters, const TextLimitVec& textLimits,
+      const TripleGraph& tg,
+      AdaptiveJoinTree::IdsOfSubtrees* idsOfSubtrees) const;
+
+  // Return a `LeapfrogTriejoin` of the `connectedComponent` if it is cyclic
+  // and consists of at least three `IndexScan`s with two variables each. For
+  // each triple, the scan is chosen whose permutation matches the variable
+  // order of the join, s.t. no sorting is required.
+  std::optional<SubtreePlan> createLeapfrogTriejoin(
+      const std::vector<SubtreePlan>& connectedComponent) const;
+
+  // Plan the joins of the `connectedComponent` with dynamic programming like
+  // `runDynamicProgrammingOnConnectedComponent` and wrap the resulting plans
+  // into an `AdaptiveJoinTree`, which re-plans the joins if the actual sizes
+  // of the intermediate results differ from their estimates by more than the
+  // `reoptimizationFactor` (see `replanJoinTree` below).
+  std::vector<QueryPlanner::SubtreePlan>
+  runAdaptivePlanningOnConnectedComponent(
+      std::vector<SubtreePlan> connectedComponent, const TripleGraph& tg,
+      double reoptimizationFactor) const;
+
   // Same as `runDynamicProgrammingOnConnectedComponent`, but uses a greedy
   // algorithm that always greedily chooses the smallest result of the possible
   // join operations using the "Greedy Operator Ordering (GOO)" algorithm.
@@ -21,6 +21,11 @@ QueryPlanningCostFactors::QueryPlanningCostFactors() : _factors() {
   _factors["HASH_MAP_OPERATION_COST"] = 50.0;
   _factors["JOIN_SIZE_ESTIMATE_CORRECTION_FACTOR"] = 0.7;
   _factors["DUMMY_JOIN_SIZE_ESTIMATE_CORRECTION_FACTOR"] = 0.7;
+  // The cost of inserting a row into the hash map of a `HashJoin` and the cost
+  // of a lookup in this hash map (per row, relative to the cost of a row in a
+  // merge join).
+  _factors["HASH_JOIN_BUILD_COST"] = 4.0;
+  _factors["HASH_JOIN_PROBE_COST"] = 2.0;
 
   // Assume that a random disk seek is 100 times more expensive than an
   // average `O(1)` access to a single ID.
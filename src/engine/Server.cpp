@@ -17,6 +17,7 @@
 #include "engine/QueryPlanner.h"
 #include "engine/SPARQLProtocol.h"
 #include "global/RuntimeParameters.h"
+#include "index/DecompressedBlockCache.h"
 #include "index/IndexImpl.h"
 #include "util/AsioHelpers.h"
 #include "util/MemorySize/MemorySize.h"
@@ -37,14 +38,21 @@ using ad_utility::MediaType;
 // __________________________________________________________________________
 Server::Server(unsigned short port, size_t numThreads,
                ad_utility::MemorySize maxMem, std::string accessToken,
-               bool usePatternTrick)
+               bool usePatternTrick, std::string persistentCacheDirectory)
     : numThreads_(numThreads),
       port_(port),
       accessToken_(std::move(accessToken)),
+      persistentCacheDirectory_(std::move(persistentCacheDirectory)),
       allocator_{ad_utility::makeAllocationMemoryLeftThreadsafeObject(maxMem),
                  [this](ad_utility::MemorySize numMemoryToAllocate) {
-                   cache_.makeRoomAsMuchAsPossible(MAKE_ROOM_SLACK_FACTOR *
-                                                   numMemoryToAllocate);
+                   // The decompressed blocks of the index scans are also
+                   // allocated with this allocator. They are cheaper to
+                   // recompute than query results, so they are evicted first.
+                   auto size = MAKE_ROOM_SLACK_FACTOR * numMemoryToAllocate;
+                   if (!DecompressedBlockCache::get().makeRoomAsMuchAsPossible(
+                           size)) {
+                     cache_.makeRoomAsMuchAsPossible(size);
+                   }
                  }},
       index_{allocator_},
       enablePatternTrick_(usePatternTrick),
@@ -61,11 +69,21 @@ Server::Server(unsigned short port, size_t numThreads,
       [this](ad_utility::MemorySize newValue) {
         cache_.setMaxSizeSingleEntry(newValue);
       });
+  RuntimeParameters().setOnUpdateAction<"cache-eviction-policy">(
+      [this](const std::string& newValue) {
+        cache_.setEvictionPolicy(
+            ad_utility::cacheEvictionPolicyFromString(newValue));
+      });
+  RuntimeParameters().setOnUpdateAction<"decompressed-block-cache-max-size">(
+      [](ad_utility::MemorySize newValue) {
+        DecompressedBlockCache::get().setMaxSize(newValue);
+      });
 }
 
 // __________________________________________________________________________
 void Server::initialize(const string& indexBaseName, bool useText,
-                        bool usePatterns, bool loadAllPermutations) {
+                        bool usePatterns, bool loadAllPermutations,
+                        bool persistUpdates) {
   LOG(INFO) << "Initializing server ..." << std::endl;
 
   index_.usePatterns() = usePatterns;
@@ -77,6 +95,23 @@ void Server::initialize(const string& indexBaseName, bool useText,
     index_.addTextFromOnDiskIndex();
   }
 
+  // The persistent cache needs the ID of the index to recognize its results.
+  if (!persistentCacheDirectory_.empty()) {
+    persistentCache_ = std::make_shared<PersistentResultCache>(
+        persistentCacheDirectory_, index_.getIndexId(), allocator_);
+    cache_.setSecondLevelCache(persistentCache_);
+    LOG(INFO) << "Results of the cache are persisted in \""
+              << persistentCacheDirectory_ << "\"" << std::endl;
+  }
+
+  // Restore the updates from previous runs of the server. This has to happen
+  // after the index has been loaded (the original block metadata of the
+  // permutations is required to locate the updated triples).
+  if (persistUpdates) {
+    index_.deltaTriplesManager().enableWriteAheadLog(
+        absl::StrCat(indexBaseName, DELTA_TRIPLES_WRITE_AHEAD_LOG_SUFFIX));
+  }
+
   sortPerformanceEstimator_.computeEstimatesExpensively(
       allocator_, index_.numTriples().normalAndInternal_() *
                       PERCENTAGE_OF_TRIPLES_FOR_SORT_ESTIMATE / 100);
@@ -87,7 +122,7 @@ void Server::initialize(const string& indexBaseName, bool useText,
 
 // _____________________________________________________________________________
 void Server::run(const string& indexBaseName, bool useText, bool usePatterns,
-                 bool loadAllPermutations) {
+                 bool loadAllPermutations, bool persistUpdates) {
   using namespace ad_utility::httpUtils;
 
   // Function that handles a request asynchronously, will be passed as argument
@@ -162,7 +197,8 @@ void Server::run(const string& indexBaseName, bool useText, bool usePatterns,
                                std::move(webSocketSessionSupplier)};
 
   // Initialize the index
-  initialize(indexBaseName, useText, usePatterns, loadAllPermutations);
+  initialize(indexBaseName, useText, usePatterns, loadAllPermutations,
+             persistUpdates);
 
   LOG(INFO) << "The server is ready, listening for requests on port "
             << std::to_string(httpServer.getPort()) << " ..." << std::endl;
@@ -284,6 +320,7 @@ Awaitable<void> Server::process(
     requireValidAccessToken("clear-cache-complete");
     logCommand(cmd, "clear cache completely (including unpinned elements)");
     cache_.clearAll();
+    DecompressedBlockCache::get().clear();
     response = createJsonResponse(composeCacheStatsJson(), request);
   } else if (auto cmd = checkParameter("cmd", "clear-delta-triples")) {
     requireValidAccessToken("clear-delta-triples");
@@ -625,6 +662,20 @@ nlohmann::json Server::composeCacheStatsJson() const {
   // converter.
   result["non-pinned-size"] = cache_.nonPinnedSize().getBytes();
   result["pinned-size"] = cache_.pinnedSize().getBytes();
+  result["eviction-policy"] = ad_utility::toString(cache_.getEvictionPolicy());
+  result["num-hits"] = cache_.numHits();
+  result["num-misses"] = cache_.numMisses();
+  result["num-evictions"] = cache_.numEvictions();
+  result["evicted-cost-ms"] = cache_.evictedCost();
+  // The statistics of the cache of decompressed blocks of the permutations.
+  auto blockCache = DecompressedBlockCache::get().getStatistics();
+  result["block-cache-num-entries"] = blockCache.numEntries_;
+  result["block-cache-size"] = blockCache.size_.getBytes();
+  result["block-cache-max-size"] = blockCache.maxSize_.getBytes();
+  result["block-cache-num-hits"] = blockCache.numHits_;
+  result["block-cache-num-misses"] = blockCache.numMisses_;
+  result["block-cache-hit-rate"] = blockCache.hitRate();
+  result["block-cache-bytes-saved"] = blockCache.numBytesSaved_;
   return result;
 }
 
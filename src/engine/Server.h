@@ -12,6 +12,7 @@
 
 #include "ExecuteUpdate.h"
 #include "engine/Engine.h"
+#include "engine/PersistentResultCache.h"
 #include "engine/QueryExecutionContext.h"
 #include "engine/QueryExecutionTree.h"
 #include "engine/SortPerformanceEstimator.h"
@@ -42,22 +43,28 @@ class Server {
   FRIEND_TEST(ServerTest, createMessageSender);
 
  public:
+  // If the `persistentCacheDirectory` is not empty, then results of the cache
+  // are additionally stored in that directory and survive a restart of the
+  // server (see `PersistentResultCache`).
   explicit Server(unsigned short port, size_t numThreads,
                   ad_utility::MemorySize maxMem, std::string accessToken,
-                  bool usePatternTrick = true);
+                  bool usePatternTrick = true,
+                  std::string persistentCacheDirectory = "");
 
   virtual ~Server() = default;
 
  private:
-  //! Initialize the server.
+  //! Initialize the server. If `persistUpdates` is true, the updates are
+  //! restored from and written to a write-ahead log next to the index files.
   void initialize(const string& indexBaseName, bool useText,
-                  bool usePatterns = true, bool loadAllPermutations = true);
+                  bool usePatterns = true, bool loadAllPermutations = true,
+                  bool persistUpdates = false);
 
  public:
   //! First initialize the server. Then loop, wait for requests and trigger
   //! processing. This method never returns except when throwing an exception.
   void run(const string& indexBaseName, bool useText, bool usePatterns = true,
-           bool loadAllPermutations = true);
+           bool loadAllPermutations = true, bool persistUpdates = false);
 
   Index& index() { return index_; }
   const Index& index() const { return index_; }
@@ -73,6 +80,8 @@ class Server {
   unsigned short port_;
   std::string accessToken_;
   QueryResultCache cache_;
+  std::string persistentCacheDirectory_;
+  std::shared_ptr<PersistentResultCache> persistentCache_;
   ad_utility::AllocatorWithLimit<Id> allocator_;
   SortPerformanceEstimator sortPerformanceEstimator_;
   Index index_;
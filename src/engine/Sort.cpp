@@ -9,6 +9,7 @@
 
 #include "engine/CallFixedSize.h"
 #include "engine/Engine.h"
+#include "engine/ExternalSort.h"
 #include "engine/QueryExecutionTree.h"
 #include "global/RuntimeParameters.h"
 
@@ -51,26 +52,69 @@ std::string Sort::getDescriptor() const {
 }
 
 // _____________________________________________________________________________
-ProtoResult Sort::computeResult([[maybe_unused]] bool requestLaziness) {
+ProtoResult Sort::computeResult(bool requestLaziness) {
   using std::endl;
   LOG(DEBUG) << "Getting sub-result for Sort result computation..." << endl;
-  std::shared_ptr<const Result> subRes = subtree_->getResult();
+  std::shared_ptr<const Result> subRes = subtree_->getResult(requestLaziness);
+
+  // Sort the `input` externally by the internal order of the IDs in the
+  // `sortColumnIndices_` (like `Engine::sort`) and return the lazy result.
+  auto sortExternally = [this](externalSort::SortInput input) -> ProtoResult {
+    auto comparator = [sortColumns = sortColumnIndices_](const auto& row1,
+                                                         const auto& row2) {
+      for (ColumnIndex column : sortColumns) {
+        if (row1[column] != row2[column]) {
+          return row1[column] < row2[column];
+        }
+      }
+      return false;
+    };
+    LOG(DEBUG) << "Sorting the input of the Sort externally..." << endl;
+    runtimeInfo().addDetail("external-sort", true);
+    return {externalSort::sortExternally(
+                std::move(input), std::move(comparator),
+                getSpillFilename(getIndex(), "external-sort"),
+                cancellationHandle_),
+            resultSortedOn()};
+  };
+
+  if (!subRes->isFullyMaterialized()) {
+    auto input = externalSort::readLazyInput(std::move(subRes),
+                                             getResultWidth(), allocator());
+    if (!input.isCompletelyRead()) {
+      return sortExternally(std::move(input));
+    }
+    sortInMemory(input.readRows_);
+    return {std::move(input.readRows_), resultSortedOn(),
+            std::move(input.localVocab_)};
+  }
 
-  // TODO<joka921> proper timeout for sorting operations
   const auto& subTable = subRes->idTable();
-  getExecutionContext()->getSortPerformanceEstimator().throwIfEstimateTooLong(
-      subTable.numRows(), subTable.numColumns(), deadline_, "Sort operation");
+  if (requestLaziness && externalSort::isTooLargeForSortInMemory(
+                             subTable.numRows(), subTable.numColumns(),
+                             allocator())) {
+    return sortExternally({subRes, IdTable{getResultWidth(), allocator()},
+                           subRes->localVocab().clone()});
+  }
 
   LOG(DEBUG) << "Sort result computation..." << endl;
   ad_utility::Timer t{ad_utility::timer::Timer::InitialStatus::Started};
-  IdTable idTable = subRes->idTable().clone();
+  IdTable idTable = subTable.clone();
   runtimeInfo().addDetail("time-cloning", t.msecs());
+  sortInMemory(idTable);
+
+  LOG(DEBUG) << "Sort result computation done." << endl;
+  return {std::move(idTable), resultSortedOn(), subRes->getSharedLocalVocab()};
+}
+
+// _____________________________________________________________________________
+void Sort::sortInMemory(IdTable& idTable) {
+  // TODO<joka921> proper timeout for sorting operations
+  getExecutionContext()->getSortPerformanceEstimator().throwIfEstimateTooLong(
+      idTable.numRows(), idTable.numColumns(), deadline_, "Sort operation");
   Engine::sort(idTable, sortColumnIndices_);
 
   // Don't report missed timeout check because sort is not cancellable
   cancellationHandle_->resetWatchDogState();
   checkCancellation();
-
-  LOG(DEBUG) << "Sort result computation done." << endl;
-  return {std::move(idTable), resultSortedOn(), subRes->getSharedLocalVocab()};
 }
@@ -42,6 +42,10 @@ class Sort : public Operation {
     return subtree_->getMultiplicity(col);
   }
 
+  const ValueHistogram* getValueHistogram(size_t col) const override {
+    return subtree_->getRootOperation()->getValueHistogram(col);
+  }
+
   std::shared_ptr<QueryExecutionTree> getSubtree() const { return subtree_; }
 
   virtual size_t getCostEstimate() override {
@@ -67,8 +71,11 @@ class Sort : public Operation {
   }
 
  private:
-  virtual ProtoResult computeResult(
-      [[maybe_unused]] bool requestLaziness) override;
+  virtual ProtoResult computeResult(bool requestLaziness) override;
+
+  // Sort the `idTable` in RAM (by the internal order of the IDs in the
+  // `sortColumnIndices_`).
+  void sortInMemory(IdTable& idTable);
 
   [[nodiscard]] VariableToColumnMap computeVariableToColumnMap()
       const override {
@@ -0,0 +1,34 @@
+//  Copyright 2025, University of Freiburg,
+//                  Chair of Algorithms and Data Structures.
+
+#pragma once
+
+#include <absl/strings/str_cat.h>
+
+#include <atomic>
+#include <filesystem>
+#include <string>
+#include <string_view>
+
+#include "global/RuntimeParameters.h"
+#include "index/Index.h"
+
+// Return a filename for a temporary file of an operation that writes parts of
+// its input to disk (for example the external sort or the hash map GROUP BY),
+// such that concurrent operations on the same `index` use different files. The
+// `kind` is part of the filename and identifies the operation. The file is
+// placed in the directory that is given by the runtime parameter
+// `spill-directory`, or next to the files of the `index` if this parameter is
+// empty.
+inline std::string getSpillFilename(const Index& index, std::string_view kind) {
+  static std::atomic<size_t> counter = 0;
+  const std::string& onDiskBase = index.getOnDiskBase();
+  auto directory = RuntimeParameters().get<"spill-directory">();
+  if (directory.empty()) {
+    return absl::StrCat(onDiskBase, ".", kind, ".", counter++, ".dat");
+  }
+  auto basename = std::filesystem::path{onDiskBase}.filename().string();
+  return (std::filesystem::path{directory} /
+          absl::StrCat(basename, ".", kind, ".", counter++, ".dat"))
+      .string();
+}
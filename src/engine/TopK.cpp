@@ -0,0 +1,133 @@
+//  Copyright 2025, University of Freiburg,
+//                  Chair of Algorithms and Data Structures.
+
+#include "engine/TopK.h"
+
+#include <absl/strings/str_cat.h>
+
+#include <algorithm>
+#include <span>
+
+#include "engine/CallFixedSize.h"
+#include "engine/Engine.h"
+#include "util/TransparentFunctors.h"
+
+namespace {
+// A fully materialized input is processed in chunks of at least this many
+// rows, s.t. the memory consumption stays at O(k) also in that case.
+constexpr size_t MIN_CHUNK_SIZE = 100'000;
+}  // namespace
+
+// _____________________________________________________________________________
+size_t TopK::getResultWidth() const { return subtree_->getResultWidth(); }
+
+// _____________________________________________________________________________
+TopK::TopK(QueryExecutionContext* qec,
+           std::shared_ptr<QueryExecutionTree> subtree, SortIndices sortIndices)
+    : Operation{qec},
+      subtree_{std::move(subtree)},
+      sortIndices_{std::move(sortIndices)} {
+  AD_CONTRACT_CHECK(!sortIndices_.empty());
+  AD_CONTRACT_CHECK(ql::ranges::all_of(
+      sortIndices_,
+      [this](ColumnIndex index) { return index < getResultWidth(); },
+      ad_utility::first));
+}
+
+// _____________________________________________________________________________
+std::string TopK::getCacheKeyImpl() const {
+  std::string result = "TOP K ORDER BY on columns:";
+  for (auto [column, isDescending] : sortIndices_) {
+    absl::StrAppend(&result, isDescending ? "desc(" : "asc(", column, ") ");
+  }
+  absl::StrAppend(&result, "\n", subtree_->getCacheKey());
+  return result;
+}
+
+// _____________________________________________________________________________
+std::string TopK::getDescriptor() const {
+  std::string orderByVars;
+  for (const auto& [variable, ascOrDesc] : getSortedVariables()) {
+    using enum OrderBy::AscOrDesc;
+    absl::StrAppend(&orderByVars, ascOrDesc == Desc ? " DESC(" : " ASC(",
+                    variable.name(), ")");
+  }
+  return absl::StrCat("TopK on", orderByVars);
+}
+
+// _____________________________________________________________________________
+OrderBy::SortedVariables TopK::getSortedVariables() const {
+  OrderBy::SortedVariables result;
+  for (const auto& [colIdx, isDescending] : sortIndices_) {
+    using enum OrderBy::AscOrDesc;
+    result.emplace_back(subtree_->getVariableAndInfoByColumnIndex(colIdx).first,
+                        isDescending ? Desc : Asc);
+  }
+  return result;
+}
+
+// _____________________________________________________________________________
+template <size_t WIDTH>
+void TopK::keepTopRows(IdTable& idTable, size_t k) const {
+  if (idTable.numRows() <= k) {
+    return;
+  }
+  IdTableStatic<WIDTH> table = std::move(idTable).toStatic<WIDTH>();
+  std::nth_element(table.begin(), table.begin() + k, table.end(),
+                   OrderBy::makeComparator(sortIndices_));
+  table.resize(k);
+  idTable = std::move(table).toDynamic();
+}
+
+// _____________________________________________________________________________
+ProtoResult TopK::computeResult([[maybe_unused]] bool requestLaziness) {
+  LOG(DEBUG) << "Getting sub-result for TopK result computation..."
+             << std::endl;
+  std::shared_ptr<const Result> subRes = subtree_->getResult(true);
+
+  // The rows before the `OFFSET` also have to be computed to know which rows
+  // come after it.
+  const auto& limit = getLimit();
+  const size_t k = limit.upperBound(std::numeric_limits<uint64_t>::max());
+  IdTable result{getResultWidth(), allocator()};
+  LocalVocab localVocab;
+
+  ad_utility::callFixedSize(getResultWidth(), [&]<size_t I>() {
+    // Append the rows `[begin, end)` of the `block` to the `result`, and reduce
+    // the `result` to its `k` best rows as soon as it has more than `2 * k`
+    // rows. This amortizes the linear cost of `keepTopRows`.
+    auto addRows = [&](const IdTable& block, size_t begin, size_t end) {
+      result.insertAtEnd(block, begin, end);
+      if (result.numRows() / 2 > k) {
+        keepTopRows<I>(result, k);
+      }
+      checkCancellation();
+    };
+    if (subRes->isFullyMaterialized()) {
+      const IdTable& input = subRes->idTable();
+      size_t chunkSize = std::max(k, MIN_CHUNK_SIZE);
+      size_t begin = 0;
+      while (begin < input.numRows()) {
+        size_t end = begin + std::min(chunkSize, input.numRows() - begin);
+        addRows(input, begin, end);
+        begin = end;
+      }
+      localVocab = subRes->localVocab().clone();
+    } else {
+      for (auto& [block, blockVocab] : subRes->idTables()) {
+        addRows(block, 0, block.numRows());
+        localVocab.mergeWith(std::span{&blockVocab, 1});
+      }
+    }
+    keepTopRows<I>(result, k);
+    Engine::sort<I>(&result, OrderBy::makeComparator(sortIndices_));
+  });
+  // We can't check during sort, so reset status here
+  cancellationHandle_->resetWatchDogState();
+  checkCancellation();
+
+  result.erase(result.begin(),
+               result.begin() + limit.actualOffset(result.numRows()));
+  LOG(DEBUG) << "TopK result computation done." << std::endl;
+  return {std::move(result), resultSortedOn(), std::move(localVocab)};
+}
@@ -0,0 +1,82 @@
+//  Copyright 2025, University of Freiburg,
+//                  Chair of Algorithms and Data Structures.
+
+#pragma once
+
+#include <vector>
+
+#include "engine/Operation.h"
+#include "engine/OrderBy.h"
+#include "engine/QueryExecutionTree.h"
+
+// The implementation of a SPARQL `ORDER BY` that is directly followed by a
+// `LIMIT` (and possibly an `OFFSET`). The result is the same as that of an
+// `OrderBy` with the same `sortIndices` and the same limit, but instead of
+// sorting its complete input, this operation only keeps the best
+// `LIMIT + OFFSET` rows seen so far. It thus requires only
+// O(LIMIT + OFFSET) memory and consumes a lazy input block by block.
+class TopK : public Operation {
+ public:
+  using SortIndices = OrderBy::SortIndices;
+
+ private:
+  std::shared_ptr<QueryExecutionTree> subtree_;
+  SortIndices sortIndices_;
+
+ public:
+  TopK(QueryExecutionContext* qec, std::shared_ptr<QueryExecutionTree> subtree,
+       SortIndices sortIndices);
+
+ protected:
+  string getCacheKeyImpl() const override;
+
+ public:
+  string getDescriptor() const override;
+
+  // Just like for `OrderBy`, the result is sorted `semantically`, which is
+  // different from the `internal` order of the IDs.
+  std::vector<ColumnIndex> resultSortedOn() const override { return {}; }
+
+  // Expose the variables on which this TopK is performed. Currently mostly
+  // used for testing.
+  OrderBy::SortedVariables getSortedVariables() const;
+
+  // The `LIMIT` and `OFFSET` are the whole point of this operation.
+  bool supportsLimit() const override { return true; }
+
+ private:
+  uint64_t getSizeEstimateBeforeLimit() override {
+    return subtree_->getSizeEstimate();
+  }
+
+ public:
+  float getMultiplicity(size_t col) override {
+    return subtree_->getMultiplicity(col);
+  }
+
+  // Every row of the input is compared with a constant number of rows on
+  // average, so the cost is linear in the size of the input.
+  size_t getCostEstimate() override {
+    return getSizeEstimateBeforeLimit() + subtree_->getCostEstimate();
+  }
+
+  bool knownEmptyResult() override { return subtree_->knownEmptyResult(); }
+
+  size_t getResultWidth() const override;
+
+  vector<QueryExecutionTree*> getChildren() override {
+    return {subtree_.get()};
+  }
+
+ private:
+  ProtoResult computeResult(bool requestLaziness) override;
+
+  // Reduce the `idTable` to its `k` best rows (which afterwards are in no
+  // particular order).
+  template <size_t WIDTH>
+  void keepTopRows(IdTable& idTable, size_t k) const;
+
+  VariableToColumnMap computeVariableToColumnMap() const override {
+    return subtree_->getVariableColumns();
+  }
+};
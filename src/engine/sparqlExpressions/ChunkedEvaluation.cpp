@@ -0,0 +1,42 @@
+//  Copyright 2025, University of Freiburg,
+//                  Chair of Algorithms and Data Structures.
+
+#include "engine/sparqlExpressions/ChunkedEvaluation.h"
+
+#include <absl/cleanup/cleanup.h>
+
+#include <algorithm>
+
+namespace sparqlExpression {
+
+// _____________________________________________________________________________
+bool canBeEvaluatedInChunks(const SparqlExpression& expression) {
+  return !expression.containsAggregate();
+}
+
+// _____________________________________________________________________________
+void evaluateInChunks(const SparqlExpression& expression,
+                      EvaluationContext* context, size_t chunkSize,
+                      const ChunkConsumer& consumer) {
+  const size_t beginIndex = context->_beginIndex;
+  const size_t endIndex = context->_endIndex;
+  if (chunkSize == 0 || !canBeEvaluatedInChunks(expression)) {
+    chunkSize = std::max<size_t>(endIndex - beginIndex, 1);
+  }
+  absl::Cleanup restoreRange{[context, beginIndex, endIndex]() {
+    context->_beginIndex = beginIndex;
+    context->_endIndex = endIndex;
+  }};
+  // Note: An empty range is also evaluated (as a single empty chunk), s.t. the
+  // `consumer` is called at least once.
+  size_t chunkBegin = beginIndex;
+  do {
+    size_t chunkEnd = std::min(endIndex, chunkBegin + chunkSize);
+    context->_beginIndex = chunkBegin;
+    context->_endIndex = chunkEnd;
+    consumer(expression.evaluate(context), chunkBegin, chunkEnd);
+    chunkBegin = chunkEnd;
+  } while (chunkBegin < endIndex);
+}
+
+}  // namespace sparqlExpression
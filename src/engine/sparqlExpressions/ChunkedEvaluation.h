@@ -0,0 +1,42 @@
+//  Copyright 2025, University of Freiburg,
+//                  Chair of Algorithms and Data Structures.
+
+#pragma once
+
+#include <functional>
+
+#include "engine/sparqlExpressions/SparqlExpression.h"
+
+// Chunked evaluation of expression trees.
+//
+// The evaluation of an expression materializes the complete result of each
+// node of the tree before its parent consumes it. For a large input, for
+// example `FILTER(?a * 2 + ?b > 10 && ?c < 5)`, this allocates several
+// intermediate columns with one entry per row of the input, which are much
+// larger than the CPU caches. The functions in this file instead evaluate the
+// complete tree on one chunk of rows after the other. The intermediate results
+// then only have the size of a chunk, s.t. they stay in the L1/L2 cache from
+// the moment they are written by a child until they are read by its parent.
+namespace sparqlExpression {
+
+// Return true if the result of the `expression` for a row only depends on this
+// row (and not on the other rows of the input), s.t. the `expression` can be
+// evaluated chunk by chunk. This is the case iff the `expression` contains no
+// aggregates.
+bool canBeEvaluatedInChunks(const SparqlExpression& expression);
+
+// Evaluate the `expression` on the rows `[context->_beginIndex,
+// context->_endIndex)` in chunks of (at most) `chunkSize` rows. For each chunk,
+// `consumer(result, chunkBegin, chunkEnd)` is called, where `result` is the
+// result of the `expression` for the rows `[chunkBegin, chunkEnd)` of the
+// input table. If the `expression` can't be evaluated in chunks (see above) or
+// if `chunkSize` is zero, the complete range is evaluated as a single chunk.
+// The range of the `context` is the same as before when this function returns.
+using ChunkConsumer =
+    std::function<void(ExpressionResult result, size_t chunkBegin,
+                       size_t chunkEnd)>;
+void evaluateInChunks(const SparqlExpression& expression,
+                      EvaluationContext* context, size_t chunkSize,
+                      const ChunkConsumer& consumer);
+
+}  // namespace sparqlExpression
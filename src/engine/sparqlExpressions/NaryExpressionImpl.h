@@ -8,6 +8,7 @@
 
 #include "engine/sparqlExpressions/SparqlExpressionGenerators.h"
 #include "engine/sparqlExpressions/SparqlExpressionValueGetters.h"
+#include "engine/sparqlExpressions/VectorizedKernels.h"
 #include "util/CryptographicHashUtils.h"
 
 namespace sparqlExpression::detail {
@@ -44,6 +45,17 @@ class NaryExpression : public SparqlExpression {
     return pos < N ? std::make_optional(children_[pos].get()) : std::nullopt;
   }
 
+ protected:
+  // Evaluate all the children of this expression.
+  std::array<ExpressionResult, N> evaluateChildren(
+      EvaluationContext* context) const;
+
+  // Evaluate this expression, given the results of its children (as computed
+  // by `evaluateChildren`).
+  static ExpressionResult evaluateOnChildResults(
+      std::array<ExpressionResult, N> resultsOfChildren,
+      EvaluationContext* context);
+
  private:
   // _________________________________________________________________________
   std::span<SparqlExpression::Ptr> childrenImpl() override;
@@ -152,10 +164,28 @@ template <typename NaryOperation>
 requires(isOperation<NaryOperation>)
 ExpressionResult NaryExpression<NaryOperation>::evaluate(
     EvaluationContext* context) const {
-  auto resultsOfChildren = ad_utility::applyFunctionToEachElementOfTuple(
-      [context](const auto& child) { return child->evaluate(context); },
+  return evaluateOnChildResults(evaluateChildren(context), context);
+}
+
+// _____________________________________________________________________________
+template <typename NaryOperation>
+requires(isOperation<NaryOperation>)
+auto NaryExpression<NaryOperation>::evaluateChildren(
+    EvaluationContext* context) const -> std::array<ExpressionResult, N> {
+  // Note: The elements of a braced initializer list are evaluated in order.
+  return std::apply(
+      [context](const auto&... children) {
+        return std::array<ExpressionResult, N>{children->evaluate(context)...};
+      },
       children_);
+}
 
+// _____________________________________________________________________________
+template <typename NaryOperation>
+requires(isOperation<NaryOperation>)
+ExpressionResult NaryExpression<NaryOperation>::evaluateOnChildResults(
+    std::array<ExpressionResult, N> resultsOfChildren,
+    EvaluationContext* context) {
   // Bind the `evaluateOnChildrenOperands` to a lambda.
   auto evaluateOnChildOperandsAsLambda = [](auto&&... args) {
     return evaluateOnChildrenOperands(AD_FWD(args)...);
@@ -190,6 +220,36 @@ requires(isOperation<Op>) [[nodiscard]] string NaryExpression<Op>::getCacheKey(
   return key;
 }
 
+// A binary `NaryExpression` that is evaluated via the vectorized kernel for
+// the `VectorizedOperation` (see `VectorizedKernels.h`) if the results of both
+// children are columns or constants of `Id`s with suitable datatypes, and via
+// the generic `NaryOperation` else.
+template <vectorized::BinaryOperation VectorizedOperation,
+          typename NaryOperation>
+requires(isOperation<NaryOperation> && NaryOperation::N == 2)
+class VectorizedBinaryExpression : public NaryExpression<NaryOperation> {
+ public:
+  using NaryExpression<NaryOperation>::NaryExpression;
+
+  // _________________________________________________________________________
+  ExpressionResult evaluate(EvaluationContext* context) const override {
+    auto resultsOfChildren = this->evaluateChildren(context);
+    auto kernel = [](const auto& a, const auto& b, std::span<Id> result) {
+      return vectorized::evaluateBinaryOperation(VectorizedOperation, a, b,
+                                                 result);
+    };
+    auto vectorizedResult = std::visit(
+        [&kernel, context](const auto& a, const auto& b) {
+          return vectorized::evaluateKernel(kernel, a, b, context);
+        },
+        resultsOfChildren[0], resultsOfChildren[1]);
+    if (vectorizedResult.has_value()) {
+      return std::move(vectorizedResult.value());
+    }
+    return this->evaluateOnChildResults(std::move(resultsOfChildren), context);
+  }
+};
+
 // Define a class `Name` that is a strong typedef (via inheritance) from
 // `NaryExpresssion<N, X, ...>`. The strong typedef (vs. a simple `using`
 // declaration) is used to improve compiler messages as the resulting class has
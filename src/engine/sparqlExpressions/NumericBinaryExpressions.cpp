@@ -8,8 +8,9 @@ namespace sparqlExpression {
 namespace detail {
 // Multiplication.
 inline auto multiply = makeNumericExpression<std::multiplies<>>();
-NARY_EXPRESSION(MultiplyExpression, 2,
-                FV<decltype(multiply), NumericValueGetter>);
+using MultiplyExpression = VectorizedBinaryExpression<
+    vectorized::BinaryOperation::Multiply,
+    Operation<2, FV<decltype(multiply), NumericValueGetter>>>;
 
 // Division.
 //
@@ -24,15 +25,20 @@ NARY_EXPRESSION(MultiplyExpression, 2,
   return static_cast<double>(x) / static_cast<double>(y);
 };
 inline auto divide = makeNumericExpression<decltype(divideImpl)>();
-NARY_EXPRESSION(DivideExpression, 2, FV<decltype(divide), NumericValueGetter>);
+using DivideExpression = VectorizedBinaryExpression<
+    vectorized::BinaryOperation::Divide,
+    Operation<2, FV<decltype(divide), NumericValueGetter>>>;
 
 // Addition and subtraction, currently all results are converted to double.
 inline auto add = makeNumericExpression<std::plus<>>();
-NARY_EXPRESSION(AddExpression, 2, FV<decltype(add), NumericValueGetter>);
+using AddExpression = VectorizedBinaryExpression<
+    vectorized::BinaryOperation::Add,
+    Operation<2, FV<decltype(add), NumericValueGetter>>>;
 
 inline auto subtract = makeNumericExpression<std::minus<>>();
-NARY_EXPRESSION(SubtractExpression, 2,
-                FV<decltype(subtract), NumericValueGetter>);
+using SubtractExpression = VectorizedBinaryExpression<
+    vectorized::BinaryOperation::Subtract,
+    Operation<2, FV<decltype(subtract), NumericValueGetter>>>;
 
 // _____________________________________________________________________________
 // Power.
@@ -314,11 +320,15 @@ constexpr auto getMergeFunction(bool isNegated) {
 }  // namespace
 
 //______________________________________________________________________________
-template <typename BinaryPrefilterExpr, typename NaryOperation>
+template <typename BinaryPrefilterExpr,
+          vectorized::BinaryOperation VectorizedOperation,
+          typename NaryOperation>
 requires isOperation<NaryOperation>
-class LogicalBinaryExpressionImpl : public NaryExpression<NaryOperation> {
+class LogicalBinaryExpressionImpl
+    : public VectorizedBinaryExpression<VectorizedOperation, NaryOperation> {
  public:
-  using NaryExpression<NaryOperation>::NaryExpression;
+  using VectorizedBinaryExpression<VectorizedOperation,
+                                   NaryOperation>::VectorizedBinaryExpression;
 
   std::vector<PrefilterExprVariablePair> getPrefilterExpressionForMetadata(
       bool isNegated) const override {
@@ -338,12 +348,12 @@ class LogicalBinaryExpressionImpl : public NaryExpression<NaryOperation> {
 
 //______________________________________________________________________________
 using AndExpression = constructPrefilterExpr::LogicalBinaryExpressionImpl<
-    prefilterExpressions::AndExpression,
+    prefilterExpressions::AndExpression, vectorized::BinaryOperation::And,
     Operation<2, FV<decltype(andLambda), EffectiveBooleanValueGetter>,
               SET<SetOfIntervals::Intersection>>>;
 
 using OrExpression = constructPrefilterExpr::LogicalBinaryExpressionImpl<
-    prefilterExpressions::OrExpression,
+    prefilterExpressions::OrExpression, vectorized::BinaryOperation::Or,
     Operation<2, FV<decltype(orLambda), EffectiveBooleanValueGetter>,
               SET<SetOfIntervals::Union>>>;
 
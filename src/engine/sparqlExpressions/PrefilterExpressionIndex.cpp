@@ -4,6 +4,7 @@
 
 #include "engine/sparqlExpressions/PrefilterExpressionIndex.h"
 
+#include <functional>
 #include <ranges>
 
 #include "global/ValueIdComparators.h"
@@ -153,6 +154,27 @@ static std::string getRelationalOpStr(const CompOp relOp) {
   }
 }
 
+//______________________________________________________________________________
+// Return the comparator (e.g. `std::less`) that corresponds to the `CompOp`.
+template <CompOp Comparison>
+static constexpr auto getComparator() {
+  using enum CompOp;
+  if constexpr (Comparison == LT) {
+    return std::less<>{};
+  } else if constexpr (Comparison == LE) {
+    return std::less_equal<>{};
+  } else if constexpr (Comparison == EQ) {
+    return std::equal_to<>{};
+  } else if constexpr (Comparison == NE) {
+    return std::not_equal_to<>{};
+  } else if constexpr (Comparison == GE) {
+    return std::greater_equal<>{};
+  } else {
+    static_assert(Comparison == GT);
+    return std::greater<>{};
+  }
+}
+
 //______________________________________________________________________________
 // Return `LogicalOperator`s as string.
 static std::string getLogicalOpStr(const LogicalOperator logOp) {
@@ -176,7 +198,7 @@ std::vector<BlockMetadata> PrefilterExpression::evaluate(
     return evaluateAndCheckImpl(input, evaluationColumn);
   }
   if (input.size() < 3) {
-    return std::vector<BlockMetadata>(input.begin(), input.end());
+    return evaluateOnColumnSummaries(input, evaluationColumn);
   }
 
   std::optional<BlockMetadata> firstBlock = std::nullopt;
@@ -197,9 +219,70 @@ std::vector<BlockMetadata> PrefilterExpression::evaluate(
   if (lastBlock.has_value()) {
     result.push_back(lastBlock.value());
   }
-  return result;
+  return evaluateOnColumnSummaries(result, evaluationColumn);
 };
 
+// _____________________________________________________________________________
+std::vector<BlockMetadata> PrefilterExpression::evaluateOnColumnSummaries(
+    std::span<const BlockMetadata> input, size_t evaluationColumn) const {
+  AD_CONTRACT_CHECK(evaluationColumn < 3);
+  std::vector<ColumnSummary> summaries;
+  for (const BlockMetadata& block : input) {
+    if (block.columnSummaries_.has_value()) {
+      summaries.push_back(block.columnSummaries_.value()[evaluationColumn]);
+    }
+  }
+  auto isRelevant = mayContainRelevantIds(summaries);
+  std::vector<BlockMetadata> result;
+  result.reserve(input.size());
+  auto isRelevantIt = isRelevant.begin();
+  for (const BlockMetadata& block : input) {
+    if (!block.columnSummaries_.has_value() || *isRelevantIt++) {
+      result.push_back(block);
+    }
+  }
+  return result;
+}
+
+// _____________________________________________________________________________
+double PrefilterExpression::estimateSelectivity(
+    const ValueHistogram& histogram) const {
+  const auto& buckets = histogram.buckets();
+  std::vector<ColumnSummary> summaries;
+  std::vector<ValueId> boundaries;
+  uint64_t numValuesTotal = 0;
+  for (const auto& bucket : buckets) {
+    summaries.push_back(bucket.summary_);
+    boundaries.push_back(bucket.summary_.min_);
+    boundaries.push_back(bucket.summary_.max_);
+    numValuesTotal += bucket.numValues_;
+  }
+  if (numValuesTotal == 0) {
+    return 1.0;
+  }
+  auto mayBeRelevant = mayContainRelevantIds(summaries);
+  auto boundaryIsRelevant = evaluateOnIds(boundaries);
+  double numRelevantValues = 0;
+  for (size_t i = 0; i < buckets.size(); ++i) {
+    if (!mayBeRelevant[i]) {
+      continue;
+    }
+    const auto& bucket = buckets[i];
+    size_t numRelevantBoundaries =
+        boundaryIsRelevant[2 * i] + boundaryIsRelevant[2 * i + 1];
+    if (numRelevantBoundaries == 2) {
+      numRelevantValues += bucket.numValues_;
+    } else if (numRelevantBoundaries == 1) {
+      numRelevantValues += bucket.numValues_ / 2.0;
+    } else {
+      numRelevantValues +=
+          static_cast<double>(bucket.numValues_) /
+          static_cast<double>(std::max<uint64_t>(1, bucket.numDistinctValues_));
+    }
+  }
+  return numRelevantValues / static_cast<double>(numValuesTotal);
+}
+
 // _____________________________________________________________________________
 std::vector<BlockMetadata> PrefilterExpression::evaluateAndCheckImpl(
     std::span<const BlockMetadata> input, size_t evaluationColumn) const {
@@ -311,6 +394,97 @@ std::vector<BlockMetadata> RelationalExpression<Comparison>::evaluateImpl(
   return getSetUnion(relevantBlocks, mixedDatatypeBlocks);
 };
 
+//______________________________________________________________________________
+template <CompOp Comparison>
+std::vector<uint8_t> RelationalExpression<Comparison>::evaluateOnIds(
+    std::span<const ValueId> ids) const {
+  using namespace valueIdComparators;
+  LocalVocab vocab{};
+  auto referenceId =
+      getValueIdFromIdOrLocalVocabEntry(rightSideReferenceValue_, vocab);
+  std::vector<uint8_t> result(ids.size());
+
+  // Fast path for the frequent case that all the `ids` have the datatype of
+  // the `referenceId`, and the values of this datatype can be compared
+  // without visiting the `Id`s. The loop is then simple enough to be
+  // vectorized by the compiler.
+  auto compareAll = [&ids, &result, referenceId](auto projection) {
+    constexpr auto comparator = getComparator<Comparison>();
+    const auto reference = projection(referenceId);
+    for (size_t i = 0; i < ids.size(); ++i) {
+      result[i] =
+          static_cast<uint8_t>(comparator(projection(ids[i]), reference));
+    }
+  };
+  const auto datatype = referenceId.getDatatype();
+  const bool allIdsHaveReferenceType =
+      ql::ranges::all_of(ids, [datatype](ValueId id) {
+        return id.getDatatype() == datatype;
+      });
+  if (allIdsHaveReferenceType && datatype == Datatype::VocabIndex) {
+    // The order of the bits of the `VocabIndex` IDs is the order of their
+    // indices.
+    compareAll([](ValueId id) { return id.getBits(); });
+  } else if (allIdsHaveReferenceType && datatype == Datatype::Int) {
+    compareAll([](ValueId id) { return id.getInt(); });
+  } else {
+    for (size_t i = 0; i < ids.size(); ++i) {
+      result[i] = static_cast<uint8_t>(compareIds(ids[i], referenceId,
+                                                  Comparison) ==
+                                       ComparisonResult::True);
+    }
+  }
+  return result;
+}
+
+//______________________________________________________________________________
+template <CompOp Comparison>
+std::vector<uint8_t> RelationalExpression<Comparison>::mayContainRelevantIds(
+    std::span<const ColumnSummary> summaries) const {
+  using namespace valueIdComparators;
+  LocalVocab vocab{};
+  auto referenceId =
+      getValueIdFromIdOrLocalVocabEntry(rightSideReferenceValue_, vocab);
+  // The datatypes of the `Id`s that can be compared to the `referenceId`.
+  // All other values are never relevant.
+  uint16_t compatibleDatatypes = 0;
+  for (size_t i = 0; i <= static_cast<size_t>(Datatype::MaxValue); ++i) {
+    if (detail::areTypesCompatible(static_cast<Datatype>(i),
+                                   referenceId.getDatatype())) {
+      compatibleDatatypes |= uint16_t{1} << i;
+    }
+  }
+
+  std::vector<uint8_t> result(summaries.size());
+  for (size_t i = 0; i < summaries.size(); ++i) {
+    const auto& [min, max, datatypes] = summaries[i];
+    if ((datatypes & compatibleDatatypes) == 0) {
+      result[i] = 0;
+      continue;
+    }
+    // As in `evaluateImpl`, we can't reason about mixed datatypes.
+    if (min.getDatatype() != max.getDatatype()) {
+      result[i] = 1;
+      continue;
+    }
+    // All the values of the column lie in `[min, max]`, so the column behaves
+    // like a single block with these values as its first and last value in
+    // `evaluateImpl`. The block is relevant iff a returned range overlaps the
+    // two bounds, or is an empty range between them (for `EQ`).
+    std::array bounds{min, max};
+    auto ranges = Comparison != CompOp::EQ
+                      ? getRangesForId(bounds.begin(), bounds.end(),
+                                       referenceId, Comparison)
+                      : getRangesForId(bounds.begin(), bounds.end(),
+                                       referenceId, Comparison, false);
+    result[i] = static_cast<uint8_t>(
+        ql::ranges::any_of(ranges, [&bounds](const auto& range) {
+          return range.first < bounds.end() && range.second > bounds.begin();
+        }));
+  }
+  return result;
+}
+
 //______________________________________________________________________________
 template <CompOp Comparison>
 bool RelationalExpression<Comparison>::operator==(
@@ -389,6 +563,40 @@ std::vector<BlockMetadata> LogicalExpression<Operation>::evaluateImpl(
   }
 };
 
+//______________________________________________________________________________
+template <LogicalOperator Operation>
+std::vector<uint8_t> LogicalExpression<Operation>::evaluateOnIds(
+    std::span<const ValueId> ids) const {
+  auto result = child1_->evaluateOnIds(ids);
+  auto resultChild2 = child2_->evaluateOnIds(ids);
+  for (size_t i = 0; i < result.size(); ++i) {
+    if constexpr (Operation == LogicalOperator::AND) {
+      result[i] &= resultChild2[i];
+    } else {
+      static_assert(Operation == LogicalOperator::OR);
+      result[i] |= resultChild2[i];
+    }
+  }
+  return result;
+}
+
+//______________________________________________________________________________
+template <LogicalOperator Operation>
+std::vector<uint8_t> LogicalExpression<Operation>::mayContainRelevantIds(
+    std::span<const ColumnSummary> summaries) const {
+  auto result = child1_->mayContainRelevantIds(summaries);
+  auto resultChild2 = child2_->mayContainRelevantIds(summaries);
+  for (size_t i = 0; i < result.size(); ++i) {
+    if constexpr (Operation == LogicalOperator::AND) {
+      result[i] &= resultChild2[i];
+    } else {
+      static_assert(Operation == LogicalOperator::OR);
+      result[i] |= resultChild2[i];
+    }
+  }
+  return result;
+}
+
 //______________________________________________________________________________
 template <LogicalOperator Operation>
 bool LogicalExpression<Operation>::operator==(
@@ -440,6 +648,20 @@ std::vector<BlockMetadata> NotExpression::evaluateImpl(
   return child_->evaluate(input, evaluationColumn, false);
 };
 
+//______________________________________________________________________________
+std::vector<uint8_t> NotExpression::evaluateOnIds(
+    std::span<const ValueId> ids) const {
+  // The `child_` has already been complemented in the constructor.
+  return child_->evaluateOnIds(ids);
+}
+
+//______________________________________________________________________________
+std::vector<uint8_t> NotExpression::mayContainRelevantIds(
+    std::span<const ColumnSummary> summaries) const {
+  // The `child_` has already been complemented in the constructor.
+  return child_->mayContainRelevantIds(summaries);
+}
+
 //______________________________________________________________________________
 bool NotExpression::operator==(const PrefilterExpression& other) const {
   const auto* otherNotExpression = dynamic_cast<const NotExpression*>(&other);
@@ -4,12 +4,15 @@
 
 #pragma once
 
+#include <cstdint>
 #include <memory>
+#include <span>
 #include <vector>
 
 #include "global/Id.h"
 #include "global/ValueIdComparators.h"
 #include "index/CompressedRelation.h"
+#include "index/PredicateStatistics.h"
 
 // For certain SparqlExpressions it is possible to perform a prefiltering
 // procedure w.r.t. relevant data blocks / ValueId values by making use of the
@@ -35,6 +38,9 @@ constexpr size_t maxInfoRecursion = 3;
 // filter out the non-relevant blocks by checking their content of
 // `firstTriple_` and `lastTriple_` (`PermutedTriple`)
 using BlockMetadata = CompressedBlockMetadata;
+// The summary of the values of a single column of a block (see
+// `CompressedBlockMetadata::columnSummaries_`).
+using ColumnSummary = BlockMetadata::ColumnSummary;
 
 //______________________________________________________________________________
 /*
@@ -91,11 +97,44 @@ class PrefilterExpression {
   // handled appropriately, the `stripIncompleteBlocks` flag is set to `true`.
   // The flag value shouldn't be changed in general, because `evaluate()` only
   // removes the respective block if it is conditionally (inconsistent columns)
-  // necessary.
+  // necessary. If `stripIncompleteBlocks` is set, the blocks that are relevant
+  // w.r.t. their first and last triple are additionally checked via their
+  // `columnSummaries_` (see `evaluateOnColumnSummaries` below).
   std::vector<BlockMetadata> evaluate(std::span<const BlockMetadata> input,
                                       size_t evaluationColumn,
                                       bool stripIncompleteBlocks = true) const;
 
+  // The row-level counterpart of `evaluate`: Return for each of the `ids` (the
+  // values of the evaluation column) whether it is relevant (`1`) or not
+  // (`0`). An `Id` is relevant iff a block that only consists of this `Id`
+  // would be considered relevant by `evaluate`. This is used to filter the
+  // rows of the decompressed blocks of an `IndexScan` (see
+  // `ScanSpecification::RowFilter`).
+  virtual std::vector<uint8_t> evaluateOnIds(
+      std::span<const ValueId> ids) const = 0;
+
+  // Return the subset of the `input` blocks that may contain relevant values in
+  // the `evaluationColumn` according to their `columnSummaries_` (blocks
+  // without summaries are always kept). In contrast to `evaluate`, the blocks
+  // don't have to be sorted by the `evaluationColumn`, so this can also be
+  // used for the columns of an `IndexScan` that are not the first free column.
+  std::vector<BlockMetadata> evaluateOnColumnSummaries(
+      std::span<const BlockMetadata> input, size_t evaluationColumn) const;
+
+  // Return for each of the `summaries` whether the summarized column may
+  // contain a relevant value (`1`) or certainly doesn't (`0`).
+  virtual std::vector<uint8_t> mayContainRelevantIds(
+      std::span<const ColumnSummary> summaries) const = 0;
+
+  // Estimate the fraction of the values of a column with the given `histogram`
+  // that are relevant. Buckets that can't contain relevant values contribute
+  // nothing, buckets whose smallest and largest value are both relevant
+  // contribute all their values, and buckets with one relevant boundary half
+  // of their values. For the remaining buckets (for example for `?x = 42` with
+  // `42` strictly inside the bucket) we assume that a single distinct value of
+  // the bucket is relevant. Returns `1.0` for an empty histogram.
+  double estimateSelectivity(const ValueHistogram& histogram) const;
+
   // Format for debugging
   friend std::ostream& operator<<(std::ostream& str,
                                   const PrefilterExpression& expression) {
@@ -154,6 +193,10 @@ class RelationalExpression : public PrefilterExpression {
   bool operator==(const PrefilterExpression& other) const override;
   std::unique_ptr<PrefilterExpression> clone() const override;
   std::string asString(size_t depth) const override;
+  std::vector<uint8_t> evaluateOnIds(
+      std::span<const ValueId> ids) const override;
+  std::vector<uint8_t> mayContainRelevantIds(
+      std::span<const ColumnSummary> summaries) const override;
 
  private:
   std::vector<BlockMetadata> evaluateImpl(
@@ -184,6 +227,10 @@ class LogicalExpression : public PrefilterExpression {
   bool operator==(const PrefilterExpression& other) const override;
   std::unique_ptr<PrefilterExpression> clone() const override;
   std::string asString(size_t depth) const override;
+  std::vector<uint8_t> evaluateOnIds(
+      std::span<const ValueId> ids) const override;
+  std::vector<uint8_t> mayContainRelevantIds(
+      std::span<const ColumnSummary> summaries) const override;
 
  private:
   std::vector<BlockMetadata> evaluateImpl(
@@ -209,6 +256,10 @@ class NotExpression : public PrefilterExpression {
   bool operator==(const PrefilterExpression& other) const override;
   std::unique_ptr<PrefilterExpression> clone() const override;
   std::string asString(size_t depth) const override;
+  std::vector<uint8_t> evaluateOnIds(
+      std::span<const ValueId> ids) const override;
+  std::vector<uint8_t> mayContainRelevantIds(
+      std::span<const ColumnSummary> summaries) const override;
 
  private:
   std::vector<BlockMetadata> evaluateImpl(
@@ -69,6 +69,65 @@ std::optional<std::string> getPrefixRegex(std::string regex) {
   return regex;
 }
 
+// ____________________________________________________________________________
+RegexVocabularyPrefilter::RegexVocabularyPrefilter(const std::string& regex) {
+  RE2::Options options;
+  options.set_log_errors(false);
+  int id;
+  if (filter_.Add(regex, options, &id) != RE2::NoError) {
+    return;
+  }
+  filter_.Compile(&requiredSubstrings_);
+  // If the regex can match without any of the required substrings, then
+  // `FilteredRE2` reports it as a potential match even if no substring matches.
+  std::vector<int> potentialMatches;
+  filter_.AllPotentials({}, &potentialMatches);
+  isApplicable_ = potentialMatches.empty();
+}
+
+// ____________________________________________________________________________
+std::optional<std::vector<uint64_t>>
+RegexVocabularyPrefilter::computeCandidates(
+    const VocabularyTrigramIndex& trigramIndex) const {
+  if (!isApplicable_) {
+    return std::nullopt;
+  }
+  // Pairs of (index of a word, index of a required substring that the word
+  // possibly contains).
+  std::vector<std::pair<uint64_t, int>> wordsAndSubstrings;
+  for (size_t i = 0; i < requiredSubstrings_.size(); ++i) {
+    auto substring =
+        VocabularyTrigramIndex::normalize(requiredSubstrings_.at(i));
+    if (substring.size() < 3) {
+      return std::nullopt;
+    }
+    for (uint64_t word : trigramIndex.getCandidates(substring)) {
+      wordsAndSubstrings.emplace_back(word, static_cast<int>(i));
+    }
+  }
+  ql::ranges::sort(wordsAndSubstrings);
+
+  // For each word, evaluate the boolean formula on the substrings that the
+  // word possibly contains.
+  std::vector<uint64_t> candidates;
+  std::vector<int> substrings;
+  std::vector<int> potentialMatches;
+  auto it = wordsAndSubstrings.begin();
+  while (it != wordsAndSubstrings.end()) {
+    uint64_t word = it->first;
+    substrings.clear();
+    for (; it != wordsAndSubstrings.end() && it->first == word; ++it) {
+      substrings.push_back(it->second);
+    }
+    potentialMatches.clear();
+    filter_.AllPotentials(substrings, &potentialMatches);
+    if (!potentialMatches.empty()) {
+      candidates.push_back(word);
+    }
+  }
+  return candidates;
+}
+
 }  // namespace sparqlExpression::detail
 
 namespace sparqlExpression {
@@ -140,6 +199,12 @@ RegexExpression::RegexExpression(
   // store the prefix in `prefixRegex_` (otherwise that becomes `std::nullopt`).
   regexAsString_ = regexString;
   prefixRegex_ = detail::getPrefixRegex(regexString);
+  if (!prefixRegex_.has_value()) {
+    vocabularyPrefilter_.emplace(regexString);
+    if (!vocabularyPrefilter_->isApplicable()) {
+      vocabularyPrefilter_.reset();
+    }
+  }
   regex_.emplace(regexString, RE2::Quiet);
   const auto& r = regex_.value();
   if (r.error_code() != RE2::NoError) {
@@ -256,6 +321,25 @@ ExpressionResult RegexExpression::evaluatePrefixRegex(
   return result;
 }
 
+// ___________________________________________________________________________
+const std::vector<uint64_t>* RegexExpression::getVocabularyCandidates(
+    const sparqlExpression::EvaluationContext* context) const {
+  if (!vocabularyPrefilter_.has_value()) {
+    return nullptr;
+  }
+  const auto* trigramIndex =
+      context->_qec.getIndex().getVocabularyTrigramIndex();
+  if (trigramIndex == nullptr) {
+    return nullptr;
+  }
+  std::call_once(vocabularyCandidatesFlag_, [this, trigramIndex]() {
+    vocabularyCandidates_ =
+        vocabularyPrefilter_->computeCandidates(*trigramIndex);
+  });
+  return vocabularyCandidates_.has_value() ? &vocabularyCandidates_.value()
+                                           : nullptr;
+}
+
 // ___________________________________________________________________________
 template <SingleExpressionResult T>
 ExpressionResult RegexExpression::evaluateGeneralCase(
@@ -266,13 +350,43 @@ ExpressionResult RegexExpression::evaluateGeneralCase(
   result.reserve(resultSize);
   AD_CORRECTNESS_CHECK(regex_.has_value());
 
+  // If there is a trigram index, the words of the vocabulary that are not
+  // among the candidates can't match the regex. The result for those is
+  // `false` without looking at the word, unless the getter returns
+  // `std::nullopt` for it. This is the case for IRIs if the expression is not
+  // enclosed in `STR()`, so for those we fall back to the getter.
+  const auto* candidates = getVocabularyCandidates(context);
+  std::optional<Index::Vocab::PrefixRanges> literalRanges;
+  if (candidates != nullptr && !childIsStrExpression_) {
+    literalRanges = context->_qec.getIndex().prefixRanges("\"");
+  }
+  auto isNoCandidate = [candidates, &literalRanges](const auto& id) {
+    if constexpr (!std::is_same_v<std::decay_t<decltype(id)>, Id>) {
+      return false;
+    } else {
+      if (candidates == nullptr || id.getDatatype() != Datatype::VocabIndex) {
+        return false;
+      }
+      auto index = id.getVocabIndex();
+      if (literalRanges.has_value() && !literalRanges->contain(index)) {
+        return false;
+      }
+      return !ql::ranges::binary_search(*candidates, index.get());
+    }
+  };
+
   // Compute the result using the given value getter. If the getter returns
   // `std::nullopt` for a row, the result is `UNDEF`. Otherwise, we have a
   // string and evaluate the regex on it.
   auto computeResult = [&]<typename ValueGetter>(const ValueGetter& getter) {
     ql::ranges::for_each(
         detail::makeGenerator(AD_FWD(input), resultSize, context),
-        [&getter, &context, &result, this](const auto& id) {
+        [&getter, &context, &result, &isNoCandidate, this](const auto& id) {
+          if (isNoCandidate(id)) {
+            result.push_back(Id::makeFromBool(false));
+            checkCancellation(context);
+            return;
+          }
           auto str = getter(id, context);
           if (!str.has_value()) {
             result.push_back(Id::makeUndefined());
@@ -4,13 +4,47 @@
 
 #pragma once
 
+#include <mutex>
 #include <string>
 
 #include "engine/sparqlExpressions/LiteralExpression.h"
 #include "engine/sparqlExpressions/SparqlExpression.h"
+#include "index/VocabularyTrigramIndex.h"
+#include "re2/filtered_re2.h"
 #include "re2/re2.h"
 
 namespace sparqlExpression {
+namespace detail {
+// Compute a superset of the words of the vocabulary that can match a regex
+// with the help of the `VocabularyTrigramIndex`. For this purpose, RE2's
+// `FilteredRE2` extracts the literal substrings (of at least three bytes) from
+// the regex that are required for a match, together with a boolean formula
+// (e.g. "abc" AND ("def" OR "ghi")) on them. The formula is then evaluated on
+// the candidates for the substrings from the trigram index.
+class RegexVocabularyPrefilter {
+ private:
+  re2::FilteredRE2 filter_{3};
+  // The required substrings (lowercase, as computed by RE2).
+  std::vector<std::string> requiredSubstrings_;
+  bool isApplicable_ = false;
+
+ public:
+  explicit RegexVocabularyPrefilter(const std::string& regex);
+
+  // Return true iff the regex has required substrings, s.t. not all the words
+  // of the vocabulary are candidates.
+  bool isApplicable() const { return isApplicable_; }
+  const std::vector<std::string>& requiredSubstrings() const {
+    return requiredSubstrings_;
+  }
+
+  // Return the (sorted) indices of the words that can match the regex, or
+  // `std::nullopt` if the `trigramIndex` can't restrict the candidates.
+  std::optional<std::vector<uint64_t>> computeCandidates(
+      const VocabularyTrigramIndex& trigramIndex) const;
+};
+}  // namespace detail
+
 // Class implementing the REGEX function, which takes two mandatory arguments
 // (an expression and a regex) and one optional argument (a string of flags).
 class RegexExpression : public SparqlExpression {
@@ -28,6 +62,12 @@ class RegexExpression : public SparqlExpression {
   // True iff the expression is enclosed in `STR()`.
   bool childIsStrExpression_ = false;
 
+  // The prefilter for the words of the vocabulary, and the candidates that it
+  // computes (once, when the expression is evaluated for the first time).
+  std::optional<detail::RegexVocabularyPrefilter> vocabularyPrefilter_;
+  mutable std::once_flag vocabularyCandidatesFlag_;
+  mutable std::optional<std::vector<uint64_t>> vocabularyCandidates_;
+
  public:
   // The `child` must be a `VariableExpression` and `regex` must be a
   // `LiteralExpression` that stores a string, otherwise an exception will be
@@ -59,6 +99,12 @@ class RegexExpression : public SparqlExpression {
       const Variable& variable,
       sparqlExpression::EvaluationContext* context) const;
 
+  // Return the (sorted) indices of the only words of the vocabulary that can
+  // match the regex, or `nullptr` if there is no such restriction (because the
+  // regex has no required substrings or the index has no trigram index).
+  const std::vector<uint64_t>* getVocabularyCandidates(
+      const sparqlExpression::EvaluationContext* context) const;
+
   // Evaluate for the general case.
   template <SingleExpressionResult T>
   ExpressionResult evaluateGeneralCase(
@@ -8,6 +8,7 @@
 #include "engine/sparqlExpressions/NaryExpression.h"
 #include "engine/sparqlExpressions/RelationalExpressionHelpers.h"
 #include "engine/sparqlExpressions/SparqlExpressionGenerators.h"
+#include "engine/sparqlExpressions/VectorizedKernels.h"
 #include "util/LambdaHelpers.h"
 #include "util/TypeTraits.h"
 
@@ -183,6 +184,17 @@ requires AreComparable<S1, S2> ExpressionResult evaluateRelationalExpression(
     }
   }
 
+  // If both operands are columns or constants of the same numeric datatype (or
+  // of datatype `Date`), use the vectorized kernel.
+  auto kernel = [](const auto& a, const auto& b, std::span<Id> target) {
+    return vectorized::evaluateComparison(Comp, a, b, target);
+  };
+  if (auto vectorizedResult =
+          vectorized::evaluateKernel(kernel, value1, value2, context);
+      vectorizedResult.has_value()) {
+    return std::move(vectorizedResult.value());
+  }
+
   auto [generatorA, generatorB] =
       getGenerators(AD_FWD(value1), AD_FWD(value2), resultSize, context);
   auto itA = generatorA.begin();
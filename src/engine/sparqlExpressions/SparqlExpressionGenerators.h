@@ -157,11 +157,10 @@ auto applyOperation(size_t numElements, Operation&&, EvaluationContext* context,
 }
 
 // Return a lambda that takes a `LiteralOrIri` and converts it to an `Id` by
-// adding it to the `localVocab`.
+// adding it to the `localVocab` (unless it is short enough to be inlined).
 inline auto makeStringResultGetter(LocalVocab* localVocab) {
   return [localVocab](const ad_utility::triple_component::LiteralOrIri& str) {
-    auto localVocabIndex = localVocab->getIndexAndAddIfNotContained(str);
-    return ValueId::makeFromLocalVocabIndex(localVocabIndex);
+    return localVocab->getIdAndAddIfNotContained(str);
   };
 }
 
@@ -230,8 +230,7 @@ Id constantExpressionResultToId(T&& result, LocalVocabT& localVocab) {
     return std::visit(
         [&localVocab]<typename R>(R&& el) mutable {
           if constexpr (ad_utility::isSimilar<R, LocalVocabEntry>) {
-            return Id::makeFromLocalVocabIndex(
-                localVocab.getIndexAndAddIfNotContained(AD_FWD(el)));
+            return localVocab.getIdAndAddIfNotContained(AD_FWD(el));
           } else {
             static_assert(ad_utility::isSimilar<R, Id>);
             return el;
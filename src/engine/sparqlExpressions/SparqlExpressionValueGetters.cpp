@@ -27,6 +27,7 @@ NumericValue NumericValueGetter::operator()(
     case Datatype::Undefined:
     case Datatype::VocabIndex:
     case Datatype::LocalVocabIndex:
+    case Datatype::InlineString:
     case Datatype::TextRecordIndex:
     case Datatype::WordVocabIndex:
     case Datatype::Date:
@@ -67,6 +68,11 @@ auto EffectiveBooleanValueGetter::operator()(
                  ? False
                  : True;
     }
+    case Datatype::InlineString: {
+      auto word = LiteralOrIri::fromStringRepresentation(
+          std::string{id.getInlineString().view()});
+      return word.getContent().empty() ? False : True;
+    }
     case Datatype::WordVocabIndex:
     case Datatype::TextRecordIndex:
     case Datatype::Date:
@@ -148,7 +154,8 @@ Id IsSomethingValueGetter<isSomethingFunction, prefix>::operator()(
     return Id::makeFromBool(std::invoke(isSomethingFunction,
                                         context->_qec.getIndex().getVocab(),
                                         id.getVocabIndex()));
-  } else if (id.getDatatype() == Datatype::LocalVocabIndex) {
+  } else if (id.getDatatype() == Datatype::LocalVocabIndex ||
+             id.getDatatype() == Datatype::InlineString) {
     auto word = ExportQueryExecutionTrees::idToStringAndType<false>(
         context->_qec.getIndex(), id, context->_localVocab);
     return Id::makeFromBool(word.has_value() &&
@@ -200,6 +207,7 @@ IntDoubleStr ToNumericValueGetter::operator()(
       return id.getGeoPoint().toStringRepresentation();
     case Datatype::VocabIndex:
     case Datatype::LocalVocabIndex:
+    case Datatype::InlineString:
     case Datatype::TextRecordIndex:
     case Datatype::WordVocabIndex:
     case Datatype::Date:
@@ -242,6 +250,7 @@ OptIri DatatypeValueGetter::operator()(ValueId id,
       return Iri::fromIrirefWithoutBrackets(dateType);
     }
     case LocalVocabIndex:
+    case InlineString:
     case VocabIndex:
       return (*this)(ExportQueryExecutionTrees::getLiteralOrIriFromVocabIndex(
                          context->_qec.getIndex(), id, context->_localVocab),
@@ -294,6 +303,7 @@ T getValue(ValueId id, const sparqlExpression::EvaluationContext* context,
   using enum Datatype;
   switch (id.getDatatype()) {
     case LocalVocabIndex:
+    case InlineString:
     case VocabIndex:
       return valueGetter(
           ExportQueryExecutionTrees::getLiteralOrIriFromVocabIndex(
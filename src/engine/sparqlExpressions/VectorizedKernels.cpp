@@ -0,0 +1,244 @@
+//  Copyright 2025, University of Freiburg,
+//                  Chair of Algorithms and Data Structures.
+
+#include "engine/sparqlExpressions/VectorizedKernels.h"
+
+#include <functional>
+
+#include "engine/sparqlExpressions/SparqlExpressionValueGetters.h"
+#include "util/Exception.h"
+#include "util/OverloadCallOperator.h"
+
+namespace sparqlExpression::vectorized {
+
+namespace {
+using detail::makeNumericId;
+
+// The value of an `Id` as it is used by the kernels: `int64_t` for `Int`,
+// `double` for `Double`, and the raw bits for all other datatypes.
+template <typename Value>
+Value getValue(Id id) {
+  if constexpr (std::is_same_v<Value, int64_t>) {
+    return id.getInt();
+  } else if constexpr (std::is_same_v<Value, double>) {
+    return id.getDouble();
+  } else {
+    static_assert(std::is_same_v<Value, uint64_t>);
+    return id.getBits();
+  }
+}
+
+// Return a function that maps a row index to the value of the `operand` in
+// this row. For a constant operand, the value is computed only once.
+template <typename Value>
+auto makeAccessor(std::span<const Id> column) {
+  return [column](size_t i) { return getValue<Value>(column[i]); };
+}
+template <typename Value>
+auto makeAccessor(Id constant) {
+  return [value = getValue<Value>(constant)](size_t) { return value; };
+}
+
+// Write `f(a[i], b[i])` to `result[i]` for all rows `i`, where the values of
+// `a` and `b` are interpreted as `ValueA` and `ValueB`. The visitation of the
+// operands happens outside of the loop, s.t. each of the (at most four)
+// instantiations of the loop can be vectorized.
+template <typename ValueA, typename ValueB>
+void applyKernel(const Operand& a, const Operand& b, std::span<Id> result,
+                 auto f) {
+  std::visit(
+      [&result, &f](const auto& x, const auto& y) {
+        auto getA = makeAccessor<ValueA>(x);
+        auto getB = makeAccessor<ValueB>(y);
+        for (size_t i = 0; i < result.size(); ++i) {
+          result[i] = f(getA(i), getB(i));
+        }
+      },
+      a, b);
+}
+
+// The datatype of all the `Id`s of the `operand`, if it is the same.
+std::optional<Datatype> getDatatype(const Operand& operand) {
+  return std::visit(
+      ad_utility::OverloadCallOperator{
+          [](Id id) -> std::optional<Datatype> { return id.getDatatype(); },
+          [](std::span<const Id> column) {
+            return getCommonDatatype(column);
+          }},
+      operand);
+}
+
+// Call `f(ValueA{}, ValueB{})` for the value types that correspond to the
+// numeric datatypes `a` and `b`. Return false if any of them is not numeric.
+bool visitNumericTypes(Datatype a, Datatype b, const auto& f) {
+  auto isNumeric = [](Datatype type) {
+    return type == Datatype::Int || type == Datatype::Double;
+  };
+  if (!isNumeric(a) || !isNumeric(b)) {
+    return false;
+  }
+  auto visitB = [&f, b](auto valueA) {
+    if (b == Datatype::Int) {
+      f(valueA, int64_t{});
+    } else {
+      f(valueA, double{});
+    }
+  };
+  if (a == Datatype::Int) {
+    visitB(int64_t{});
+  } else {
+    visitB(double{});
+  }
+  return true;
+}
+
+// The arithmetic operations. As in the generic evaluation, all the results
+// are `Double`s, except for the addition, subtraction, and multiplication of
+// two `Int`s. The multiplication of `Int`s is performed on unsigned integers,
+// s.t. an overflow is well-defined.
+template <BinaryOperation Op>
+Id arithmetic(auto x, auto y) {
+  using enum BinaryOperation;
+  if constexpr (Op == Add) {
+    return makeNumericId(x + y);
+  } else if constexpr (Op == Subtract) {
+    return makeNumericId(x - y);
+  } else if constexpr (Op == Multiply) {
+    if constexpr (std::is_same_v<decltype(x), int64_t> &&
+                  std::is_same_v<decltype(y), int64_t>) {
+      return Id::makeFromInt(static_cast<int64_t>(static_cast<uint64_t>(x) *
+                                                  static_cast<uint64_t>(y)));
+    } else {
+      return makeNumericId(x * y);
+    }
+  } else {
+    static_assert(Op == Divide);
+    return Id::makeFromDouble(static_cast<double>(x) / static_cast<double>(y));
+  }
+}
+
+// _____________________________________________________________________________
+template <BinaryOperation Op>
+bool evaluateArithmetic(const Operand& a, const Operand& b,
+                        std::span<Id> result) {
+  auto typeA = getDatatype(a);
+  auto typeB = getDatatype(b);
+  if (!typeA.has_value() || !typeB.has_value()) {
+    return false;
+  }
+  return visitNumericTypes(
+      typeA.value(), typeB.value(),
+      [&]<typename ValueA, typename ValueB>(ValueA, ValueB) {
+        applyKernel<ValueA, ValueB>(a, b, result, [](auto x, auto y) {
+          return arithmetic<Op>(x, y);
+        });
+      });
+}
+
+// _____________________________________________________________________________
+template <BinaryOperation Op>
+bool evaluateLogical(const Operand& a, const Operand& b,
+                     std::span<Id> result) {
+  if (getDatatype(a) != Datatype::Bool || getDatatype(b) != Datatype::Bool) {
+    return false;
+  }
+  // The bits of `Bool` `Id`s only differ in the last bit, which is the value,
+  // so the logical operations can be directly applied to the bits.
+  applyKernel<uint64_t, uint64_t>(a, b, result, [](uint64_t x, uint64_t y) {
+    if constexpr (Op == BinaryOperation::And) {
+      return Id::fromBits(x & y);
+    } else {
+      static_assert(Op == BinaryOperation::Or);
+      return Id::fromBits(x | y);
+    }
+  });
+  return true;
+}
+
+// _____________________________________________________________________________
+template <typename Comparator>
+bool evaluateComparisonImpl(const Operand& a, const Operand& b,
+                            std::span<Id> result) {
+  auto typeA = getDatatype(a);
+  auto typeB = getDatatype(b);
+  if (!typeA.has_value() || !typeB.has_value()) {
+    return false;
+  }
+  auto compare = [](auto x, auto y) {
+    return Id::makeFromBool(Comparator{}(x, y));
+  };
+  // For `Date`s the comparison of the bits is also the correct comparison of
+  // the values.
+  if (typeA == Datatype::Date && typeB == Datatype::Date) {
+    applyKernel<uint64_t, uint64_t>(a, b, result, compare);
+    return true;
+  }
+  return visitNumericTypes(
+      typeA.value(), typeB.value(),
+      [&]<typename ValueA, typename ValueB>(ValueA, ValueB) {
+        applyKernel<ValueA, ValueB>(a, b, result, compare);
+      });
+}
+}  // namespace
+
+// _____________________________________________________________________________
+std::optional<Datatype> getCommonDatatype(std::span<const Id> ids) {
+  if (ids.empty()) {
+    return std::nullopt;
+  }
+  // Compare the datatype bits of all the `Id`s without branching, which is
+  // much faster than an early exit for the typical case of a common datatype.
+  auto firstType = ids[0].getBits() >> Id::numDataBits;
+  bool allEqual = true;
+  for (Id id : ids) {
+    allEqual &= (id.getBits() >> Id::numDataBits) == firstType;
+  }
+  if (!allEqual) {
+    return std::nullopt;
+  }
+  return ids[0].getDatatype();
+}
+
+// _____________________________________________________________________________
+bool evaluateBinaryOperation(BinaryOperation op, const Operand& a,
+                             const Operand& b, std::span<Id> result) {
+  using enum BinaryOperation;
+  switch (op) {
+    case Add:
+      return evaluateArithmetic<Add>(a, b, result);
+    case Subtract:
+      return evaluateArithmetic<Subtract>(a, b, result);
+    case Multiply:
+      return evaluateArithmetic<Multiply>(a, b, result);
+    case Divide:
+      return evaluateArithmetic<Divide>(a, b, result);
+    case And:
+      return evaluateLogical<And>(a, b, result);
+    case Or:
+      return evaluateLogical<Or>(a, b, result);
+  }
+  AD_FAIL();
+}
+
+// _____________________________________________________________________________
+bool evaluateComparison(Comparison comparison, const Operand& a,
+                        const Operand& b, std::span<Id> result) {
+  using enum Comparison;
+  switch (comparison) {
+    case LT:
+      return evaluateComparisonImpl<std::less<>>(a, b, result);
+    case LE:
+      return evaluateComparisonImpl<std::less_equal<>>(a, b, result);
+    case EQ:
+      return evaluateComparisonImpl<std::equal_to<>>(a, b, result);
+    case NE:
+      return evaluateComparisonImpl<std::not_equal_to<>>(a, b, result);
+    case GE:
+      return evaluateComparisonImpl<std::greater_equal<>>(a, b, result);
+    case GT:
+      return evaluateComparisonImpl<std::greater<>>(a, b, result);
+  }
+  AD_FAIL();
+}
+
+}  // namespace sparqlExpression::vectorized
@@ -0,0 +1,102 @@
+//  Copyright 2025, University of Freiburg,
+//                  Chair of Algorithms and Data Structures.
+
+#pragma once
+
+#include <optional>
+#include <span>
+#include <variant>
+
+#include "engine/sparqlExpressions/SparqlExpressionGenerators.h"
+#include "global/ValueId.h"
+#include "global/ValueIdComparators.h"
+
+// Vectorized evaluation of binary SPARQL expressions on columns of `Id`s.
+//
+// The generic evaluation of expressions (see `NaryExpression`) dispatches on
+// the datatype of each single value. If all the values of an operand have the
+// same datatype, the kernels in this file instead run a single tight loop over
+// the raw `Id`s, which the compiler can auto-vectorize for the instruction set
+// of the target (e.g. AVX2, AVX-512 or NEON). The datatype dispatch happens
+// once per operand and not once per value.
+//
+// All the kernels return `false` (and don't write anything) if they don't
+// support the datatypes of their operands. The caller then has to fall back to
+// the generic evaluation. The results of the kernels are always the same as
+// those of the generic evaluation.
+namespace sparqlExpression::vectorized {
+
+using valueIdComparators::Comparison;
+
+// An operand of a kernel: Either a column of `Id`s (one for each row), or a
+// single `Id` that is the same for all the rows.
+using Operand = std::variant<std::span<const Id>, Id>;
+
+// The binary operations that have a vectorized implementation.
+enum class BinaryOperation { Add, Subtract, Multiply, Divide, And, Or };
+
+// If all the `ids` have the same datatype, return this datatype, else (and for
+// an empty input) return `std::nullopt`.
+std::optional<Datatype> getCommonDatatype(std::span<const Id> ids);
+
+// Write `a op b` for each row to the `result`. Supported are the arithmetic
+// operations for operands that are either all `Int` or all `Double`, and the
+// logical operations `And` and `Or` for operands that are all `Bool`.
+bool evaluateBinaryOperation(BinaryOperation op, const Operand& a,
+                             const Operand& b, std::span<Id> result);
+
+// Write `a comparison b` (as a `Bool` `Id`) for each row to the `result`.
+// Supported are operands that are all `Int` or all `Double` (also mixed), and
+// operands that are all `Date`.
+bool evaluateComparison(Comparison comparison, const Operand& a,
+                        const Operand& b, std::span<Id> result);
+
+// Convert the result of a child expression to an `Operand`. Return
+// `std::nullopt` for results that don't directly store `Id`s, e.g. strings or
+// a `SetOfIntervals`.
+template <SingleExpressionResult S>
+std::optional<Operand> getOperand(const S& input,
+                                  const EvaluationContext* context) {
+  if constexpr (ad_utility::isSimilar<S, ::Variable>) {
+    return detail::getIdsFromVariable(input, context);
+  } else if constexpr (ad_utility::isSimilar<S, VectorWithMemoryLimit<Id>>) {
+    return std::span<const Id>{input};
+  } else if constexpr (ad_utility::isSimilar<S, Id>) {
+    return input;
+  } else if constexpr (ad_utility::isSimilar<S, IdOrLiteralOrIri>) {
+    if (const auto* id = std::get_if<Id>(&input)) {
+      return *id;
+    }
+    return std::nullopt;
+  } else {
+    return std::nullopt;
+  }
+}
+
+// Evaluate the `kernel` (one of the functions above with the operation already
+// bound) on the `inputs`, which are the results of two child expressions.
+// Return `std::nullopt` if the kernel can't be used, in particular if both
+// inputs are constants (then there is nothing to vectorize).
+template <SingleExpressionResult S1, SingleExpressionResult S2>
+std::optional<ExpressionResult> evaluateKernel(
+    const auto& kernel, const S1& input1, const S2& input2,
+    const EvaluationContext* context) {
+  if constexpr (isConstantResult<S1> && isConstantResult<S2>) {
+    return std::nullopt;
+  } else {
+    auto a = getOperand(input1, context);
+    auto b = getOperand(input2, context);
+    if (!a.has_value() || !b.has_value()) {
+      return std::nullopt;
+    }
+    VectorWithMemoryLimit<Id> result{context->_allocator};
+    result.resize(context->size());
+    if (!kernel(a.value(), b.value(), std::span<Id>{result})) {
+      return std::nullopt;
+    }
+    context->cancellationHandle_->throwIfCancelled();
+    return result;
+  }
+}
+
+}  // namespace sparqlExpression::vectorized
@@ -151,8 +151,14 @@ constexpr inline char GEO_WKT_LITERAL[] =
     "http://www.opengis.net/ont/geosparql#wktLiteral";
 
 constexpr inline std::string_view VOCAB_SUFFIX = ".vocabulary";
+constexpr inline std::string_view VOCAB_TRIGRAM_INDEX_SUFFIX =
+    ".vocabulary.trigrams";
+constexpr inline std::string_view PREDICATE_STATISTICS_SUFFIX =
+    ".predicate-statistics";
 constexpr inline std::string_view MMAP_FILE_SUFFIX = ".meta";
 constexpr inline std::string_view CONFIGURATION_FILE = ".meta-data.json";
+constexpr inline std::string_view DELTA_TRIPLES_WRITE_AHEAD_LOG_SUFFIX =
+    ".update-triples";
 
 constexpr inline std::string_view ERROR_IGNORE_CASE_UNSUPPORTED =
     "Key \"ignore-case\" is no longer supported. Please remove this key from "
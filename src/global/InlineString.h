@@ -0,0 +1,81 @@
+//  Copyright 2025, University of Freiburg,
+//                  Chair of Algorithms and Data Structures.
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+// A short string that is stored directly in the bits of a `ValueId` (see
+// `Datatype::InlineString`), s.t. it needs neither the vocabulary nor a
+// `LocalVocab`. The string is the internal representation of a literal or an
+// IRI (including the quotes or angle brackets, e.g. `"de"` or `<x>`), and may
+// have at most `maxSize` bytes.
+//
+// The first character is stored in the most significant byte, the size in the
+// lowest four bits. Two `InlineString`s thus have the same bit representation
+// iff they are equal. NOTE: The order of the bits is NOT the order of the
+// vocabulary (which depends on the locale), see `ValueId::operator<=>`.
+class InlineString {
+ public:
+  static constexpr size_t maxSize = 7;
+  static constexpr size_t numDataBits = 60;
+
+ private:
+  static constexpr size_t numSizeBits = 4;
+  static_assert(maxSize * 8 + numSizeBits == numDataBits);
+
+  std::array<char, maxSize> chars_{};
+  uint8_t size_ = 0;
+
+ public:
+  // The empty string.
+  constexpr InlineString() = default;
+
+  // Return the `InlineString` for the `word`, or `std::nullopt` if the `word`
+  // has more than `maxSize` bytes.
+  static constexpr std::optional<InlineString> make(std::string_view word) {
+    if (word.size() > maxSize) {
+      return std::nullopt;
+    }
+    InlineString result;
+    for (size_t i = 0; i < word.size(); ++i) {
+      result.chars_[i] = word[i];
+    }
+    result.size_ = static_cast<uint8_t>(word.size());
+    return result;
+  }
+
+  // Access the stored string.
+  constexpr std::string_view view() const { return {chars_.data(), size_}; }
+
+  // Convert to and from the `numDataBits` that are stored in a `ValueId`.
+  constexpr uint64_t toBitRepresentation() const {
+    uint64_t bits = size_;
+    for (size_t i = 0; i < size_; ++i) {
+      bits |= static_cast<uint64_t>(static_cast<uint8_t>(chars_[i]))
+              << shiftForChar(i);
+    }
+    return bits;
+  }
+  static constexpr InlineString fromBitRepresentation(uint64_t bits) {
+    InlineString result;
+    result.size_ = static_cast<uint8_t>(bits & ((1u << numSizeBits) - 1));
+    for (size_t i = 0; i < result.size_; ++i) {
+      result.chars_[i] = static_cast<char>((bits >> shiftForChar(i)) & 0xFF);
+    }
+    return result;
+  }
+
+  constexpr bool operator==(const InlineString& other) const {
+    return view() == other.view();
+  }
+
+ private:
+  // The position of the `i`-th character in the bit representation.
+  static constexpr size_t shiftForChar(size_t i) {
+    return numDataBits - 8 * (i + 1);
+  }
+};
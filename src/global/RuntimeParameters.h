@@ -5,6 +5,9 @@
 #ifndef QLEVER_RUNTIMEPARAMETERS_H
 #define QLEVER_RUNTIMEPARAMETERS_H
 
+#include <filesystem>
+
+#include "util/Cache.h"
 #include "util/Parameters.h"
 
 inline auto& RuntimeParameters() {
@@ -13,6 +16,7 @@ inline auto& RuntimeParameters() {
   using ad_utility::detail::parameterShortNames::DurationParameter;
   using ad_utility::detail::parameterShortNames::MemorySizeParameter;
   using ad_utility::detail::parameterShortNames::SizeT;
+  using ad_utility::detail::parameterShortNames::String;
   // NOTE: It is important that the value of the static variable is created by
   // an immediately invoked lambda, otherwise we get really strange segfaults on
   // Clang 16 and 17.
@@ -32,6 +36,27 @@ inline auto& RuntimeParameters() {
           });
       return AD_FWD(parameter);
     };
+    auto ensureValidEvictionPolicy = [](auto&& parameter) {
+      parameter.setParameterConstraint(
+          [](const std::string& value,
+             [[maybe_unused]] std::string_view parameterName) {
+            // Throws if the `value` is not a valid policy.
+            ad_utility::cacheEvictionPolicyFromString(value);
+          });
+      return AD_FWD(parameter);
+    };
+    auto ensureExistingDirectory = [](auto&& parameter) {
+      parameter.setParameterConstraint(
+          [](const std::string& value, std::string_view parameterName) {
+            if (!value.empty() && !std::filesystem::is_directory(value)) {
+              throw std::runtime_error{absl::StrCat(
+                  "Parameter ", parameterName,
+                  " must be empty or an existing directory, was \"", value,
+                  "\"")};
+            }
+          });
+      return AD_FWD(parameter);
+    };
     return ad_utility::Parameters{
         // If the time estimate for a sort operation is larger by more than this
         // factor than the remaining time, then the sort is canceled with a
@@ -40,14 +65,49 @@ inline auto& RuntimeParameters() {
         SizeT<"cache-max-num-entries">{1000},
         MemorySizeParameter<"cache-max-size">{30_GB},
         MemorySizeParameter<"cache-max-size-single-entry">{5_GB},
+        // The policy by which entries are evicted from the query result cache,
+        // either "lru" (least recently used) or "gdsf" (GreedyDual-Size-
+        // Frequency, which prefers to keep small results that were expensive
+        // to compute and that are accessed often).
+        ensureValidEvictionPolicy(String<"cache-eviction-policy">{"lru"}),
+        // The maximal total size of the process-wide cache of decompressed
+        // blocks of the permutations (see `DecompressedBlockCache`). The
+        // cached blocks are part of the memory that is limited by
+        // `memory-max-size`. A value of zero disables this cache.
+        MemorySizeParameter<"decompressed-block-cache-max-size">{1_GB},
         SizeT<"lazy-index-scan-queue-size">{20},
+        // The maximal number of threads of the shared pool of the index scans
+        // (see `getIndexScanWorkerPool` in `CompressedRelation.cpp`) that
+        // work for a single lazy index scan at the same time.
         SizeT<"lazy-index-scan-num-threads">{10},
+        // The number of threads of the pool that is shared by all the lazy
+        // index scans of all queries. Zero means one thread per core. This
+        // value is only read when the pool is created (at the first lazy
+        // index scan).
+        SizeT<"index-scan-worker-pool-num-threads">{0},
+        // The number of consecutive blocks that a thread of a lazy index scan
+        // reads from disk at once (all reads of such a batch are submitted
+        // together, see `ad_utility::readBatch`).
+        SizeT<"lazy-index-scan-io-batch-size">{4},
+        // If true, the rows of the blocks of an index scan that has a
+        // prefilter (see `PrefilterExpression`) are already filtered by this
+        // prefilter when the blocks are decompressed, and not only the
+        // complete blocks.
+        Bool<"index-scan-filter-rows-by-prefilter">{true},
         ensureStrictPositivity(
             DurationParameter<std::chrono::seconds, "default-query-timeout">{
                 30s}),
         SizeT<"lazy-index-scan-max-size-materialization">{1'000'000},
         Bool<"use-binsearch-transitive-path">{true},
         Bool<"group-by-hash-map-enabled">{false},
+        // The hash map optimization of GROUP BY splits its input into this
+        // many partitions (by the hash of the groups), which are aggregated
+        // in parallel.
+        SizeT<"group-by-hash-map-num-partitions">{16},
+        // If the hash maps of the hash map optimization of GROUP BY become
+        // larger than this, then the rows of new groups are written to disk
+        // and aggregated after the rest of the input.
+        MemorySizeParameter<"group-by-hash-map-memory-threshold">{5_GB},
         Bool<"group-by-disable-index-scan-optimizations">{false},
         SizeT<"service-max-value-rows">{10'000},
         SizeT<"query-planning-budget">{1500},
@@ -63,6 +123,55 @@ inline auto& RuntimeParameters() {
         // Determines whether the cost estimate for a cached subtree should be
         // set to zero in query planning.
         Bool<"zero-cost-estimate-for-cached-subtree">{false},
+        // If the input of a `Sort` or `OrderBy` whose result is requested
+        // lazily is larger than this (or than half of the memory that is
+        // still available for the query), then the input is sorted externally
+        // (in presorted blocks on disk that are merged lazily) instead of
+        // completely in RAM.
+        MemorySizeParameter<"sort-in-memory-threshold">{1_GB},
+        // The directory for the temporary files of operations that write
+        // parts of their input to disk (the external sort and the hash map
+        // GROUP BY). If empty, the files are written next to the index files.
+        ensureExistingDirectory(String<"spill-directory">{""}),
+        // An ORDER BY that is followed by a LIMIT where LIMIT + OFFSET is at
+        // most this value is computed by the `TopK` operation, which only
+        // keeps the best LIMIT + OFFSET rows in RAM instead of sorting the
+        // complete input.
+        SizeT<"top-k-max-num-rows">{100'000},
+        // FILTER expressions without aggregates are evaluated on chunks of
+        // this many rows of their input (see `evaluateInChunks`), s.t. the
+        // intermediate results of the expression stay in the CPU cache. Zero
+        // means that the complete input is evaluated at once.
+        SizeT<"expression-evaluation-chunk-size">{1024},
+        // The `QueryPlanner` considers a `HashJoin` for a join of two inputs
+        // that are not sorted on the join column if the smaller input has at
+        // least this many rows (estimated) and if the rows of the smaller
+        // input (the build side) fit into the given memory.
+        SizeT<"hash-join-min-input-size">{100'000},
+        MemorySizeParameter<"hash-join-max-build-side-size">{1_GB},
+        // The `HashJoin` splits its inputs into `2^hash-join-num-radix-bits`
+        // partitions, which are joined in parallel.
+        SizeT<"hash-join-num-radix-bits">{6},
+        // If this is larger than zero, the joins of a connected component of
+        // a query are re-planned during their execution as soon as the actual
+        // size of an intermediate result differs from its estimate by more
+        // than this factor (see `AdaptiveJoinTree`). Zero disables the
+        // re-planning.
+        Double<"adaptive-reoptimization-factor">{0.0},
+        // If one input of a `Join` is materialized before the other one and
+        // has at most this many rows, then the values of its join column are
+        // pushed down as a filter into the `IndexScan`s of the other input
+        // (see `JoinFilter`). Zero disables these filters.
+        SizeT<"join-filter-max-build-size">{100'000},
+        // A join filter with at most this many distinct values stores them as
+        // a sorted list (which can also be used to skip blocks of the scans),
+        // else it is a Bloom filter.
+        SizeT<"join-filter-max-sorted-keys">{4096},
+        // The write-ahead log of the updates (see `DeltaTriples`) is rewritten
+        // to contain only the current inserted and deleted triples as soon as
+        // it contains at least this many triples and more than twice as many
+        // triples as are currently inserted or deleted.
+        SizeT<"write-ahead-log-min-triples-for-compaction">{100'000},
     };
   }();
   return params;
@@ -13,7 +13,9 @@
 
 #include "global/Constants.h"
 #include "global/IndexTypes.h"
+#include "global/InlineString.h"
 #include "parser/GeoPoint.h"
+#include "util/Algorithm.h"
 #include "util/BitUtils.h"
 #include "util/DateYearDuration.h"
 #include "util/NBitInteger.h"
@@ -28,6 +30,7 @@ enum struct Datatype {
   Double,
   VocabIndex,
   LocalVocabIndex,
+  InlineString,
   TextRecordIndex,
   Date,
   GeoPoint,
@@ -55,6 +58,8 @@ constexpr std::string_view toString(Datatype type) {
       return "VocabIndex";
     case Datatype::LocalVocabIndex:
       return "LocalVocabIndex";
+    case Datatype::InlineString:
+      return "InlineString";
     case Datatype::TextRecordIndex:
       return "TextRecordIndex";
     case Datatype::WordVocabIndex:
@@ -96,8 +101,8 @@ class ValueId {
   // types form a consecutive range of IDs when sorted. Within this range, the
   // IDs are ordered by their string values, not by their IDs (and hence also
   // not by their types).
-  static constexpr std::array<Datatype, 2> stringTypes_{
-      Datatype::VocabIndex, Datatype::LocalVocabIndex};
+  static constexpr std::array<Datatype, 3> stringTypes_{
+      Datatype::VocabIndex, Datatype::LocalVocabIndex, Datatype::InlineString};
 
   // Assert that the types in `stringTypes_` are directly adjacent. This is
   // required to make the comparison of IDs in `ValueIdComparators.h` work.
@@ -111,6 +116,9 @@ class ValueId {
   // ValueId.
   static_assert(numDataBits == GeoPoint::numDataBits);
 
+  // The same for an `InlineString`.
+  static_assert(numDataBits == InlineString::numDataBits);
+
   /// This exception is thrown if we try to store a value of an index type
   /// (VocabIndex, LocalVocabIndex, TextRecordIndex) that is larger than
   /// `maxIndex`.
@@ -149,28 +157,30 @@ class ValueId {
   /// the positive integers in order and then the negative integers in order.
   /// For doubles it is first the positive doubles in order, then the negative
   /// doubles in reversed order. This is a direct consequence of comparing the
-  /// bit representation of these values as unsigned integers.
+  /// bit representation of these values as unsigned integers. The string types
+  /// `LocalVocabIndex` and `InlineString` are the exception, they are ordered
+  /// by their string value together with the `VocabIndex`.
   constexpr auto operator<=>(const ValueId& other) const {
     using enum Datatype;
     auto type = getDatatype();
     auto otherType = other.getDatatype();
-    if (type != LocalVocabIndex && otherType != LocalVocabIndex) {
+    auto isOrderedByBits = [](Datatype datatype) {
+      return datatype != LocalVocabIndex && datatype != InlineString;
+    };
+    if (isOrderedByBits(type) && isOrderedByBits(otherType)) {
       return _bits <=> other._bits;
     }
+    if (type == InlineString || otherType == InlineString) [[unlikely]] {
+      return compareWithInlineString(other);
+    }
     if (type == LocalVocabIndex && otherType == LocalVocabIndex) [[unlikely]] {
       return *getLocalVocabIndex() <=> *other.getLocalVocabIndex();
     }
     auto compareVocabAndLocalVocab =
         [](::VocabIndex vocabIndex,
            ::LocalVocabIndex localVocabIndex) -> std::strong_ordering {
-      auto [lowerBound, upperBound] = localVocabIndex->positionInVocab();
-      if (vocabIndex < lowerBound) {
-        return std::strong_ordering::less;
-      } else if (vocabIndex >= upperBound) {
-        return std::strong_ordering::greater;
-      } else {
-        return std::strong_ordering::equal;
-      }
+      return compareVocabIndexAndPosition(vocabIndex,
+                                          localVocabIndex->positionInVocab());
     };
     // GCC 11 issues a false positive warning here, so we try to avoid it by
     // being over-explicit about the branches here.
@@ -281,6 +291,10 @@ class ValueId {
     return makeFromIndex(reinterpret_cast<T>(index) >> numDatatypeBits,
                          Datatype::LocalVocabIndex);
   }
+  static ValueId makeFromInlineString(InlineString string) {
+    return addDatatypeBits(string.toBitRepresentation(),
+                           Datatype::InlineString);
+  }
   static ValueId makeFromWordVocabIndex(WordVocabIndex index) {
     return makeFromIndex(index.get(), Datatype::WordVocabIndex);
   }
@@ -300,6 +314,9 @@ class ValueId {
   [[nodiscard]] LocalVocabIndex getLocalVocabIndex() const noexcept {
     return reinterpret_cast<LocalVocabIndex>(_bits << numDatatypeBits);
   }
+  [[nodiscard]] constexpr InlineString getInlineString() const noexcept {
+    return InlineString::fromBitRepresentation(removeDatatypeBits(_bits));
+  }
   [[nodiscard]] constexpr WordVocabIndex getWordVocabIndex() const noexcept {
     return WordVocabIndex::make(removeDatatypeBits(_bits));
   }
@@ -376,6 +393,8 @@ class ValueId {
         return std::invoke(visitor, getVocabIndex());
       case Datatype::LocalVocabIndex:
         return std::invoke(visitor, getLocalVocabIndex());
+      case Datatype::InlineString:
+        return std::invoke(visitor, getInlineString());
       case Datatype::TextRecordIndex:
         return std::invoke(visitor, getTextRecordIndex());
       case Datatype::WordVocabIndex:
@@ -414,6 +433,8 @@ class ValueId {
       } else if constexpr (ad_utility::isSimilar<T, LocalVocabIndex>) {
         AD_CORRECTNESS_CHECK(value != nullptr);
         ostr << value->toStringRepresentation();
+      } else if constexpr (ad_utility::isSimilar<T, InlineString>) {
+        ostr << value.view();
       } else {
         // T is `VocabIndex | TextRecordIndex`
         ostr << std::to_string(value.get());
@@ -442,6 +463,55 @@ class ValueId {
     return bits & mask;
   }
 
+  // Compare a `VocabIndex` to a word that is not stored in the vocabulary but
+  // has the given `position` in it (see `LocalVocabEntry::PositionInVocab`).
+  static std::strong_ordering compareVocabIndexAndPosition(
+      ::VocabIndex vocabIndex, LocalVocabEntry::PositionInVocab position) {
+    if (vocabIndex < position.lowerBound_) {
+      return std::strong_ordering::less;
+    } else if (vocabIndex >= position.upperBound_) {
+      return std::strong_ordering::greater;
+    } else {
+      return std::strong_ordering::equal;
+    }
+  }
+
+  // The part of `operator<=>` where at least one of the IDs is an
+  // `InlineString`. IDs with the same bits are always equal, and all other
+  // strings are compared like the ones in the `LocalVocab`, that is, using
+  // the position in the vocabulary or the comparator of the vocabulary.
+  std::strong_ordering compareWithInlineString(const ValueId& other) const {
+    using enum Datatype;
+    auto isString = [](Datatype datatype) {
+      return ad_utility::contains(stringTypes_, datatype);
+    };
+    if (_bits == other._bits || !isString(getDatatype()) ||
+        !isString(other.getDatatype())) {
+      return _bits <=> other._bits;
+    }
+    if (getDatatype() == VocabIndex) {
+      return 0 <=> other.compareWithInlineString(*this);
+    }
+    if (other.getDatatype() == VocabIndex) {
+      // As one of the IDs is an `InlineString`, it has to be this one.
+      auto position = LocalVocabEntry::positionInVocab(getInlineString());
+      return 0 <=> compareVocabIndexAndPosition(other.getVocabIndex(),
+                                                position);
+    }
+    auto getWord = [](const ValueId& id,
+                      ::InlineString& buffer) -> std::string_view {
+      if (id.getDatatype() == LocalVocabIndex) {
+        return id.getLocalVocabIndex()->toStringRepresentation();
+      }
+      buffer = id.getInlineString();
+      return buffer.view();
+    };
+    ::InlineString bufferA;
+    ::InlineString bufferB;
+    return LocalVocabEntry::compareStringRepresentations(
+        getWord(*this, bufferA), getWord(other, bufferB));
+  }
+
   // Helper function for the implementation of the unsigned index types.
   static constexpr ValueId makeFromIndex(T id, Datatype type) {
     if (id > maxIndex) {
@@ -409,6 +409,7 @@ inline std::vector<std::pair<RandomIt, RandomIt>> getRangesForId(
     case Datatype::Undefined:
     case Datatype::VocabIndex:
     case Datatype::LocalVocabIndex:
+    case Datatype::InlineString:
     case Datatype::WordVocabIndex:
     case Datatype::TextRecordIndex:
     case Datatype::Bool:
@@ -453,6 +454,7 @@ inline std::vector<std::pair<RandomIt, RandomIt>> getRangesForEqualIds(
       AD_FAIL();
     case Datatype::VocabIndex:
     case Datatype::LocalVocabIndex:
+    case Datatype::InlineString:
     case Datatype::WordVocabIndex:
     case Datatype::TextRecordIndex:
       return detail::simplifyRanges(detail::getRangesForIndexTypes(
@@ -498,10 +500,13 @@ ComparisonResult compareIdsImpl(ValueId a, ValueId b, auto comparator) {
     }
   }
 
-  // If any of the entries is a `LocalVocabIndex`, then the ordinary comparison
-  // on ValueIds already does the right thing.
-  if (a.getDatatype() == Datatype::LocalVocabIndex ||
-      b.getDatatype() == Datatype::LocalVocabIndex) {
+  // If any of the entries is a `LocalVocabIndex` or an `InlineString`, then the
+  // ordinary comparison on ValueIds already does the right thing.
+  auto isLocalVocabIndexOrInlineString = [](Datatype type) {
+    return type == Datatype::LocalVocabIndex || type == Datatype::InlineString;
+  };
+  if (isLocalVocabIndexOrInlineString(typeA) ||
+      isLocalVocabIndexOrInlineString(typeB)) {
     return fromBool(std::invoke(comparator, a, b));
   }
 
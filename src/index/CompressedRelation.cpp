@@ -4,6 +4,9 @@
 
 #include "CompressedRelation.h"
 
+#include <absl/cleanup/cleanup.h>
+
+#include <atomic>
 #include <ranges>
 
 #include "engine/Engine.h"
@@ -12,12 +15,12 @@
 #include "global/RuntimeParameters.h"
 #include "index/ConstantsIndexBuilding.h"
 #include "index/LocatedTriples.h"
-#include "util/CompressionUsingZstd/ZstdWrapper.h"
+#include "util/BatchedFileReader.h"
 #include "util/Generator.h"
 #include "util/OnDestructionDontThrowDuringStackUnwinding.h"
 #include "util/OverloadCallOperator.h"
 #include "util/ProgressBar.h"
-#include "util/ThreadSafeQueue.h"
+#include "util/SharedWorkerPool.h"
 #include "util/Timer.h"
 #include "util/TransparentFunctors.h"
 #include "util/TypeTraits.h"
@@ -79,6 +82,54 @@ static void pruneBlock(auto& block, LimitOffsetClause& limitOffset) {
   }
 }
 
+// Remove the rows from the `block` for which one of the `rowFilters` (see
+// `ScanSpecification::RowFilter`) returns zero. Return the number of removed
+// rows.
+static size_t applyRowFilters(
+    DecompressedBlock& block,
+    std::span<const ScanSpecification::RowFilterOnColumn> rowFilters) {
+  if (rowFilters.empty() || block.empty()) {
+    return 0;
+  }
+  std::vector<uint8_t> isRelevant(block.numRows(), 1);
+  for (const auto& [rowFilter, column] : rowFilters) {
+    AD_CORRECTNESS_CHECK(rowFilter != nullptr && column < block.numColumns());
+    auto isRelevantForFilter = (*rowFilter)(block.getColumn(column));
+    AD_CORRECTNESS_CHECK(isRelevantForFilter.size() == block.numRows());
+    for (size_t row = 0; row < isRelevant.size(); ++row) {
+      isRelevant[row] &= static_cast<uint8_t>(isRelevantForFilter[row] != 0);
+    }
+  }
+  size_t numRelevant = ql::ranges::count_if(
+      isRelevant, [](uint8_t relevant) { return relevant != 0; });
+  if (numRelevant == block.numRows()) {
+    return 0;
+  }
+  // Compact each column in place, keeping only the relevant rows.
+  for (size_t col = 0; col < block.numColumns(); ++col) {
+    auto column = block.getColumn(col);
+    size_t target = 0;
+    for (size_t row = 0; row < column.size(); ++row) {
+      column[target] = column[row];
+      target += static_cast<size_t>(isRelevant[row] != 0);
+    }
+  }
+  size_t numRemoved = block.numRows() - numRelevant;
+  block.resize(numRelevant);
+  return numRemoved;
+}
+
+// The pool of worker threads that is shared by the lazy index scans of all
+// queries (see `asyncParallelBlockGenerator`).
+static ad_utility::SharedWorkerPool& getIndexScanWorkerPool() {
+  static ad_utility::SharedWorkerPool pool{[]() -> size_t {
+    auto numThreads =
+        RuntimeParameters().get<"index-scan-worker-pool-num-threads">();
+    return numThreads > 0 ? numThreads : std::thread::hardware_concurrency();
+  }()};
+  return pool;
+}
+
 // ____________________________________________________________________________
 CompressedRelationReader::IdTableGenerator
 CompressedRelationReader::asyncParallelBlockGenerator(
@@ -94,79 +145,144 @@ CompressedRelationReader::asyncParallelBlockGenerator(
   const auto& columnIndices = scanConfig.scanColumns_;
   const auto& blockGraphFilter = scanConfig.graphFilter_;
   LazyScanMetadata& details = co_await cppcoro::getDetails;
-  const size_t queueSize =
-      RuntimeParameters().get<"lazy-index-scan-queue-size">();
+  const size_t batchSize = std::max(
+      size_t{1}, RuntimeParameters().get<"lazy-index-scan-io-batch-size">());
+  // The size of the queue is specified in blocks, but the queue contains
+  // batches.
+  const size_t queueSize = std::max(
+      size_t{1},
+      RuntimeParameters().get<"lazy-index-scan-queue-size">() / batchSize);
   auto blockMetadataIterator = beginBlock;
   std::mutex blockIteratorMutex;
-
-  // Helper lambda that reads and decompessed the next block and returns it
-  // together with its index relative to `beginBlock`. Return `std::nullopt`
-  // when `endBlock` is reached. Returns `std::nullopt` for the block if it
-  // is skipped due to the graph filter.
-  auto readAndDecompressBlock = [&]()
-      -> std::optional<
-          std::pair<size_t, std::optional<DecompressedBlockAndMetadata>>> {
+  // The blocks of a batch. Blocks that are skipped due to the graph filter are
+  // `std::nullopt`.
+  using Batch = std::vector<std::optional<DecompressedBlockAndMetadata>>;
+
+  // Helper lambda that reads and decompresses the next batch of (at most
+  // `batchSize`) blocks and returns it together with the index of the batch.
+  // Return `std::nullopt` when `endBlock` is reached. The mutex only protects
+  // the `blockMetadataIterator`, the reading from the file happens without
+  // holding it, s.t. the reads of several threads (and the reads of all the
+  // blocks of a batch, see `readCompressedBlocksFromFile`) are served by the
+  // SSD in parallel.
+  auto readAndDecompressBatch =
+      [&]() -> std::optional<std::pair<size_t, Batch>> {
     cancellationHandle->throwIfCancelled();
     std::unique_lock lock{blockIteratorMutex};
     if (blockMetadataIterator == endBlock) {
       return std::nullopt;
     }
+    // Note: The order of the following lines is important: The index of the
+    // batch depends on the current value of `blockMetadataIterator`, so we have
+    // to compute it before incrementing the iterator.
+    auto myIndex =
+        static_cast<size_t>(blockMetadataIterator - beginBlock) / batchSize;
+    auto numBlocks = std::min(
+        batchSize, static_cast<size_t>(endBlock - blockMetadataIterator));
     // Note: taking a copy here is probably not necessary (the lifetime of
     // all the blocks is long enough, so a `const&` would suffice), but the
     // copy is cheap and makes the code more robust.
-    auto blockMetadata = *blockMetadataIterator;
-    // Note: The order of the following two lines is important: The index
-    // of the current blockMetadata depends on the current value of
-    // `blockMetadataIterator`, so we have to compute it before incrementing the
-    // iterator.
-    auto myIndex = static_cast<size_t>(blockMetadataIterator - beginBlock);
-    ++blockMetadataIterator;
-    if (blockGraphFilter.canBlockBeSkipped(blockMetadata)) {
-      return std::pair{myIndex, std::nullopt};
-    }
-    // Note: the reading of the blockMetadata could also happen without holding
-    // the lock. We still perform it inside the lock to avoid contention of the
-    // file. On a fast SSD we could possibly change this, but this has to be
-    // investigated.
-    CompressedBlock compressedBlock =
-        readCompressedBlockFromFile(blockMetadata, columnIndices);
+    std::vector<CompressedBlockMetadata> blocks(
+        blockMetadataIterator, blockMetadataIterator + numBlocks);
+    blockMetadataIterator += numBlocks;
     lock.unlock();
-    auto decompressedBlockAndMetadata = decompressAndPostprocessBlock(
-        compressedBlock, blockMetadata.numRows_, scanConfig, blockMetadata);
-    return std::pair{myIndex,
-                     std::optional{std::move(decompressedBlockAndMetadata)}};
+
+    // Take the blocks from the cache if possible, and read the remaining ones
+    // from disk.
+    Batch batch(blocks.size());
+    std::vector<size_t> indicesToRead;
+    std::vector<CompressedBlockMetadata> blocksToRead;
+    for (size_t i = 0; i < blocks.size(); ++i) {
+      const auto& blockMetadata = blocks[i];
+      if (blockGraphFilter.canBlockBeSkipped(blockMetadata)) {
+        continue;
+      }
+      auto cachedBlock = getCachedBlock(blockMetadata, columnIndices);
+      if (cachedBlock != nullptr) {
+        batch[i] =
+            postprocessCachedBlock(*cachedBlock, scanConfig, blockMetadata);
+      } else {
+        indicesToRead.push_back(i);
+        blocksToRead.push_back(blockMetadata);
+      }
+    }
+    auto compressedBlocks =
+        readCompressedBlocksFromFile(blocksToRead, columnIndices);
+    for (size_t i = 0; i < blocksToRead.size(); ++i) {
+      cancellationHandle->throwIfCancelled();
+      const auto& blockMetadata = blocksToRead[i];
+      batch[indicesToRead[i]] = decompressAndCacheBlock(
+          compressedBlocks[i], blockMetadata, scanConfig);
+    }
+    return std::pair{myIndex, std::move(batch)};
   };
 
-  // Prepare queue for reading and decompressing blocks concurrently using
-  // `numThreads` threads.
-  const size_t numThreads =
-      RuntimeParameters().get<"lazy-index-scan-num-threads">();
+  // Read and decompress the blocks concurrently on the worker pool that is
+  // shared by all the index scans, using at most `numThreads` of its threads
+  // at the same time. Keep track of the time that the workers spend on this
+  // scan.
+  const size_t numThreads = std::max(
+      size_t{1}, RuntimeParameters().get<"lazy-index-scan-num-threads">());
+  auto& pool = getIndexScanWorkerPool();
+  std::atomic<int64_t> taskTimeMicroseconds = 0;
+  auto timedReadAndDecompressBatch = [&readAndDecompressBatch,
+                                      &taskTimeMicroseconds]() {
+    ad_utility::Timer taskTimer{ad_utility::Timer::Started};
+    auto cleanup = absl::Cleanup{[&taskTimer, &taskTimeMicroseconds]() {
+      taskTimeMicroseconds +=
+          std::chrono::duration_cast<std::chrono::microseconds>(
+              taskTimer.value())
+              .count();
+    }};
+    return readAndDecompressBatch();
+  };
+  const auto poolBusyTimeAtStart = pool.busyTime();
+  ad_utility::Timer wallTimer{ad_utility::Timer::Started};
   ad_utility::Timer popTimer{ad_utility::timer::Timer::InitialStatus::Started};
   // In case the coroutine is destroyed early we still want to have this
   // information.
   auto setTimer = ad_utility::makeOnDestructionDontThrowDuringStackUnwinding(
-      [&details, &popTimer]() { details.blockingTime_ = popTimer.msecs(); });
-  auto queue = ad_utility::data_structures::queueManager<
-      ad_utility::data_structures::OrderedThreadSafeQueue<
-          std::optional<DecompressedBlockAndMetadata>>>(queueSize, numThreads,
-                                                        readAndDecompressBlock);
+      [&details, &popTimer, &pool, &wallTimer, &taskTimeMicroseconds,
+       poolBusyTimeAtStart]() {
+        details.blockingTime_ = popTimer.msecs();
+        details.poolTaskTime_ = std::chrono::duration_cast<
+            std::chrono::milliseconds>(
+            std::chrono::microseconds{taskTimeMicroseconds.load()});
+        // The fraction of the capacity of the pool that was used (by all the
+        // scans) while this scan was running.
+        auto capacity =
+            static_cast<double>(pool.numThreads()) *
+            std::chrono::duration_cast<std::chrono::microseconds>(
+                wallTimer.value())
+                .count();
+        if (capacity > 0) {
+          details.poolUtilization_ = std::min(
+              1.0, static_cast<double>(
+                       (pool.busyTime() - poolBusyTimeAtStart).count()) /
+                       capacity);
+        }
+      });
+  auto queue = pool.orderedGenerator<Batch>(queueSize, numThreads,
+                                            timedReadAndDecompressBatch);
 
   // Yield the blocks (in the right order) as soon as they become available.
   // Stop when all the blocks have been yielded or the LIMIT of the query is
   // reached. Keep track of various statistics.
-  for (std::optional<DecompressedBlockAndMetadata>& optBlock : queue) {
+  for (Batch& batch : queue) {
     popTimer.stop();
-    cancellationHandle->throwIfCancelled();
-    details.update(optBlock);
-    if (optBlock.has_value()) {
-      auto& block = optBlock.value().block_;
-      pruneBlock(block, limitOffset);
-      details.numElementsYielded_ += block.numRows();
-      if (!block.empty()) {
-        co_yield block;
-      }
-      if (limitOffset._limit.value_or(1) == 0) {
-        co_return;
+    for (std::optional<DecompressedBlockAndMetadata>& optBlock : batch) {
+      cancellationHandle->throwIfCancelled();
+      details.update(optBlock);
+      if (optBlock.has_value()) {
+        auto& block = optBlock.value().block_;
+        pruneBlock(block, limitOffset);
+        details.numElementsYielded_ += block.numRows();
+        if (!block.empty()) {
+          co_yield block;
+        }
+        if (limitOffset._limit.value_or(1) == 0) {
+          co_return;
+        }
       }
     }
     popTimer.cont();
@@ -296,6 +412,8 @@ CompressedRelationReader::IdTableGenerator CompressedRelationReader::lazyScan(
     auto result = readPossiblyIncompleteBlock(
         scanSpec, config, *it, std::ref(details), locatedTriplesPerBlock);
     cancellationHandle->throwIfCancelled();
+    details.numElementsFilteredOut_ +=
+        applyRowFilters(result, config.rowFilters_);
     return result;
   };
 
@@ -417,7 +535,8 @@ auto getRelevantIdFromTriple(
 // _____________________________________________________________________________
 std::vector<CompressedBlockMetadata> CompressedRelationReader::getBlocksForJoin(
     std::span<const Id> joinColumn,
-    const ScanSpecAndBlocksAndBounds& metadataAndBlocks) {
+    const ScanSpecAndBlocksAndBounds& metadataAndBlocks,
+    size_t* numBlocksSkippedByCol1Filter) {
   // Get all the blocks where `col0FirstId_ <= col0Id <= col0LastId_`.
   auto relevantBlocks = getBlocksFromMetadata(metadataAndBlocks);
 
@@ -449,8 +568,27 @@ std::vector<CompressedBlockMetadata> CompressedRelationReader::getBlocksForJoin(
   // this doesn't work because the implicit equality defined by
   // `!lessThan(a,b) && !lessThan(b, a)` is not transitive.
   std::vector<CompressedBlockMetadata> result;
-  auto blockIsNeeded = [&joinColumn, &lessThan](const auto& block) {
-    return !ql::ranges::equal_range(joinColumn, block, lessThan).empty();
+  // If the join column is the `col1`, additionally skip the blocks whose Bloom
+  // filter rules out all the `Id`s from the `joinColumn` that lie in the range
+  // of the block.
+  const auto& scanSpec = metadataAndBlocks.scanSpec_;
+  bool joinColumnIsCol1 =
+      scanSpec.col0Id().has_value() && !scanSpec.col1Id().has_value();
+  auto blockIsNeeded = [&joinColumn, &lessThan, joinColumnIsCol1,
+                        numBlocksSkippedByCol1Filter](const auto& block) {
+    auto matchingIds = ql::ranges::equal_range(joinColumn, block, lessThan);
+    if (matchingIds.empty()) {
+      return false;
+    }
+    if (!joinColumnIsCol1 || !block.col1Filter_.has_value()) {
+      return true;
+    }
+    bool mayMatch = ql::ranges::any_of(
+        matchingIds, [&block](Id id) { return block.mayContainCol1(id); });
+    if (!mayMatch && numBlocksSkippedByCol1Filter != nullptr) {
+      ++*numBlocksSkippedByCol1Filter;
+    }
+    return mayMatch;
   };
   ql::ranges::copy(relevantBlocks | ql::views::filter(blockIsNeeded),
                    std::back_inserter(result));
@@ -897,62 +1035,139 @@ void CompressedRelationWriter::writeBufferedRelationsToSingleBlock() {
 CompressedBlock CompressedRelationReader::readCompressedBlockFromFile(
     const CompressedBlockMetadata& blockMetaData,
     ColumnIndicesRef columnIndices) const {
-  CompressedBlock compressedBuffer;
-  compressedBuffer.resize(columnIndices.size());
-  // TODO<C++23> Use `ql::views::zip`
-  for (size_t i = 0; i < compressedBuffer.size(); ++i) {
-    const auto& offset =
-        blockMetaData.offsetsAndCompressedSize_.at(columnIndices[i]);
-    auto& currentCol = compressedBuffer[i];
-    currentCol.resize(offset.compressedSize_);
-    file_.read(currentCol.data(), offset.compressedSize_, offset.offsetInFile_);
+  auto compressedBlocks = readCompressedBlocksFromFile(
+      std::span{&blockMetaData, 1}, columnIndices);
+  return std::move(compressedBlocks.at(0));
+}
+
+// _____________________________________________________________________________
+std::vector<CompressedBlock>
+CompressedRelationReader::readCompressedBlocksFromFile(
+    std::span<const CompressedBlockMetadata> blockMetadata,
+    ColumnIndicesRef columnIndices) const {
+  std::vector<CompressedBlock> compressedBlocks(blockMetadata.size());
+  std::vector<ad_utility::FileReadRequest> requests;
+  requests.reserve(blockMetadata.size() * columnIndices.size());
+  for (size_t i = 0; i < blockMetadata.size(); ++i) {
+    auto& compressedBuffer = compressedBlocks[i];
+    compressedBuffer.resize(columnIndices.size());
+    // TODO<C++23> Use `ql::views::zip`
+    for (size_t j = 0; j < compressedBuffer.size(); ++j) {
+      const auto& offset =
+          blockMetadata[i].offsetsAndCompressedSize_.at(columnIndices[j]);
+      auto& currentCol = compressedBuffer[j];
+      currentCol.resize(offset.compressedSize_);
+      requests.push_back(
+          {currentCol.data(), offset.compressedSize_, offset.offsetInFile_});
+    }
   }
-  return compressedBuffer;
+  ad_utility::readBatch(file_, requests);
+  return compressedBlocks;
 }
 
 // ____________________________________________________________________________
 DecompressedBlock CompressedRelationReader::decompressBlock(
-    const CompressedBlock& compressedBlock, size_t numRowsToRead) const {
+    const CompressedBlock& compressedBlock,
+    const CompressedBlockMetadata& blockMetadata,
+    ColumnIndicesRef columnIndices) const {
+  AD_CORRECTNESS_CHECK(compressedBlock.size() == columnIndices.size());
   DecompressedBlock decompressedBlock{compressedBlock.size(), allocator_};
-  decompressedBlock.resize(numRowsToRead);
+  decompressedBlock.resize(blockMetadata.numRows_);
   for (size_t i = 0; i < compressedBlock.size(); ++i) {
     auto col = decompressedBlock.getColumn(i);
-    decompressColumn(compressedBlock[i], numRowsToRead, col.data());
+    const auto& codec =
+        blockMetadata.offsetsAndCompressedSize_.at(columnIndices[i]).codec_;
+    decompressColumn(compressedBlock[i], codec, blockMetadata.numRows_,
+                     col.data());
   }
   return decompressedBlock;
 }
 
 // ____________________________________________________________________________
-DecompressedBlockAndMetadata
-CompressedRelationReader::decompressAndPostprocessBlock(
-    const CompressedBlock& compressedBlock, size_t numRowsToRead,
+std::shared_ptr<const DecompressedBlock>
+CompressedRelationReader::getCachedBlock(
+    const CompressedBlockMetadata& blockMetadata,
+    ColumnIndicesRef columnIndices) const {
+  return DecompressedBlockCache::get().lookup(
+      {blockCacheId_,
+       blockMetadata.blockIndex_,
+       {columnIndices.begin(), columnIndices.end()}});
+}
+
+// ____________________________________________________________________________
+DecompressedBlockAndMetadata CompressedRelationReader::decompressAndCacheBlock(
+    const CompressedBlock& compressedBlock,
+    const CompressedBlockMetadata& blockMetadata,
+    const ScanImplConfig& scanConfig) const {
+  const auto& columnIndices = scanConfig.scanColumns_;
+  auto decompressedBlock =
+      decompressBlock(compressedBlock, blockMetadata, columnIndices);
+  auto& cache = DecompressedBlockCache::get();
+  if (!cache.isEnabled()) {
+    return postprocessBlock(std::move(decompressedBlock), scanConfig,
+                            blockMetadata);
+  }
+  // The block was allocated with `allocator_`, so it stays counted against
+  // the memory limit while it is cached.
+  auto sharedBlock =
+      std::make_shared<DecompressedBlock>(std::move(decompressedBlock));
+  cache.insert({blockCacheId_,
+                blockMetadata.blockIndex_,
+                {columnIndices.begin(), columnIndices.end()}},
+               sharedBlock);
+  return postprocessCachedBlock(*sharedBlock, scanConfig, blockMetadata);
+}
+
+// ____________________________________________________________________________
+DecompressedBlockAndMetadata CompressedRelationReader::postprocessBlock(
+    DecompressedBlock decompressedBlock,
+    const CompressedRelationReader::ScanImplConfig& scanConfig,
+    const CompressedBlockMetadata& metadata) const {
+  if (!scanConfig.locatedTriples_.containsTriples(metadata.blockIndex_)) {
+    return filterBlock(std::move(decompressedBlock), false, scanConfig,
+                       metadata);
+  }
+  return postprocessCachedBlock(decompressedBlock, scanConfig, metadata);
+}
+
+// ____________________________________________________________________________
+DecompressedBlockAndMetadata CompressedRelationReader::postprocessCachedBlock(
+    const DecompressedBlock& cachedBlock,
     const CompressedRelationReader::ScanImplConfig& scanConfig,
     const CompressedBlockMetadata& metadata) const {
-  auto decompressedBlock = decompressBlock(compressedBlock, numRowsToRead);
+  if (!scanConfig.locatedTriples_.containsTriples(metadata.blockIndex_)) {
+    return filterBlock(cachedBlock.clone(), false, scanConfig, metadata);
+  }
   auto [numIndexColumns, includeGraphColumn] =
       prepareLocatedTriples(scanConfig.scanColumns_);
-  bool hasUpdates = false;
-  if (scanConfig.locatedTriples_.containsTriples(metadata.blockIndex_)) {
-    decompressedBlock = scanConfig.locatedTriples_.mergeTriples(
-        metadata.blockIndex_, decompressedBlock, numIndexColumns,
-        includeGraphColumn);
-    hasUpdates = true;
-  }
+  return filterBlock(
+      scanConfig.locatedTriples_.mergeTriples(metadata.blockIndex_, cachedBlock,
+                                              numIndexColumns,
+                                              includeGraphColumn),
+      true, scanConfig, metadata);
+}
+
+// ____________________________________________________________________________
+DecompressedBlockAndMetadata CompressedRelationReader::filterBlock(
+    DecompressedBlock block, bool hasUpdates,
+    const CompressedRelationReader::ScanImplConfig& scanConfig,
+    const CompressedBlockMetadata& metadata) const {
   bool wasPostprocessed =
-      scanConfig.graphFilter_.postprocessBlock(decompressedBlock, metadata);
-  return {std::move(decompressedBlock), wasPostprocessed, hasUpdates};
+      scanConfig.graphFilter_.postprocessBlock(block, metadata);
+  size_t numRowsFilteredOut = applyRowFilters(block, scanConfig.rowFilters_);
+  return {std::move(block), wasPostprocessed, hasUpdates, numRowsFilteredOut};
 }
 
 // ____________________________________________________________________________
 template <typename Iterator>
 void CompressedRelationReader::decompressColumn(
-    const std::vector<char>& compressedBlock, size_t numRowsToRead,
-    Iterator iterator) {
-  auto numBytesActuallyRead = ZstdWrapper::decompressToBuffer(
-      compressedBlock.data(), compressedBlock.size(), iterator,
-      numRowsToRead * sizeof(*iterator));
-  static_assert(sizeof(Id) == sizeof(*iterator));
-  AD_CORRECTNESS_CHECK(numRowsToRead * sizeof(Id) == numBytesActuallyRead);
+    const std::vector<char>& compressedBlock, ad_utility::ColumnCodec codec,
+    size_t numRowsToRead, Iterator iterator) {
+  static_assert(sizeof(Id) == sizeof(uint64_t) &&
+                sizeof(Id) == sizeof(*iterator));
+  ad_utility::decodeColumn(
+      codec, compressedBlock,
+      {reinterpret_cast<uint64_t*>(&*iterator), numRowsToRead});
 }
 
 // ____________________________________________________________________________
@@ -963,23 +1178,27 @@ CompressedRelationReader::readAndDecompressBlock(
   if (scanConfig.graphFilter_.canBlockBeSkipped(blockMetaData)) {
     return std::nullopt;
   }
-  CompressedBlock compressedColumns =
-      readCompressedBlockFromFile(blockMetaData, scanConfig.scanColumns_);
-  const auto numRowsToRead = blockMetaData.numRows_;
-  return decompressAndPostprocessBlock(compressedColumns, numRowsToRead,
-                                       scanConfig, blockMetaData);
+  const auto& columnIndices = scanConfig.scanColumns_;
+  auto cachedBlock = getCachedBlock(blockMetaData, columnIndices);
+  if (cachedBlock != nullptr) {
+    return postprocessCachedBlock(*cachedBlock, scanConfig, blockMetaData);
+  }
+  return decompressAndCacheBlock(
+      readCompressedBlockFromFile(blockMetaData, columnIndices), blockMetaData,
+      scanConfig);
 }
 
 // ____________________________________________________________________________
 CompressedBlockMetadata::OffsetAndCompressedSize
 CompressedRelationWriter::compressAndWriteColumn(std::span<const Id> column) {
-  std::vector<char> compressedBlock = ZstdWrapper::compress(
-      (void*)(column.data()), column.size() * sizeof(column[0]));
+  static_assert(sizeof(Id) == sizeof(uint64_t));
+  auto [codec, compressedBlock] = ad_utility::encodeColumn(
+      {reinterpret_cast<const uint64_t*>(column.data()), column.size()});
   auto compressedSize = compressedBlock.size();
   auto file = outfile_.wlock();
   auto offsetInFile = file->tell();
   file->write(compressedBlock.data(), compressedBlock.size());
-  return {offsetInFile, compressedSize};
+  return {offsetInFile, compressedSize, codec};
 };
 
 // Find out whether the sorted `block` contains duplicates and whether it
@@ -1021,6 +1240,42 @@ static std::pair<bool, std::optional<std::vector<Id>>> getGraphInfo(
   return {hasDuplicates(), graphInfo()};
 }
 
+// Compute the `ColumnSummary`s of the first three columns of the `block`.
+static std::array<CompressedBlockMetadata::ColumnSummary, 3>
+computeColumnSummaries(const IdTable& block) {
+  std::array<CompressedBlockMetadata::ColumnSummary, 3> summaries;
+  for (size_t i = 0; i < summaries.size(); ++i) {
+    for (Id id : block.getColumn(i)) {
+      summaries[i].add(id);
+    }
+  }
+  return summaries;
+}
+
+// Build the Bloom filter of the `col1` of the `block` (see
+// `CompressedBlockMetadata::col1Filter_`). Blocks with `Id`s that can't be
+// stored in the filter get no filter.
+static std::optional<ad_utility::BloomFilter> computeCol1Filter(
+    const IdTable& block, const ad_utility::BloomFilterBudget& budget) {
+  auto col1 = block.getColumn(1);
+  if (!ql::ranges::all_of(col1, &CompressedBlockMetadata::canBeInCol1Filter)) {
+    return std::nullopt;
+  }
+  // The `col1` is sorted for each `col0Id`, so the number of changes between
+  // adjacent values is (a close upper bound for) the number of distinct keys.
+  size_t numDistinct = col1.empty() ? 0 : 1;
+  for (size_t i = 1; i < col1.size(); ++i) {
+    numDistinct += col1[i] != col1[i - 1];
+  }
+  auto filter = ad_utility::BloomFilter::forNumKeys(numDistinct, budget);
+  if (filter.has_value()) {
+    for (Id id : col1) {
+      filter->add(id.getBits());
+    }
+  }
+  return filter;
+}
+
 // _____________________________________________________________________________
 void CompressedRelationWriter::compressAndWriteBlock(
     Id firstCol0Id, Id lastCol0Id, std::shared_ptr<IdTable> block,
@@ -1046,7 +1301,9 @@ void CompressedRelationWriter::compressAndWriteBlock(
         {first[0], first[1], first[2], first[3]},
         {last[0], last[1], last[2], last[3]},
         std::move(graphInfo),
-        hasDuplicates});
+        hasDuplicates,
+        computeColumnSummaries(*block),
+        computeCol1Filter(*block, bloomFilterBudget_)});
     if (invokeCallback && smallBlocksCallback_) {
       std::invoke(smallBlocksCallback_, std::move(block));
     }
@@ -1088,7 +1345,19 @@ CompressedRelationReader::getRelevantBlocks(
     return blockA.lastTriple_ < blockB.firstTriple_;
   };
 
-  return ql::ranges::equal_range(blockMetadata, key, comp);
+  std::span<const CompressedBlockMetadata> result =
+      ql::ranges::equal_range(blockMetadata, key, comp);
+
+  // Point lookups: If the `col0Id` and `col1Id` are fixed, but don't occur in
+  // the index, then there is at most one block whose range contains them. The
+  // Bloom filter of this block can often show that the block doesn't have to
+  // be read at all.
+  if (scanSpec.col0Id().has_value() && scanSpec.col1Id().has_value() &&
+      result.size() == 1 &&
+      !result.front().mayContainCol1(scanSpec.col1Id().value())) {
+    return result.subspan(0, 0);
+  }
+  return result;
 }
 
 // _____________________________________________________________________________
@@ -1630,7 +1899,8 @@ auto CompressedRelationReader::getScanConfig(
   }();
   FilterDuplicatesAndGraphs graphFilter{scanSpec.graphsToFilter(),
                                         graphColumnIndex, deleteGraphColumn};
-  return {std::move(columnIndices), std::move(graphFilter), locatedTriples};
+  return {std::move(columnIndices), std::move(graphFilter), locatedTriples,
+          scanSpec.rowFilters()};
 }
 
 // _____________________________________________________________________________
@@ -1641,7 +1911,9 @@ void CompressedRelationReader::LazyScanMetadata::update(
   numBlocksWithUpdate_ +=
       static_cast<size_t>(blockAndMetadata.containsUpdates_);
   ++numBlocksRead_;
-  numElementsRead_ += blockAndMetadata.block_.numRows();
+  numElementsRead_ +=
+      blockAndMetadata.block_.numRows() + blockAndMetadata.numRowsFilteredOut_;
+  numElementsFilteredOut_ += blockAndMetadata.numRowsFilteredOut_;
 }
 
 // _____________________________________________________________________________
@@ -1663,6 +1935,11 @@ void CompressedRelationReader::LazyScanMetadata::aggregate(
   numBlocksAll_ += newValue.numBlocksAll_;
   numElementsRead_ += newValue.numElementsRead_;
   numBlocksSkippedBecauseOfGraph_ += newValue.numBlocksSkippedBecauseOfGraph_;
+  numBlocksSkippedBecauseOfBloomFilter_ +=
+      newValue.numBlocksSkippedBecauseOfBloomFilter_;
   numBlocksPostprocessed_ += newValue.numBlocksPostprocessed_;
   numBlocksWithUpdate_ += newValue.numBlocksWithUpdate_;
+  numElementsFilteredOut_ += newValue.numElementsFilteredOut_;
+  poolTaskTime_ += newValue.poolTaskTime_;
+  poolUtilization_ = std::max(poolUtilization_, newValue.poolUtilization_);
 }
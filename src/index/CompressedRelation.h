@@ -4,15 +4,20 @@
 
 #pragma once
 
+#include <array>
+#include <cstdint>
 #include <type_traits>
 #include <vector>
 
 #include "backports/algorithm.h"
 #include "engine/idTable/IdTable.h"
 #include "global/Id.h"
+#include "index/DecompressedBlockCache.h"
 #include "index/ScanSpecification.h"
 #include "parser/data/LimitOffsetClause.h"
+#include "util/BloomFilter.h"
 #include "util/CancellationHandle.h"
+#include "util/ColumnCodec.h"
 #include "util/File.h"
 #include "util/Generator.h"
 #include "util/MemorySize/MemorySize.h"
@@ -44,6 +49,9 @@ struct DecompressedBlockAndMetadata {
   // True iff triples this block had to be merged with the `LocatedTriples`
   // because it contained updates.
   bool containsUpdates_;
+  // The number of rows that were removed by the `RowFilter`s of the scan (see
+  // `ScanSpecification`).
+  size_t numRowsFilteredOut_ = 0;
 };
 
 // After compression the columns have different sizes, so we cannot use an
@@ -57,6 +65,8 @@ struct CompressedBlockMetadataNoBlockIndex {
   struct OffsetAndCompressedSize {
     off_t offsetInFile_;
     size_t compressedSize_;
+    // The encoding of the column (chosen per column when the index is built).
+    ad_utility::ColumnCodec codec_ = ad_utility::ColumnCodec::Zstd;
     bool operator==(const OffsetAndCompressedSize&) const = default;
   };
 
@@ -109,6 +119,64 @@ struct CompressedBlockMetadataNoBlockIndex {
   // blocks.
   bool containsDuplicatesWithDifferentGraphs_;
 
+  // A summary of the values of a single column of the block (also known as a
+  // "zone map"): The smallest and the largest `Id` and the set of the contained
+  // datatypes. In contrast to the `firstTriple_` and `lastTriple_`, these can
+  // also be used to skip blocks when filtering on a column by which the blocks
+  // are not sorted, for example the objects of a large relation in the PSO
+  // permutation.
+  struct ColumnSummary {
+    Id min_ = Id::max();
+    Id max_ = Id::min();
+    // Bit `i` is set iff the column contains an `Id` with `Datatype` `i`.
+    uint16_t datatypes_ = 0;
+    static_assert(static_cast<size_t>(Datatype::MaxValue) < 16);
+
+    // Add the `id` to the summary.
+    void add(Id id) {
+      min_ = std::min(min_, id);
+      max_ = std::max(max_, id);
+      datatypes_ |= uint16_t{1} << static_cast<size_t>(id.getDatatype());
+    }
+
+    bool containsDatatype(Datatype datatype) const {
+      return (datatypes_ >> static_cast<size_t>(datatype)) & 1;
+    }
+
+    bool operator==(const ColumnSummary&) const = default;
+    friend std::true_type allowTrivialSerialization(ColumnSummary, auto);
+  };
+  // The summaries of the columns `col0`, `col1` and `col2` of the block.
+  // `std::nullopt` means that there is no summary (for example for blocks that
+  // only consist of inserted triples), such blocks can never be skipped based
+  // on the summaries.
+  std::optional<std::array<ColumnSummary, 3>> columnSummaries_ = std::nullopt;
+
+  // A Bloom filter of the `Id`s in the `col1` of the block (for all the
+  // `col0Id`s in the block). It allows skipping blocks for point lookups and
+  // joins on `col1`, where the `firstTriple_` and `lastTriple_` only give a
+  // (possibly large) range. `std::nullopt` means that no filter was built (see
+  // `ad_utility::BloomFilterBudget`).
+  std::optional<ad_utility::BloomFilter> col1Filter_ = std::nullopt;
+
+  // Return false if the `col1` of this block definitely doesn't contain `id`.
+  bool mayContainCol1(Id id) const {
+    return !col1Filter_.has_value() || !canBeInCol1Filter(id) ||
+           col1Filter_->mayContain(id.getBits());
+  }
+
+  // The `col1Filter_` hashes the bits of the `Id`s, so it only works for
+  // `Id`s that are equal iff their bits are equal. This is not the case for
+  // `LocalVocabIndex` and `InlineString`, which are compared by their string
+  // values (the same string can be stored in different `LocalVocab`s or be
+  // equal to a `VocabIndex`). Such `Id`s are never looked up in the filter,
+  // and blocks that contain them in their `col1` have no filter.
+  static bool canBeInCol1Filter(Id id) {
+    auto datatype = id.getDatatype();
+    return datatype != Datatype::LocalVocabIndex &&
+           datatype != Datatype::InlineString;
+  }
+
   // Two of these are equal if all members are equal.
   bool operator==(const CompressedBlockMetadataNoBlockIndex&) const = default;
 
@@ -154,6 +222,7 @@ struct CompressedBlockMetadata : CompressedBlockMetadataNoBlockIndex {
 AD_SERIALIZE_FUNCTION(CompressedBlockMetadata::OffsetAndCompressedSize) {
   serializer | arg.offsetInFile_;
   serializer | arg.compressedSize_;
+  serializer | arg.codec_;
 }
 
 // Serialization of the block metadata.
@@ -164,6 +233,8 @@ AD_SERIALIZE_FUNCTION(CompressedBlockMetadata) {
   serializer | arg.lastTriple_;
   serializer | arg.graphInfo_;
   serializer | arg.containsDuplicatesWithDifferentGraphs_;
+  serializer | arg.columnSummaries_;
+  serializer | arg.col1Filter_;
   serializer | arg.blockIndex_;
 }
 
@@ -228,6 +299,8 @@ class CompressedRelationWriter {
   // A buffer for small relations that will be stored in the same block.
   SmallRelationsBuffer smallRelationsBuffer_{numColumns_, allocator_};
   ad_utility::MemorySize uncompressedBlocksizePerColumn_;
+  // The budget for the Bloom filters on `col1` of the written blocks.
+  ad_utility::BloomFilterBudget bloomFilterBudget_;
 
   // When we store a large relation with multiple blocks then we keep track of
   // its `col0Id`, mostly for sanity checks.
@@ -251,10 +324,12 @@ class CompressedRelationWriter {
   /// Create using a filename, to which the relation data will be written.
   explicit CompressedRelationWriter(
       size_t numColumns, ad_utility::File f,
-      ad_utility::MemorySize uncompressedBlocksizePerColumn)
+      ad_utility::MemorySize uncompressedBlocksizePerColumn,
+      ad_utility::BloomFilterBudget bloomFilterBudget = {})
       : outfile_{std::move(f)},
         numColumns_{numColumns},
-        uncompressedBlocksizePerColumn_{uncompressedBlocksizePerColumn} {}
+        uncompressedBlocksizePerColumn_{uncompressedBlocksizePerColumn},
+        bloomFilterBudget_{bloomFilterBudget} {}
   // Two helper types used to make the interface of the function
   // `createPermutationPair` below safer and more explicit.
   using MetadataCallback =
@@ -347,8 +422,9 @@ class CompressedRelationWriter {
   // data of the written block. Then clear `smallRelationsBuffer_`.
   void writeBufferedRelationsToSingleBlock();
 
-  // Compress the `column` and write it to the `outfile_`. Return the offset and
-  // size of the compressed column in the `outfile_`.
+  // Compress the `column` with the best suited `ColumnCodec` and write it to
+  // the `outfile_`. Return the offset, size, and codec of the compressed column
+  // in the `outfile_`.
   CompressedBlockMetadata::OffsetAndCompressedSize compressAndWriteColumn(
       std::span<const Id> column);
 
@@ -460,6 +536,9 @@ class CompressedRelationReader {
     ColumnIndices scanColumns_;
     FilterDuplicatesAndGraphs graphFilter_;
     const LocatedTriplesPerBlock& locatedTriples_;
+    // The filters on the rows of the scan (see `ScanSpecification::RowFilter`).
+    // Empty if all rows are needed.
+    std::vector<ScanSpecification::RowFilterOnColumn> rowFilters_ = {};
   };
 
   // The specification of scan, together with the blocks on which this scan is
@@ -498,6 +577,9 @@ class CompressedRelationReader {
     // The number of blocks that are skipped by looking only at their metadata
     // (because the graph IDs of the block did not match the query).
     size_t numBlocksSkippedBecauseOfGraph_ = 0;
+    // The number of blocks that were skipped for a join because their Bloom
+    // filter didn't contain any of the join `Id`s (see `getBlocksForJoin`).
+    size_t numBlocksSkippedBecauseOfBloomFilter_ = 0;
     size_t numBlocksPostprocessed_ = 0;
     // The number of blocks that contain updated (inserted or deleted) triples.
     size_t numBlocksWithUpdate_ = 0;
@@ -505,11 +587,20 @@ class CompressedRelationReader {
     // actually yield.
     size_t numElementsRead_ = 0;
     size_t numElementsYielded_ = 0;
+    // The number of rows that were removed by the `RowFilter`s of the scan
+    // (see `ScanSpecification`).
+    size_t numElementsFilteredOut_ = 0;
     std::chrono::milliseconds blockingTime_ = std::chrono::milliseconds::zero();
+    // The time that the threads of the shared worker pool have spent reading
+    // and decompressing blocks for this scan.
+    std::chrono::milliseconds poolTaskTime_ = std::chrono::milliseconds::zero();
+    // The fraction (between 0 and 1) of the threads of the shared worker pool
+    // that were busy (with any scan) while this scan was running.
+    double poolUtilization_ = 0;
 
     // Update this metadata, given the metadata from `blockAndMetadata`.
     // Currently updates: `numBlocksPostprocessed_`, `numBlocksWithUpdate_`,
-    // `numElementsRead_`, and `numBlocksRead_`.
+    // `numElementsRead_`, `numElementsFilteredOut_`, and `numBlocksRead_`.
     void update(const DecompressedBlockAndMetadata& blockAndMetadata);
     // `nullopt` means the block was skipped because of the graph filters, else
     // call the overload directly above.
@@ -529,6 +620,9 @@ class CompressedRelationReader {
   // The file that stores the actual permutations.
   ad_utility::File file_;
 
+  // Identifies the blocks of this reader in the `DecompressedBlockCache`.
+  size_t blockCacheId_ = DecompressedBlockCache::get().getNewReaderId();
+
  public:
   explicit CompressedRelationReader(Allocator allocator, ad_utility::File file)
       : allocator_{std::move(allocator)}, file_{std::move(file)} {}
@@ -539,10 +633,14 @@ class CompressedRelationReader {
   // `metadataAndBlocks`). The join column of the scan is the first column that
   // is not fixed by the `metadataAndBlocks`, so the middle column (col1) in
   // case the `metadataAndBlocks` doesn't contain a `col1Id`, or the last column
-  // (col2) else.
+  // (col2) else. If the join column is the col1, then the Bloom filters of the
+  // blocks (see `CompressedBlockMetadata::col1Filter_`) are used to skip
+  // additional blocks. The number of these blocks is added to
+  // `*numBlocksSkippedByCol1Filter` (unless it is `nullptr`).
   static std::vector<CompressedBlockMetadata> getBlocksForJoin(
       std::span<const Id> joinColumn,
-      const ScanSpecAndBlocksAndBounds& metadataAndBlocks);
+      const ScanSpecAndBlocksAndBounds& metadataAndBlocks,
+      size_t* numBlocksSkippedByCol1Filter = nullptr);
 
   // For each of `metadataAndBlocks, metadataAndBlocks2` get the blocks (an
   // ordered subset of the blocks in the `scanMetadata` that might contain
@@ -668,33 +766,76 @@ class CompressedRelationReader {
       const CompressedBlockMetadata& blockMetaData,
       ColumnIndicesRef columnIndices) const;
 
-  // Decompress the `compressedBlock`. The number of rows that the block will
-  // have after decompression must be passed in via the `numRowsToRead`
-  // argument. It is typically obtained from the corresponding
-  // `CompressedBlockMetaData`.
-  DecompressedBlock decompressBlock(const CompressedBlock& compressedBlock,
-                                    size_t numRowsToRead) const;
-
-  // Helper function used by `decompressBlock` and
-  // `decompressBlockToExistingIdTable`. Decompress the `compressedColumn` and
-  // store the result at the `iterator`. For the `numRowsToRead` argument, see
-  // the documentation of `decompressBlock`.
+  // Like `readCompressedBlockFromFile`, but read all the blocks given by the
+  // `blockMetadata` with a single batch of reads (see `ad_utility::readBatch`),
+  // which are performed concurrently if possible.
+  std::vector<CompressedBlock> readCompressedBlocksFromFile(
+      std::span<const CompressedBlockMetadata> blockMetadata,
+      ColumnIndicesRef columnIndices) const;
+
+  // Decompress the `compressedBlock`, which contains the `columnIndices` of
+  // the block described by the `blockMetadata` (which determines the number of
+  // rows and the codecs of the columns).
+  DecompressedBlock decompressBlock(
+      const CompressedBlock& compressedBlock,
+      const CompressedBlockMetadata& blockMetadata,
+      ColumnIndicesRef columnIndices) const;
+
+  // Return the block that is identified by the `blockMetadata` with the
+  // `columnIndices` from the `DecompressedBlockCache`, or `nullptr` if it is
+  // not contained there. The block is shared with the cache and is therefore
+  // read-only.
+  std::shared_ptr<const DecompressedBlock> getCachedBlock(
+      const CompressedBlockMetadata& blockMetadata,
+      ColumnIndicesRef columnIndices) const;
+
+  // Decompress the `compressedBlock` (see `decompressBlock`), which was read
+  // for the `blockMetadata` and the `scanColumns_` of the `scanConfig`, store
+  // the result in the `DecompressedBlockCache`, and postprocess it (see
+  // `postprocessBlock`).
+  DecompressedBlockAndMetadata decompressAndCacheBlock(
+      const CompressedBlock& compressedBlock,
+      const CompressedBlockMetadata& blockMetadata,
+      const ScanImplConfig& scanConfig) const;
+
+  // Helper function used by `decompressBlock`. Decompress the
+  // `compressedColumn`, which was encoded with the `codec`, and store the
+  // `numRowsToRead` many values at the `iterator`.
   template <typename Iterator>
   static void decompressColumn(const std::vector<char>& compressedColumn,
+                               ad_utility::ColumnCodec codec,
                                size_t numRowsToRead, Iterator iterator);
 
   // Read and decompress the parts of the block given by `blockMetaData` (which
   // identifies the block) and `scanConfig` (which specifies the part of that
-  // block).
+  // block), and postprocess it (see `postprocessBlock`). The decompressed
+  // block is taken from the `DecompressedBlockCache` if possible.
   std::optional<DecompressedBlockAndMetadata> readAndDecompressBlock(
       const CompressedBlockMetadata& blockMetaData,
       const ScanImplConfig& scanConfig) const;
 
-  // Like `readAndDecompressBlock`, and postprocess by merging the located
-  // triples (if any) and applying the graph filters (if any), both specified
-  // as part of the `scanConfig`.
-  DecompressedBlockAndMetadata decompressAndPostprocessBlock(
-      const CompressedBlock& compressedBlock, size_t numRowsToRead,
+  // Postprocess the `decompressedBlock` by merging the located triples (if
+  // any) and applying the graph filters and row filters (if any), all
+  // specified as part of the `scanConfig`.
+  DecompressedBlockAndMetadata postprocessBlock(
+      DecompressedBlock decompressedBlock,
+      const CompressedRelationReader::ScanImplConfig& scanConfig,
+      const CompressedBlockMetadata& metadata) const;
+
+  // Same as `postprocessBlock`, but for a `cachedBlock` from the
+  // `DecompressedBlockCache`, which is not modified. The result is the only
+  // copy of the block that is made: the located triples are merged into a new
+  // block anyway, otherwise the `cachedBlock` is copied.
+  DecompressedBlockAndMetadata postprocessCachedBlock(
+      const DecompressedBlock& cachedBlock,
+      const CompressedRelationReader::ScanImplConfig& scanConfig,
+      const CompressedBlockMetadata& metadata) const;
+
+  // Helper function for `postprocessBlock` and `postprocessCachedBlock`:
+  // Apply the graph filters and row filters of the `scanConfig` to the
+  // `block`, into which the located triples have already been merged.
+  DecompressedBlockAndMetadata filterBlock(
+      DecompressedBlock block, bool hasUpdates,
       const CompressedRelationReader::ScanImplConfig& scanConfig,
       const CompressedBlockMetadata& metadata) const;
 
@@ -715,7 +856,8 @@ class CompressedRelationReader {
   // `columnIndices` are set, only the specified columns from the blocks
   // are yielded, else all columns are yielded. The blocks are yielded
   // in the correct order, but asynchronously read and decompressed using
-  // multiple worker threads.
+  // multiple worker threads. Each thread reads batches of consecutive blocks
+  // (see the runtime parameter `lazy-index-scan-io-batch-size`).
   IdTableGenerator asyncParallelBlockGenerator(
       auto beginBlock, auto endBlock, const ScanImplConfig& scanConfig,
       CancellationHandle cancellationHandle,
@@ -0,0 +1,80 @@
+//  Copyright 2025, University of Freiburg,
+//                  Chair of Algorithms and Data Structures.
+
+#include "index/DecompressedBlockCache.h"
+
+#include <limits>
+
+#include "global/RuntimeParameters.h"
+
+// _____________________________________________________________________________
+DecompressedBlockCache::DecompressedBlockCache(ad_utility::MemorySize maxSize)
+    : cache_{std::numeric_limits<size_t>::max(), maxSize, maxSize},
+      maxSizeInBytes_{maxSize.getBytes()} {}
+
+// _____________________________________________________________________________
+DecompressedBlockCache& DecompressedBlockCache::get() {
+  static DecompressedBlockCache cache{
+      RuntimeParameters().get<"decompressed-block-cache-max-size">()};
+  return cache;
+}
+
+// _____________________________________________________________________________
+std::shared_ptr<const IdTable> DecompressedBlockCache::lookup(const Key& key) {
+  if (!isEnabled()) {
+    return nullptr;
+  }
+  // The block stays valid because of the `shared_ptr`, even if it is evicted
+  // while it is still used.
+  auto block = (*cache_.wlock())[key];
+  if (block == nullptr) {
+    ++numMisses_;
+    return nullptr;
+  }
+  ++numHits_;
+  numBytesSaved_ += SizeGetter{}(*block).getBytes();
+  return block;
+}
+
+// _____________________________________________________________________________
+void DecompressedBlockCache::insert(const Key& key,
+                                    std::shared_ptr<IdTable> block) {
+  if (!isEnabled()) {
+    return;
+  }
+  auto lock = cache_.wlock();
+  if (!lock->contains(key)) {
+    lock->insert(key, std::move(block));
+  }
+}
+
+// _____________________________________________________________________________
+void DecompressedBlockCache::setMaxSize(ad_utility::MemorySize maxSize) {
+  maxSizeInBytes_ = maxSize.getBytes();
+  auto lock = cache_.wlock();
+  lock->setMaxSize(maxSize);
+  lock->setMaxSizeSingleEntry(maxSize);
+}
+
+// _____________________________________________________________________________
+bool DecompressedBlockCache::makeRoomAsMuchAsPossible(
+    ad_utility::MemorySize size) {
+  return cache_.wlock()->makeRoomAsMuchAsPossible(size);
+}
+
+// _____________________________________________________________________________
+void DecompressedBlockCache::clear() { cache_.wlock()->clearAll(); }
+
+// _____________________________________________________________________________
+DecompressedBlockCache::Statistics DecompressedBlockCache::getStatistics()
+    const {
+  Statistics statistics;
+  statistics.numHits_ = numHits_;
+  statistics.numMisses_ = numMisses_;
+  statistics.numBytesSaved_ = numBytesSaved_;
+  statistics.maxSize_ = ad_utility::MemorySize::bytes(maxSizeInBytes_);
+  auto lock = cache_.wlock();
+  statistics.numEntries_ = lock->numNonPinnedEntries();
+  statistics.size_ = lock->nonPinnedSize();
+  return statistics;
+}
@@ -0,0 +1,121 @@
+//  Copyright 2025, University of Freiburg,
+//                  Chair of Algorithms and Data Structures.
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "engine/idTable/IdTable.h"
+#include "global/Id.h"
+#include "util/Cache.h"
+#include "util/MemorySize/MemorySize.h"
+#include "util/Synchronized.h"
+
+// A process-wide cache of decompressed blocks of the permutations. Without
+// it, every scan reads and decompresses all its blocks from disk, even if the
+// same (hot) blocks have just been decompressed for another query.
+//
+// The cache stores the blocks exactly as they are on disk, that is before the
+// located triples are merged and before the graphs are filtered, so it is
+// independent of the updates and of the query. An entry is identified by the
+// reader of the permutation (see `getNewReaderId`), the index of the block,
+// and the columns that were read. The size of the cache is bounded by the
+// runtime parameter `decompressed-block-cache-max-size`; a size of zero
+// disables the cache.
+//
+// The cache does not copy the blocks, it shares them with the scans, which
+// only read them. The blocks are allocated by the scans with the allocator of
+// the index, so the cached blocks are counted against `memory-max-size` like
+// all other intermediate results.
+class DecompressedBlockCache {
+ public:
+  struct Key {
+    size_t readerId_;
+    size_t blockIndex_;
+    std::vector<ColumnIndex> columns_;
+
+    bool operator==(const Key&) const = default;
+
+    template <typename H>
+    friend H AbslHashValue(H h, const Key& key) {
+      return H::combine(std::move(h), key.readerId_, key.blockIndex_,
+                        key.columns_);
+    }
+  };
+
+  // The statistics that are reported by `cmd=cache-stats`.
+  struct Statistics {
+    size_t numHits_ = 0;
+    size_t numMisses_ = 0;
+    // The number of bytes that did not have to be decompressed because of the
+    // hits.
+    size_t numBytesSaved_ = 0;
+    size_t numEntries_ = 0;
+    ad_utility::MemorySize size_;
+    ad_utility::MemorySize maxSize_;
+
+    double hitRate() const {
+      size_t numLookups = numHits_ + numMisses_;
+      return numLookups == 0 ? 0.0
+                             : static_cast<double>(numHits_) / numLookups;
+    }
+  };
+
+ private:
+  struct SizeGetter {
+    ad_utility::MemorySize operator()(const IdTable& block) const {
+      return ad_utility::MemorySize::bytes(block.numRows() *
+                                           block.numColumns() * sizeof(Id));
+    }
+  };
+  using Cache = ad_utility::HeapBasedLRUCache<Key, IdTable, SizeGetter>;
+
+  ad_utility::Synchronized<Cache, std::mutex> cache_;
+  std::atomic<size_t> maxSizeInBytes_;
+  std::atomic<size_t> numHits_ = 0;
+  std::atomic<size_t> numMisses_ = 0;
+  std::atomic<size_t> numBytesSaved_ = 0;
+  std::atomic<size_t> nextReaderId_ = 0;
+
+ public:
+  // Create an empty cache. Typically, only the process-wide instance (see
+  // `get` below) is used, but tests can create their own.
+  explicit DecompressedBlockCache(ad_utility::MemorySize maxSize);
+
+  // The process-wide instance, which initially has the size from the runtime
+  // parameter `decompressed-block-cache-max-size`.
+  static DecompressedBlockCache& get();
+
+  // Return a new ID for a `CompressedRelationReader`, such that the blocks of
+  // different permutations (or different indices) never share an entry.
+  size_t getNewReaderId() { return nextReaderId_++; }
+
+  // Return the block for the `key`, or `nullptr` if the block is not
+  // contained. The block is shared with the cache and must not be modified.
+  std::shared_ptr<const IdTable> lookup(const Key& key);
+
+  // Store the `block` for the `key` (without copying it). Does nothing if the
+  // cache is disabled or if the `key` is already contained (because another
+  // thread has decompressed the same block concurrently).
+  void insert(const Key& key, std::shared_ptr<IdTable> block);
+
+  // Change the maximal size. Entries are evicted if necessary.
+  void setMaxSize(ad_utility::MemorySize maxSize);
+
+  // Return true iff the maximal size is not zero.
+  bool isEnabled() const { return maxSizeInBytes_ > 0; }
+
+  // Evict entries of a total size of at least `size`, or all entries if they
+  // are smaller. Return true iff entries of at least `size` were evicted. This
+  // is called when an allocation would exceed the memory limit, as the cached
+  // blocks count against it (see `Server`).
+  bool makeRoomAsMuchAsPossible(ad_utility::MemorySize size);
+
+  // Remove all entries (the statistics are kept).
+  void clear();
+
+  Statistics getStatistics() const;
+};
@@ -6,10 +6,78 @@
 
 #include "index/DeltaTriples.h"
 
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <filesystem>
+
 #include "absl/strings/str_cat.h"
+#include "global/RuntimeParameters.h"
 #include "index/Index.h"
 #include "index/IndexImpl.h"
 #include "index/LocatedTriples.h"
+#include "util/Serializer/ByteBufferSerializer.h"
+#include "util/Serializer/SerializeString.h"
+
+namespace {
+// The different ways in which an `Id` is stored in the write-ahead log of the
+// `DeltaTriples`.
+enum class WriteAheadLogIdType : uint8_t {
+  // The `Id` is stored via its bits. This is used for all `Id`s that stay valid
+  // when the server is restarted with the same index.
+  Bits = 0,
+  // The `Id` is a `LocalVocabIndex`, the string representation of the
+  // corresponding `LocalVocabEntry` is stored.
+  LocalVocabWord = 1,
+  // The `Id` is a local blank node, its `BlankNodeIndex` is stored.
+  LocalBlankNode = 2
+};
+
+// Sync the directory that contains the file with the given `filename` to disk,
+// such that a newly created file survives a crash of the operating system.
+void syncParentDirectory(const std::string& filename) {
+  auto directory = std::filesystem::absolute(filename).parent_path();
+  int fd = open(directory.c_str(), O_RDONLY | O_DIRECTORY);
+  bool success = fd >= 0 && fsync(fd) == 0;
+  int error = errno;
+  if (fd >= 0) {
+    ::close(fd);
+  }
+  if (!success) {
+    throw std::runtime_error{absl::StrCat("Could not sync the directory \"",
+                                          directory.string(), "\" to disk (",
+                                          strerror(error), ")")};
+  }
+}
+
+// Write all the `data` to the file with the given descriptor `fd` (bypassing
+// the buffer of the `FILE` stream, s.t. no partial data is left in that buffer
+// when the write fails). Return false if the write fails.
+bool writeToFileDescriptor(int fd, std::span<const char> data) {
+  while (!data.empty()) {
+    ssize_t numBytesWritten = ::write(fd, data.data(), data.size());
+    if (numBytesWritten < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return false;
+    }
+    data = data.subspan(static_cast<size_t>(numBytesWritten));
+  }
+  return true;
+}
+
+// Write a single entry of the write-ahead log of the `DeltaTriples` to the
+// file with the given descriptor `fd`. Each entry is prefixed by its size in
+// bytes, which allows us to detect an incompletely written last entry when
+// reading the log. Return false if the write fails.
+bool writeEntryToFileDescriptor(int fd, std::span<const char> data) {
+  uint64_t numBytes = data.size();
+  std::span<const char> size{reinterpret_cast<const char*>(&numBytes),
+                             sizeof(numBytes)};
+  return writeToFileDescriptor(fd, size) && writeToFileDescriptor(fd, data);
+}
+}  // namespace
 
 // ____________________________________________________________________________
 LocatedTriples::iterator& DeltaTriples::LocatedTripleHandles::forPermutation(
@@ -22,31 +90,44 @@ void DeltaTriples::clear() {
   triplesInserted_.clear();
   triplesDeleted_.clear();
   ql::ranges::for_each(locatedTriples(), &LocatedTriplesPerBlock::clear);
+  if (writeAheadLog_.has_value()) {
+    // Truncate the log, the updates that it contains are no longer valid.
+    writeAheadLog_.emplace(writeAheadLogFilename_, "w");
+    writeAheadLogSize_ = 0;
+    writeWriteAheadLogHeader();
+  }
 }
 
 // ____________________________________________________________________________
-std::vector<DeltaTriples::LocatedTripleHandles>
-DeltaTriples::locateAndAddTriples(CancellationHandle cancellationHandle,
-                                  std::span<const IdTriple<0>> idTriples,
-                                  bool shouldExist) {
-  std::array<std::vector<LocatedTriples::iterator>, Permutation::ALL.size()>
-      intermediateHandles;
+DeltaTriples::LocatedTriplesAllPermutations DeltaTriples::locateTriples(
+    const CancellationHandle& cancellationHandle,
+    std::span<const IdTriple<0>> idTriples, bool shouldExist) const {
+  LocatedTriplesAllPermutations result;
   for (auto permutation : Permutation::ALL) {
     auto& perm = index_.getPermutation(permutation);
-    auto locatedTriples = LocatedTriple::locateTriplesInPermutation(
-        // TODO<qup42>: replace with `getAugmentedMetadata` once integration
-        //  is done
-        idTriples, perm.metaData().blockData(), perm.keyOrder(), shouldExist,
-        cancellationHandle);
-    cancellationHandle->throwIfCancelled();
-    intermediateHandles[static_cast<size_t>(permutation)] =
-        this->locatedTriples()[static_cast<size_t>(permutation)].add(
-            locatedTriples);
+    result[static_cast<size_t>(permutation)] =
+        LocatedTriple::locateTriplesInPermutation(
+            // TODO<qup42>: replace with `getAugmentedMetadata` once
+            //  integration is done
+            idTriples, perm.metaData().blockData(), perm.keyOrder(),
+            shouldExist, cancellationHandle);
     cancellationHandle->throwIfCancelled();
   }
-  std::vector<DeltaTriples::LocatedTripleHandles> handles{idTriples.size()};
+  return result;
+}
+
+// ____________________________________________________________________________
+std::vector<DeltaTriples::LocatedTripleHandles> DeltaTriples::addLocatedTriples(
+    const LocatedTriplesAllPermutations& locatedTriples, size_t numTriples) {
+  std::array<std::vector<LocatedTriples::iterator>, Permutation::ALL.size()>
+      intermediateHandles;
   for (auto permutation : Permutation::ALL) {
-    for (size_t i = 0; i < idTriples.size(); i++) {
+    auto i = static_cast<size_t>(permutation);
+    intermediateHandles[i] = this->locatedTriples()[i].add(locatedTriples[i]);
+  }
+  std::vector<DeltaTriples::LocatedTripleHandles> handles{numTriples};
+  for (auto permutation : Permutation::ALL) {
+    for (size_t i = 0; i < numTriples; i++) {
       handles[i].forPermutation(permutation) =
           intermediateHandles[static_cast<size_t>(permutation)][i];
     }
@@ -156,21 +237,338 @@ void DeltaTriples::modifyTriplesImpl(CancellationHandle cancellationHandle,
   std::erase_if(triples, [&targetMap](const IdTriple<0>& triple) {
     return targetMap.contains(triple);
   });
-  ql::ranges::for_each(triples, [this, &inverseMap](const IdTriple<0>& triple) {
-    auto handle = inverseMap.find(triple);
-    if (handle != inverseMap.end()) {
-      eraseTripleInAllPermutations(handle->second);
-      inverseMap.erase(triple);
+
+  // Locating the triples is the only part of the update that can be
+  // cancelled, it doesn't change anything yet.
+  auto locatedTriples = locateTriples(cancellationHandle, triples, shouldExist);
+
+  // The update is written to the log and synced to disk before the located
+  // triples are changed, so the server never answers queries with an update
+  // that is not in the log. If the update is not applied completely (which
+  // can only happen if we run out of memory), its entry is removed from the
+  // log again.
+  uint64_t writeAheadLogSizeBefore = writeAheadLogSize_;
+  appendToWriteAheadLog(triples, shouldExist);
+  try {
+    ql::ranges::for_each(
+        triples, [this, &inverseMap](const IdTriple<0>& triple) {
+          auto handle = inverseMap.find(triple);
+          if (handle != inverseMap.end()) {
+            eraseTripleInAllPermutations(handle->second);
+            inverseMap.erase(triple);
+          }
+        });
+
+    std::vector<LocatedTripleHandles> handles =
+        addLocatedTriples(locatedTriples, triples.size());
+
+    AD_CORRECTNESS_CHECK(triples.size() == handles.size());
+    // TODO<qup42>: replace with ql::views::zip in C++23
+    for (size_t i = 0; i < triples.size(); i++) {
+      targetMap.insert({triples[i], handles[i]});
     }
-  });
+  } catch (...) {
+    if (writeAheadLog_.has_value()) {
+      truncateWriteAheadLog(writeAheadLogSizeBefore);
+      numTriplesInWriteAheadLog_ -= triples.size();
+    }
+    throw;
+  }
+  if (writeAheadLog_.has_value() && writeAheadLogNeedsCompaction()) {
+    compactWriteAheadLog();
+  }
+}
+
+// ____________________________________________________________________________
+std::vector<char> DeltaTriples::serializeWriteAheadLogHeader() const {
+  ad_utility::serialization::ByteBufferWriteSerializer serializer;
+  serializer << index_.getIndexId();
+  return std::move(serializer).data();
+}
+
+// ____________________________________________________________________________
+void DeltaTriples::writeWriteAheadLogHeader() {
+  AD_CORRECTNESS_CHECK(writeAheadLog_.has_value());
+  appendEntryToWriteAheadLog(serializeWriteAheadLogHeader());
+  numTriplesInWriteAheadLog_ = 0;
+}
 
-  std::vector<LocatedTripleHandles> handles =
-      locateAndAddTriples(std::move(cancellationHandle), triples, shouldExist);
+// ____________________________________________________________________________
+void DeltaTriples::appendEntryToWriteAheadLog(std::span<const char> data) {
+  AD_CORRECTNESS_CHECK(writeAheadLog_.has_value());
+  if (writeAheadLogIsCorrupt_) {
+    throw std::runtime_error{absl::StrCat(
+        "The write-ahead log \"", writeAheadLogFilename_,
+        "\" for the updates ends with an incomplete entry that could not be "
+        "removed, so no further updates are accepted. Please restart the "
+        "server")};
+  }
+  try {
+    if (!writeEntryToFileDescriptor(writeAheadLog_->fileDescriptor(), data)) {
+      throw std::runtime_error{absl::StrCat(
+          "Could not write to the write-ahead log \"", writeAheadLogFilename_,
+          "\" for the updates (", strerror(errno), ")")};
+    }
+    writeAheadLog_->sync();
+  } catch (...) {
+    // Later entries must not be appended after a partially written entry,
+    // because the log is only replayed up to the first incomplete entry.
+    truncateWriteAheadLog(writeAheadLogSize_);
+    throw;
+  }
+  writeAheadLogSize_ += sizeof(uint64_t) + data.size();
+}
 
-  AD_CORRECTNESS_CHECK(triples.size() == handles.size());
-  // TODO<qup42>: replace with ql::views::zip in C++23
-  for (size_t i = 0; i < triples.size(); i++) {
-    targetMap.insert({triples[i], handles[i]});
+// ____________________________________________________________________________
+void DeltaTriples::truncateWriteAheadLog(uint64_t size) {
+  AD_CORRECTNESS_CHECK(writeAheadLog_.has_value());
+  int fd = writeAheadLog_->fileDescriptor();
+  if (ftruncate(fd, static_cast<off_t>(size)) != 0 || fsync(fd) != 0) {
+    writeAheadLogIsCorrupt_ = true;
+    throw std::runtime_error{absl::StrCat(
+        "Could not remove an entry from the write-ahead log \"",
+        writeAheadLogFilename_, "\" for the updates (", strerror(errno),
+        "), no further updates are accepted")};
+  }
+  writeAheadLogSize_ = size;
+}
+
+// ____________________________________________________________________________
+std::vector<char> DeltaTriples::serializeUpdate(const Triples& triples,
+                                                bool shouldExist) const {
+  auto minLocalBlankNode = index_.getBlankNodeManager()->minIndex_;
+  ad_utility::serialization::ByteBufferWriteSerializer serializer;
+  auto writeType = [&serializer](WriteAheadLogIdType type) {
+    serializer << static_cast<uint8_t>(type);
+  };
+  serializer << shouldExist;
+  serializer << static_cast<uint64_t>(triples.size());
+  for (const auto& triple : triples) {
+    for (Id id : triple.ids_) {
+      if (id.getDatatype() == Datatype::LocalVocabIndex) {
+        writeType(WriteAheadLogIdType::LocalVocabWord);
+        serializer << id.getLocalVocabIndex()->toStringRepresentation();
+      } else if (id.getDatatype() == Datatype::BlankNodeIndex &&
+                 id.getBlankNodeIndex().get() >= minLocalBlankNode) {
+        writeType(WriteAheadLogIdType::LocalBlankNode);
+        serializer << id.getBlankNodeIndex().get();
+      } else {
+        writeType(WriteAheadLogIdType::Bits);
+        serializer << id.getBits();
+      }
+    }
+  }
+  return std::move(serializer).data();
+}
+
+// ____________________________________________________________________________
+void DeltaTriples::appendToWriteAheadLog(const Triples& triples,
+                                         bool shouldExist) {
+  if (!writeAheadLog_.has_value()) {
+    return;
+  }
+  appendEntryToWriteAheadLog(serializeUpdate(triples, shouldExist));
+  numTriplesInWriteAheadLog_ += triples.size();
+}
+
+// ____________________________________________________________________________
+bool DeltaTriples::writeAheadLogNeedsCompaction() const {
+  auto numDeltaTriples = static_cast<uint64_t>(numInserted() + numDeleted());
+  return numTriplesInWriteAheadLog_ >=
+             RuntimeParameters()
+                 .get<"write-ahead-log-min-triples-for-compaction">() &&
+         numTriplesInWriteAheadLog_ > 2 * numDeltaTriples;
+}
+
+// ____________________________________________________________________________
+void DeltaTriples::compactWriteAheadLog() {
+  AD_CORRECTNESS_CHECK(writeAheadLog_.has_value());
+  auto getSortedTriples = [](const TriplesToHandlesMap& map) {
+    Triples triples;
+    triples.reserve(map.size());
+    for (const auto& [triple, handles] : map) {
+      triples.push_back(triple);
+    }
+    ql::ranges::sort(triples);
+    return triples;
+  };
+  // The compacted log is written to a temporary file, which then atomically
+  // replaces the log, s.t. a crash at any time leaves a complete log.
+  auto compactedFilename = absl::StrCat(writeAheadLogFilename_, ".compacted");
+  try {
+    {
+      ad_utility::File compacted{compactedFilename, "w"};
+      AD_CORRECTNESS_CHECK(compacted.isOpen());
+      int fd = compacted.fileDescriptor();
+      if (!writeEntryToFileDescriptor(fd, serializeWriteAheadLogHeader()) ||
+          !writeEntryToFileDescriptor(
+              fd, serializeUpdate(getSortedTriples(triplesInserted_), true)) ||
+          !writeEntryToFileDescriptor(
+              fd, serializeUpdate(getSortedTriples(triplesDeleted_), false))) {
+        throw std::runtime_error{absl::StrCat("Could not write to \"",
+                                              compactedFilename, "\" (",
+                                              strerror(errno), ")")};
+      }
+      compacted.sync();
+    }
+    std::filesystem::rename(compactedFilename, writeAheadLogFilename_);
+  } catch (const std::exception& e) {
+    // The compaction is optional, the current log stays valid.
+    std::error_code errorCode;
+    std::filesystem::remove(compactedFilename, errorCode);
+    AD_LOG_WARN << "Could not compact the write-ahead log \""
+                << writeAheadLogFilename_ << "\" for the updates: " << e.what()
+                << std::endl;
+    return;
+  }
+  writeAheadLog_.emplace(writeAheadLogFilename_, "a");
+  AD_CORRECTNESS_CHECK(writeAheadLog_->isOpen());
+  syncParentDirectory(writeAheadLogFilename_);
+  writeAheadLogSize_ = std::filesystem::file_size(writeAheadLogFilename_);
+  numTriplesInWriteAheadLog_ =
+      static_cast<uint64_t>(numInserted() + numDeleted());
+}
+
+// ____________________________________________________________________________
+void DeltaTriples::replayWriteAheadLog(
+    const std::string& filename, const CancellationHandle& cancellationHandle) {
+  ad_utility::File file{filename, "r"};
+  AD_CORRECTNESS_CHECK(file.isOpen());
+  // Read the next entry of the log. Return `std::nullopt` if the end of the
+  // file is reached or if the entry is incomplete.
+  auto readEntry = [&file]() -> std::optional<std::vector<char>> {
+    uint64_t numBytes = 0;
+    if (file.read(&numBytes, sizeof(numBytes)) != sizeof(numBytes)) {
+      return std::nullopt;
+    }
+    std::vector<char> data(numBytes);
+    if (file.read(data.data(), numBytes) != numBytes) {
+      return std::nullopt;
+    }
+    return data;
+  };
+
+  using ad_utility::serialization::ByteBufferReadSerializer;
+  auto header = readEntry();
+  if (!header.has_value()) {
+    // The log is empty or even its header is incomplete, so it contains no
+    // updates.
+    return;
+  }
+  {
+    ByteBufferReadSerializer serializer{std::move(header.value())};
+    std::string indexId;
+    serializer >> indexId;
+    if (indexId != index_.getIndexId()) {
+      throw std::runtime_error{absl::StrCat(
+          "The write-ahead log \"", filename,
+          "\" for the updates was written for a different index (index ID \"",
+          indexId, "\" instead of \"", index_.getIndexId(),
+          "\"). Please remove the file or use the index it belongs to.")};
+    }
+  }
+
+  // Local blank nodes from the log are consistently replaced by new blank
+  // nodes that are managed by the `localVocab_`.
+  ad_utility::HashMap<uint64_t, Id> blankNodeMap;
+  auto readId = [this, &blankNodeMap](ByteBufferReadSerializer& serializer) {
+    uint8_t type;
+    serializer >> type;
+    switch (static_cast<WriteAheadLogIdType>(type)) {
+      case WriteAheadLogIdType::Bits: {
+        uint64_t bits;
+        serializer >> bits;
+        return Id::fromBits(bits);
+      }
+      case WriteAheadLogIdType::LocalVocabWord: {
+        std::string word;
+        serializer >> word;
+        return Id::makeFromLocalVocabIndex(
+            localVocab_.getIndexAndAddIfNotContained(LocalVocabEntry{
+                ad_utility::triple_component::LiteralOrIri::
+                    fromStringRepresentation(std::move(word))}));
+      }
+      case WriteAheadLogIdType::LocalBlankNode: {
+        uint64_t blankNodeIndex;
+        serializer >> blankNodeIndex;
+        auto [it, isNew] =
+            blankNodeMap.try_emplace(blankNodeIndex, Id::makeUndefined());
+        if (isNew) {
+          it->second = Id::makeFromBlankNodeIndex(
+              localVocab_.getBlankNodeIndex(index_.getBlankNodeManager()));
+        }
+        return it->second;
+      }
+    }
+    AD_FAIL();
+  };
+
+  size_t numEntries = 0;
+  auto endOfLastCompleteEntry = file.tell();
+  while (auto entry = readEntry()) {
+    ByteBufferReadSerializer serializer{std::move(entry.value())};
+    bool shouldExist;
+    uint64_t numTriples;
+    serializer >> shouldExist;
+    serializer >> numTriples;
+    Triples triples;
+    triples.reserve(numTriples);
+    for (uint64_t i = 0; i < numTriples; ++i) {
+      std::array<Id, 4> ids;
+      for (auto& id : ids) {
+        id = readId(serializer);
+      }
+      triples.emplace_back(ids);
+    }
+    // The `Id`s of the local vocab entries have changed, so we have to restore
+    // the sortedness that is required by `modifyTriplesImpl`.
+    ql::ranges::sort(triples);
+    triples.erase(std::unique(triples.begin(), triples.end()), triples.end());
+    numTriplesInWriteAheadLog_ += numTriples;
+    if (shouldExist) {
+      modifyTriplesImpl(cancellationHandle, std::move(triples), true,
+                        triplesInserted_, triplesDeleted_);
+    } else {
+      modifyTriplesImpl(cancellationHandle, std::move(triples), false,
+                        triplesDeleted_, triplesInserted_);
+    }
+    ++numEntries;
+    endOfLastCompleteEntry = file.tell();
+  }
+  file.close();
+
+  if (endOfLastCompleteEntry !=
+      static_cast<off_t>(std::filesystem::file_size(filename))) {
+    AD_LOG_WARN << "The last entry of the write-ahead log \"" << filename
+                << "\" is incomplete (probably because the server was "
+                   "terminated during an update) and is ignored"
+                << std::endl;
+    std::filesystem::resize_file(
+        filename, static_cast<uintmax_t>(endOfLastCompleteEntry));
+  }
+  AD_LOG_INFO << "Restored " << numEntries << " updates from \"" << filename
+              << "\", the number of inserted and deleted triples is "
+              << numInserted() << " and " << numDeleted() << std::endl;
+}
+
+// ____________________________________________________________________________
+void DeltaTriples::enableWriteAheadLog(const std::string& filename,
+                                       CancellationHandle cancellationHandle) {
+  AD_CONTRACT_CHECK(!writeAheadLog_.has_value(),
+                    "The write-ahead log for the updates can only be enabled "
+                    "once");
+  if (std::filesystem::exists(filename)) {
+    replayWriteAheadLog(filename, cancellationHandle);
+  }
+  writeAheadLogFilename_ = filename;
+  writeAheadLog_.emplace(filename, "a");
+  AD_CORRECTNESS_CHECK(writeAheadLog_->isOpen());
+  writeAheadLogSize_ = std::filesystem::file_size(filename);
+  if (writeAheadLogSize_ == 0) {
+    writeWriteAheadLogHeader();
+    syncParentDirectory(filename);
+  } else if (writeAheadLogNeedsCompaction()) {
+    compactWriteAheadLog();
   }
 }
 
@@ -183,13 +581,20 @@ LocatedTriplesSnapshot::getLocatedTriplesForPermutation(
 
 // ____________________________________________________________________________
 SharedLocatedTriplesSnapshot DeltaTriples::getSnapshot() {
-  // NOTE: Both members of the `LocatedTriplesSnapshot` are copied, but the
-  // `localVocab_` has no copy constructor (in order to avoid accidental
-  // copies), hence the explicit `clone`.
+  // NOTE: The located triples are not copied as a whole, but only those blocks
+  // that have changed since the previous snapshot, all other blocks are shared
+  // (see `LocatedTriplesPerBlock::copyForSnapshot`). The `localVocab_` has no
+  // copy constructor (in order to avoid accidental copies), hence the explicit
+  // `clone`, which only copies shared pointers.
   auto snapshotIndex = nextSnapshotIndex_;
   ++nextSnapshotIndex_;
+  LocatedTriplesPerBlockAllPermutations locatedTriplesCopy;
+  for (auto permutation : Permutation::ALL) {
+    auto i = static_cast<size_t>(permutation);
+    locatedTriplesCopy[i] = locatedTriples()[i].copyForSnapshot();
+  }
   return SharedLocatedTriplesSnapshot{std::make_shared<LocatedTriplesSnapshot>(
-      locatedTriples(), localVocab_.clone(), snapshotIndex)};
+      std::move(locatedTriplesCopy), localVocab_.clone(), snapshotIndex)};
 }
 
 // ____________________________________________________________________________
@@ -254,6 +659,15 @@ template DeltaTriplesCount DeltaTriplesManager::modify<DeltaTriplesCount>(
 // _____________________________________________________________________________
 void DeltaTriplesManager::clear() { modify<void>(&DeltaTriples::clear); }
 
+// _____________________________________________________________________________
+void DeltaTriplesManager::enableWriteAheadLog(const std::string& filename) {
+  // Restoring the updates is not cancellable.
+  auto handle = std::make_shared<ad_utility::CancellationHandle<>>();
+  modify<void>([&filename, &handle](DeltaTriples& deltaTriples) {
+    deltaTriples.enableWriteAheadLog(filename, handle);
+  });
+}
+
 // _____________________________________________________________________________
 SharedLocatedTriplesSnapshot DeltaTriplesManager::getCurrentSnapshot() const {
   return *currentLocatedTriplesSnapshot_.rlock();
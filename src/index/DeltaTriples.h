@@ -12,6 +12,7 @@
 #include "index/IndexBuilderTypes.h"
 #include "index/LocatedTriples.h"
 #include "index/Permutation.h"
+#include "util/File.h"
 #include "util/Synchronized.h"
 
 // Typedef for one `LocatedTriplesPerBlock` object for each of the six
@@ -118,6 +119,20 @@ class DeltaTriples {
   TriplesToHandlesMap triplesInserted_;
   TriplesToHandlesMap triplesDeleted_;
 
+  // If set, each call to `insertTriples` or `deleteTriples` is appended to this
+  // file, so that the updates can be restored after a restart (see
+  // `enableWriteAheadLog`).
+  std::optional<ad_utility::File> writeAheadLog_;
+  std::string writeAheadLogFilename_;
+  // The size of the complete entries of the `writeAheadLog_` in bytes.
+  uint64_t writeAheadLogSize_ = 0;
+  // True iff an incomplete entry could not be removed from the
+  // `writeAheadLog_`. Then no further entries can be appended.
+  bool writeAheadLogIsCorrupt_ = false;
+  // The number of triples in all the entries of the `writeAheadLog_` (see
+  // `compactWriteAheadLog`).
+  uint64_t numTriplesInWriteAheadLog_ = 0;
+
  public:
   // Construct for given index.
   explicit DeltaTriples(const Index& index);
@@ -160,11 +175,33 @@ class DeltaTriples {
   // Delete triples.
   void deleteTriples(CancellationHandle cancellationHandle, Triples triples);
 
-  // Return a deep copy of the `LocatedTriples` and the corresponding
-  // `LocalVocab` which form a snapshot of the current status of this
-  // `DeltaTriples` object.
+  // Return a copy of the `LocatedTriples` and the corresponding `LocalVocab`
+  // which form a snapshot of the current status of this `DeltaTriples` object.
+  // The snapshot shares all blocks of located triples that have not changed
+  // since the previous call to `getSnapshot`, so the cost of this function only
+  // depends on the number of blocks that were touched by the last updates.
   SharedLocatedTriplesSnapshot getSnapshot();
 
+  // Restore all the updates that are stored in the write-ahead log with the
+  // given `filename` (if the file exists) and append all future updates to
+  // this file. That way, the updates survive a restart of the server. The log
+  // is emptied by `clear()`. Throws if the log was written for a different
+  // index.
+  //
+  // The log is compacted when it contains many more triples than are
+  // currently inserted or deleted (see `compactWriteAheadLog`), so its size is
+  // bounded by the number of delta triples.
+  //
+  // NOTE: The delta triples are never merged into the permutations on disk,
+  // so the cost of the delta triples for each scan grows with their number
+  // until the index is rebuilt. This compaction is not implemented yet. It
+  // requires rewriting the affected blocks and the relation metadata of all
+  // permutations, as well as the patterns and the statistics of the index,
+  // and the triples with local vocab entries can't be written to the
+  // permutations at all.
+  void enableWriteAheadLog(const std::string& filename,
+                           CancellationHandle cancellationHandle);
+
   // Register the original `metadata` for the given `permutation`. This has to
   // be called before any updates are processed.
   void setOriginalMetadata(
@@ -172,14 +209,23 @@ class DeltaTriples {
       std::shared_ptr<const std::vector<CompressedBlockMetadata>> metadata);
 
  private:
-  // Find the position of the given triple in the given permutation and add it
-  // to each of the six `LocatedTriplesPerBlock` maps (one per permutation).
-  // `shouldExist` specifies the action: insert or delete. Return the iterators
-  // of where it was added (so that we can easily delete it again from these
-  // maps later).
-  std::vector<LocatedTripleHandles> locateAndAddTriples(
-      CancellationHandle cancellationHandle,
-      std::span<const IdTriple<0>> idTriples, bool shouldExist);
+  // The located triples for each of the six permutations.
+  using LocatedTriplesAllPermutations =
+      std::array<std::vector<LocatedTriple>, Permutation::ALL.size()>;
+
+  // Find the position of the given triples in each of the six permutations.
+  // `shouldExist` specifies the action: insert or delete. This doesn't change
+  // the `DeltaTriples`, so it can be cancelled safely.
+  LocatedTriplesAllPermutations locateTriples(
+      const CancellationHandle& cancellationHandle,
+      std::span<const IdTriple<0>> idTriples, bool shouldExist) const;
+
+  // Add the `locatedTriples` (as returned by `locateTriples`) to each of the
+  // six `LocatedTriplesPerBlock` maps (one per permutation). Return the
+  // iterators of where they were added (so that we can easily delete them
+  // again from these maps later).
+  std::vector<LocatedTripleHandles> addLocatedTriples(
+      const LocatedTriplesAllPermutations& locatedTriples, size_t numTriples);
 
   // Common implementation for `insertTriples` and `deleteTriples`.
   // `shouldExist` specifies the action: insert or delete. `targetMap` contains
@@ -190,6 +236,52 @@ class DeltaTriples {
                          bool shouldExist, TriplesToHandlesMap& targetMap,
                          TriplesToHandlesMap& inverseMap);
 
+  // Append the `triples` (to be inserted if `shouldExist` is true, else to be
+  // deleted) to the `writeAheadLog_`. Does nothing if no write-ahead log is
+  // enabled.
+  void appendToWriteAheadLog(const Triples& triples, bool shouldExist);
+
+  // Serialize the `triples` (to be inserted if `shouldExist` is true, else to
+  // be deleted) as a single entry of the write-ahead log. Local vocab entries
+  // are stored as strings, and local blank nodes via their index (they are
+  // consistently replaced by new blank nodes when the log is read).
+  std::vector<char> serializeUpdate(const Triples& triples,
+                                    bool shouldExist) const;
+
+  // Serialize the header of the write-ahead log (the ID of the index).
+  std::vector<char> serializeWriteAheadLogHeader() const;
+
+  // Write the header of an empty write-ahead log (which contains the ID of the
+  // index).
+  void writeWriteAheadLogHeader();
+
+  // Append the serialized `data` of a single entry (prefixed by its size) to
+  // the `writeAheadLog_` and sync the log to disk. Throw if this fails, after
+  // removing the partially written entry from the log.
+  void appendEntryToWriteAheadLog(std::span<const char> data);
+
+  // Truncate the `writeAheadLog_` to the given `size` (the end of its last
+  // complete entry that should be kept).
+  void truncateWriteAheadLog(uint64_t size);
+
+  // Return true iff the `writeAheadLog_` contains many more triples than the
+  // current inserted and deleted triples (because triples were inserted and
+  // deleted again, or were inserted repeatedly), see the runtime parameter
+  // `write-ahead-log-min-triples-for-compaction`.
+  bool writeAheadLogNeedsCompaction() const;
+
+  // Replace the `writeAheadLog_` by a log that consists of one entry with the
+  // currently inserted and one entry with the currently deleted triples. The
+  // new log is written to a temporary file that then atomically replaces the
+  // old one. If this fails, a warning is logged and the old log is kept.
+  void compactWriteAheadLog();
+
+  // Apply all the updates from the write-ahead log with the given `filename`.
+  // A truncated last entry (which can be the result of a crash during an
+  // update) is ignored and removed from the file.
+  void replayWriteAheadLog(const std::string& filename,
+                           const CancellationHandle& cancellationHandle);
+
   // Rewrite each triple in `triples` such that all local vocab entries and all
   // local blank nodes are managed by the `localVocab_` of this class.
   //
@@ -236,7 +328,12 @@ class DeltaTriplesManager {
   // update the current snapshot.
   void clear();
 
-  // Return a shared pointer to a deep copy of the current snapshot. This can
-  // be safely used to execute a query without interfering with future updates.
+  // Restore the updates from the write-ahead log with the given `filename` and
+  // persist all future updates to it, see `DeltaTriples::enableWriteAheadLog`.
+  void enableWriteAheadLog(const std::string& filename);
+
+  // Return a shared pointer to the current snapshot. The snapshot is immutable
+  // and can be safely used to execute a query without interfering with future
+  // updates.
   SharedLocatedTriplesSnapshot getCurrentSnapshot() const;
 };
@@ -35,6 +35,21 @@ void Index::buildDocsDB(const std::string& docsFile) {
   pimpl_->buildDocsDB(docsFile);
 }
 
+// ____________________________________________________________________________
+void Index::buildVocabularyTrigramIndex() {
+  pimpl_->buildVocabularyTrigramIndex();
+}
+
+// ____________________________________________________________________________
+const VocabularyTrigramIndex* Index::getVocabularyTrigramIndex() const {
+  return pimpl_->getVocabularyTrigramIndex();
+}
+
+// ____________________________________________________________________________
+const PredicateStatistics* Index::getPredicateStatistics() const {
+  return pimpl_->getPredicateStatistics();
+}
+
 // ____________________________________________________________________________
 void Index::addTextFromOnDiskIndex() { pimpl_->addTextFromOnDiskIndex(); }
 
@@ -200,6 +215,11 @@ ad_utility::MemorySize& Index::blocksizePermutationsPerColumn() {
   return pimpl_->blocksizePermutationPerColumn();
 }
 
+// ____________________________________________________________________________
+ad_utility::BloomFilterBudget& Index::bloomFilterBudget() {
+  return pimpl_->bloomFilterBudget();
+}
+
 // ____________________________________________________________________________
 void Index::setOnDiskBase(const std::string& onDiskBase) {
   return pimpl_->setOnDiskBase(onDiskBase);
@@ -224,6 +244,11 @@ const std::string& Index::getKbName() const { return pimpl_->getKbName(); }
 // ____________________________________________________________________________
 const std::string& Index::getIndexId() const { return pimpl_->getIndexId(); }
 
+// ____________________________________________________________________________
+const std::string& Index::getOnDiskBase() const {
+  return pimpl_->getOnDiskBase();
+}
+
 // ____________________________________________________________________________
 Index::NumNormalAndInternal Index::numTriples() const {
   return pimpl_->numTriples();
@@ -15,6 +15,7 @@
 #include "index/StringSortComparator.h"
 #include "index/Vocabulary.h"
 #include "parser/TripleComponent.h"
+#include "util/BloomFilter.h"
 #include "util/CancellationHandle.h"
 #include "util/json.h"
 
@@ -24,6 +25,8 @@ class TextBlockMetaData;
 class IndexImpl;
 struct LocatedTriplesSnapshot;
 class DeltaTriplesManager;
+class VocabularyTrigramIndex;
+class PredicateStatistics;
 
 class Index {
  private:
@@ -100,6 +103,18 @@ class Index {
   // Build docsDB file from given file (one text record per line).
   void buildDocsDB(const std::string& docsFile);
 
+  // Build the trigram index of the vocabulary of a complete KB index, which
+  // speeds up regexes with literal substrings (see `VocabularyTrigramIndex`).
+  void buildVocabularyTrigramIndex();
+
+  // Return the trigram index of the vocabulary, or `nullptr` if it was not
+  // built for this index.
+  const VocabularyTrigramIndex* getVocabularyTrigramIndex() const;
+
+  // Return the histograms of the objects of each predicate, or `nullptr` if
+  // the index was built without them (see `PredicateStatistics`).
+  const PredicateStatistics* getPredicateStatistics() const;
+
   // Add text index from on-disk index that has previously been constructed.
   // Read necessary metadata into memory and open file handles.
   void addTextFromOnDiskIndex();
@@ -200,6 +215,8 @@ class Index {
 
   ad_utility::MemorySize& blocksizePermutationsPerColumn();
 
+  ad_utility::BloomFilterBudget& bloomFilterBudget();
+
   void setOnDiskBase(const std::string& onDiskBase);
 
   void setSettingsFile(const std::string& filename);
@@ -212,6 +229,9 @@ class Index {
 
   const std::string& getIndexId() const;
 
+  // The basename of all the files that belong to this index.
+  const std::string& getOnDiskBase() const;
+
   NumNormalAndInternal numTriples() const;
 
   size_t getNofTextRecords() const;
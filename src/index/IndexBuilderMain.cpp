@@ -166,6 +166,9 @@ int main(int argc, char** argv) {
   bool addWordsFromLiterals = false;
   std::optional<ad_utility::MemorySize> stxxlMemory;
   std::optional<ad_utility::MemorySize> parserBufferSize;
+  size_t bloomFilterBitsPerKey = 0;
+  std::optional<ad_utility::MemorySize> bloomFilterMaxSizePerBlock;
+  bool buildVocabularyTrigramIndex = false;
   optind = 1;
 
   Index index{ad_utility::makeUnlimitedAllocator<Id>()};
@@ -224,6 +227,20 @@ int main(int argc, char** argv) {
   add("only-pso-and-pos-permutations,o", po::bool_switch(&onlyPsoAndPos),
       "Only build the PSO and POS permutations. This is faster, but then "
       "queries with predicate variables are not supported");
+  add("bloom-filter-bits-per-key", po::value(&bloomFilterBitsPerKey),
+      "Build a Bloom filter with this many bits per distinct key for the "
+      "second column of each block of the permutations. The filters speed up "
+      "point lookups and joins with few matches on large predicates, but "
+      "they are kept in memory. Default: 0 (no filters).");
+  add("bloom-filter-max-size-per-block",
+      po::value(&bloomFilterMaxSizePerBlock),
+      "The maximal size of the Bloom filter of a single block (blocks with "
+      "many distinct keys get a less precise filter). Default: 4 kB.");
+  add("vocabulary-trigram-index", po::bool_switch(&buildVocabularyTrigramIndex),
+      "Build an index of the trigrams of the vocabulary, which speeds up "
+      "regexes that contain literal substrings of at least three characters "
+      "(also case-insensitive ones). Can be combined with `add-text-index` to "
+      "only build this index for an existing knowledge graph index.");
 
   // Options for the index building process.
   add("stxxl-memory,m", po::value(&stxxlMemory),
@@ -256,6 +273,11 @@ int main(int argc, char** argv) {
   if (parserBufferSize.has_value()) {
     index.parserBufferSize() = parserBufferSize.value();
   }
+  index.bloomFilterBudget().bitsPerKey_ = bloomFilterBitsPerKey;
+  if (bloomFilterMaxSizePerBlock.has_value()) {
+    index.bloomFilterBudget().maxSizePerFilter_ =
+        bloomFilterMaxSizePerBlock.value();
+  }
 
   // If no text index name was specified, take the part of the wordsfile after
   // the last slash.
@@ -337,6 +359,10 @@ int main(int argc, char** argv) {
     if (!docsfile.empty()) {
       index.buildDocsDB(docsfile);
     }
+
+    if (buildVocabularyTrigramIndex) {
+      index.buildVocabularyTrigramIndex();
+    }
     ad_utility::deleteFile(stxxlFileName, false);
   } catch (std::exception& e) {
     LOG(ERROR) << e.what() << std::endl;
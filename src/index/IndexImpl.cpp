@@ -7,6 +7,7 @@
 #include "./IndexImpl.h"
 
 #include <cstdio>
+#include <filesystem>
 #include <future>
 #include <numeric>
 #include <optional>
@@ -343,6 +344,15 @@ void IndexImpl::createFromFiles(
 
   readIndexBuilderSettingsFromFile();
 
+  // A trigram index of a previous index with the same name doesn't belong to
+  // the new vocabulary (see `buildVocabularyTrigramIndex`).
+  auto trigramIndexFilename =
+      absl::StrCat(onDiskBase_, VOCAB_TRIGRAM_INDEX_SUFFIX);
+  ad_utility::deleteFile(trigramIndexFilename, false);
+  ad_utility::deleteFile(absl::StrCat(trigramIndexFilename,
+                                      VocabularyTrigramIndex::postingsSuffix_),
+                         false);
+
   updateInputFileSpecificationsAndLog(files, useParallelParser_);
   IndexBuilderDataAsFirstPermutationSorter indexBuilderData =
       createIdTriplesAndVocab(makeRdfParser(files));
@@ -778,9 +788,11 @@ IndexImpl::createPermutationPairImpl(size_t numColumns, const string& fileName1,
   metaData2.setup(fileName2 + MMAP_FILE_SUFFIX, ad_utility::CreateTag{});
 
   CompressedRelationWriter writer1{numColumns, ad_utility::File(fileName1, "w"),
-                                   blocksizePermutationPerColumn_};
+                                   blocksizePermutationPerColumn_,
+                                   bloomFilterBudget_};
   CompressedRelationWriter writer2{numColumns, ad_utility::File(fileName2, "w"),
-                                   blocksizePermutationPerColumn_};
+                                   blocksizePermutationPerColumn_,
+                                   bloomFilterBudget_};
 
   // Lift a callback that works on single elements to a callback that works on
   // blocks.
@@ -873,6 +885,36 @@ void IndexImpl::createFromOnDiskIndex(const string& onDiskBase) {
   AD_LOG_DEBUG << "Number of words in internal and external vocabulary: "
                << vocab_.size() << std::endl;
 
+  // The trigram index of the vocabulary is optional. Its posting lists are
+  // memory-mapped and not read into RAM. A trigram index that was built for a
+  // different vocabulary would yield wrong results, so it is ignored.
+  if (auto filename = absl::StrCat(onDiskBase_, VOCAB_TRIGRAM_INDEX_SUFFIX);
+      std::filesystem::exists(filename)) {
+    auto trigramIndex = VocabularyTrigramIndex::readFromFile(filename);
+    if (trigramIndex.indexId() != indexId_ ||
+        trigramIndex.numWords() != vocab_.size()) {
+      AD_LOG_WARN << "The trigram index of the vocabulary \"" << filename
+                  << "\" was built for a different index and is ignored, "
+                     "please rebuild it"
+                  << std::endl;
+    } else {
+      vocabularyTrigramIndex_ = std::move(trigramIndex);
+      AD_LOG_INFO << "Loaded the trigram index of the vocabulary with "
+                  << vocabularyTrigramIndex_->numTrigrams()
+                  << " distinct trigrams" << std::endl;
+    }
+  }
+
+  // The statistics of the predicates are optional (indexes that were built
+  // before they were introduced don't have them).
+  if (auto filename = absl::StrCat(onDiskBase_, PREDICATE_STATISTICS_SUFFIX);
+      std::filesystem::exists(filename)) {
+    predicateStatistics_ = PredicateStatistics::readFromFile(filename);
+    AD_LOG_INFO << "Loaded the object histograms of "
+                << predicateStatistics_->numPredicates() << " predicates"
+                << std::endl;
+  }
+
   auto range1 =
       vocab_.prefixRanges(QLEVER_INTERNAL_PREFIX_IRI_WITHOUT_CLOSING_BRACKET);
   auto range2 = vocab_.prefixRanges("@");
@@ -941,6 +983,26 @@ void IndexImpl::createFromOnDiskIndex(const string& onDiskBase) {
   }
 }
 
+// _____________________________________________________________________________
+void IndexImpl::buildVocabularyTrigramIndex() {
+  // The vocabulary has been deleted during the index creation to save RAM (or
+  // not been loaded at all), so we have to reload it.
+  vocab_ = RdfsVocabulary{};
+  readConfiguration();
+  vocab_.readFromFile(onDiskBase_ + VOCAB_SUFFIX);
+  AD_LOG_INFO << "Building the trigram index of the vocabulary with "
+              << vocab_.size() << " words ..." << std::endl;
+  auto filename = absl::StrCat(onDiskBase_, VOCAB_TRIGRAM_INDEX_SUFFIX);
+  VocabularyTrigramIndex::build(filename, indexId_, vocab_.size(),
+                                [this](size_t i) {
+                                  return std::string{
+                                      vocab_[VocabIndex::make(i)]};
+                                });
+  vocabularyTrigramIndex_ = VocabularyTrigramIndex::readFromFile(filename);
+  AD_LOG_INFO << "Done, number of distinct trigrams: "
+              << vocabularyTrigramIndex_->numTrigrams() << std::endl;
+}
+
 // _____________________________________________________________________________
 void IndexImpl::throwExceptionIfNoPatterns() const {
   AD_CONTRACT_CHECK(
@@ -1639,10 +1701,16 @@ CPP_template_def(typename... NextSorter)(requires(
   };
   size_t numPredicatesNormal = 0;
   auto predicateCounter = makeNumDistinctIdsCounter<1>(numPredicatesNormal);
-  size_t numPredicatesTotal =
-      createPermutationPair(numColumns, AD_FWD(sortedTriples), pso_, pos_,
-                            nextSorter.makePushCallback()...,
-                            std::ref(predicateCounter), countTriplesNormal);
+  // The triples are sorted by their predicate, so the histograms of the
+  // objects of all predicates can be computed in the same pass.
+  PredicateStatistics::Builder statisticsBuilder;
+  auto addToStatistics = [&statisticsBuilder](const auto& triple) {
+    statisticsBuilder.addTriple(triple[1], triple[2]);
+  };
+  size_t numPredicatesTotal = createPermutationPair(
+      numColumns, AD_FWD(sortedTriples), pso_, pos_,
+      nextSorter.makePushCallback()..., std::ref(predicateCounter),
+      countTriplesNormal, addToStatistics);
   configurationJson_["num-predicates"] =
       NumNormalAndInternal::fromNormalAndTotal(numPredicatesNormal,
                                                numPredicatesTotal);
@@ -1650,6 +1718,9 @@ CPP_template_def(typename... NextSorter)(requires(
       numTriplesNormal, numTriplesTotal);
   if (doWriteConfiguration) {
     writeConfiguration();
+    predicateStatistics_ = std::move(statisticsBuilder).finish();
+    predicateStatistics_->writeToFile(
+        absl::StrCat(onDiskBase_, PREDICATE_STATISTICS_SUFFIX));
   }
 };
 
@@ -27,10 +27,12 @@
 #include "index/PatternCreator.h"
 #include "index/Permutation.h"
 #include "index/Postings.h"
+#include "index/PredicateStatistics.h"
 #include "index/StxxlSortFunctors.h"
 #include "index/TextMetaData.h"
 #include "index/Vocabulary.h"
 #include "index/VocabularyMerger.h"
+#include "index/VocabularyTrigramIndex.h"
 #include "parser/RdfParser.h"
 #include "parser/TripleComponent.h"
 #include "parser/WordsAndDocsFileParser.h"
@@ -132,8 +134,17 @@ class IndexImpl {
   ad_utility::MemorySize parserBufferSize_ = DEFAULT_PARSER_BUFFER_SIZE;
   ad_utility::MemorySize blocksizePermutationPerColumn_ =
       UNCOMPRESSED_BLOCKSIZE_COMPRESSED_METADATA_PER_COLUMN;
+  // The budget for the per-block Bloom filters on the `col1` of the
+  // permutations (disabled by default).
+  ad_utility::BloomFilterBudget bloomFilterBudget_;
   json configurationJson_;
   Index::Vocab vocab_;
+  // The (optional) trigram index of the `vocab_`, see
+  // `buildVocabularyTrigramIndex`.
+  std::optional<VocabularyTrigramIndex> vocabularyTrigramIndex_;
+  // The (optional) histograms of the objects of each predicate, which are
+  // computed while the PSO permutation is built.
+  std::optional<PredicateStatistics> predicateStatistics_;
   Index::TextVocab textVocab_;
 
   TextMetaData textMeta_;
@@ -260,6 +271,25 @@ class IndexImpl {
   // Build docsDB file from given file (one text record per line).
   void buildDocsDB(const string& docsFile) const;
 
+  // Build the trigram index of the vocabulary (see `VocabularyTrigramIndex`)
+  // of a complete KB index and write it to disk.
+  void buildVocabularyTrigramIndex();
+
+  // Return the trigram index of the vocabulary, or `nullptr` if it was not
+  // built for this index.
+  const VocabularyTrigramIndex* getVocabularyTrigramIndex() const {
+    return vocabularyTrigramIndex_.has_value()
+               ? &vocabularyTrigramIndex_.value()
+               : nullptr;
+  }
+
+  // Return the statistics of the objects of each predicate, or `nullptr` if
+  // the index was built without them.
+  const PredicateStatistics* getPredicateStatistics() const {
+    return predicateStatistics_.has_value() ? &predicateStatistics_.value()
+                                            : nullptr;
+  }
+
   // Adds text index from on disk index that has previously been constructed.
   // Read necessary meta data into memory and opens file handles.
   void addTextFromOnDiskIndex();
@@ -417,6 +447,10 @@ class IndexImpl {
     return blocksizePermutationPerColumn_;
   }
 
+  ad_utility::BloomFilterBudget& bloomFilterBudget() {
+    return bloomFilterBudget_;
+  }
+
   void setOnDiskBase(const std::string& onDiskBase);
 
   void setSettingsFile(const std::string& filename);
@@ -431,6 +465,8 @@ class IndexImpl {
 
   const string& getIndexId() const { return indexId_; }
 
+  const string& getOnDiskBase() const { return onDiskBase_; }
+
   size_t getNofTextRecords() const { return textMeta_.getNofTextRecords(); }
   size_t getNofWordPostings() const { return textMeta_.getNofWordPostings(); }
   size_t getNofEntityPostings() const {
@@ -692,8 +728,9 @@ class IndexImpl {
 
   // Create the PSO and POS permutations. Additionally, count the number of
   // distinct predicates and the number of actual triples and write them to the
-  // metadata. The meta-data JSON file for the index statistics will only be
-  // written iff `doWriteConfiguration` is true. That parameter is set to
+  // metadata. The meta-data JSON file for the index statistics and the
+  // `PredicateStatistics` will only be written iff `doWriteConfiguration` is
+  // true. That parameter is set to
   // `false` when building the additional permutations for the internal triples.
   CPP_template(typename... NextSorter)(
       requires(sizeof...(NextSorter) <=
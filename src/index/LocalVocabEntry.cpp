@@ -4,7 +4,16 @@
 
 #include "LocalVocabEntry.h"
 
+#include <array>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <utility>
+
+#include "absl/hash/hash.h"
 #include "index/IndexImpl.h"
+#include "util/HashMap.h"
+#include "util/Synchronized.h"
 
 // ___________________________________________________________________________
 auto LocalVocabEntry::positionInVocabExpensiveCase() const -> PositionInVocab {
@@ -22,3 +31,73 @@ auto LocalVocabEntry::positionInVocabExpensiveCase() const -> PositionInVocab {
   positionInVocabKnown_.store(true, std::memory_order_release);
   return positionInVocab;
 }
+
+// ___________________________________________________________________________
+auto LocalVocabEntry::positionInVocab(InlineString word) -> PositionInVocab {
+  // The positions of all the words that have been looked up so far, for the
+  // index the positions belong to (which changes in tests). The number of
+  // cached positions is bounded, s.t. many distinct words don't use up the
+  // RAM.
+  struct GlobalCache {
+    const IndexImpl* index_ = nullptr;
+    ad_utility::HashMap<uint64_t, PositionInVocab> positions_;
+  };
+  static constexpr size_t maxNumGlobalCacheEntries = 1 << 20;
+  static ad_utility::Synchronized<GlobalCache, std::shared_mutex> globalCache;
+  // A small direct-mapped cache per thread in front of the global cache, which
+  // avoids the locking for the most recently used words.
+  struct CachedPosition {
+    const IndexImpl* index_ = nullptr;
+    uint64_t word_ = 0;
+    PositionInVocab position_;
+  };
+  static constexpr size_t cacheSize = 256;
+  thread_local std::array<CachedPosition, cacheSize> cache;
+
+  const IndexImpl& index = IndexImpl::staticGlobalSingletonIndex();
+  uint64_t bits = word.toBitRepresentation();
+  auto& entry = cache[absl::Hash<uint64_t>{}(bits) % cacheSize];
+  if (entry.index_ == &index && entry.word_ == bits) {
+    return entry.position_;
+  }
+  auto position = globalCache.withReadLock(
+      [&index, bits](const GlobalCache& positions)
+          -> std::optional<PositionInVocab> {
+        if (positions.index_ != &index) {
+          return std::nullopt;
+        }
+        auto it = positions.positions_.find(bits);
+        return it != positions.positions_.end() ? std::optional{it->second}
+                                                : std::nullopt;
+      });
+  if (!position.has_value()) {
+    const auto& vocab = index.getVocab();
+    position = PositionInVocab{vocab.lower_bound(word.view()),
+                               vocab.upper_bound(std::string{word.view()})};
+    globalCache.withWriteLock(
+        [&index, bits, &position](GlobalCache& positions) {
+          if (positions.index_ != &index ||
+              positions.positions_.size() >= maxNumGlobalCacheEntries) {
+            positions.positions_.clear();
+            positions.index_ = &index;
+          }
+          positions.positions_.emplace(bits, position.value());
+        });
+  }
+  entry = CachedPosition{&index, bits, position.value()};
+  return entry.position_;
+}
+
+// ___________________________________________________________________________
+std::strong_ordering LocalVocabEntry::compareStringRepresentations(
+    std::string_view a, std::string_view b) {
+  // Note: This has to be consistent with `LiteralOrIri::operator<=>`.
+  int i = IndexImpl::staticGlobalSingletonComparator().compare(a, b);
+  if (i < 0) {
+    return std::strong_ordering::less;
+  } else if (i > 0) {
+    return std::strong_ordering::greater;
+  } else {
+    return std::strong_ordering::equal;
+  }
+}
@@ -5,8 +5,11 @@
 #pragma once
 
 #include <atomic>
+#include <compare>
+#include <string_view>
 
 #include "backports/algorithm.h"
+#include "global/InlineString.h"
 #include "global/VocabIndex.h"
 #include "parser/LiteralOrIri.h"
 #include "util/CopyableSynchronization.h"
@@ -67,6 +70,17 @@ class alignas(16) LocalVocabEntry
     return positionInVocabExpensiveCase();
   }
 
+  // Return the position of the `word` in the vocabulary. The position of each
+  // `InlineString` is looked up only once and then cached (globally and for
+  // the most recently used words per thread), so comparing `InlineString`s to
+  // `VocabIndex` IDs (see `ValueId::operator<=>`) is cheap.
+  static PositionInVocab positionInVocab(InlineString word);
+
+  // Compare two words (given by their string representations) in the same way
+  // as two `LocalVocabEntry`s are compared.
+  static std::strong_ordering compareStringRepresentations(std::string_view a,
+                                                           std::string_view b);
+
   // It suffices to hash the base class `LiteralOrIri` as the position in the
   // vocab is redundant for those purposes.
   template <typename H, typename V>
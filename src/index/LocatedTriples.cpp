@@ -51,7 +51,7 @@ NumAddedAndDeleted LocatedTriplesPerBlock::numTriples(size_t blockIndex) const {
     return {0, 0};
   }
 
-  auto blockUpdateTriples = map_.at(blockIndex);
+  const auto& blockUpdateTriples = *map_.at(blockIndex);
   size_t countInserts = ql::ranges::count_if(
       blockUpdateTriples, &LocatedTriple::shouldTripleExist_);
   return {countInserts, blockUpdateTriples.size() - countInserts};
@@ -112,7 +112,7 @@ IdTable LocatedTriplesPerBlock::mergeTriplesImpl(size_t blockIndex,
   IdTable result{block.numColumns(), block.getAllocator()};
   result.resize(block.numRows() + numInsertsAndDeletes.numAdded_);
 
-  const auto& locatedTriples = map_.at(blockIndex);
+  const auto& locatedTriples = *map_.at(blockIndex);
 
   auto lessThan = [](const auto& lt, const auto& row) {
     return tieLocatedTriple<numIndexColumns, includeGraphColumn>(lt) <
@@ -215,7 +215,12 @@ std::vector<LocatedTriples::iterator> LocatedTriplesPerBlock::add(
   std::vector<LocatedTriples::iterator> handles;
   handles.reserve(locatedTriples.size());
   for (auto triple : locatedTriples) {
-    LocatedTriples& locatedTriplesInBlock = map_[triple.blockIndex_];
+    auto& locatedTriplesInBlockPtr = map_[triple.blockIndex_];
+    if (locatedTriplesInBlockPtr == nullptr) {
+      locatedTriplesInBlockPtr = std::make_shared<LocatedTriples>();
+    }
+    LocatedTriples& locatedTriplesInBlock = *locatedTriplesInBlockPtr;
+    blocksModifiedSinceLastSnapshot_.insert(triple.blockIndex_);
     auto [handle, wasInserted] = locatedTriplesInBlock.emplace(triple);
     AD_CORRECTNESS_CHECK(wasInserted == true);
     AD_CORRECTNESS_CHECK(handle != locatedTriplesInBlock.end());
@@ -234,15 +239,41 @@ void LocatedTriplesPerBlock::erase(size_t blockIndex,
   auto blockIter = map_.find(blockIndex);
   AD_CONTRACT_CHECK(blockIter != map_.end(), "Block ", blockIndex,
                     " is not contained.");
-  auto& block = blockIter->second;
+  auto& block = *blockIter->second;
   block.erase(iter);
   numTriples_--;
+  blocksModifiedSinceLastSnapshot_.insert(blockIndex);
   if (block.empty()) {
     map_.erase(blockIndex);
   }
   updateAugmentedMetadata();
 }
 
+// ____________________________________________________________________________
+LocatedTriplesPerBlock LocatedTriplesPerBlock::copyForSnapshot() {
+  // Bring `lastSnapshotMap_` up to date by only copying the sets of the blocks
+  // that have changed since the last snapshot. All other sets are still
+  // identical to the ones from the last snapshot and can be shared.
+  for (size_t blockIndex : blocksModifiedSinceLastSnapshot_) {
+    auto it = map_.find(blockIndex);
+    if (it == map_.end()) {
+      lastSnapshotMap_.erase(blockIndex);
+    } else {
+      lastSnapshotMap_[blockIndex] =
+          std::make_shared<LocatedTriples>(*it->second);
+    }
+  }
+  blocksModifiedSinceLastSnapshot_.clear();
+  AD_EXPENSIVE_CHECK(lastSnapshotMap_.size() == map_.size());
+
+  LocatedTriplesPerBlock result;
+  result.numTriples_ = numTriples_;
+  result.map_ = lastSnapshotMap_;
+  result.augmentedMetadata_ = augmentedMetadata_;
+  result.originalMetadata_ = originalMetadata_;
+  return result;
+}
+
 // ____________________________________________________________________________
 void LocatedTriplesPerBlock::setOriginalMetadata(
     std::shared_ptr<const std::vector<CompressedBlockMetadata>> metadata) {
@@ -291,21 +322,67 @@ static auto updateGraphMetadata(CompressedBlockMetadata& blockMetadata,
   ql::ranges::sort(graphs.value());
 }
 
+// Update the `columnSummaries_` of the `blockMetadata`, such that they also
+// cover the triples that are inserted via the `locatedTriples`. Deleted
+// triples are ignored, so the summaries may become less precise, but are
+// never wrong.
+static void updateColumnSummaries(CompressedBlockMetadata& blockMetadata,
+                                  const LocatedTriples& locatedTriples) {
+  auto& summaries = blockMetadata.columnSummaries_;
+  if (!summaries.has_value()) {
+    return;
+  }
+  for (auto& lt : locatedTriples) {
+    if (!lt.shouldTripleExist_) {
+      continue;
+    }
+    for (size_t i = 0; i < summaries.value().size(); ++i) {
+      summaries.value()[i].add(lt.triple_.ids_.at(i));
+    }
+  }
+}
+
+// Add the `col1` of the triples that are inserted via the `locatedTriples` to
+// the `col1Filter_` of the `blockMetadata`, such that the filter never rules
+// out an inserted triple. If one of these `Id`s can't be stored in the filter
+// (for example, a new IRI from the `LocalVocab` of the updates), the filter is
+// removed.
+static void updateCol1Filter(CompressedBlockMetadata& blockMetadata,
+                             const LocatedTriples& locatedTriples) {
+  auto& filter = blockMetadata.col1Filter_;
+  for (auto& lt : locatedTriples) {
+    if (!filter.has_value()) {
+      return;
+    }
+    if (!lt.shouldTripleExist_) {
+      continue;
+    }
+    Id col1 = lt.triple_.ids_.at(1);
+    if (CompressedBlockMetadata::canBeInCol1Filter(col1)) {
+      filter.value().add(col1.getBits());
+    } else {
+      filter.reset();
+    }
+  }
+}
+
 // ____________________________________________________________________________
 void LocatedTriplesPerBlock::updateAugmentedMetadata() {
   // TODO<C++23> use view::enumerate
   size_t blockIndex = 0;
-  // Copy to preserve originalMetadata_.
+  // Copy to preserve originalMetadata_. Note that the previous
+  // `augmentedMetadata_` might still be used by a snapshot, so we always have to
+  // create a new vector.
+  std::vector<CompressedBlockMetadata> augmentedMetadata;
   if (!originalMetadata_.has_value()) {
     AD_LOG_WARN << "The original metadata has not been set, but updates are "
                    "being performed. This should only happen in unit tests\n";
-    augmentedMetadata_.emplace();
   } else {
-    augmentedMetadata_ = *originalMetadata_.value();
+    augmentedMetadata = *originalMetadata_.value();
   }
-  for (auto& blockMetadata : augmentedMetadata_.value()) {
+  for (auto& blockMetadata : augmentedMetadata) {
     if (hasUpdates(blockIndex)) {
-      const auto& blockUpdates = map_.at(blockIndex);
+      const auto& blockUpdates = *map_.at(blockIndex);
       blockMetadata.firstTriple_ =
           std::min(blockMetadata.firstTriple_,
                    blockUpdates.begin()->triple_.toPermutedTriple());
@@ -313,13 +390,15 @@ void LocatedTriplesPerBlock::updateAugmentedMetadata() {
           std::max(blockMetadata.lastTriple_,
                    blockUpdates.rbegin()->triple_.toPermutedTriple());
       updateGraphMetadata(blockMetadata, blockUpdates);
+      updateColumnSummaries(blockMetadata, blockUpdates);
+      updateCol1Filter(blockMetadata, blockUpdates);
     }
     blockIndex++;
   }
   // Also account for the last block that contains the triples that are larger
   // than all the inserted triples.
   if (hasUpdates(blockIndex)) {
-    const auto& blockUpdates = map_.at(blockIndex);
+    const auto& blockUpdates = *map_.at(blockIndex);
     auto firstTriple = blockUpdates.begin()->triple_.toPermutedTriple();
     auto lastTriple = blockUpdates.rbegin()->triple_.toPermutedTriple();
 
@@ -338,8 +417,11 @@ void LocatedTriplesPerBlock::updateAugmentedMetadata() {
     lastBlockN.graphInfo_.emplace();
     CompressedBlockMetadata lastBlock{lastBlockN, blockIndex};
     updateGraphMetadata(lastBlock, blockUpdates);
-    augmentedMetadata_->push_back(lastBlock);
+    augmentedMetadata.push_back(lastBlock);
   }
+  augmentedMetadata_ =
+      std::make_shared<const std::vector<CompressedBlockMetadata>>(
+          std::move(augmentedMetadata));
 }
 
 // ____________________________________________________________________________
@@ -368,6 +450,6 @@ bool LocatedTriplesPerBlock::isLocatedTriple(const IdTriple<0>& triple,
 
   return ql::ranges::any_of(map_, [&blockContains](auto& indexAndBlock) {
     const auto& [index, block] = indexAndBlock;
-    return blockContains(block, index);
+    return blockContains(*block, index);
   });
 }
@@ -12,6 +12,7 @@
 #include "global/IdTriple.h"
 #include "index/CompressedRelation.h"
 #include "util/HashMap.h"
+#include "util/HashSet.h"
 
 class Permutation;
 
@@ -78,10 +79,27 @@ class LocatedTriplesPerBlock {
   size_t numTriples_ = 0;
 
   // For each block with a non-empty set of located triples, the located triples
-  // in that block.
-  ad_utility::HashMap<size_t, LocatedTriples> map_;
+  // in that block. The sets are stored via `shared_ptr`, such that a snapshot
+  // (see `copyForSnapshot` below) can share the sets of all the blocks that
+  // have not changed since the previous snapshot.
+  //
+  // NOTE: The sets that are owned by an object that is modified via `add` or
+  // `erase` are never shared with a snapshot, so the iterators returned by
+  // `add` remain valid.
+  ad_utility::HashMap<size_t, std::shared_ptr<LocatedTriples>> map_;
+
+  // The indices of the blocks that were modified via `add` or `erase` since the
+  // last call to `copyForSnapshot`.
+  ad_utility::HashSet<size_t> blocksModifiedSinceLastSnapshot_;
+
+  // The (immutable) copies of the sets that were handed out with the last call
+  // to `copyForSnapshot`. They are reused by the next snapshot for all blocks
+  // that are not contained in `blocksModifiedSinceLastSnapshot_`.
+  ad_utility::HashMap<size_t, std::shared_ptr<LocatedTriples>>
+      lastSnapshotMap_;
 
   FRIEND_TEST(LocatedTriplesTest, numTriplesInBlock);
+  FRIEND_TEST(LocatedTriplesTest, copyForSnapshot);
 
   // Implementation of the `mergeTriples` function (which has `numIndexColumns`
   // as a normal argument, and translates it into a template argument).
@@ -89,8 +107,11 @@ class LocatedTriplesPerBlock {
   IdTable mergeTriplesImpl(size_t blockIndex, const IdTable& block) const;
 
   // Stores the block metadata where the block borders have been adjusted for
-  // the updated triples.
-  std::optional<std::vector<CompressedBlockMetadata>> augmentedMetadata_;
+  // the updated triples. This is a `shared_ptr` to a constant vector such that
+  // snapshots can share it without copying (`nullptr` means that there are no
+  // updates and the original metadata is used).
+  std::shared_ptr<const std::vector<CompressedBlockMetadata>>
+      augmentedMetadata_;
   std::optional<std::shared_ptr<const std::vector<CompressedBlockMetadata>>>
       originalMetadata_;
 
@@ -132,6 +153,17 @@ class LocatedTriplesPerBlock {
   IdTable mergeTriples(size_t blockIndex, const IdTable& block,
                        size_t numIndexColumns, bool includeGraphColumn) const;
 
+  // Return a copy of this object that can be used as part of a snapshot (see
+  // `LocatedTriplesSnapshot` in `DeltaTriples.h`). The sets of all blocks that
+  // have not been modified since the last call to this function are shared with
+  // the previous snapshot, only the modified blocks are copied. The cost of a
+  // snapshot is thus linear in the number of modified located triples (and in
+  // the number of blocks with located triples), but not in the total number of
+  // located triples.
+  //
+  // NOTE: The returned object must not be modified via `add` or `erase`.
+  LocatedTriplesPerBlock copyForSnapshot();
+
   // Return true iff there are located triples in the block with the given
   // index.
   bool containsTriples(size_t blockIndex) const {
@@ -171,8 +203,8 @@ class LocatedTriplesPerBlock {
   // account for the update triples. All triples (both insert and delete) will
   // enlarge the block borders.
   const std::vector<CompressedBlockMetadata>& getAugmentedMetadata() const {
-    if (augmentedMetadata_.has_value()) {
-      return augmentedMetadata_.value();
+    if (augmentedMetadata_ != nullptr) {
+      return *augmentedMetadata_;
     }
     AD_CONTRACT_CHECK(originalMetadata_.has_value());
     return *originalMetadata_.value();
@@ -181,6 +213,8 @@ class LocatedTriplesPerBlock {
   // Remove all located triples.
   void clear() {
     map_.clear();
+    blocksModifiedSinceLastSnapshot_.clear();
+    lastSnapshotMap_.clear();
     numTriples_ = 0;
     augmentedMetadata_.reset();
   }
@@ -201,8 +235,8 @@ class LocatedTriplesPerBlock {
                      std::back_inserter(blockIndices));
     ql::ranges::sort(blockIndices);
     for (auto blockIndex : blockIndices) {
-      os << "LTs in Block #" << blockIndex << ": " << ltpb.map_.at(blockIndex)
-         << std::endl;
+      os << "LTs in Block #" << blockIndex << ": "
+         << *ltpb.map_.at(blockIndex) << std::endl;
     }
     return os;
   };
@@ -0,0 +1,170 @@
+//  Copyright 2025, University of Freiburg,
+//                  Chair of Algorithms and Data Structures.
+
+#include "index/PredicateStatistics.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "backports/algorithm.h"
+#include "util/Exception.h"
+#include "util/Serializer/FileSerializer.h"
+
+// _____________________________________________________________________________
+ValueHistogram ValueHistogram::fromSortedSample(std::span<const Id> sample,
+                                                uint64_t numValues,
+                                                uint64_t numDistinctValues,
+                                                size_t maxNumBuckets) {
+  AD_CONTRACT_CHECK(maxNumBuckets > 0);
+  AD_CONTRACT_CHECK(std::is_sorted(sample.begin(), sample.end()));
+  ValueHistogram result;
+  result.numValues_ = numValues;
+  result.numDistinctValues_ = std::min(numDistinctValues, numValues);
+  if (sample.empty()) {
+    return result;
+  }
+  // If the sample contains all the values, the counts are exact, else they
+  // are scaled by `numValues / sample.size()`.
+  const bool isExact = sample.size() == numValues;
+  const double scale = static_cast<double>(numValues) / sample.size();
+  const size_t targetBucketSize =
+      (sample.size() + maxNumBuckets - 1) / maxNumBuckets;
+  size_t numDistinctInSample = 0;
+  for (size_t i = 0; i < sample.size(); ++i) {
+    numDistinctInSample += i == 0 || sample[i] != sample[i - 1];
+  }
+
+  size_t begin = 0;
+  while (begin < sample.size()) {
+    // Extend the bucket to the end of the run of its last value.
+    size_t end = std::min(begin + targetBucketSize, sample.size());
+    while (end < sample.size() && sample[end] == sample[end - 1]) {
+      ++end;
+    }
+    Bucket bucket;
+    size_t numDistinctInBucket = 0;
+    for (size_t i = begin; i < end; ++i) {
+      bucket.summary_.add(sample[i]);
+      numDistinctInBucket += i == begin || sample[i] != sample[i - 1];
+    }
+    if (isExact) {
+      bucket.numValues_ = end - begin;
+      bucket.numDistinctValues_ = numDistinctInBucket;
+    } else {
+      bucket.numValues_ = std::max<uint64_t>(
+          1, static_cast<uint64_t>(std::round((end - begin) * scale)));
+      // The distinct values are distributed over the buckets like the
+      // distinct values of the sample. The distinct values of the bucket's
+      // sample are a lower bound.
+      double numDistinct = static_cast<double>(result.numDistinctValues_) *
+                           numDistinctInBucket / numDistinctInSample;
+      bucket.numDistinctValues_ = std::clamp<uint64_t>(
+          static_cast<uint64_t>(std::round(numDistinct)), numDistinctInBucket,
+          bucket.numValues_);
+    }
+    result.buckets_.push_back(bucket);
+    begin = end;
+  }
+  return result;
+}
+
+// _____________________________________________________________________________
+double ValueHistogram::estimateFractionInRangeOf(
+    const ValueHistogram& other) const {
+  if (numValues_ == 0 || buckets_.empty() || other.buckets_.empty()) {
+    return 1.0;
+  }
+  const Id otherMin = other.buckets_.front().summary_.min_;
+  const Id otherMax = other.buckets_.back().summary_.max_;
+  double numValuesInRange = 0;
+  uint64_t numValuesTotal = 0;
+  for (const auto& [summary, numValues, numDistinct] : buckets_) {
+    numValuesTotal += numValues;
+    if (summary.max_ < otherMin || summary.min_ > otherMax) {
+      continue;
+    }
+    bool isContained = summary.min_ >= otherMin && summary.max_ <= otherMax;
+    // For a partial overlap, we assume that half of the values are in range.
+    numValuesInRange += isContained ? numValues : numValues / 2.0;
+  }
+  return numValuesInRange / static_cast<double>(numValuesTotal);
+}
+
+// _____________________________________________________________________________
+const ValueHistogram* PredicateStatistics::getObjectHistogram(
+    Id predicate) const {
+  auto it = objectHistograms_.find(predicate);
+  return it == objectHistograms_.end() ? nullptr : &it->second;
+}
+
+// _____________________________________________________________________________
+void PredicateStatistics::writeToFile(const std::string& filename) const {
+  ad_utility::serialization::FileWriteSerializer serializer{filename};
+  serializer << *this;
+}
+
+// _____________________________________________________________________________
+PredicateStatistics PredicateStatistics::readFromFile(
+    const std::string& filename) {
+  ad_utility::serialization::FileReadSerializer serializer{filename};
+  PredicateStatistics statistics;
+  serializer >> statistics;
+  return statistics;
+}
+
+// _____________________________________________________________________________
+PredicateStatistics::Builder::Builder(size_t sampleSize, size_t maxNumBuckets)
+    : sampleSize_{sampleSize}, maxNumBuckets_{maxNumBuckets} {
+  AD_CONTRACT_CHECK(sampleSize_ > 0 && maxNumBuckets_ > 0);
+  sample_.reserve(sampleSize_);
+}
+
+// _____________________________________________________________________________
+void PredicateStatistics::Builder::addTriple(Id predicate, Id object) {
+  if (currentPredicate_ != predicate) {
+    finishCurrentPredicate();
+    currentPredicate_ = predicate;
+    AD_CONTRACT_CHECK(!result_.objectHistograms_.contains(predicate),
+                      "The triples must be grouped by their predicate");
+  }
+  ++numValues_;
+  distinctValues_.add(object.getBits());
+  // Reservoir sampling: The `i`-th value replaces a random element of the
+  // sample with probability `sampleSize / i`.
+  if (sample_.size() < sampleSize_) {
+    sample_.push_back(object);
+  } else if (uint64_t index = randomGenerator_() % numValues_;
+             index < sampleSize_) {
+    sample_[index] = object;
+  }
+}
+
+// _____________________________________________________________________________
+void PredicateStatistics::Builder::finishCurrentPredicate() {
+  if (!currentPredicate_.has_value()) {
+    return;
+  }
+  ql::ranges::sort(sample_);
+  // If all the values are in the sample, the number of distinct values is
+  // exact, else the `HyperLogLog` estimate is used.
+  uint64_t numDistinctValues = distinctValues_.estimate();
+  if (sample_.size() == numValues_) {
+    numDistinctValues = 0;
+    for (size_t i = 0; i < sample_.size(); ++i) {
+      numDistinctValues += i == 0 || sample_[i] != sample_[i - 1];
+    }
+  }
+  result_.objectHistograms_[currentPredicate_.value()] =
+      ValueHistogram::fromSortedSample(sample_, numValues_, numDistinctValues,
+                                       maxNumBuckets_);
+  currentPredicate_.reset();
+  sample_.clear();
+  numValues_ = 0;
+  distinctValues_ = ad_utility::HyperLogLog{};
+}
+
+// _____________________________________________________________________________
+PredicateStatistics PredicateStatistics::Builder::finish() && {
+  finishCurrentPredicate();
+  return std::move(result_);
+}
@@ -0,0 +1,129 @@
+//  Copyright 2025, University of Freiburg,
+//                  Chair of Algorithms and Data Structures.
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "global/Id.h"
+#include "index/CompressedRelation.h"
+#include "util/HashMap.h"
+#include "util/HyperLogLog.h"
+#include "util/Random.h"
+#include "util/Serializer/SerializeHashMap.h"
+#include "util/Serializer/SerializeVector.h"
+#include "util/Serializer/Serializer.h"
+
+// An equi-depth histogram of the values of a column: The (sorted) values are
+// split into buckets with roughly the same number of values. Each bucket knows
+// the smallest and largest value and the datatypes of its values (as a
+// `ColumnSummary`, like the blocks of a permutation), and the number of
+// (distinct) values. The histogram is used by the query planner to estimate
+// the selectivity of FILTERs and the size of joins.
+class ValueHistogram {
+ public:
+  using ColumnSummary = CompressedBlockMetadata::ColumnSummary;
+  struct Bucket {
+    ColumnSummary summary_;
+    uint64_t numValues_ = 0;
+    uint64_t numDistinctValues_ = 0;
+
+    bool operator==(const Bucket&) const = default;
+    AD_SERIALIZE_FRIEND_FUNCTION(Bucket) {
+      serializer | arg.summary_;
+      serializer | arg.numValues_;
+      serializer | arg.numDistinctValues_;
+    }
+  };
+
+ private:
+  std::vector<Bucket> buckets_;
+  uint64_t numValues_ = 0;
+  uint64_t numDistinctValues_ = 0;
+
+ public:
+  ValueHistogram() = default;
+
+  // Create the histogram for a column with `numValues` values, of which
+  // `numDistinctValues` are distinct, from a uniform `sample` of these values
+  // that is sorted by the order of the `Id`s. The histogram has at most
+  // `maxNumBuckets` buckets, and equal values are never split between two
+  // buckets.
+  static ValueHistogram fromSortedSample(std::span<const Id> sample,
+                                         uint64_t numValues,
+                                         uint64_t numDistinctValues,
+                                         size_t maxNumBuckets);
+
+  const std::vector<Bucket>& buckets() const { return buckets_; }
+  uint64_t numValues() const { return numValues_; }
+  uint64_t numDistinctValues() const { return numDistinctValues_; }
+
+  // The estimated fraction of the values of this histogram that lie in the
+  // range `[min, max]` of the values of the `other` histogram. Values outside
+  // this range can't have a join partner in the column of the `other`
+  // histogram.
+  double estimateFractionInRangeOf(const ValueHistogram& other) const;
+
+  bool operator==(const ValueHistogram&) const = default;
+  AD_SERIALIZE_FRIEND_FUNCTION(ValueHistogram) {
+    serializer | arg.buckets_;
+    serializer | arg.numValues_;
+    serializer | arg.numDistinctValues_;
+  }
+};
+
+// Statistics about the objects of each predicate (an equi-depth histogram with
+// an estimate of the number of distinct objects), which are computed while the
+// PSO permutation is built, and stored in a separate file of the index.
+class PredicateStatistics {
+ private:
+  ad_utility::HashMap<Id, ValueHistogram> objectHistograms_;
+
+ public:
+  // The histogram of the objects of the `predicate`, or `nullptr` if the
+  // predicate has no triples.
+  const ValueHistogram* getObjectHistogram(Id predicate) const;
+
+  size_t numPredicates() const { return objectHistograms_.size(); }
+
+  void writeToFile(const std::string& filename) const;
+  static PredicateStatistics readFromFile(const std::string& filename);
+
+  AD_SERIALIZE_FRIEND_FUNCTION(PredicateStatistics) {
+    serializer | arg.objectHistograms_;
+  }
+
+  // Computes the `PredicateStatistics` from all the triples in a single pass.
+  // The triples have to be sorted (or at least grouped) by their predicate,
+  // but the objects of a predicate can be in any order. For each predicate,
+  // only a reservoir sample of the objects and a `HyperLogLog` sketch are
+  // kept in memory.
+  class Builder {
+   private:
+    size_t sampleSize_;
+    size_t maxNumBuckets_;
+    std::optional<Id> currentPredicate_;
+    std::vector<Id> sample_;
+    uint64_t numValues_ = 0;
+    ad_utility::HyperLogLog distinctValues_;
+    // A fixed seed makes the statistics of an index deterministic.
+    ad_utility::FastRandomIntGenerator<uint64_t> randomGenerator_{
+        ad_utility::RandomSeed::make(42)};
+    PredicateStatistics result_;
+
+   public:
+    explicit Builder(size_t sampleSize = 1024, size_t maxNumBuckets = 32);
+
+    void addTriple(Id predicate, Id object);
+
+    PredicateStatistics finish() &&;
+
+   private:
+    // Create the histogram for the `currentPredicate_` and reset the state.
+    void finishCurrentPredicate();
+  };
+};
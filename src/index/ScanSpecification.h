@@ -3,7 +3,12 @@
 //  Author: Johannes Kalmbach <kalmbach@cs.uni-freiburg.de>
 
 #pragma once
+#include <cstdint>
+#include <functional>
+#include <memory>
 #include <optional>
+#include <span>
+#include <vector>
 
 #include "engine/LocalVocab.h"
 #include "global/Id.h"
@@ -23,6 +28,16 @@ class ScanSpecification {
  public:
   using T = std::optional<Id>;
   using Graphs = std::optional<ad_utility::HashSet<Id>>;
+  // A filter on the rows of the scan result, that is evaluated on a single
+  // column of the result. It returns one entry per row, and the rows for which
+  // this entry is zero are removed from the result.
+  using RowFilter = std::function<std::vector<uint8_t>(std::span<const Id>)>;
+  // A `RowFilter` together with the column of the scan result (including the
+  // additional columns) on which it is evaluated.
+  struct RowFilterOnColumn {
+    std::shared_ptr<const RowFilter> filter_;
+    ColumnIndex column_ = 0;
+  };
 
  private:
   T col0Id_;
@@ -43,6 +58,12 @@ class ScanSpecification {
   // If specified (i.e. not `nullopt`) then the result of the scan only consists
   // of triples that belong to the union of these graphs.
   Graphs graphsToFilter_{};
+  // The rows of the scan result are filtered by these filters directly after
+  // the blocks have been decompressed (a row is kept iff all the filters keep
+  // it). This is used to push down simple FILTERs and the filters of joins into
+  // the scan (see `IndexScan`). Note that no filters must be added if the scan
+  // has a LIMIT or OFFSET.
+  std::vector<RowFilterOnColumn> rowFilters_;
   friend class ScanSpecificationAsTripleComponent;
 
   void validate() const;
@@ -63,6 +84,16 @@ class ScanSpecification {
 
   const Graphs& graphsToFilter() const { return graphsToFilter_; }
 
+  const std::vector<RowFilterOnColumn>& rowFilters() const {
+    return rowFilters_;
+  }
+  // Add a filter that is evaluated on the `column` of the scan result. Column
+  // `0` is the first column that is not fixed by the `colXId_`s.
+  void addRowFilter(std::shared_ptr<const RowFilter> rowFilter,
+                    ColumnIndex column = 0) {
+    rowFilters_.push_back({std::move(rowFilter), column});
+  }
+
   // Only used in tests.
   void setCol1Id(T col1Id) {
     col1Id_ = col1Id;
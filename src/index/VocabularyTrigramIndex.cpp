@@ -0,0 +1,152 @@
+//  Copyright 2025, University of Freiburg,
+//                  Chair of Algorithms and Data Structures.
+
+#include "index/VocabularyTrigramIndex.h"
+
+#include <absl/strings/str_cat.h>
+#include <unicode/uchar.h>
+#include <unicode/utf8.h>
+
+#include <algorithm>
+#include <span>
+
+#include "backports/algorithm.h"
+#include "util/Exception.h"
+#include "util/HashMap.h"
+#include "util/Serializer/FileSerializer.h"
+#include "util/Serializer/SerializeString.h"
+#include "util/Serializer/SerializeVector.h"
+
+// _____________________________________________________________________________
+std::string VocabularyTrigramIndex::normalize(std::string_view word) {
+  std::string result;
+  result.reserve(word.size());
+  auto length = static_cast<int32_t>(word.size());
+  int32_t i = 0;
+  while (i < length) {
+    int32_t begin = i;
+    UChar32 codePoint;
+    U8_NEXT(word.data(), i, length, codePoint);
+    if (codePoint < 0) {
+      // Invalid UTF-8 is kept as it is.
+      result.append(word.substr(begin, i - begin));
+      continue;
+    }
+    codePoint = u_foldCase(codePoint, U_FOLD_CASE_DEFAULT);
+    char buffer[U8_MAX_LENGTH];
+    int32_t bufferLength = 0;
+    U8_APPEND_UNSAFE(buffer, bufferLength, codePoint);
+    result.append(buffer, bufferLength);
+  }
+  return result;
+}
+
+// _____________________________________________________________________________
+auto VocabularyTrigramIndex::getTrigrams(std::string_view normalizedWord)
+    -> std::vector<Trigram> {
+  std::vector<Trigram> result;
+  for (size_t i = 0; i + 3 <= normalizedWord.size(); ++i) {
+    auto byte = [&normalizedWord, i](size_t j) {
+      return static_cast<Trigram>(
+          static_cast<unsigned char>(normalizedWord[i + j]));
+    };
+    result.push_back((byte(0) << 16) | (byte(1) << 8) | byte(2));
+  }
+  ql::ranges::sort(result);
+  result.erase(std::unique(result.begin(), result.end()), result.end());
+  return result;
+}
+
+// _____________________________________________________________________________
+void VocabularyTrigramIndex::build(
+    const std::string& filename, std::string_view indexId, size_t numWords,
+    const std::function<std::string(size_t)>& getWord) {
+  // First pass: Count the words for each trigram to compute the offsets.
+  ad_utility::HashMap<Trigram, uint64_t> counts;
+  for (size_t i = 0; i < numWords; ++i) {
+    for (Trigram trigram : getTrigrams(normalize(getWord(i)))) {
+      ++counts[trigram];
+    }
+  }
+  std::vector<Trigram> trigrams;
+  trigrams.reserve(counts.size());
+  for (const auto& [trigram, count] : counts) {
+    trigrams.push_back(trigram);
+  }
+  ql::ranges::sort(trigrams);
+  std::vector<uint64_t> offsets;
+  offsets.reserve(trigrams.size() + 1);
+  offsets.push_back(0);
+  for (Trigram trigram : trigrams) {
+    offsets.push_back(offsets.back() + counts.at(trigram));
+  }
+
+  // Second pass: Fill the posting lists directly on disk. The words are
+  // visited in ascending order, so each posting list is sorted.
+  {
+    ad_utility::MmapVector<uint64_t> postings(
+        offsets.back(), absl::StrCat(filename, postingsSuffix_),
+        ad_utility::AccessPattern::Random);
+    std::vector<uint64_t> nextPosition(offsets.begin(), offsets.end() - 1);
+    for (size_t i = 0; i < numWords; ++i) {
+      for (Trigram trigram : getTrigrams(normalize(getWord(i)))) {
+        auto trigramIndex =
+            ql::ranges::lower_bound(trigrams, trigram) - trigrams.begin();
+        postings[nextPosition[trigramIndex]++] = i;
+      }
+    }
+  }  // The destructor of the `MmapVector` writes its metadata to disk.
+
+  ad_utility::serialization::FileWriteSerializer serializer{filename};
+  serializer << std::string{indexId};
+  serializer << static_cast<uint64_t>(numWords);
+  serializer << trigrams;
+  serializer << offsets;
+}
+
+// _____________________________________________________________________________
+VocabularyTrigramIndex VocabularyTrigramIndex::readFromFile(
+    const std::string& filename) {
+  VocabularyTrigramIndex index;
+  ad_utility::serialization::FileReadSerializer serializer{filename};
+  serializer >> index.indexId_;
+  serializer >> index.numWords_;
+  serializer >> index.trigrams_;
+  serializer >> index.offsets_;
+  index.postings_.open(absl::StrCat(filename, postingsSuffix_),
+                       ad_utility::AccessPattern::Random);
+  AD_CORRECTNESS_CHECK(index.offsets_.size() == index.trigrams_.size() + 1);
+  AD_CORRECTNESS_CHECK(index.offsets_.back() == index.postings_.size());
+  return index;
+}
+
+// _____________________________________________________________________________
+std::vector<uint64_t> VocabularyTrigramIndex::getCandidates(
+    std::string_view normalizedSubstring) const {
+  auto trigrams = getTrigrams(normalizedSubstring);
+  AD_CONTRACT_CHECK(!trigrams.empty());
+  // Get the posting lists of all the trigrams and intersect them, starting
+  // with the shortest one.
+  std::vector<std::span<const uint64_t>> postingLists;
+  for (Trigram trigram : trigrams) {
+    auto it = ql::ranges::lower_bound(trigrams_, trigram);
+    if (it == trigrams_.end() || *it != trigram) {
+      return {};
+    }
+    size_t i = it - trigrams_.begin();
+    postingLists.emplace_back(postings_.data() + offsets_[i],
+                              postings_.data() + offsets_[i + 1]);
+  }
+  ql::ranges::sort(postingLists, std::less{},
+                   [](const auto& list) { return list.size(); });
+  std::vector<uint64_t> result(postingLists[0].begin(),
+                               postingLists[0].end());
+  std::vector<uint64_t> intersection;
+  for (const auto& list : postingLists | ql::views::drop(1)) {
+    intersection.clear();
+    std::set_intersection(result.begin(), result.end(), list.begin(),
+                          list.end(), std::back_inserter(intersection));
+    std::swap(result, intersection);
+  }
+  return result;
+}
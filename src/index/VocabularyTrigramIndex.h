@@ -0,0 +1,82 @@
+//  Copyright 2025, University of Freiburg,
+//                  Chair of Algorithms and Data Structures.
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "util/MmapVector.h"
+
+// An inverted index from the trigrams (three consecutive bytes) of the
+// normalized (case-folded) words of the vocabulary to the indices of the words
+// that contain them. For a substring of at least three bytes, the index
+// yields a small superset of the words that contain the substring, without
+// looking at the words themselves. This is used to evaluate regexes with
+// required literal substrings (see `RegexExpression`) only on few candidate
+// words. The index is optional and built by the `IndexBuilderMain` on
+// request.
+//
+// The trigrams and the offsets of their posting lists are kept in RAM, the
+// (much larger) posting lists are memory-mapped from a separate file.
+class VocabularyTrigramIndex {
+ public:
+  // The three bytes of a trigram, in the lower 24 bits.
+  using Trigram = uint32_t;
+
+  // The posting lists are stored in the file `<filename>.postings`, where
+  // `<filename>` is the file of the trigrams and offsets.
+  static constexpr std::string_view postingsSuffix_ = ".postings";
+
+ private:
+  // The distinct trigrams of all the words (sorted).
+  std::vector<Trigram> trigrams_;
+  // The posting list of `trigrams_[i]` is `postings_[offsets_[i],
+  // offsets_[i + 1])`, it contains the (sorted) indices of all the words that
+  // contain this trigram.
+  std::vector<uint64_t> offsets_;
+  ad_utility::MmapVectorView<uint64_t> postings_;
+  // The ID of the index and the size of the vocabulary for which the index
+  // was built, to detect an index that doesn't belong to the current
+  // vocabulary.
+  std::string indexId_;
+  uint64_t numWords_ = 0;
+
+ public:
+  // Build the index for the words with the indices `[0, numWords)` of the
+  // vocabulary of the index with the given `indexId` and write it to the
+  // `filename` (and the file with the `postingsSuffix_`). `getWord(i)` has to
+  // return the `i`-th word. It is called twice for each word, s.t. the words
+  // don't have to be kept in memory.
+  static void build(const std::string& filename, std::string_view indexId,
+                    size_t numWords,
+                    const std::function<std::string(size_t)>& getWord);
+
+  // Read an index that was written by `build`.
+  static VocabularyTrigramIndex readFromFile(const std::string& filename);
+
+  // The normalization of the words and substrings: The simple case folding
+  // of each code point (without the context-dependent and one-to-many
+  // mappings of the full case mapping, like the final sigma). This is the same
+  // per-code-point equivalence that RE2 uses for case-insensitive matching, so
+  // the normalized required substrings of a regex (which RE2 lowercases per
+  // code point) are substrings of the normalized words that match it.
+  static std::string normalize(std::string_view word);
+
+  // The distinct trigrams of the `normalizedWord` (sorted).
+  static std::vector<Trigram> getTrigrams(std::string_view normalizedWord);
+
+  // Return the (sorted) indices of all the words that contain all the
+  // trigrams of the `normalizedSubstring`. This is a superset of the words
+  // that contain the `normalizedSubstring`. The `normalizedSubstring` must
+  // have at least three bytes.
+  std::vector<uint64_t> getCandidates(
+      std::string_view normalizedSubstring) const;
+
+  size_t numTrigrams() const { return trigrams_.size(); }
+  const std::string& indexId() const { return indexId_; }
+  uint64_t numWords() const { return numWords_; }
+};
@@ -0,0 +1,149 @@
+//  Copyright 2025, University of Freiburg,
+//                  Chair of Algorithms and Data Structures.
+
+#include "util/BatchedFileReader.h"
+
+#ifdef QLEVER_USE_IO_URING
+#include <liburing.h>
+#endif
+
+#include <absl/strings/str_cat.h>
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "util/Exception.h"
+
+namespace ad_utility {
+
+namespace {
+// Throw an exception for a failed read from the `file` with the `errorCode`.
+[[noreturn]] void throwReadError(const File& file, int errorCode) {
+  throw std::runtime_error{absl::StrCat("Reading from file \"", file.name(),
+                                        "\" failed: ", strerror(errorCode))};
+}
+
+// Perform the `request` via `pread`, except for the first `numBytesDone` bytes
+// which have already been read.
+void readViaPread(const File& file, const FileReadRequest& request,
+                  size_t numBytesDone = 0) {
+  AD_CORRECTNESS_CHECK(numBytesDone <= request.size_);
+  auto numBytesRead =
+      file.read(request.target_ + numBytesDone, request.size_ - numBytesDone,
+                request.offset_ + static_cast<off_t>(numBytesDone));
+  if (numBytesRead < 0) {
+    throwReadError(file, errno);
+  }
+}
+
+#ifdef QLEVER_USE_IO_URING
+// An io_uring with room for `MAX_NUM_READS_IN_FLIGHT` requests. Each thread
+// uses its own instance (see `getIoUringForThisThread`), so no synchronization
+// is required.
+class IoUring {
+  io_uring ring_;
+  bool isValid_ = false;
+
+ public:
+  IoUring() {
+    isValid_ = io_uring_queue_init(MAX_NUM_READS_IN_FLIGHT, &ring_, 0) == 0;
+  }
+  ~IoUring() {
+    if (isValid_) {
+      io_uring_queue_exit(&ring_);
+    }
+  }
+  IoUring(const IoUring&) = delete;
+  IoUring& operator=(const IoUring&) = delete;
+
+  bool isValid() const { return isValid_; }
+  io_uring* get() { return &ring_; }
+};
+
+IoUring& getIoUringForThisThread() {
+  thread_local IoUring ring;
+  return ring;
+}
+
+// Submit the `requests` (at most `MAX_NUM_READS_IN_FLIGHT`) to the `ring` and
+// wait until all of them are done.
+void readViaIoUring(io_uring* ring, const File& file,
+                    std::span<const FileReadRequest> requests) {
+  AD_CORRECTNESS_CHECK(requests.size() <= MAX_NUM_READS_IN_FLIGHT);
+  const int fd = file.fileDescriptor();
+  for (const auto& request : requests) {
+    io_uring_sqe* sqe = io_uring_get_sqe(ring);
+    AD_CORRECTNESS_CHECK(sqe != nullptr);
+    io_uring_prep_read(sqe, fd, request.target_,
+                       static_cast<unsigned>(request.size_), request.offset_);
+    io_uring_sqe_set_data(sqe, const_cast<FileReadRequest*>(&request));
+  }
+  int numSubmitted = io_uring_submit(ring);
+  if (numSubmitted < 0) {
+    throwReadError(file, -numSubmitted);
+  }
+  AD_CORRECTNESS_CHECK(static_cast<size_t>(numSubmitted) == requests.size());
+
+  // Reap all the completions before throwing, s.t. the ring is empty for the
+  // next call. Reads that returned fewer bytes than requested are completed
+  // via `pread`.
+  int errorCode = 0;
+  std::vector<std::pair<const FileReadRequest*, size_t>> partialReads;
+  for (size_t i = 0; i < requests.size(); ++i) {
+    io_uring_cqe* cqe = nullptr;
+    int result = io_uring_wait_cqe(ring, &cqe);
+    AD_CORRECTNESS_CHECK(result == 0, [&result]() {
+      return absl::StrCat("Waiting for an io_uring completion failed: ",
+                          strerror(-result));
+    });
+    const auto* request =
+        static_cast<const FileReadRequest*>(io_uring_cqe_get_data(cqe));
+    int numBytesRead = cqe->res;
+    io_uring_cqe_seen(ring, cqe);
+    if (numBytesRead < 0) {
+      errorCode = -numBytesRead;
+    } else if (static_cast<size_t>(numBytesRead) < request->size_) {
+      partialReads.emplace_back(request, numBytesRead);
+    }
+  }
+  if (errorCode != 0) {
+    throwReadError(file, errorCode);
+  }
+  for (const auto& [request, numBytesDone] : partialReads) {
+    readViaPread(file, *request, numBytesDone);
+  }
+}
+#endif
+}  // namespace
+
+// _____________________________________________________________________________
+void readBatch(const File& file, std::span<const FileReadRequest> requests) {
+#ifdef QLEVER_USE_IO_URING
+  auto& ring = getIoUringForThisThread();
+  if (ring.isValid()) {
+    for (size_t i = 0; i < requests.size(); i += MAX_NUM_READS_IN_FLIGHT) {
+      readViaIoUring(ring.get(), file,
+                     requests.subspan(i, std::min(MAX_NUM_READS_IN_FLIGHT,
+                                                  requests.size() - i)));
+    }
+    return;
+  }
+#endif
+  for (const auto& request : requests) {
+    readViaPread(file, request);
+  }
+}
+
+// _____________________________________________________________________________
+bool isIoUringAvailable() {
+#ifdef QLEVER_USE_IO_URING
+  return getIoUringForThisThread().isValid();
+#else
+  return false;
+#endif
+}
+
+}  // namespace ad_utility
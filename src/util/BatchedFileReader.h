@@ -0,0 +1,39 @@
+//  Copyright 2025, University of Freiburg,
+//                  Chair of Algorithms and Data Structures.
+
+#pragma once
+
+#include <sys/types.h>
+
+#include <cstddef>
+#include <span>
+
+#include "util/File.h"
+
+namespace ad_utility {
+
+// A single read of `size_` bytes at the `offset_` of a file into `target_`.
+struct FileReadRequest {
+  char* target_;
+  size_t size_;
+  off_t offset_;
+};
+
+// The maximal number of reads that `readBatch` submits at once.
+inline constexpr size_t MAX_NUM_READS_IN_FLIGHT = 64;
+
+// Perform all the `requests` on the `file` and return when all of them are
+// done. Throw if one of the reads fails.
+//
+// If QLever was built with io_uring support (see `USE_IO_URING` in the
+// `CMakeLists.txt`), then the requests are submitted to the kernel at once,
+// so that the SSD can serve them in parallel. Otherwise, or if io_uring cannot
+// be used at runtime (for example because it is forbidden by the seccomp
+// profile of a container), the requests are performed one after the other via
+// `pread`.
+void readBatch(const File& file, std::span<const FileReadRequest> requests);
+
+// Return true iff `readBatch` uses io_uring (in the calling thread).
+bool isIoUringAvailable();
+
+}  // namespace ad_utility
@@ -30,6 +30,18 @@ constexpr inline uint64_t bitMaskForHigherBits(uint64_t numBits) {
   return ~bitMaskForLowerBits(64 - numBits);
 }
 
+// The finalizer of MurmurHash3, which mixes all the bits of the `key`. This is
+// a cheap hash function for keys like `Id`s that typically differ only in a
+// few (low) bits, e.g. for Bloom filters, partitioning, and sketches.
+constexpr inline uint64_t mixBits(uint64_t key) {
+  key ^= key >> 33;
+  key *= 0xff51afd7ed558ccdULL;
+  key ^= key >> 33;
+  key *= 0xc4ceb9fe1a85ec53ULL;
+  key ^= key >> 33;
+  return key;
+}
+
 namespace detail {
 
 // Return any value, the type of which is the smallest unsigned integer type
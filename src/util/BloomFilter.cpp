@@ -0,0 +1,76 @@
+//  Copyright 2025, University of Freiburg,
+//                  Chair of Algorithms and Data Structures.
+
+#include "util/BloomFilter.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "util/BitUtils.h"
+#include "util/Exception.h"
+
+namespace ad_utility {
+
+namespace {
+// Call `f(bitIndex)` for each of the `numHashFunctions` bits of the `key` in a
+// filter with `numBits` bits.
+template <typename F>
+void forEachBit(uint64_t key, size_t numHashFunctions, size_t numBits, F f) {
+  uint64_t hash = mixBits(key);
+  uint64_t h1 = hash & 0xffffffff;
+  // An odd step size ensures that the bits are distinct for a power of two.
+  uint64_t h2 = (hash >> 32) | 1;
+  for (size_t i = 0; i < numHashFunctions; ++i) {
+    f((h1 + i * h2) % numBits);
+  }
+}
+}  // namespace
+
+// _____________________________________________________________________________
+BloomFilter::BloomFilter(size_t numBits, size_t numHashFunctions)
+    : words_((numBits + 63) / 64, 0),
+      numHashFunctions_{static_cast<uint8_t>(numHashFunctions)} {
+  AD_CONTRACT_CHECK(numBits > 0);
+  AD_CONTRACT_CHECK(numHashFunctions > 0 && numHashFunctions <= 255);
+}
+
+// _____________________________________________________________________________
+std::optional<BloomFilter> BloomFilter::forNumKeys(
+    size_t numKeys, const BloomFilterBudget& budget) {
+  if (budget.bitsPerKey_ == 0 || numKeys == 0) {
+    return std::nullopt;
+  }
+  size_t maxNumBits =
+      std::max<size_t>(budget.maxSizePerFilter_.getBytes() * 8, 64);
+  size_t numBits = std::min(numKeys * budget.bitsPerKey_, maxNumBits);
+  // The optimal number of hash functions for the actual number of bits per key
+  // is `ln(2) * bitsPerKey`. More than 16 hash functions make the lookups
+  // expensive without a significant gain.
+  double bitsPerKey = static_cast<double>(numBits) / numKeys;
+  auto numHashFunctions = static_cast<size_t>(
+      std::clamp(std::round(bitsPerKey * std::log(2.0)), 1.0, 16.0));
+  return BloomFilter{numBits, numHashFunctions};
+}
+
+// _____________________________________________________________________________
+void BloomFilter::add(uint64_t key) {
+  AD_CONTRACT_CHECK(!words_.empty());
+  forEachBit(key, numHashFunctions_, numBits(), [this](size_t bit) {
+    words_[bit / 64] |= uint64_t{1} << (bit % 64);
+  });
+}
+
+// _____________________________________________________________________________
+bool BloomFilter::mayContain(uint64_t key) const {
+  // A filter without bits (see the default constructor) contains everything.
+  if (words_.empty()) {
+    return true;
+  }
+  bool result = true;
+  forEachBit(key, numHashFunctions_, numBits(), [this, &result](size_t bit) {
+    result &= (words_[bit / 64] >> (bit % 64)) & 1;
+  });
+  return result;
+}
+
+}  // namespace ad_utility
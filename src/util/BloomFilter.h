@@ -0,0 +1,67 @@
+//  Copyright 2025, University of Freiburg,
+//                  Chair of Algorithms and Data Structures.
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "util/MemorySize/MemorySize.h"
+#include "util/Serializer/SerializeVector.h"
+#include "util/Serializer/Serializer.h"
+
+namespace ad_utility {
+
+// The size budget for the `BloomFilter`s that are built for the blocks of the
+// permutations. `bitsPerKey_ == 0` means that no filters are built at all.
+struct BloomFilterBudget {
+  size_t bitsPerKey_ = 0;
+  // The filter of a block with many distinct keys is capped at this size (at
+  // the cost of a higher false positive rate).
+  MemorySize maxSizePerFilter_ = MemorySize::kilobytes(4);
+};
+
+// A simple Bloom filter for 64-bit keys (for example the bits of an `Id`). It
+// can answer the question "Was the key added to the filter?" with either
+// "definitely not" or "maybe" (with a false positive rate that depends on the
+// number of bits per key). Each key sets `numHashFunctions_` many bits, which
+// are computed from a single 64-bit hash via double hashing.
+class BloomFilter {
+ private:
+  std::vector<uint64_t> words_;
+  uint8_t numHashFunctions_ = 0;
+
+ public:
+  // The default constructed filter has no bits and can only be used as the
+  // target of deserialization.
+  BloomFilter() = default;
+
+  // Create an empty filter with `numBits` bits (rounded up to a multiple of 64)
+  // that sets `numHashFunctions` bits per key. Both must be positive.
+  BloomFilter(size_t numBits, size_t numHashFunctions);
+
+  // Create an empty filter for `numKeys` many distinct keys that respects the
+  // `budget`. Return `std::nullopt` if the `budget` disables the filters or if
+  // `numKeys` is zero.
+  static std::optional<BloomFilter> forNumKeys(size_t numKeys,
+                                               const BloomFilterBudget& budget);
+
+  // Add the `key` to the filter.
+  void add(uint64_t key);
+
+  // Return false if the `key` was definitely not added to this filter.
+  bool mayContain(uint64_t key) const;
+
+  size_t numBits() const { return words_.size() * 64; }
+  size_t numHashFunctions() const { return numHashFunctions_; }
+
+  bool operator==(const BloomFilter&) const = default;
+
+  AD_SERIALIZE_FRIEND_FUNCTION(BloomFilter) {
+    serializer | arg.words_;
+    serializer | arg.numHashFunctions_;
+  }
+};
+
+}  // namespace ad_utility
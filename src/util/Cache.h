@@ -6,10 +6,16 @@
 
 #pragma once
 
+#include <absl/strings/str_cat.h>
+
+#include <algorithm>
 #include <cassert>
 #include <concepts>
+#include <functional>
 #include <limits>
 #include <memory>
+#include <stdexcept>
+#include <string_view>
 #include <type_traits>
 #include <utility>
 
@@ -226,6 +232,13 @@ CPP_template(template <typename Sc, typename Val, typename Comp>
     return _maxSizeSingleEntry;
   }
 
+  // Set a function that is called with the key and the value of each entry
+  // that is evicted to make room for other entries. It is not called for
+  // entries that are removed via `erase` or one of the `clear` functions.
+  void setOnEviction(std::function<void(const Key&, ValuePtr)> onEviction) {
+    _onEviction = std::move(onEviction);
+  }
+
   //! Checks if there is an entry with the given key.
   bool contains(const Key& key) const {
     return containsPinned(key) || containsNonPinned(key);
@@ -384,6 +397,17 @@ CPP_template(template <typename Sc, typename Val, typename Comp>
   void removeOneEntry() {
     AD_CONTRACT_CHECK(!_entries.empty());
     auto handle = _entries.pop();
+    // Policies that depend on the evicted entries (e.g. GreedyDual, see
+    // `CostAwareCache` below) are informed about the eviction.
+    if constexpr (requires {
+                    _scoreCalculator.onEviction(handle.score(),
+                                                *handle.value().value());
+                  }) {
+      _scoreCalculator.onEviction(handle.score(), *handle.value().value());
+    }
+    if (_onEviction) {
+      _onEviction(handle.value().key(), handle.value().value());
+    }
     _totalSizeNonPinned =
         _totalSizeNonPinned - _valueSizeGetter(*handle.value().value());
     _accessMap.erase(handle.value().key());
@@ -401,6 +425,7 @@ CPP_template(template <typename Sc, typename Val, typename Comp>
   ValueSizeGetterT _valueSizeGetter;
   PinnedMap _pinnedMap;
   AccessMap _accessMap;
+  std::function<void(const Key&, ValuePtr)> _onEviction;
 };
 
 // Partial instantiation of FlexibleCache using the heap-based priority queue
@@ -478,6 +503,142 @@ CPP_template(typename Key, typename Value, typename ValueSizeGetterT)(
              detail::timeAsScore{}, ValueSizeGetterT{}) {}
 };
 
+// The strategies by which a `CostAwareCache` (see below) chooses the entries
+// that are evicted.
+enum class CacheEvictionPolicy {
+  // Evict the least recently used entry.
+  LRU,
+  // GreedyDual-Size-Frequency: Evict the entry with the lowest priority
+  // `clock + frequency * cost / size`, where `clock` is the priority of the
+  // last evicted entry. Entries that were expensive to compute, that are
+  // small, or that are accessed often are thus kept longer. As the `clock`
+  // only increases, entries that are no longer accessed eventually age out.
+  GDSF
+};
+
+// Convert between a `CacheEvictionPolicy` and the strings "lru" and "gdsf".
+inline std::string_view toString(CacheEvictionPolicy policy) {
+  return policy == CacheEvictionPolicy::LRU ? "lru" : "gdsf";
+}
+inline CacheEvictionPolicy cacheEvictionPolicyFromString(
+    std::string_view policy) {
+  if (policy == "lru") {
+    return CacheEvictionPolicy::LRU;
+  } else if (policy == "gdsf") {
+    return CacheEvictionPolicy::GDSF;
+  }
+  throw std::runtime_error{absl::StrCat(
+      "Unknown cache eviction policy \"", policy,
+      "\", the supported policies are \"lru\" and \"gdsf\"")};
+}
+
+namespace detail {
+// The score of an entry in a `CostAwareCache`. Entries with a lower
+// `priority_` are evicted first.
+struct CostAwareScore {
+  double priority_ = 0;
+  // The number of times the entry was inserted or accessed.
+  size_t frequency_ = 1;
+
+  bool operator<(const CostAwareScore& other) const {
+    return priority_ < other.priority_;
+  }
+};
+
+// The state of a `CostAwarePolicy` that is shared between all its copies.
+struct CostAwarePolicyState {
+  CacheEvictionPolicy policy_ = CacheEvictionPolicy::LRU;
+  // For `LRU`, a counter that is incremented on each access. For `GDSF`, the
+  // highest priority of an evicted entry.
+  double clock_ = 0;
+  size_t numEvictions_ = 0;
+  // The sum of the costs of all evicted entries.
+  double evictedCost_ = 0;
+};
+
+// The `ScoreCalculator` and the `AccessUpdater` of the `CostAwareCache`. The
+// `CostGetterT` returns the cost of computing a value (e.g. in milliseconds).
+template <typename Value, typename ValueSizeGetterT, typename CostGetterT>
+struct CostAwarePolicy {
+  std::shared_ptr<CostAwarePolicyState> state_ =
+      std::make_shared<CostAwarePolicyState>();
+
+  CostAwareScore computeScore(size_t frequency, const Value& value) const {
+    auto& state = *state_;
+    if (state.policy_ == CacheEvictionPolicy::LRU) {
+      return {++state.clock_, frequency};
+    }
+    // Values that were computed in (almost) no time are treated as if their
+    // cost was 1, s.t. their size and frequency still matter.
+    double cost = std::max(CostGetterT{}(value), 1.0);
+    auto size = static_cast<double>(
+        std::max(ValueSizeGetterT{}(value).getBytes(), size_t{1}));
+    return {state.clock_ + static_cast<double>(frequency) * cost / size,
+            frequency};
+  }
+
+  // Score of a newly inserted `value`.
+  CostAwareScore operator()(const Value& value) const {
+    return computeScore(1, value);
+  }
+
+  // Score of an `entry` (of the `FlexibleCache`) that is accessed.
+  template <typename Entry>
+  CostAwareScore operator()(const CostAwareScore& score,
+                            const Entry& entry) const {
+    return computeScore(score.frequency_ + 1, *entry.value());
+  }
+
+  // Called by the `FlexibleCache` when the entry with the `score` and the
+  // `value` is evicted.
+  void onEviction(const CostAwareScore& score, const Value& value) const {
+    auto& state = *state_;
+    ++state.numEvictions_;
+    state.evictedCost_ += CostGetterT{}(value);
+    if (state.policy_ == CacheEvictionPolicy::GDSF) {
+      state.clock_ = std::max(state.clock_, score.priority_);
+    }
+  }
+};
+}  // namespace detail
+
+// A cache whose eviction policy can be changed at runtime, see
+// `CacheEvictionPolicy` above. When the policy is changed, the entries keep
+// their scores from the previous policy until they are accessed again. The
+// `CostGetterT` returns the cost of computing a value (as a `double`).
+CPP_template(typename Key, typename Value, typename ValueSizeGetterT,
+             typename CostGetterT)(
+    requires ValueSizeGetter<ValueSizeGetterT, Value>) class CostAwareCache
+    : public HeapBasedCache<
+          Key, Value, detail::CostAwareScore, std::less<>,
+          detail::CostAwarePolicy<Value, ValueSizeGetterT, CostGetterT>,
+          detail::CostAwarePolicy<Value, ValueSizeGetterT, CostGetterT>,
+          ValueSizeGetterT> {
+  using Policy = detail::CostAwarePolicy<Value, ValueSizeGetterT, CostGetterT>;
+  using Base = HeapBasedCache<Key, Value, detail::CostAwareScore, std::less<>,
+                              Policy, Policy, ValueSizeGetterT>;
+  std::shared_ptr<detail::CostAwarePolicyState> state_;
+
+ public:
+  explicit CostAwareCache(size_t capacityNumEls = size_t_max,
+                          MemorySize capacitySize = MemorySize::max(),
+                          MemorySize maxSizeSingleEl = MemorySize::max(),
+                          Policy policy = Policy{})
+      : Base(capacityNumEls, capacitySize, maxSizeSingleEl, std::less<>(),
+             policy, policy, ValueSizeGetterT{}),
+        state_{policy.state_} {}
+
+  void setEvictionPolicy(CacheEvictionPolicy policy) {
+    state_->policy_ = policy;
+  }
+  CacheEvictionPolicy getEvictionPolicy() const { return state_->policy_; }
+
+  // The number of entries that were evicted to make room for other entries
+  // and the sum of their costs.
+  size_t numEvictions() const { return state_->numEvictions_; }
+  double evictedCost() const { return state_->evictedCost_; }
+};
+
 /// typedef for the simple name LRUCache that is fixed to one of the possible
 /// implementations at compile time
 #ifdef _QLEVER_USE_TREE_BASED_CACHE
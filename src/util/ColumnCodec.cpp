@@ -0,0 +1,298 @@
+//  Copyright 2025, University of Freiburg,
+//                  Chair of Algorithms and Data Structures.
+
+#include "util/ColumnCodec.h"
+
+#include <absl/strings/str_cat.h>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstring>
+#include <utility>
+
+#include "util/CompressionUsingZstd/ZstdWrapper.h"
+#include "util/Exception.h"
+
+namespace ad_utility {
+
+namespace {
+// The values of a `FrameOfReference` encoding are bit-packed in groups of this
+// many values. The packed bits of a group with bit width `w` occupy exactly `w`
+// 64-bit words, so each group can be decoded independently.
+constexpr size_t GROUP_SIZE = 64;
+
+// Append the binary representation of `value` to the `target`.
+void append(std::vector<char>& target, uint64_t value) {
+  auto offset = target.size();
+  target.resize(offset + sizeof(value));
+  std::memcpy(target.data() + offset, &value, sizeof(value));
+}
+
+// Read a `uint64_t` from the beginning of `source` and advance `source`.
+uint64_t readValue(std::span<const char>& source) {
+  AD_CORRECTNESS_CHECK(source.size() >= sizeof(uint64_t),
+                       "Encoded column is truncated");
+  uint64_t value;
+  std::memcpy(&value, source.data(), sizeof(value));
+  source = source.subspan(sizeof(value));
+  return value;
+}
+
+// Throw if the number of encoded values does not match the size of the target.
+void checkNumValues(uint64_t numValues, std::span<uint64_t> target) {
+  AD_CORRECTNESS_CHECK(numValues == target.size(), [&]() {
+    return absl::StrCat("Encoded column has ", numValues,
+                        " values, but the target has room for ", target.size(),
+                        " values");
+  });
+}
+
+// Bit-pack the `GROUP_SIZE` many `values` with the given `width` into the
+// `width` many words at `packed` (which must be zero-initialized).
+void packGroup(const uint64_t* values, size_t width, uint64_t* packed) {
+  if (width == 0) {
+    return;
+  }
+  for (size_t i = 0; i < GROUP_SIZE; ++i) {
+    size_t bit = i * width;
+    size_t word = bit / 64;
+    size_t shift = bit % 64;
+    packed[word] |= values[i] << shift;
+    if (shift + width > 64) {
+      packed[word + 1] |= values[i] >> (64 - shift);
+    }
+  }
+}
+
+// The inverse of `packGroup`, additionally adds the `base` to all the values.
+// The width is a template parameter, so that the compiler can fully unroll the
+// loop and vectorize it.
+template <size_t Width>
+void unpackGroup(const uint64_t* packed, uint64_t base, uint64_t* out) {
+  if constexpr (Width == 0) {
+    std::fill_n(out, GROUP_SIZE, base);
+  } else {
+    constexpr uint64_t mask =
+        Width == 64 ? ~uint64_t{0} : (uint64_t{1} << Width) - 1;
+    for (size_t i = 0; i < GROUP_SIZE; ++i) {
+      size_t bit = i * Width;
+      size_t word = bit / 64;
+      size_t shift = bit % 64;
+      uint64_t value = packed[word] >> shift;
+      if (shift + Width > 64) {
+        value |= packed[word + 1] << (64 - shift);
+      }
+      out[i] = base + (value & mask);
+    }
+  }
+}
+
+// The `unpackGroup` function for each of the possible widths `0, ..., 64`.
+using UnpackFunction = void (*)(const uint64_t*, uint64_t, uint64_t*);
+constexpr auto unpackFunctions =
+    []<size_t... Widths>(std::index_sequence<Widths...>) {
+      return std::array<UnpackFunction, sizeof...(Widths)>{
+          &unpackGroup<Widths>...};
+    }(std::make_index_sequence<65>{});
+
+// Append the `FrameOfReference` encoding of the `values` to the `target`. The
+// format is: number of values, base, width, followed by the packed groups.
+void appendFrameOfReference(std::span<const uint64_t> values,
+                            std::vector<char>& target) {
+  uint64_t base = 0;
+  size_t width = 0;
+  if (!values.empty()) {
+    auto [min, max] = std::ranges::minmax(values);
+    base = min;
+    width = std::bit_width(max - min);
+  }
+  append(target, values.size());
+  append(target, base);
+  append(target, width);
+  std::array<uint64_t, GROUP_SIZE> group;
+  std::array<uint64_t, GROUP_SIZE> packed;
+  for (size_t begin = 0; begin < values.size(); begin += GROUP_SIZE) {
+    auto numValues = std::min(GROUP_SIZE, values.size() - begin);
+    group.fill(0);
+    std::ranges::transform(values.subspan(begin, numValues), group.begin(),
+                           [base](uint64_t value) { return value - base; });
+    packed.fill(0);
+    packGroup(group.data(), width, packed.data());
+    auto offset = target.size();
+    target.resize(offset + width * sizeof(uint64_t));
+    std::memcpy(target.data() + offset, packed.data(),
+                width * sizeof(uint64_t));
+  }
+}
+
+// Decode a column that was encoded via `appendFrameOfReference`.
+void decodeFrameOfReference(std::span<const char> encoded,
+                            std::span<uint64_t> target) {
+  checkNumValues(readValue(encoded), target);
+  uint64_t base = readValue(encoded);
+  uint64_t width = readValue(encoded);
+  AD_CORRECTNESS_CHECK(width <= 64);
+  size_t numGroups = (target.size() + GROUP_SIZE - 1) / GROUP_SIZE;
+  AD_CORRECTNESS_CHECK(encoded.size() == numGroups * width * sizeof(uint64_t));
+  auto unpack = unpackFunctions[width];
+  std::array<uint64_t, GROUP_SIZE> packed;
+  std::array<uint64_t, GROUP_SIZE> lastGroup;
+  for (size_t begin = 0; begin < target.size(); begin += GROUP_SIZE) {
+    // Copy the packed words to make sure that they are properly aligned.
+    std::memcpy(packed.data(), encoded.data(), width * sizeof(uint64_t));
+    encoded = encoded.subspan(width * sizeof(uint64_t));
+    auto numValues = std::min(GROUP_SIZE, target.size() - begin);
+    if (numValues == GROUP_SIZE) {
+      unpack(packed.data(), base, target.data() + begin);
+    } else {
+      unpack(packed.data(), base, lastGroup.data());
+      std::copy_n(lastGroup.begin(), numValues, target.begin() + begin);
+    }
+  }
+}
+
+// _____________________________________________________________________________
+std::vector<char> encodeRunLength(std::span<const uint64_t> column) {
+  std::vector<char> result;
+  append(result, column.size());
+  for (size_t i = 0; i < column.size();) {
+    size_t runEnd = i + 1;
+    while (runEnd < column.size() && column[runEnd] == column[i]) {
+      ++runEnd;
+    }
+    append(result, column[i]);
+    append(result, runEnd - i);
+    i = runEnd;
+  }
+  return result;
+}
+
+// _____________________________________________________________________________
+void decodeRunLength(std::span<const char> encoded,
+                     std::span<uint64_t> target) {
+  checkNumValues(readValue(encoded), target);
+  auto it = target.begin();
+  while (!encoded.empty()) {
+    uint64_t value = readValue(encoded);
+    uint64_t runLength = readValue(encoded);
+    AD_CORRECTNESS_CHECK(runLength <= static_cast<size_t>(target.end() - it));
+    it = std::fill_n(it, runLength, value);
+  }
+  AD_CORRECTNESS_CHECK(it == target.end());
+}
+
+// The `DeltaFrameOfReference` encoding: The first value, followed by the
+// `FrameOfReference` encoding of the differences between consecutive values.
+// The difference at position 0 is a placeholder that is ignored when decoding.
+std::vector<char> encodeDeltaFrameOfReference(
+    std::span<const uint64_t> column) {
+  std::vector<uint64_t> deltas(column.size());
+  for (size_t i = 1; i < column.size(); ++i) {
+    deltas[i] = column[i] - column[i - 1];
+  }
+  // Use an arbitrary actual difference for the placeholder, s.t. it doesn't
+  // increase the width of the `FrameOfReference` encoding.
+  if (column.size() > 1) {
+    deltas[0] = deltas[1];
+  }
+  std::vector<char> result;
+  append(result, column.empty() ? 0 : column[0]);
+  appendFrameOfReference(deltas, result);
+  return result;
+}
+
+// _____________________________________________________________________________
+void decodeDeltaFrameOfReference(std::span<const char> encoded,
+                                 std::span<uint64_t> target) {
+  uint64_t first = readValue(encoded);
+  decodeFrameOfReference(encoded, target);
+  if (target.empty()) {
+    return;
+  }
+  target[0] = first;
+  for (size_t i = 1; i < target.size(); ++i) {
+    target[i] += target[i - 1];
+  }
+}
+}  // namespace
+
+// _____________________________________________________________________________
+std::string_view toString(ColumnCodec codec) {
+  using enum ColumnCodec;
+  switch (codec) {
+    case Zstd:
+      return "zstd";
+    case RunLength:
+      return "run-length";
+    case FrameOfReference:
+      return "frame-of-reference";
+    case DeltaFrameOfReference:
+      return "delta-frame-of-reference";
+  }
+  AD_FAIL();
+}
+
+// _____________________________________________________________________________
+std::vector<char> encodeColumn(std::span<const uint64_t> column,
+                               ColumnCodec codec) {
+  using enum ColumnCodec;
+  switch (codec) {
+    case Zstd:
+      return ZstdWrapper::compress(column.data(),
+                                   column.size() * sizeof(uint64_t));
+    case RunLength:
+      return encodeRunLength(column);
+    case FrameOfReference: {
+      std::vector<char> result;
+      appendFrameOfReference(column, result);
+      return result;
+    }
+    case DeltaFrameOfReference:
+      return encodeDeltaFrameOfReference(column);
+  }
+  AD_FAIL();
+}
+
+// _____________________________________________________________________________
+EncodedColumn encodeColumn(std::span<const uint64_t> column) {
+  using enum ColumnCodec;
+  EncodedColumn best{RunLength, encodeColumn(column, RunLength)};
+  for (auto codec : {FrameOfReference, DeltaFrameOfReference}) {
+    auto encoded = encodeColumn(column, codec);
+    if (encoded.size() < best.bytes_.size()) {
+      best = {codec, std::move(encoded)};
+    }
+  }
+  // Only use zstd if it needs less than half of the space, otherwise the much
+  // faster decoding of the lightweight encodings is preferable.
+  auto zstd = encodeColumn(column, Zstd);
+  if (2 * zstd.size() < best.bytes_.size()) {
+    best = {Zstd, std::move(zstd)};
+  }
+  return best;
+}
+
+// _____________________________________________________________________________
+void decodeColumn(ColumnCodec codec, std::span<const char> encoded,
+                  std::span<uint64_t> target) {
+  using enum ColumnCodec;
+  switch (codec) {
+    case Zstd: {
+      auto numBytes = ZstdWrapper::decompressToBuffer(
+          encoded.data(), encoded.size(), target.data(),
+          target.size() * sizeof(uint64_t));
+      AD_CORRECTNESS_CHECK(numBytes == target.size() * sizeof(uint64_t));
+      return;
+    }
+    case RunLength:
+      return decodeRunLength(encoded, target);
+    case FrameOfReference:
+      return decodeFrameOfReference(encoded, target);
+    case DeltaFrameOfReference:
+      return decodeDeltaFrameOfReference(encoded, target);
+  }
+  AD_FAIL();
+}
+
+}  // namespace ad_utility
@@ -0,0 +1,66 @@
+//  Copyright 2025, University of Freiburg,
+//                  Chair of Algorithms and Data Structures.
+
+#pragma once
+
+#include <concepts>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace ad_utility {
+
+// The encodings of a column of 64-bit integers (for example, a column of `Id`s
+// of a block of a permutation). Apart from `Zstd`, these are lightweight
+// encodings that exploit the typical structure of the columns and are much
+// faster to decode than generic compression:
+//
+// `Zstd`: The raw bytes of the column, compressed with zstd.
+// `RunLength`: Pairs of (value, length of the run). Good for columns with few
+//   distinct consecutive values, for example the first column of a
+//   permutation.
+// `FrameOfReference`: The minimum of the column, followed by the differences
+//   of all values to this minimum, bit-packed with the smallest possible
+//   width. Good for columns whose values lie in a small range.
+// `DeltaFrameOfReference`: The first value, followed by the differences of
+//   consecutive values, encoded via `FrameOfReference`. Good for sorted
+//   columns, for example the second column of a permutation.
+//
+// NOTE: The numeric values are stored on disk as part of the block metadata
+// of the permutations, so they must not be changed.
+enum class ColumnCodec : uint8_t {
+  Zstd = 0,
+  RunLength = 1,
+  FrameOfReference = 2,
+  DeltaFrameOfReference = 3,
+};
+
+// The codec can be serialized via its binary representation.
+[[maybe_unused]] void allowTrivialSerialization(std::same_as<ColumnCodec> auto,
+                                                auto);
+
+// Return a human-readable name of the `codec`.
+std::string_view toString(ColumnCodec codec);
+
+// A column that was encoded via `encodeColumn`.
+struct EncodedColumn {
+  ColumnCodec codec_;
+  std::vector<char> bytes_;
+};
+
+// Encode the `column` with the given `codec`.
+std::vector<char> encodeColumn(std::span<const uint64_t> column,
+                               ColumnCodec codec);
+
+// Encode the `column` with the codec that is best suited for it: The smallest
+// of the lightweight encodings is chosen unless zstd needs less than half of
+// its space, because the lightweight encodings are much faster to decode.
+EncodedColumn encodeColumn(std::span<const uint64_t> column);
+
+// Decode the `encoded` column (which was encoded with the `codec`) into the
+// `target`. Throw if the number of encoded values is not `target.size()`.
+void decodeColumn(ColumnCodec codec, std::span<const char> encoded,
+                  std::span<uint64_t> target);
+
+}  // namespace ad_utility
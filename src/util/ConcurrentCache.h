@@ -10,6 +10,7 @@
 #include <mutex>
 #include <utility>
 
+#include "util/Cache.h"
 #include "util/Forward.h"
 #include "util/HashMap.h"
 #include "util/Log.h"
@@ -32,11 +33,13 @@ class WaitedForResultWhichThenFailedException : public std::exception {
 
 // A strongly typed enum to differentiate the following cases:
 // a result was stored in the cache, but not cachedPinned. A result was stored
-// in the cache and cachedPinned, a result was not in the cache and therefore
-// had to be computed.
+// in the cache and cachedPinned, a result was not in the cache, but was loaded
+// from the second level of the cache (see `SecondLevelCache` below), a result
+// was not in the cache and therefore had to be computed.
 enum struct CacheStatus {
   cachedNotPinned,
   cachedPinned,
+  cachedInSecondLevel,
   // TODO<RobinTF> Rename to notCached, the name is just confusing. Can
   // potentially be merged with notInCacheAndNotComputed.
   computed,
@@ -51,6 +54,8 @@ constexpr std::string_view toString(CacheStatus status) {
       return "cached_not_pinned";
     case CacheStatus::cachedPinned:
       return "cached_pinned";
+    case CacheStatus::cachedInSecondLevel:
+      return "cached_in_second_level";
     case CacheStatus::computed:
       return "computed";
     case CacheStatus::notInCacheAndNotComputed:
@@ -73,6 +78,24 @@ CacheStatus getCacheStatus(const auto& cache, const auto& key) {
   }
 }
 
+// An optional second level of a `ConcurrentCache` (for example on disk), which
+// is slower, but typically much larger than the cache itself. Values that are
+// evicted from the cache or pinned in the cache are passed to `store`. When a
+// value is not contained in the cache, `load` is tried before the value is
+// computed.
+template <typename Key, typename Value>
+class SecondLevelCache {
+ public:
+  virtual ~SecondLevelCache() = default;
+
+  // Note: This function is called while the `ConcurrentCache` is locked, so it
+  // must return quickly (e.g. by only scheduling the actual work).
+  virtual void store(const Key& key, std::shared_ptr<const Value> value) = 0;
+
+  // Return the value for the `key` or `nullptr` if it is not contained.
+  virtual std::shared_ptr<Value> load(const Key& key) = 0;
+};
+
 // Implementation details, do not call them from outside this module.
 namespace ConcurrentCacheDetail {
 
@@ -218,10 +241,13 @@ class ConcurrentCache {
       [[maybe_unused]] const InvocableWithConvertibleReturnType<
           bool, const Value&> auto& suitedForCache) {
     {
-      auto resultPtr = _cacheAndInProgressMap.wlock()->_cache[key];
+      auto lockPtr = _cacheAndInProgressMap.wlock();
+      auto resultPtr = lockPtr->_cache[key];
       if (resultPtr != nullptr) {
+        ++lockPtr->_numHits;
         return {std::move(resultPtr), CacheStatus::cachedNotPinned};
       }
+      ++lockPtr->_numMisses;
     }
     if (onlyReadFromCache) {
       return {nullptr, CacheStatus::notInCacheAndNotComputed};
@@ -283,6 +309,29 @@ class ConcurrentCache {
     return _cacheAndInProgressMap.wlock()->_cache.pinnedSize();
   }
 
+  // The number of lookups (via `computeOnce`, `computeOncePinned`, or
+  // `computeButDontStore`) for which the key was contained in the cache
+  // (hits) or not (misses).
+  size_t numHits() const { return _cacheAndInProgressMap.wlock()->_numHits; }
+  size_t numMisses() const {
+    return _cacheAndInProgressMap.wlock()->_numMisses;
+  }
+
+  // The following functions are only available if the underlying cache is a
+  // `CostAwareCache`, see `Cache.h`.
+  size_t numEvictions() const {
+    return _cacheAndInProgressMap.wlock()->_cache.numEvictions();
+  }
+  double evictedCost() const {
+    return _cacheAndInProgressMap.wlock()->_cache.evictedCost();
+  }
+  void setEvictionPolicy(CacheEvictionPolicy policy) {
+    _cacheAndInProgressMap.wlock()->_cache.setEvictionPolicy(policy);
+  }
+  CacheEvictionPolicy getEvictionPolicy() const {
+    return _cacheAndInProgressMap.wlock()->_cache.getEvictionPolicy();
+  }
+
   /// only for testing: get access to the implementation
   auto& getStorage() { return _cacheAndInProgressMap; }
 
@@ -320,6 +369,22 @@ class ConcurrentCache {
     return _cacheAndInProgressMap.wlock()->_cache.getMaxSizeSingleEntry();
   }
 
+  // Set the second level of this cache, see `SecondLevelCache` above.
+  void setSecondLevelCache(
+      std::shared_ptr<SecondLevelCache<Key, Value>> secondLevelCache) {
+    auto lockPtr = _cacheAndInProgressMap.wlock();
+    if (secondLevelCache) {
+      lockPtr->_cache.setOnEviction(
+          [secondLevel = secondLevelCache.get()](
+              const Key& key, std::shared_ptr<const Value> value) {
+            secondLevel->store(key, std::move(value));
+          });
+    } else {
+      lockPtr->_cache.setOnEviction({});
+    }
+    lockPtr->_secondLevelCache = std::move(secondLevelCache);
+  }
+
  private:
   using ResultInProgress = ConcurrentCacheDetail::ResultInProgress<Value>;
 
@@ -331,6 +396,10 @@ class ConcurrentCache {
     // Values that are currently being computed. The bool tells us whether this
     // result will be pinned in the cache.
     HashMap<Key, std::pair<bool, shared_ptr<ResultInProgress>>> _inProgress;
+    // Statistics about the lookups, see `numHits()` and `numMisses()`.
+    size_t _numHits = 0;
+    size_t _numMisses = 0;
+    std::shared_ptr<SecondLevelCache<Key, Value>> _secondLevelCache;
 
     CacheAndInProgressMap() = default;
     template <typename Arg, typename... Args>
@@ -351,6 +420,9 @@ class ConcurrentCache {
     AD_CONTRACT_CHECK(lockPtr->_inProgress.contains(key));
     bool pinned = lockPtr->_inProgress[key].first;
     if (pinned) {
+      if (lockPtr->_secondLevelCache) {
+        lockPtr->_secondLevelCache->store(key, computationResult);
+      }
       lockPtr->_cache.insertPinned(std::move(key),
                                    std::move(computationResult));
     } else {
@@ -370,6 +442,7 @@ class ConcurrentCache {
     using std::make_shared;
     bool mustCompute;
     shared_ptr<ResultInProgress> resultInProgress;
+    std::shared_ptr<SecondLevelCache<Key, Value>> secondLevelCache;
     // first determine whether we have to compute the result,
     // this is done atomically by locking the storage for the whole time
     {
@@ -382,8 +455,11 @@ class ConcurrentCache {
       bool contained = cacheStatus != CacheStatus::computed;
       if (contained) {
         // the result is in the cache, simply return it.
+        ++lockPtr->_numHits;
         return {cache[key], cacheStatus};
-      } else if (onlyReadFromCache) {
+      }
+      ++lockPtr->_numMisses;
+      if (onlyReadFromCache) {
         return {nullptr, CacheStatus::notInCacheAndNotComputed};
       } else if (lockPtr->_inProgress.contains(key)) {
         // the result is not cached, but someone else is computing it.
@@ -402,13 +478,22 @@ class ConcurrentCache {
         mustCompute = true;
         resultInProgress = make_shared<ResultInProgress>();
         lockPtr->_inProgress[key] = std::pair(pinned, resultInProgress);
+        secondLevelCache = lockPtr->_secondLevelCache;
       }
     }  // release the lock, it is not required while we are computing
     if (mustCompute) {
       LOG(TRACE) << "Not in the cache, need to compute result" << std::endl;
       try {
-        // The actual computation
-        shared_ptr<Value> result = make_shared<Value>(computeFunction());
+        // Try the second level of the cache, and only if the result is not
+        // contained there, perform the actual computation.
+        auto cacheStatus = CacheStatus::computed;
+        shared_ptr<Value> result =
+            secondLevelCache ? secondLevelCache->load(key) : nullptr;
+        if (result) {
+          cacheStatus = CacheStatus::cachedInSecondLevel;
+        } else {
+          result = make_shared<Value>(computeFunction());
+        }
         if (suitableForCache(*result)) {
           moveFromInProgressToCache(key, result);
           // Signal other threads who are waiting for the results.
@@ -419,7 +504,7 @@ class ConcurrentCache {
           resultInProgress->finish(nullptr);
         }
         // result was not cached
-        return {std::move(result), CacheStatus::computed};
+        return {std::move(result), cacheStatus};
       } catch (...) {
         // Other threads may try this computation again in the future
         _cacheAndInProgressMap.wlock()->_inProgress.erase(key);
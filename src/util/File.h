@@ -93,6 +93,13 @@ class File {
   //! checks if the file is open.
   [[nodiscard]] bool isOpen() const { return (file_ != NULL); }
 
+  // The name of the file and the underlying file descriptor.
+  const string& name() const { return name_; }
+  int fileDescriptor() const {
+    assert(file_);
+    return fileno(file_);
+  }
+
   //! Close file.
   bool close() {
     if (not isOpen()) {
@@ -125,6 +132,18 @@ class File {
 
   void flush() { fflush(file_); }
 
+  // Flush the stream and write all its data to the storage device (via
+  // `fsync`), so that it survives a crash of the operating system or a power
+  // failure. Throw if this fails.
+  void sync() {
+    assert(file_);
+    if (fflush(file_) != 0 || fsync(fileno(file_)) != 0) {
+      throw std::runtime_error{absl::StrCat("Could not sync the file \"",
+                                            name_, "\" to disk (",
+                                            strerror(errno), ")")};
+    }
+  }
+
   //! Seeks a position in the file.
   //! Sets the file position indicator for the stream.
   //! The new position is obtained by adding seekOffset
@@ -0,0 +1,66 @@
+//  Copyright 2025, University of Freiburg,
+//                  Chair of Algorithms and Data Structures.
+
+#include "util/HyperLogLog.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+#include "util/BitUtils.h"
+#include "util/Exception.h"
+
+namespace ad_utility {
+
+// _____________________________________________________________________________
+HyperLogLog::HyperLogLog(size_t precision)
+    : precision_{static_cast<uint8_t>(precision)} {
+  AD_CONTRACT_CHECK(precision >= 4 && precision <= 16);
+  registers_.assign(size_t{1} << precision, 0);
+}
+
+// _____________________________________________________________________________
+void HyperLogLog::add(uint64_t key) {
+  uint64_t hash = mixBits(key);
+  // The highest `precision_` bits select the register, which stores the
+  // maximal position of the first set bit in the remaining bits.
+  size_t index = hash >> (64 - precision_);
+  uint64_t remainingBits = hash << precision_;
+  auto rank = static_cast<uint8_t>(
+      remainingBits == 0 ? 64 - precision_ + 1
+                         : std::countl_zero(remainingBits) + 1);
+  registers_[index] = std::max(registers_[index], rank);
+}
+
+// _____________________________________________________________________________
+void HyperLogLog::merge(const HyperLogLog& other) {
+  AD_CONTRACT_CHECK(precision_ == other.precision_);
+  for (size_t i = 0; i < registers_.size(); ++i) {
+    registers_[i] = std::max(registers_[i], other.registers_[i]);
+  }
+}
+
+// _____________________________________________________________________________
+uint64_t HyperLogLog::estimate() const {
+  const auto m = static_cast<double>(registers_.size());
+  double sum = 0;
+  size_t numZeroRegisters = 0;
+  for (uint8_t value : registers_) {
+    sum += std::ldexp(1.0, -static_cast<int>(value));
+    numZeroRegisters += value == 0;
+  }
+  // The bias correction from the original paper by Flajolet et al.
+  double alpha = m >= 128 ? 0.7213 / (1 + 1.079 / m)
+                 : m >= 64 ? 0.709
+                 : m >= 32 ? 0.697
+                           : 0.673;
+  double result = alpha * m * m / sum;
+  // For small cardinalities, linear counting on the empty registers is more
+  // accurate. Large cardinalities need no correction for a 64-bit hash.
+  if (result <= 2.5 * m && numZeroRegisters > 0) {
+    result = m * std::log(m / static_cast<double>(numZeroRegisters));
+  }
+  return static_cast<uint64_t>(std::round(result));
+}
+
+}  // namespace ad_utility
@@ -0,0 +1,50 @@
+//  Copyright 2025, University of Freiburg,
+//                  Chair of Algorithms and Data Structures.
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "util/Serializer/SerializeVector.h"
+#include "util/Serializer/Serializer.h"
+
+namespace ad_utility {
+
+// A HyperLogLog sketch, which estimates the number of distinct 64-bit keys
+// (for example the bits of an `Id`) that were added to it, using only
+// `2^precision` bytes of memory. The relative standard error of the estimate
+// is about `1.04 / sqrt(2^precision)`, e.g. 1.6% for the default precision.
+class HyperLogLog {
+ private:
+  std::vector<uint8_t> registers_;
+  uint8_t precision_ = 0;
+
+ public:
+  static constexpr size_t DEFAULT_PRECISION = 12;
+
+  // The `precision` must be in `[4, 16]`.
+  explicit HyperLogLog(size_t precision = DEFAULT_PRECISION);
+
+  // Add the `key` to the sketch.
+  void add(uint64_t key);
+
+  // After this call, the sketch estimates the number of distinct keys that
+  // were added to this sketch or to the `other` sketch. Both sketches must
+  // have the same precision.
+  void merge(const HyperLogLog& other);
+
+  // The estimated number of distinct keys.
+  uint64_t estimate() const;
+
+  size_t precision() const { return precision_; }
+
+  bool operator==(const HyperLogLog&) const = default;
+
+  AD_SERIALIZE_FRIEND_FUNCTION(HyperLogLog) {
+    serializer | arg.registers_;
+    serializer | arg.precision_;
+  }
+};
+
+}  // namespace ad_utility
@@ -0,0 +1,46 @@
+//  Copyright 2025, University of Freiburg,
+//                  Chair of Algorithms and Data Structures.
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <future>
+#include <thread>
+#include <vector>
+
+namespace ad_utility {
+
+// Call `function(i)` for all `i` in `[0, numTasks)` using (at most)
+// `numThreads` threads. Exceptions are propagated to the caller.
+inline void runTasksInParallel(size_t numTasks, size_t numThreads,
+                               const std::function<void(size_t)>& function) {
+  if (numThreads <= 1 || numTasks <= 1) {
+    for (size_t i = 0; i < numTasks; ++i) {
+      function(i);
+    }
+    return;
+  }
+  std::atomic<size_t> nextTask = 0;
+  std::vector<std::future<void>> futures;
+  for (size_t i = 0; i < std::min(numThreads, numTasks); ++i) {
+    futures.push_back(std::async(std::launch::async, [&]() {
+      for (size_t task = nextTask++; task < numTasks; task = nextTask++) {
+        function(task);
+      }
+    }));
+  }
+  for (auto& future : futures) {
+    future.get();
+  }
+}
+
+// The number of threads that should be used for `numTasks` many independent
+// tasks: at most one per task and at most one per hardware thread.
+inline size_t getNumThreadsForTasks(size_t numTasks) {
+  return std::min(numTasks,
+                  size_t{std::max(1u, std::thread::hardware_concurrency())});
+}
+
+}  // namespace ad_utility
@@ -0,0 +1,144 @@
+//  Copyright 2025, University of Freiburg,
+//                  Chair of Algorithms and Data Structures.
+
+#include "util/SharedWorkerPool.h"
+
+#include <algorithm>
+
+#include "util/Timer.h"
+
+namespace ad_utility {
+
+// _____________________________________________________________________________
+SharedWorkerPool::JobBase::JobBase(SharedWorkerPool& pool,
+                                   size_t maxNumRunningTasks,
+                                   size_t maxNumValuesInFlight)
+    : pool_{pool},
+      maxNumRunningTasks_{maxNumRunningTasks},
+      maxNumValuesInFlight_{maxNumValuesInFlight} {}
+
+// _____________________________________________________________________________
+bool SharedWorkerPool::JobBase::tryStartTask() {
+  std::lock_guard lock{mutex_};
+  if (isExhausted_ || isCancelled_ ||
+      numRunningTasks_ >= maxNumRunningTasks_ ||
+      numValuesInFlight_ >= maxNumValuesInFlight_) {
+    return false;
+  }
+  ++numRunningTasks_;
+  ++numValuesInFlight_;
+  return true;
+}
+
+// _____________________________________________________________________________
+void SharedWorkerPool::JobBase::runTask() {
+  bool hasProducedValue = false;
+  std::exception_ptr exception;
+  try {
+    hasProducedValue = runProducer();
+  } catch (...) {
+    exception = std::current_exception();
+  }
+  std::unique_lock lock{mutex_};
+  --numRunningTasks_;
+  if (!hasProducedValue) {
+    --numValuesInFlight_;
+    isExhausted_ = true;
+    if (exception && !exception_) {
+      exception_ = std::move(exception);
+    }
+  }
+  lock.unlock();
+  stateChanged_.notify_all();
+}
+
+// _____________________________________________________________________________
+void SharedWorkerPool::JobBase::cancelAndWait() {
+  std::unique_lock lock{mutex_};
+  isCancelled_ = true;
+  stateChanged_.wait(lock, [this]() { return numRunningTasks_ == 0; });
+}
+
+// _____________________________________________________________________________
+SharedWorkerPool::SharedWorkerPool(size_t numThreads) {
+  numThreads = std::max(numThreads, size_t{1});
+  threads_.reserve(numThreads);
+  for (size_t i = 0; i < numThreads; ++i) {
+    threads_.emplace_back(&SharedWorkerPool::runWorker, this);
+  }
+}
+
+// _____________________________________________________________________________
+SharedWorkerPool::~SharedWorkerPool() {
+  std::unique_lock lock{mutex_};
+  shutdown_ = true;
+  lock.unlock();
+  workAvailable_.notify_all();
+  // The `JThread`s are joined by their destructors.
+}
+
+// _____________________________________________________________________________
+void SharedWorkerPool::notifyWorkers() {
+  // Acquiring the lock makes sure that no worker misses the notification
+  // between checking for runnable jobs and starting to wait.
+  std::lock_guard lock{mutex_};
+  workAvailable_.notify_all();
+}
+
+// _____________________________________________________________________________
+void SharedWorkerPool::addJob(std::shared_ptr<JobBase> job) {
+  std::unique_lock lock{mutex_};
+  jobs_.push_back(std::move(job));
+  lock.unlock();
+  workAvailable_.notify_all();
+}
+
+// _____________________________________________________________________________
+void SharedWorkerPool::removeJob(const std::shared_ptr<JobBase>& job) {
+  std::lock_guard lock{mutex_};
+  jobs_.remove(job);
+}
+
+// _____________________________________________________________________________
+std::shared_ptr<SharedWorkerPool::JobBase>
+SharedWorkerPool::startTaskOfNextJob() {
+  for (auto it = jobs_.begin(); it != jobs_.end(); ++it) {
+    if ((*it)->tryStartTask()) {
+      auto job = *it;
+      // The job that was chosen is tried last the next time (round robin).
+      jobs_.splice(jobs_.end(), jobs_, it);
+      return job;
+    }
+  }
+  return nullptr;
+}
+
+// _____________________________________________________________________________
+void SharedWorkerPool::runWorker() {
+  std::unique_lock lock{mutex_};
+  while (true) {
+    std::shared_ptr<JobBase> job;
+    workAvailable_.wait(lock, [this, &job]() {
+      if (shutdown_) {
+        return true;
+      }
+      job = startTaskOfNextJob();
+      return job != nullptr;
+    });
+    if (shutdown_) {
+      return;
+    }
+    lock.unlock();
+    ad_utility::Timer timer{ad_utility::Timer::Started};
+    job->runTask();
+    busyTimeMicroseconds_ +=
+        std::chrono::duration_cast<std::chrono::microseconds>(timer.value())
+            .count();
+    job.reset();
+    lock.lock();
+    // The job may now be able to start another task.
+    workAvailable_.notify_all();
+  }
+}
+
+}  // namespace ad_utility
@@ -0,0 +1,211 @@
+//  Copyright 2025, University of Freiburg,
+//                  Chair of Algorithms and Data Structures.
+
+#pragma once
+
+#include <absl/cleanup/cleanup.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "util/Exception.h"
+#include "util/Generator.h"
+#include "util/HashMap.h"
+#include "util/jthread.h"
+
+namespace ad_utility {
+
+// A pool of worker threads that is shared by many concurrent producers (for
+// example, by all the lazy index scans of all queries, see
+// `CompressedRelationReader`). This avoids that each producer spawns its own
+// threads (compare `data_structures::queueManager`), which oversubscribes the
+// cores when many producers are active at the same time.
+//
+// Each producer is registered as a job via `orderedGenerator`. The workers
+// pick the jobs in a round-robin fashion, so that all the jobs make progress
+// at the same rate. The number of tasks of a job that run at the same time,
+// and the number of its values that have been produced but not consumed yet,
+// are bounded per job, so that a slow consumer only holds back its own job.
+class SharedWorkerPool {
+ public:
+  // The part of a job that does not depend on the type of the produced values.
+  class JobBase {
+    friend class SharedWorkerPool;
+
+   protected:
+    SharedWorkerPool& pool_;
+    // The members below are protected by the `mutex_`.
+    std::mutex mutex_;
+    std::condition_variable stateChanged_;
+    const size_t maxNumRunningTasks_;
+    const size_t maxNumValuesInFlight_;
+    size_t numRunningTasks_ = 0;
+    // The number of values that are currently produced or that have been
+    // produced, but not consumed yet.
+    size_t numValuesInFlight_ = 0;
+    // True iff the producer has returned `std::nullopt` or has thrown.
+    bool isExhausted_ = false;
+    bool isCancelled_ = false;
+    std::exception_ptr exception_;
+
+    JobBase(SharedWorkerPool& pool, size_t maxNumRunningTasks,
+            size_t maxNumValuesInFlight);
+
+    // Call the producer once and store its value. Return false iff the
+    // producer is exhausted. Is called without holding the `mutex_`.
+    virtual bool runProducer() = 0;
+
+    // Mark the value with the next index as consumed. Must be called with the
+    // `mutex_` held.
+    void valueWasConsumed() { --numValuesInFlight_; }
+
+   public:
+    virtual ~JobBase() = default;
+
+   private:
+    // If the limits of the job permit another task, reserve the resources for
+    // it and return true.
+    bool tryStartTask();
+    // Run a task that was reserved by `tryStartTask`.
+    void runTask();
+    // Prevent any further tasks and wait until the running tasks are done.
+    void cancelAndWait();
+  };
+
+  // A job whose producer yields values of type `T`.
+  template <typename T>
+  class Job : public JobBase {
+   public:
+    using Producer = std::function<std::optional<std::pair<size_t, T>>()>;
+
+   private:
+    Producer producer_;
+    // The values that have been produced, but not consumed yet, by their
+    // index. Protected by the `mutex_`.
+    ad_utility::HashMap<size_t, T> values_;
+    size_t nextIndex_ = 0;
+
+   public:
+    Job(SharedWorkerPool& pool, size_t maxNumRunningTasks,
+        size_t maxNumValuesInFlight, Producer producer)
+        : JobBase{pool, maxNumRunningTasks, maxNumValuesInFlight},
+          producer_{std::move(producer)} {}
+
+    // Block until the value with the next index has been produced and return
+    // it. Return `std::nullopt` if all values have been returned, and rethrow
+    // the exception if the producer has thrown.
+    std::optional<T> pop() {
+      std::unique_lock lock{mutex_};
+      stateChanged_.wait(lock, [this]() {
+        return exception_ || values_.contains(nextIndex_) ||
+               (isExhausted_ && numRunningTasks_ == 0);
+      });
+      if (exception_) {
+        std::rethrow_exception(exception_);
+      }
+      auto it = values_.find(nextIndex_);
+      if (it == values_.end()) {
+        return std::nullopt;
+      }
+      std::optional<T> result{std::move(it->second)};
+      values_.erase(it);
+      ++nextIndex_;
+      valueWasConsumed();
+      lock.unlock();
+      pool_.notifyWorkers();
+      return result;
+    }
+
+   private:
+    bool runProducer() override {
+      auto indexAndValue = producer_();
+      if (!indexAndValue.has_value()) {
+        return false;
+      }
+      std::lock_guard lock{mutex_};
+      values_.emplace(std::move(indexAndValue.value()));
+      return true;
+    }
+  };
+
+ private:
+  std::mutex mutex_;
+  std::condition_variable workAvailable_;
+  // The registered jobs, the job at the front is tried first.
+  std::list<std::shared_ptr<JobBase>> jobs_;
+  bool shutdown_ = false;
+  std::atomic<int64_t> busyTimeMicroseconds_ = 0;
+  std::vector<ad_utility::JThread> threads_;
+
+ public:
+  // Create a pool with `numThreads` worker threads (at least one).
+  explicit SharedWorkerPool(size_t numThreads);
+
+  // Stop and join all the worker threads. The generators that were obtained
+  // via `orderedGenerator` must not be used anymore.
+  ~SharedWorkerPool();
+
+  SharedWorkerPool(const SharedWorkerPool&) = delete;
+  SharedWorkerPool& operator=(const SharedWorkerPool&) = delete;
+
+  size_t numThreads() const { return threads_.size(); }
+
+  // The total time that the workers of the pool have spent running tasks.
+  std::chrono::microseconds busyTime() const {
+    return std::chrono::microseconds{busyTimeMicroseconds_.load()};
+  }
+
+  // The replacement for `data_structures::queueManager` with an
+  // `OrderedThreadSafeQueue`: The `producer` is called repeatedly by the
+  // workers of this pool, by at most `maxNumRunningTasks` of them at the same
+  // time. It has to return `std::optional<std::pair<size_t, T>>`, where the
+  // `size_t` is the index of the value (the indices must be consecutive,
+  // starting at 0), and `std::nullopt` means that the producer is exhausted.
+  // The values are yielded by the returned generator in the order of their
+  // indices. The producer is only called if less than `maxNumValuesInFlight`
+  // values are either being produced or have been produced but not yielded.
+  // Exceptions of the producer are rethrown by the generator. When the
+  // generator is destroyed, it waits for all running calls to the `producer`.
+  template <typename T, typename Producer>
+  cppcoro::generator<T> orderedGenerator(size_t maxNumValuesInFlight,
+                                         size_t maxNumRunningTasks,
+                                         Producer producer) {
+    AD_CONTRACT_CHECK(maxNumValuesInFlight > 0 && maxNumRunningTasks > 0);
+    auto job = std::make_shared<Job<T>>(
+        *this, maxNumRunningTasks, maxNumValuesInFlight, std::move(producer));
+    addJob(job);
+    absl::Cleanup cleanup{[this, &job]() {
+      job->cancelAndWait();
+      removeJob(job);
+    }};
+    while (auto value = job->pop()) {
+      co_yield value.value();
+    }
+  }
+
+  // Wake up the workers because the state of one of the jobs has changed.
+  void notifyWorkers();
+
+ private:
+  void addJob(std::shared_ptr<JobBase> job);
+  void removeJob(const std::shared_ptr<JobBase>& job);
+
+  // Return the first job that can start a task and move it to the back of the
+  // `jobs_`. Return `nullptr` if there is no such job. Must be called with the
+  // `mutex_` held.
+  std::shared_ptr<JobBase> startTaskOfNextJob();
+
+  // The loop of each of the `threads_`.
+  void runWorker();
+};
+
+}  // namespace ad_utility
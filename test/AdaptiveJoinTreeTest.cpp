@@ -0,0 +1,247 @@
+//  Copyright 2025, University of Freiburg,
+//                  Chair of Algorithms and Data Structures.
+
+#include <absl/cleanup/cleanup.h>
+#include <absl/strings/str_cat.h>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "./util/IdTableHelpers.h"
+#include "./util/IdTestHelpers.h"
+#include "./util/RuntimeParametersTestHelpers.h"
+#include "engine/AdaptiveJoinTree.h"
+#include "engine/Join.h"
+#include "engine/QueryPlanner.h"
+#include "engine/ValuesForTesting.h"
+#include "parser/SparqlParser.h"
+#include "util/IndexTestHelpers.h"
+
+namespace {
+auto I = ad_utility::testing::IntId;
+using Vars = std::vector<std::optional<Variable>>;
+using Plan = AdaptiveJoinTree::Plan;
+using ExecutedSubtree = AdaptiveJoinTree::ExecutedSubtree;
+
+// The rows of the `table` in sorted order, s.t. the results of different plans
+// can be compared independently of their order.
+std::vector<std::vector<Id>> getSortedRows(const IdTable& table) {
+  std::vector<std::vector<Id>> rows;
+  for (const auto& row : table) {
+    rows.emplace_back(row.begin(), row.end());
+  }
+  ql::ranges::sort(rows);
+  return rows;
+}
+
+std::shared_ptr<QueryExecutionTree> makeJoin(
+    QueryExecutionContext* qec, std::shared_ptr<QueryExecutionTree> left,
+    std::shared_ptr<QueryExecutionTree> right, const Variable& var) {
+  auto leftCol = left->getVariableColumn(var);
+  auto rightCol = right->getVariableColumn(var);
+  return ad_utility::makeExecutionTree<Join>(qec, std::move(left),
+                                             std::move(right), leftCol,
+                                             rightCol);
+}
+
+// The inputs `?x ?a`, `?x ?b` and `?a ?c` of the tests below, where the size
+// estimate of the first input is much too large.
+struct Inputs {
+  std::shared_ptr<QueryExecutionTree> xa_;
+  std::shared_ptr<QueryExecutionTree> xb_;
+  std::shared_ptr<QueryExecutionTree> ac_;
+  // The join of `xa` and `xb` in the initial plan.
+  std::shared_ptr<QueryExecutionTree> inner_;
+
+  explicit Inputs(QueryExecutionContext* qec) {
+    auto xa = ad_utility::makeExecutionTree<ValuesForTesting>(
+        qec, makeIdTableFromVector({{1, 10}, {2, 11}, {3, 12}}, I),
+        Vars{Variable{"?x"}, Variable{"?a"}});
+    static_cast<ValuesForTesting*>(xa->getRootOperation().get())
+        ->sizeEstimate() = 100'000;
+    xa_ = xa;
+    xb_ = ad_utility::makeExecutionTree<ValuesForTesting>(
+        qec, makeIdTableFromVector({{1, 20}, {1, 21}, {3, 22}}, I),
+        Vars{Variable{"?x"}, Variable{"?b"}});
+    ac_ = ad_utility::makeExecutionTree<ValuesForTesting>(
+        qec, makeIdTableFromVector({{10, 30}, {12, 31}, {13, 32}}, I),
+        Vars{Variable{"?a"}, Variable{"?c"}});
+  }
+
+  // The plan `(xa JOIN xb) JOIN ac`, where the inputs have the ids `1`, `2`
+  // and `4`.
+  Plan makeInitialPlan(QueryExecutionContext* qec) {
+    inner_ = makeJoin(qec, xa_, xb_, Variable{"?x"});
+    auto root = makeJoin(qec, inner_, ac_, Variable{"?a"});
+    return {root, {{inner_.get(), 0b011}, {root.get(), 0b111}}};
+  }
+};
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(AdaptiveJoinTree, estimateIsOff) {
+  EXPECT_FALSE(AdaptiveJoinTree::estimateIsOff(100, 100, 2.0));
+  EXPECT_FALSE(AdaptiveJoinTree::estimateIsOff(100, 200, 2.0));
+  EXPECT_TRUE(AdaptiveJoinTree::estimateIsOff(100, 201, 2.0));
+  EXPECT_TRUE(AdaptiveJoinTree::estimateIsOff(100, 49, 2.0));
+  // Empty results are treated like results with a single row.
+  EXPECT_FALSE(AdaptiveJoinTree::estimateIsOff(0, 1, 2.0));
+  EXPECT_TRUE(AdaptiveJoinTree::estimateIsOff(3, 0, 2.0));
+}
+
+// _____________________________________________________________________________
+TEST(AdaptiveJoinTree, noReoptimization) {
+  auto qec = ad_utility::testing::getQec();
+  qec->getQueryTreeCache().clearAll();
+  Inputs inputs{qec};
+  auto [initialPlan, ids] = inputs.makeInitialPlan(qec);
+  auto replanner = [](const std::vector<ExecutedSubtree>&) -> Plan {
+    ADD_FAILURE() << "The plan must not be re-planned";
+    return {};
+  };
+  AdaptiveJoinTree adaptive{
+      qec, initialPlan,
+      std::make_shared<AdaptiveJoinTree::IdsOfSubtrees>(std::move(ids)),
+      replanner, 1e9};
+  EXPECT_EQ(adaptive.getResultWidth(), 4);
+  EXPECT_EQ(adaptive.getSizeEstimate(), initialPlan->getSizeEstimate());
+  EXPECT_EQ(adaptive.resultSortedOn(), initialPlan->resultSortedOn());
+  EXPECT_EQ(adaptive.getExternallyVisibleVariableColumns(),
+            initialPlan->getVariableColumns());
+  EXPECT_NE(adaptive.getCacheKey(), initialPlan->getCacheKey());
+  EXPECT_THAT(adaptive.getDescriptor(), ::testing::StartsWith("Adaptive "));
+
+  auto result = adaptive.getResult();
+  EXPECT_EQ(result->idTable(), initialPlan->getResult()->idTable());
+  EXPECT_EQ(adaptive.runtimeInfo().details_["numReoptimizations"], 0);
+}
+
+// _____________________________________________________________________________
+TEST(AdaptiveJoinTree, executedJoinsAreReusedWithoutCache) {
+  using namespace ad_utility::memory_literals;
+  auto qec = ad_utility::testing::getQec();
+  qec->getQueryTreeCache().clearAll();
+  // No result is stored in the query cache.
+  absl::Cleanup restoreOriginalSize{
+      [qec, original = qec->getQueryTreeCache().getMaxSizeSingleEntry()]() {
+        qec->getQueryTreeCache().setMaxSizeSingleEntry(original);
+      }};
+  qec->getQueryTreeCache().setMaxSizeSingleEntry(0_B);
+  Inputs inputs{qec};
+  auto [initialPlan, ids] = inputs.makeInitialPlan(qec);
+  auto innerJoin = inputs.inner_->getRootOperation();
+  auto replanner = [](const std::vector<ExecutedSubtree>&) -> Plan {
+    ADD_FAILURE() << "The plan must not be re-planned";
+    return {};
+  };
+  AdaptiveJoinTree adaptive{
+      qec, initialPlan,
+      std::make_shared<AdaptiveJoinTree::IdsOfSubtrees>(std::move(ids)),
+      replanner, 1e9};
+  auto result = adaptive.getResult();
+
+  // The parent of the inner join got its result from the operation that was
+  // substituted for the inner join, so the inner join was not computed again
+  // and doesn't appear in the runtime information of the root.
+  auto containsInfo = [](const RuntimeInformation& info,
+                         const RuntimeInformation* target) {
+    auto impl = [target](const auto& self,
+                         const RuntimeInformation& current) -> bool {
+      return &current == target ||
+             ql::ranges::any_of(current.children_, [&](const auto& child) {
+               return self(self, *child);
+             });
+    };
+    return impl(impl, info);
+  };
+  EXPECT_FALSE(containsInfo(initialPlan->getRootOperation()->runtimeInfo(),
+                            &innerJoin->runtimeInfo()));
+
+  // Afterwards, the initial plan is restored.
+  EXPECT_EQ(inputs.inner_->getRootOperation(), innerJoin);
+  EXPECT_EQ(inputs.inner_->getSizeEstimate(), innerJoin->getSizeEstimate());
+  EXPECT_EQ(result->idTable(), initialPlan->getResult()->idTable());
+}
+
+// _____________________________________________________________________________
+TEST(AdaptiveJoinTree, reoptimization) {
+  auto qec = ad_utility::testing::getQec();
+  qec->getQueryTreeCache().clearAll();
+  Inputs inputs{qec};
+  auto [initialPlan, ids] = inputs.makeInitialPlan(qec);
+  // The join of `xa` and `xb` has three rows, which is far off its estimate.
+  ASSERT_TRUE(AdaptiveJoinTree::estimateIsOff(
+      inputs.inner_->getSizeEstimate(), 3, 2.0));
+  size_t numCalls = 0;
+  // The new plan joins the executed `xa JOIN xb` with `ac`, but with the
+  // children swapped, such that the columns are in a different order.
+  auto replanner = [&](const std::vector<ExecutedSubtree>& executed) -> Plan {
+    ++numCalls;
+    EXPECT_EQ(executed.size(), 1);
+    const auto& [tree, executedIds] = executed.at(0);
+    EXPECT_EQ(executedIds, 0b011);
+    // The executed subtree has the exact size and reuses the result.
+    EXPECT_EQ(tree->getSizeEstimate(), 3);
+    EXPECT_EQ(tree->getCostEstimate(), 0);
+    EXPECT_EQ(tree->getCacheKey(), inputs.inner_->getCacheKey());
+    auto root = makeJoin(qec, inputs.ac_, tree, Variable{"?a"});
+    return {root, {{root.get(), 0b111}}};
+  };
+  AdaptiveJoinTree adaptive{
+      qec, initialPlan,
+      std::make_shared<AdaptiveJoinTree::IdsOfSubtrees>(std::move(ids)),
+      replanner, 2.0};
+  auto result = adaptive.getResult();
+  EXPECT_EQ(numCalls, 1);
+  EXPECT_EQ(adaptive.runtimeInfo().details_["numReoptimizations"], 1);
+  // The result has the same columns and order as that of the initial plan.
+  EXPECT_EQ(result->idTable(), initialPlan->getResult()->idTable());
+  EXPECT_EQ(result->sortedBy(), initialPlan->resultSortedOn());
+}
+
+// _____________________________________________________________________________
+TEST(AdaptiveJoinTree, queryPlanner) {
+  std::string kg;
+  for (size_t i = 0; i < 50; ++i) {
+    absl::StrAppend(&kg, "<x", i, "> <p> <a", i % 10, "> .\n");
+    absl::StrAppend(&kg, "<x", i, "> <q> <b", i % 7, "> .\n");
+    absl::StrAppend(&kg, "<a", i % 13, "> <r> <c", i, "> .\n");
+  }
+  auto qec = ad_utility::testing::getQec(kg);
+  auto plan = [qec]() {
+    ParsedQuery pq = SparqlParser::parseQuery(
+        "SELECT * WHERE { ?x <p> ?a . ?x <q> ?b . ?a <r> ?c }");
+    return QueryPlanner{qec,
+                        std::make_shared<ad_utility::CancellationHandle<>>()}
+        .createExecutionTree(pq);
+  };
+  auto containsAdaptiveJoinTree = [](QueryExecutionTree& qet) {
+    bool found = false;
+    auto check = [&found](QueryExecutionTree* tree) {
+      found |= dynamic_cast<const AdaptiveJoinTree*>(
+                   tree->getRootOperation().get()) != nullptr;
+    };
+    check(&qet);
+    qet.forAllDescendants(check);
+    return found;
+  };
+
+  // Without the runtime parameter, the joins are not re-planned.
+  qec->getQueryTreeCache().clearAll();
+  auto staticPlan = plan();
+  EXPECT_FALSE(containsAdaptiveJoinTree(staticPlan));
+  auto expected = getSortedRows(staticPlan.getResult()->idTable());
+  EXPECT_FALSE(expected.empty());
+
+  // With the runtime parameter, the result is the same, no matter how often
+  // the joins are re-planned.
+  for (double factor : {1.0, 1.5, 1e9}) {
+    auto cleanup =
+        setRuntimeParameterForTest<"adaptive-reoptimization-factor">(factor);
+    qec->getQueryTreeCache().clearAll();
+    auto adaptivePlan = plan();
+    EXPECT_TRUE(containsAdaptiveJoinTree(adaptivePlan));
+    EXPECT_EQ(adaptivePlan.getVariableColumns(),
+              staticPlan.getVariableColumns());
+    EXPECT_EQ(getSortedRows(adaptivePlan.getResult()->idTable()), expected);
+  }
+}
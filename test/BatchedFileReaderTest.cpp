@@ -0,0 +1,64 @@
+//  Copyright 2025, University of Freiburg,
+//                  Chair of Algorithms and Data Structures.
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "util/BatchedFileReader.h"
+#include "util/File.h"
+
+namespace {
+// Write the `contents` to a file with the `filename` and return it.
+void writeFile(const std::string& filename, const std::string& contents) {
+  ad_utility::File file{filename, "w"};
+  file.write(contents.data(), contents.size());
+}
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(BatchedFileReader, readBatch) {
+  std::string filename = "BatchedFileReaderTest.readBatch.dat";
+  std::string contents;
+  for (size_t i = 0; i < 1000; ++i) {
+    contents += std::to_string(i);
+  }
+  writeFile(filename, contents);
+  ad_utility::File file{filename, "r"};
+
+  // More requests than can be in flight at once, of different sizes and in no
+  // particular order.
+  std::vector<std::string> targets;
+  std::vector<ad_utility::FileReadRequest> requests;
+  size_t numRequests = 3 * ad_utility::MAX_NUM_READS_IN_FLIGHT + 7;
+  targets.reserve(numRequests);
+  for (size_t i = 0; i < numRequests; ++i) {
+    size_t offset = (i * 37) % (contents.size() - 20);
+    auto& target = targets.emplace_back(i % 20 + 1, '\0');
+    requests.push_back(
+        {target.data(), target.size(), static_cast<off_t>(offset)});
+  }
+  ad_utility::readBatch(file, requests);
+  for (size_t i = 0; i < numRequests; ++i) {
+    EXPECT_EQ(targets.at(i), contents.substr(requests.at(i).offset_,
+                                             requests.at(i).size_));
+  }
+
+  // An empty batch is allowed.
+  ad_utility::readBatch(file, {});
+  ad_utility::deleteFile(filename);
+}
+
+// _____________________________________________________________________________
+TEST(BatchedFileReader, readErrorThrows) {
+  std::string filename = "BatchedFileReaderTest.readError.dat";
+  writeFile(filename, "someContents");
+  // A file that is opened only for writing cannot be read.
+  ad_utility::File file{filename, "w"};
+  std::string target(4, '\0');
+  std::vector<ad_utility::FileReadRequest> requests{
+      {target.data(), target.size(), 0}};
+  EXPECT_THROW(ad_utility::readBatch(file, requests), std::runtime_error);
+  ad_utility::deleteFile(filename);
+}
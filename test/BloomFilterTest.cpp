@@ -0,0 +1,80 @@
+//  Copyright 2025, University of Freiburg,
+//                  Chair of Algorithms and Data Structures.
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "util/BloomFilter.h"
+#include "util/Serializer/ByteBufferSerializer.h"
+
+using ad_utility::BloomFilter;
+using ad_utility::BloomFilterBudget;
+using namespace ad_utility::memory_literals;
+
+// _____________________________________________________________________________
+TEST(BloomFilter, noFalseNegativesAndFewFalsePositives) {
+  auto filter = BloomFilter::forNumKeys(1000, BloomFilterBudget{10, 1_MB});
+  ASSERT_TRUE(filter.has_value());
+  EXPECT_EQ(filter->numBits(), 10048);
+  EXPECT_EQ(filter->numHashFunctions(), 7);
+  // Keys that only differ in a few bits, like consecutive `Id`s.
+  for (uint64_t key = 0; key < 2000; key += 2) {
+    filter->add(key);
+  }
+  size_t numFalsePositives = 0;
+  for (uint64_t key = 0; key < 2000; ++key) {
+    if (key % 2 == 0) {
+      EXPECT_TRUE(filter->mayContain(key)) << key;
+    } else {
+      numFalsePositives += filter->mayContain(key);
+    }
+  }
+  // The expected false positive rate for 10 bits per key is about 1%.
+  EXPECT_LT(numFalsePositives, 30);
+}
+
+// _____________________________________________________________________________
+TEST(BloomFilter, budget) {
+  // Disabled filters and filters without keys.
+  EXPECT_FALSE(BloomFilter::forNumKeys(1000, BloomFilterBudget{}).has_value());
+  EXPECT_FALSE(
+      BloomFilter::forNumKeys(0, BloomFilterBudget{8, 1_MB}).has_value());
+
+  // The size of the filter is capped, which also reduces the number of hash
+  // functions.
+  auto filter = BloomFilter::forNumKeys(1000, BloomFilterBudget{16, 256_B});
+  ASSERT_TRUE(filter.has_value());
+  EXPECT_EQ(filter->numBits(), 2048);
+  EXPECT_EQ(filter->numHashFunctions(), 1);
+
+  // Very small budgets still lead to a filter with a single word.
+  filter = BloomFilter::forNumKeys(1000, BloomFilterBudget{4, 0_B});
+  ASSERT_TRUE(filter.has_value());
+  EXPECT_EQ(filter->numBits(), 64);
+  filter->add(42);
+  EXPECT_TRUE(filter->mayContain(42));
+
+  EXPECT_ANY_THROW(BloomFilter(0, 3));
+  EXPECT_ANY_THROW(BloomFilter(64, 0));
+
+  // The default constructed filter conservatively contains everything.
+  EXPECT_TRUE(BloomFilter{}.mayContain(42));
+  EXPECT_ANY_THROW(BloomFilter{}.add(42));
+}
+
+// _____________________________________________________________________________
+TEST(BloomFilter, serialization) {
+  BloomFilter filter{200, 3};
+  filter.add(17);
+  filter.add(4711);
+  ad_utility::serialization::ByteBufferWriteSerializer writer;
+  writer << filter;
+  ad_utility::serialization::ByteBufferReadSerializer reader{
+      std::move(writer).data()};
+  BloomFilter deserialized;
+  reader >> deserialized;
+  EXPECT_EQ(deserialized, filter);
+  EXPECT_EQ(deserialized.numBits(), 256);
+  EXPECT_TRUE(deserialized.mayContain(17));
+  EXPECT_TRUE(deserialized.mayContain(4711));
+}
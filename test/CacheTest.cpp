@@ -139,4 +139,77 @@ TEST(LRUCacheTest, testDecreasingCapacity) {
   ASSERT_FALSE(cache["3"]);
   ASSERT_FALSE(cache["4"]);
 }
+
+namespace {
+// A `CostGetter` for the `CostAwareCache` tests below: Values that start with
+// an `e` are expensive to compute, all other values are cheap.
+struct TestCostGetter {
+  double operator()(const string& value) const {
+    return !value.empty() && value.front() == 'e' ? 1000.0 : 1.0;
+  }
+};
+using TestCostAwareCache =
+    CostAwareCache<string, string, StringSizeGetter<string>, TestCostGetter>;
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(CostAwareCacheTest, evictionPolicies) {
+  // Insert a small expensive entry and then several large cheap entries.
+  auto fillCache = [](TestCostAwareCache& cache) {
+    cache.insert("expensive", "e");
+    for (size_t i = 0; i < 5; ++i) {
+      cache.insert(std::to_string(i), string(100, 'x'));
+    }
+  };
+
+  // With the default LRU policy, the expensive entry is the oldest one and
+  // thus evicted first.
+  {
+    TestCostAwareCache cache(3);
+    EXPECT_EQ(cache.getEvictionPolicy(), CacheEvictionPolicy::LRU);
+    fillCache(cache);
+    EXPECT_FALSE(cache.contains("expensive"));
+    EXPECT_FALSE(cache.contains("0"));
+    EXPECT_FALSE(cache.contains("1"));
+    EXPECT_TRUE(cache.contains("4"));
+    EXPECT_EQ(cache.numEvictions(), 3u);
+    EXPECT_DOUBLE_EQ(cache.evictedCost(), 1002.0);
+  }
+
+  // With GDSF, the small expensive entry is kept.
+  {
+    TestCostAwareCache cache(3);
+    cache.setEvictionPolicy(CacheEvictionPolicy::GDSF);
+    EXPECT_EQ(cache.getEvictionPolicy(), CacheEvictionPolicy::GDSF);
+    fillCache(cache);
+    EXPECT_TRUE(cache.contains("expensive"));
+    EXPECT_EQ(cache.numNonPinnedEntries(), 3u);
+    EXPECT_EQ(cache.numEvictions(), 3u);
+    EXPECT_DOUBLE_EQ(cache.evictedCost(), 3.0);
+  }
+}
+
+// _____________________________________________________________________________
+TEST(CostAwareCacheTest, gdsfPrefersFrequentlyAccessedEntries) {
+  TestCostAwareCache cache(2);
+  cache.setEvictionPolicy(CacheEvictionPolicy::GDSF);
+  cache.insert("a", "xx");
+  cache.insert("b", "xx");
+  // `b` is the most recently inserted entry, but `a` is accessed more often.
+  ASSERT_EQ(*cache["a"], "xx");
+  ASSERT_EQ(*cache["a"], "xx");
+  cache.insert("c", "xx");
+  EXPECT_TRUE(cache.contains("a"));
+  EXPECT_FALSE(cache.contains("b"));
+  EXPECT_TRUE(cache.contains("c"));
+}
+
+// _____________________________________________________________________________
+TEST(CostAwareCacheTest, policyFromString) {
+  EXPECT_EQ(cacheEvictionPolicyFromString("lru"), CacheEvictionPolicy::LRU);
+  EXPECT_EQ(cacheEvictionPolicyFromString("gdsf"), CacheEvictionPolicy::GDSF);
+  EXPECT_EQ(toString(CacheEvictionPolicy::LRU), "lru");
+  EXPECT_EQ(toString(CacheEvictionPolicy::GDSF), "gdsf");
+  EXPECT_ANY_THROW(cacheEvictionPolicyFromString("fifo"));
+}
 }  // namespace ad_utility
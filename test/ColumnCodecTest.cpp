@@ -0,0 +1,135 @@
+//  Copyright 2025, University of Freiburg,
+//                  Chair of Algorithms and Data Structures.
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <random>
+
+#include "./util/GTestHelpers.h"
+#include "util/ColumnCodec.h"
+#include "util/Serializer/ByteBufferSerializer.h"
+
+using ad_utility::ColumnCodec;
+
+namespace {
+constexpr auto allCodecs = std::array{
+    ColumnCodec::Zstd, ColumnCodec::RunLength, ColumnCodec::FrameOfReference,
+    ColumnCodec::DeltaFrameOfReference};
+
+// Encode and decode the `column` with all the codecs and check that the
+// decoded column equals the `column`.
+void testRoundTrip(const std::vector<uint64_t>& column,
+                   ad_utility::source_location l =
+                       ad_utility::source_location::current()) {
+  auto trace = generateLocationTrace(l);
+  for (auto codec : allCodecs) {
+    auto encoded = ad_utility::encodeColumn(column, codec);
+    std::vector<uint64_t> decoded(column.size());
+    ad_utility::decodeColumn(codec, encoded, decoded);
+    EXPECT_EQ(decoded, column) << ad_utility::toString(codec);
+  }
+  auto [codec, encoded] = ad_utility::encodeColumn(column);
+  std::vector<uint64_t> decoded(column.size());
+  ad_utility::decodeColumn(codec, encoded, decoded);
+  EXPECT_EQ(decoded, column) << ad_utility::toString(codec);
+}
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(ColumnCodec, roundTrip) {
+  std::mt19937_64 randomEngine{42};
+  for (size_t size : {0, 1, 2, 63, 64, 65, 127, 128, 1000}) {
+    // Values with all the possible bit widths.
+    for (size_t width = 0; width <= 64; ++width) {
+      std::vector<uint64_t> bounded(size);
+      std::ranges::generate(bounded, [&]() -> uint64_t {
+        return width == 64 ? randomEngine()
+                           : randomEngine() & ((uint64_t{1} << width) - 1);
+      });
+      testRoundTrip(bounded);
+    }
+
+    std::vector<uint64_t> smallRange(size);
+    std::ranges::generate(smallRange, [&]() {
+      return (uint64_t{1} << 60) + randomEngine() % 1000;
+    });
+    testRoundTrip(smallRange);
+
+    auto sorted = smallRange;
+    std::ranges::sort(sorted);
+    testRoundTrip(sorted);
+
+    std::vector<uint64_t> constant(size, 17);
+    testRoundTrip(constant);
+  }
+  testRoundTrip({std::numeric_limits<uint64_t>::max(), 0,
+                 std::numeric_limits<uint64_t>::max()});
+}
+
+// _____________________________________________________________________________
+TEST(ColumnCodec, codecSelection) {
+  auto codecOf = [](const std::vector<uint64_t>& column) {
+    return ad_utility::encodeColumn(column).codec_;
+  };
+  EXPECT_EQ(codecOf(std::vector<uint64_t>(1000, 42)), ColumnCodec::RunLength);
+
+  std::vector<uint64_t> sorted(1000);
+  for (size_t i = 0; i < sorted.size(); ++i) {
+    sorted[i] = (uint64_t{1} << 60) + 1000 * i;
+  }
+  EXPECT_EQ(codecOf(sorted), ColumnCodec::DeltaFrameOfReference);
+
+  std::vector<uint64_t> smallRange(1000);
+  std::mt19937_64 randomEngine{42};
+  std::ranges::generate(smallRange, [&]() {
+    return (uint64_t{1} << 60) + randomEngine() % 1000;
+  });
+  EXPECT_EQ(codecOf(smallRange), ColumnCodec::FrameOfReference);
+
+  // A few distinct values that are far apart from each other in a long
+  // repeating pattern are compressed much better by zstd.
+  std::vector<uint64_t> pattern;
+  for (size_t i = 0; i < 10000; ++i) {
+    pattern.push_back(i % 2 == 0 ? 0 : std::numeric_limits<uint64_t>::max());
+  }
+  EXPECT_EQ(codecOf(pattern), ColumnCodec::Zstd);
+
+  // The lightweight encodings of a sorted column are much smaller than the
+  // raw column.
+  EXPECT_LT(ad_utility::encodeColumn(sorted).bytes_.size(),
+            sorted.size() * sizeof(uint64_t) / 4);
+}
+
+// _____________________________________________________________________________
+TEST(ColumnCodec, decodingErrors) {
+  std::vector<uint64_t> column{1, 2, 3, 4, 5};
+  for (auto codec : allCodecs) {
+    auto encoded = ad_utility::encodeColumn(column, codec);
+    std::vector<uint64_t> tooSmall(4);
+    EXPECT_ANY_THROW(ad_utility::decodeColumn(codec, encoded, tooSmall));
+    std::vector<uint64_t> tooLarge(6);
+    EXPECT_ANY_THROW(ad_utility::decodeColumn(codec, encoded, tooLarge));
+  }
+  std::vector<uint64_t> target(5);
+  auto encoded = ad_utility::encodeColumn(column, ColumnCodec::RunLength);
+  encoded.pop_back();
+  EXPECT_ANY_THROW(
+      ad_utility::decodeColumn(ColumnCodec::RunLength, encoded, target));
+}
+
+// _____________________________________________________________________________
+TEST(ColumnCodec, serialization) {
+  ad_utility::serialization::ByteBufferWriteSerializer writer;
+  auto original = ColumnCodec::DeltaFrameOfReference;
+  writer << original;
+  ad_utility::serialization::ByteBufferReadSerializer reader{
+      std::move(writer).data()};
+  ColumnCodec codec = ColumnCodec::Zstd;
+  reader >> codec;
+  EXPECT_EQ(codec, ColumnCodec::DeltaFrameOfReference);
+  EXPECT_EQ(ad_utility::toString(codec), "delta-frame-of-reference");
+}
@@ -6,9 +6,12 @@
 
 #include "./util/IdTableHelpers.h"
 #include "index/CompressedRelation.h"
+#include "engine/LocalVocab.h"
+#include "index/DecompressedBlockCache.h"
 #include "util/GTestHelpers.h"
 #include "util/IndexTestHelpers.h"
 #include "util/OnDestructionDontThrowDuringStackUnwinding.h"
+#include "util/RuntimeParametersTestHelpers.h"
 #include "util/Serializer/ByteBufferSerializer.h"
 #include "util/SourceLocation.h"
 
@@ -104,7 +107,8 @@ auto addGraphColumnIfNecessary(std::vector<RelationInput>& inputs) {
 std::pair<std::vector<CompressedBlockMetadata>,
           std::vector<CompressedRelationMetadata>>
 compressedRelationTestWriteCompressedRelations(
-    auto inputs, std::string filename, ad_utility::MemorySize blocksize) {
+    auto inputs, std::string filename, ad_utility::MemorySize blocksize,
+    ad_utility::BloomFilterBudget bloomFilterBudget = {}) {
   // First check the invariants of the `inputs`. They must be sorted by the
   // `col0_` and for each of the `inputs` the `col1And2_` must also be sorted.
   AD_CONTRACT_CHECK(ql::ranges::is_sorted(
@@ -120,7 +124,7 @@ compressedRelationTestWriteCompressedRelations(
   size_t numColumns = getNumColumns(inputs) + 1;
   AD_CORRECTNESS_CHECK(numColumns >= 4);
   CompressedRelationWriter writer{numColumns, ad_utility::File{filename, "w"},
-                                  blocksize};
+                                  blocksize, bloomFilterBudget};
   vector<CompressedRelationMetadata> metaData;
   {
     size_t i = 0;
@@ -236,9 +240,11 @@ makeLocatedTriplesFromPartOfInput(float locatedProbab,
 // that are required to test the `CompressedRelationReader` class.
 auto writeAndOpenRelations(const std::vector<RelationInput>& inputs,
                            std::string filename,
-                           ad_utility::MemorySize blocksize) {
+                           ad_utility::MemorySize blocksize,
+                           ad_utility::BloomFilterBudget bloomFilterBudget =
+                               {}) {
   auto [blocks, metaData] = compressedRelationTestWriteCompressedRelations(
-      inputs, filename, blocksize);
+      inputs, filename, blocksize, bloomFilterBudget);
   auto reader = [&]() {
     return std::make_unique<CompressedRelationReader>(
         ad_utility::makeUnlimitedAllocator<Id>(),
@@ -474,6 +480,24 @@ TEST(CompressedRelationWriter, LargeRelationsDistinctCol1) {
   testWithDifferentBlockSizes(inputs, "largeRelationsDistinctCol1");
 }
 
+// Test that the lazy scans yield the correct blocks, no matter how many
+// blocks are read from disk at once.
+TEST(CompressedRelationWriter, DifferentIoBatchSizes) {
+  std::vector<RelationInput> inputs;
+  for (int i = 1; i < 4; ++i) {
+    std::vector<RowInput> col1And2;
+    for (int j = 0; j < 100; ++j) {
+      col1And2.push_back({i * j, i * j + 3});
+    }
+    inputs.push_back(RelationInput{i * 17, std::move(col1And2)});
+  }
+  for (size_t batchSize : {0, 1, 3, 100}) {
+    auto cleanup =
+        setRuntimeParameterForTest<"lazy-index-scan-io-batch-size">(batchSize);
+    testCompressedRelations(inputs, "differentIoBatchSizes", 19_B);
+  }
+}
+
 // Test for larger relations that span over several blocks. There are many
 // duplicates in the `col1`, so a combination of `(col0, col1)` will also be
 // stored in several blocks.
@@ -897,3 +921,418 @@ TEST(CompressedRelationWriter, scanWithGraphs) {
                 matchesIdTableFromVector({{3, 4}, {8, 5}, {9, 4}, {9, 5}}));
   }
 }
+
+// _____________________________________________________________________________
+TEST(DecompressedBlockCache, lookupAndInsert) {
+  auto allocator = ad_utility::testing::makeAllocator();
+  DecompressedBlockCache cache{1_kB};
+  DecompressedBlockCache::Key key{cache.getNewReaderId(), 3, {0, 1}};
+  EXPECT_EQ(cache.lookup(key), nullptr);
+
+  auto block =
+      std::make_shared<IdTable>(makeIdTableFromVector({{1, 2}, {3, 4}}));
+  cache.insert(key, block);
+  // Inserting the same key twice is allowed (and ignored).
+  cache.insert(key, std::make_shared<IdTable>(makeIdTableFromVector({{5, 6}})));
+  // The cached block is shared, not copied.
+  auto cached = cache.lookup(key);
+  EXPECT_EQ(cached.get(), block.get());
+  EXPECT_EQ(*cached, makeIdTableFromVector({{1, 2}, {3, 4}}));
+
+  // Other columns, other blocks, and other readers are not found.
+  EXPECT_EQ(cache.lookup({key.readerId_, 3, {0}}), nullptr);
+  EXPECT_EQ(cache.lookup({key.readerId_, 4, {0, 1}}), nullptr);
+  EXPECT_EQ(cache.lookup({cache.getNewReaderId(), 3, {0, 1}}), nullptr);
+
+  auto statistics = cache.getStatistics();
+  EXPECT_EQ(statistics.numHits_, 1u);
+  EXPECT_EQ(statistics.numMisses_, 4u);
+  EXPECT_EQ(statistics.numBytesSaved_, 4 * sizeof(Id));
+  EXPECT_EQ(statistics.numEntries_, 1u);
+  EXPECT_EQ(statistics.size_, ad_utility::MemorySize::bytes(4 * sizeof(Id)));
+  EXPECT_DOUBLE_EQ(statistics.hitRate(), 0.2);
+
+  // Blocks that are larger than the cache are not stored.
+  auto largeBlock = std::make_shared<IdTable>(2, allocator);
+  largeBlock->resize(100);
+  DecompressedBlockCache::Key largeKey{key.readerId_, 5, {0, 1}};
+  cache.insert(largeKey, largeBlock);
+  EXPECT_EQ(cache.lookup(largeKey), nullptr);
+
+  // Making room evicts entries of at least the given size, or all of them.
+  DecompressedBlockCache::Key otherKey{key.readerId_, 6, {0, 1}};
+  cache.insert(otherKey,
+               std::make_shared<IdTable>(makeIdTableFromVector({{7, 8}})));
+  EXPECT_TRUE(cache.makeRoomAsMuchAsPossible(
+      ad_utility::MemorySize::bytes(sizeof(Id))));
+  EXPECT_EQ(cache.getStatistics().numEntries_, 1u);
+  EXPECT_FALSE(cache.makeRoomAsMuchAsPossible(1_kB));
+  EXPECT_EQ(cache.getStatistics().numEntries_, 0u);
+  cache.insert(key, block);
+
+  // A block that is evicted stays valid as long as it is used.
+  cache.clear();
+  EXPECT_EQ(cache.lookup(key), nullptr);
+  EXPECT_EQ(cache.getStatistics().numEntries_, 0u);
+  EXPECT_EQ(*cached, makeIdTableFromVector({{1, 2}, {3, 4}}));
+
+  // A cache with size zero is disabled.
+  cache.setMaxSize(0_B);
+  EXPECT_FALSE(cache.isEnabled());
+  cache.insert(key, block);
+  EXPECT_EQ(cache.lookup(key), nullptr);
+  cache.setMaxSize(1_kB);
+  EXPECT_TRUE(cache.isEnabled());
+}
+
+// Test that the blocks in the `DecompressedBlockCache` are allocated with the
+// (limited) allocator of the reader and are not modified by the scans.
+TEST(CompressedRelationReader, decompressedBlockCacheUsesLimitedAllocator) {
+  std::vector<RelationInput> inputs{RelationInput{42, {}}};
+  for (int i = 1; i < 100; ++i) {
+    inputs.at(0).col1And2_.push_back({i, i + 1, 0});
+  }
+  auto& cache = DecompressedBlockCache::get();
+  cache.clear();
+  std::string filename = "decompressedBlockCacheUsesLimitedAllocator.dat";
+  auto cleanup = makeCleanup(filename);
+  auto [blocks, metadata] =
+      compressedRelationTestWriteCompressedRelations(inputs, filename, 40_B);
+  // Like the allocator of the `Server`, evict cached blocks if an allocation
+  // would exceed the limit.
+  ad_utility::AllocatorWithLimit<Id> allocator{
+      ad_utility::makeAllocationMemoryLeftThreadsafeObject(1_MB),
+      [&cache](ad_utility::MemorySize size) {
+        cache.makeRoomAsMuchAsPossible(size);
+      }};
+  CompressedRelationReader reader{allocator, ad_utility::File{filename, "r"}};
+  auto handle = std::make_shared<ad_utility::CancellationHandle<>>();
+  ScanSpecification spec{V(42), std::nullopt, std::nullopt};
+  auto scan = [&](const ScanSpecification& scanSpec) {
+    return reader.scan(scanSpec, blocks, {}, handle, emptyLocatedTriples);
+  };
+
+  auto expected = scan(spec).clone();
+  EXPECT_EQ(expected.numRows(), 99u);
+  // The blocks that stay in the cache after the scan are still counted
+  // against the memory limit of the reader.
+  auto cacheSize = cache.getStatistics().size_;
+  EXPECT_GT(cacheSize, 0_B);
+  auto memoryLeft = allocator.amountMemoryLeft();
+  EXPECT_LE(memoryLeft + cacheSize, 1_MB);
+
+  // Filtering the rows of the (shared) blocks does not change the cached
+  // blocks.
+  ScanSpecification filteredSpec = spec;
+  filteredSpec.addRowFilter(
+      std::make_shared<const ScanSpecification::RowFilter>(
+          [](std::span<const Id> ids) {
+            return std::vector<uint8_t>(ids.size(), 0);
+          }));
+  EXPECT_EQ(scan(filteredSpec).numRows(), 0u);
+  EXPECT_EQ(scan(spec), expected);
+
+  // An allocation that only fits if the cached blocks are evicted succeeds.
+  cacheSize = cache.getStatistics().size_;
+  ASSERT_GT(cacheSize, 0_B);
+  {
+    IdTable table{1, allocator};
+    EXPECT_NO_THROW(table.resize(
+        (allocator.amountMemoryLeft().getBytes() + cacheSize.getBytes() / 2) /
+        sizeof(Id)));
+    EXPECT_LT(cache.getStatistics().size_, cacheSize);
+  }
+
+  // The memory is freed when the blocks are evicted.
+  cache.clear();
+  EXPECT_GT(allocator.amountMemoryLeft(), memoryLeft);
+}
+
+// Test that repeated scans of the same blocks are answered from the
+// process-wide `DecompressedBlockCache`.
+TEST(CompressedRelationReader, scansUseDecompressedBlockCache) {
+  std::vector<RelationInput> inputs{RelationInput{42, {}}};
+  for (int i = 1; i < 100; ++i) {
+    inputs.at(0).col1And2_.push_back({i, i + 1, 0});
+  }
+  auto& cache = DecompressedBlockCache::get();
+  auto handle = std::make_shared<ad_utility::CancellationHandle<>>();
+  auto scanAll = [&handle](const auto& reader, const auto& blocks) {
+    ScanSpecification spec{V(42), std::nullopt, std::nullopt};
+    return reader->scan(spec, blocks, {}, handle, emptyLocatedTriples);
+  };
+
+  std::string filename = "scansUseDecompressedBlockCache.dat";
+  auto cleanup = makeCleanup(filename);
+  auto [blocks, metadata, reader] =
+      writeAndOpenRelations(inputs, filename, 40_B);
+  ASSERT_GT(blocks.size(), 1u);
+
+  auto before = cache.getStatistics();
+  auto result = scanAll(reader, blocks);
+  auto afterFirstScan = cache.getStatistics();
+  EXPECT_EQ(afterFirstScan.numHits_, before.numHits_);
+  auto resultFromCache = scanAll(reader, blocks);
+  auto afterSecondScan = cache.getStatistics();
+  EXPECT_EQ(resultFromCache, result);
+  EXPECT_EQ(result.numRows(), 99u);
+  EXPECT_GT(afterSecondScan.numHits_, afterFirstScan.numHits_);
+  EXPECT_EQ(afterSecondScan.numMisses_, afterFirstScan.numMisses_);
+  EXPECT_GT(afterSecondScan.numBytesSaved_, afterFirstScan.numBytesSaved_);
+
+  // A new permutation with the same file name never sees the blocks of the
+  // old one.
+  inputs.at(0).col1And2_.resize(50);
+  auto [newBlocks, newMetadata, newReader] =
+      writeAndOpenRelations(inputs, filename, 40_B);
+  EXPECT_EQ(scanAll(newReader, newBlocks).numRows(), 50u);
+}
+
+// Test that the rows of the blocks are filtered by the row filters of the
+// `ScanSpecification` (if there are any).
+TEST(CompressedRelationReader, scanWithRowFilter) {
+  std::vector<RelationInput> inputs{RelationInput{42, {}}};
+  for (int i = 1; i < 100; ++i) {
+    inputs.at(0).col1And2_.push_back({i, i + 1, 0});
+  }
+  std::string filename = "scanWithRowFilter.dat";
+  auto cleanup = makeCleanup(filename);
+  auto [blocks, metadata, reader] =
+      writeAndOpenRelations(inputs, filename, 40_B);
+  ASSERT_GT(blocks.size(), 1u);
+  auto handle = std::make_shared<ad_utility::CancellationHandle<>>();
+
+  // Keep the rows where the first column of the result is a multiple of 3.
+  ScanSpecification spec{V(42), std::nullopt, std::nullopt};
+  auto isMultipleOf = [](uint64_t divisor) {
+    return std::make_shared<const ScanSpecification::RowFilter>(
+        [divisor](std::span<const Id> ids) {
+          std::vector<uint8_t> result;
+          for (Id id : ids) {
+            result.push_back(id.getVocabIndex().get() % divisor == 0);
+          }
+          return result;
+        });
+  };
+  spec.addRowFilter(isMultipleOf(3));
+  std::vector<std::array<int, 2>> expected;
+  for (int i = 3; i < 100; i += 3) {
+    expected.push_back({i, i + 1});
+  }
+
+  auto result = reader->scan(spec, blocks, {}, handle, emptyLocatedTriples);
+  checkThatTablesAreEqual(expected, result);
+
+  IdTable lazyResult{2, ad_utility::makeUnlimitedAllocator<Id>()};
+  auto generator =
+      reader->lazyScan(spec, blocks, {}, handle, emptyLocatedTriples);
+  for (const auto& block : generator) {
+    lazyResult.insertAtEnd(block);
+  }
+  checkThatTablesAreEqual(expected, lazyResult);
+  EXPECT_EQ(generator.details().numElementsYielded_, expected.size());
+  EXPECT_EQ(generator.details().numElementsFilteredOut_,
+            99u - expected.size());
+  EXPECT_EQ(generator.details().numElementsRead_, 99u);
+
+  // Additionally keep only the rows where the second column is even.
+  spec.addRowFilter(isMultipleOf(2), 1);
+  expected.clear();
+  for (int i = 3; i < 100; i += 6) {
+    expected.push_back({i, i + 1});
+  }
+  checkThatTablesAreEqual(
+      expected, reader->scan(spec, blocks, {}, handle, emptyLocatedTriples));
+}
+
+// Test that the writer stores the correct `ColumnSummary`s for each block.
+TEST(CompressedRelationWriter, columnSummaries) {
+  std::vector<RelationInput> inputs{RelationInput{42, {}},
+                                    RelationInput{43, {}}};
+  for (int i = 1; i < 50; ++i) {
+    // The third column is not sorted within the blocks.
+    inputs.at(0).col1And2_.push_back({i, 100 - i, 0});
+    inputs.at(1).col1And2_.push_back({i, (i * 7) % 13, 0});
+  }
+  std::string filename = "columnSummaries.dat";
+  auto cleanup = makeCleanup(filename);
+  auto [blocks, metadata, reader] =
+      writeAndOpenRelations(inputs, filename, 40_B);
+  ASSERT_GT(blocks.size(), 2u);
+
+  // The blocks contain all the rows of the `inputs` in order.
+  std::vector<std::array<Id, 3>> rows;
+  for (const auto& input : inputs) {
+    for (const auto& row : input.col1And2_) {
+      rows.push_back({V(input.col0_), V(row.at(0)), V(row.at(1))});
+    }
+  }
+  size_t numRowsSeen = 0;
+  for (const auto& block : blocks) {
+    std::array<CompressedBlockMetadata::ColumnSummary, 3> expected;
+    for (size_t i = numRowsSeen; i < numRowsSeen + block.numRows_; ++i) {
+      for (size_t col = 0; col < 3; ++col) {
+        expected[col].add(rows.at(i)[col]);
+      }
+    }
+    numRowsSeen += block.numRows_;
+    ASSERT_TRUE(block.columnSummaries_.has_value());
+    EXPECT_EQ(block.columnSummaries_.value(), expected);
+    const auto& col2 = block.columnSummaries_.value()[2];
+    EXPECT_LE(col2.min_, col2.max_);
+    EXPECT_TRUE(col2.containsDatatype(Datatype::VocabIndex));
+    EXPECT_FALSE(col2.containsDatatype(Datatype::Int));
+  }
+  EXPECT_EQ(numRowsSeen, rows.size());
+}
+
+// Test that the Bloom filters on the `col1` of the blocks are used to skip
+// blocks in `getBlocksForJoin` and for point lookups.
+TEST(CompressedRelationReader, bloomFiltersOnCol1) {
+  std::vector<RelationInput> inputs{RelationInput{42, {}}};
+  for (int i = 0; i < 200; ++i) {
+    inputs.at(0).col1And2_.push_back({2 * i, 0});
+  }
+  std::string filename = "bloomFiltersOnCol1.dat";
+  std::string filenameWithFilter = "bloomFiltersOnCol1WithFilter.dat";
+  auto cleanup = makeCleanup(filename);
+  auto cleanupWithFilter = makeCleanup(filenameWithFilter);
+  auto [blocksWithoutFilter, metadata, reader] =
+      writeAndOpenRelations(inputs, filename, 40_B);
+  auto [blocks, metadata2, reader2] =
+      writeAndOpenRelations(inputs, filenameWithFilter, 40_B,
+                            ad_utility::BloomFilterBudget{64, 1_kB});
+  ASSERT_GT(blocks.size(), 10u);
+  EXPECT_TRUE(ql::ranges::all_of(blocks, [](const auto& block) {
+    return block.col1Filter_.has_value();
+  }));
+  EXPECT_TRUE(ql::ranges::none_of(blocksWithoutFilter, [](const auto& block) {
+    return block.col1Filter_.has_value();
+  }));
+
+  // All the even `Id`s are contained in the filters of their blocks.
+  for (const auto& block : blocks) {
+    for (int i = 0; i < 400; i += 2) {
+      auto id = V(i);
+      if (block.firstTriple_.col1Id_ <= id && id <= block.lastTriple_.col1Id_) {
+        EXPECT_TRUE(block.mayContainCol1(id));
+      }
+    }
+  }
+
+  // Join with the odd `Id`s, which lie in the ranges of all the blocks, but
+  // don't occur in the index.
+  std::vector<Id> joinColumn;
+  for (int i = 1; i < 400; i += 2) {
+    joinColumn.push_back(V(i));
+  }
+  using S = CompressedRelationReader::ScanSpecAndBlocksAndBounds;
+  auto getBlocksForJoin = [&joinColumn](const auto& blockMetadata,
+                                        size_t* numSkipped) {
+    S metadataAndBlocks{{{V(42), std::nullopt, std::nullopt}, blockMetadata},
+                        S::FirstAndLastTriple{{V(42), V(0), V(0), g},
+                                              {V(42), V(398), V(0), g}}};
+    return CompressedRelationReader::getBlocksForJoin(
+        joinColumn, metadataAndBlocks, numSkipped);
+  };
+  size_t numSkipped = 0;
+  EXPECT_EQ(getBlocksForJoin(blocksWithoutFilter, &numSkipped).size(),
+            blocksWithoutFilter.size());
+  EXPECT_EQ(numSkipped, 0u);
+  EXPECT_TRUE(getBlocksForJoin(blocks, &numSkipped).empty());
+  EXPECT_EQ(numSkipped, blocks.size());
+
+  // A single matching `Id` keeps its block.
+  joinColumn.push_back(V(100));
+  ql::ranges::sort(joinColumn);
+  auto result = getBlocksForJoin(blocks, nullptr);
+  ASSERT_EQ(result.size(), 1u);
+  EXPECT_LE(result.at(0).firstTriple_.col1Id_, V(100));
+  EXPECT_GE(result.at(0).lastTriple_.col1Id_, V(100));
+
+  // Point lookups for a fixed `col0Id` and `col1Id`.
+  auto getRelevantBlocks = [](int col1, const auto& blockMetadata) {
+    return CompressedRelationReader::getRelevantBlocks(
+               {V(42), V(col1), std::nullopt}, blockMetadata)
+        .size();
+  };
+  EXPECT_EQ(getRelevantBlocks(100, blocks), 1u);
+  EXPECT_EQ(getRelevantBlocks(101, blocks), 0u);
+  EXPECT_EQ(getRelevantBlocks(101, blocksWithoutFilter), 1u);
+}
+
+// Test that the Bloom filters on the `col1` never rule out `Id`s whose bits
+// differ from the ones of an equal `Id` in the block (here: the same string
+// in different `LocalVocab`s), in particular for terms that were inserted by
+// an update.
+TEST(CompressedRelationReader, bloomFiltersOnCol1WithLocalVocab) {
+  // The comparison of `LocalVocabIndex` and `VocabIndex` requires an index.
+  [[maybe_unused]] auto qec = ad_utility::testing::getQec();
+  std::vector<RelationInput> inputs{RelationInput{42, {}}};
+  for (int i = 0; i < 200; ++i) {
+    inputs.at(0).col1And2_.push_back({2 * i, 0});
+  }
+  std::string filename = "bloomFiltersOnCol1WithLocalVocab.dat";
+  auto cleanup = makeCleanup(filename);
+  auto [blocks, metadata, reader] = writeAndOpenRelations(
+      inputs, filename, 40_B, ad_utility::BloomFilterBudget{64, 1_kB});
+  ASSERT_TRUE(ql::ranges::all_of(blocks, [](const auto& block) {
+    return block.col1Filter_.has_value();
+  }));
+
+  // The same term in the `LocalVocab` of the update and in the `LocalVocab`
+  // of a query.
+  auto term = ad_utility::triple_component::LiteralOrIri::literalWithoutQuotes(
+      "termFromAnUpdate");
+  LocalVocab updateVocab;
+  LocalVocab queryVocab;
+  Id updateId = Id::makeFromLocalVocabIndex(
+      updateVocab.getIndexAndAddIfNotContained(term));
+  Id queryId = Id::makeFromLocalVocabIndex(
+      queryVocab.getIndexAndAddIfNotContained(term));
+  ASSERT_EQ(updateId, queryId);
+  ASSERT_NE(updateId.getBits(), queryId.getBits());
+
+  // `LocalVocabIndex` and `InlineString` `Id`s are never ruled out.
+  EXPECT_TRUE(ql::ranges::all_of(blocks, [&queryId](const auto& block) {
+    return block.mayContainCol1(queryId);
+  }));
+
+  auto handle = std::make_shared<ad_utility::CancellationHandle<>>();
+  std::vector<IdTriple<>> inserted{IdTriple<>{{V(42), updateId, V(0), g}}};
+  LocatedTriplesPerBlock locatedTriples;
+  locatedTriples.add(LocatedTriple::locateTriplesInPermutation(
+      inserted, blocks, {0, 1, 2}, true, handle));
+  locatedTriples.setOriginalMetadata(blocks);
+  locatedTriples.updateAugmentedMetadata();
+  const auto& augmentedBlocks = locatedTriples.getAugmentedMetadata();
+  // The block with the inserted triple has lost its filter, the other blocks
+  // keep theirs.
+  EXPECT_EQ(ql::ranges::count_if(augmentedBlocks,
+                                 [](const auto& block) {
+                                   return !block.col1Filter_.has_value();
+                                 }),
+            1);
+
+  // A point scan for the inserted term.
+  ScanSpecification spec{V(42), queryId, std::nullopt};
+  EXPECT_EQ(
+      CompressedRelationReader::getRelevantBlocks(spec, augmentedBlocks).size(),
+      1u);
+  auto result = reader->scan(spec, augmentedBlocks, {}, handle, locatedTriples);
+  EXPECT_THAT(result, matchesIdTableFromVector({{0}}));
+
+  // A join on the `col1` with the term from the `LocalVocab` of the query.
+  std::vector<Id> joinColumn{queryId};
+  using S = CompressedRelationReader::ScanSpecAndBlocksAndBounds;
+  S metadataAndBlocks{
+      {{V(42), std::nullopt, std::nullopt}, augmentedBlocks},
+      S::FirstAndLastTriple{augmentedBlocks.front().firstTriple_,
+                            augmentedBlocks.back().lastTriple_}};
+  size_t numSkipped = 0;
+  auto blocksForJoin = CompressedRelationReader::getBlocksForJoin(
+      joinColumn, metadataAndBlocks, &numSkipped);
+  EXPECT_EQ(numSkipped, 0u);
+  ASSERT_EQ(blocksForJoin.size(), 1u);
+  EXPECT_FALSE(blocksForJoin.at(0).col1Filter_.has_value());
+}
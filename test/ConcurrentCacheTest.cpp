@@ -322,6 +322,7 @@ TEST(ConcurrentCache, cacheStatusToString) {
   using enum ad_utility::CacheStatus;
   EXPECT_EQ(toString(cachedNotPinned), "cached_not_pinned");
   EXPECT_EQ(toString(cachedPinned), "cached_pinned");
+  EXPECT_EQ(toString(cachedInSecondLevel), "cached_in_second_level");
   EXPECT_EQ(toString(computed), "computed");
   EXPECT_EQ(toString(notInCacheAndNotComputed), "not_in_cache_not_computed");
 
@@ -566,3 +567,82 @@ TEST(ConcurrentCache, computeButDontStore) {
       42, []() { return "blubb"; }, true, alwaysSuitable);
   EXPECT_EQ(res._resultPointer, nullptr);
 }
+
+// _____________________________________________________________________________
+TEST(ConcurrentCache, numHitsAndMisses) {
+  SimpleConcurrentLruCache cache{};
+  auto compute = []() { return "42"; };
+  EXPECT_EQ(cache.numHits(), 0u);
+  EXPECT_EQ(cache.numMisses(), 0u);
+
+  cache.computeOnce(42, compute, false, returnTrue);
+  EXPECT_EQ(cache.numHits(), 0u);
+  EXPECT_EQ(cache.numMisses(), 1u);
+
+  cache.computeOncePinned(42, compute, false, returnTrue);
+  cache.computeButDontStore(42, compute, false, returnTrue);
+  EXPECT_EQ(cache.numHits(), 2u);
+  EXPECT_EQ(cache.numMisses(), 1u);
+
+  // Lookups that only read from the cache also count as misses.
+  cache.computeOnce(43, compute, true, returnTrue);
+  cache.computeButDontStore(44, compute, false, returnTrue);
+  EXPECT_EQ(cache.numHits(), 2u);
+  EXPECT_EQ(cache.numMisses(), 3u);
+}
+
+namespace {
+// A `SecondLevelCache` that simply stores the values in a hash map.
+struct HashMapSecondLevelCache
+    : public ad_utility::SecondLevelCache<int, std::string> {
+  ad_utility::HashMap<int, std::shared_ptr<const std::string>> values_;
+
+  void store(const int& key,
+             std::shared_ptr<const std::string> value) override {
+    values_[key] = std::move(value);
+  }
+  std::shared_ptr<std::string> load(const int& key) override {
+    auto it = values_.find(key);
+    return it == values_.end() ? nullptr
+                               : std::make_shared<std::string>(*it->second);
+  }
+};
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(ConcurrentCache, secondLevelCache) {
+  SimpleConcurrentLruCache cache{2ul};
+  auto secondLevel = std::make_shared<HashMapSecondLevelCache>();
+  cache.setSecondLevelCache(secondLevel);
+  auto computeOnce = [&cache](int key, std::string value) {
+    return cache.computeOnce(
+        key, [&value]() { return value; }, false, returnTrue);
+  };
+
+  // The oldest entry is evicted and thus stored in the second level.
+  for (int i = 0; i < 3; ++i) {
+    auto result = computeOnce(i, std::to_string(i));
+    EXPECT_EQ(result._cacheStatus, ad_utility::CacheStatus::computed);
+  }
+  EXPECT_EQ(secondLevel->values_.size(), 1u);
+  EXPECT_THAT(secondLevel->values_.at(0), Pointee("0"s));
+
+  // On a cache miss, the value is read from the second level instead of being
+  // computed.
+  auto result = computeOnce(0, "recomputed");
+  EXPECT_EQ(result._cacheStatus, ad_utility::CacheStatus::cachedInSecondLevel);
+  EXPECT_THAT(result._resultPointer, Pointee("0"s));
+  EXPECT_TRUE(cache.cacheContains(0));
+
+  // Pinned values are stored in the second level right away.
+  cache.computeOncePinned(
+      7, []() { return "7"s; }, false, returnTrue);
+  EXPECT_THAT(secondLevel->values_.at(7), Pointee("7"s));
+
+  // Without a second level, values are computed again.
+  cache.setSecondLevelCache(nullptr);
+  cache.clearAll();
+  result = computeOnce(0, "recomputed");
+  EXPECT_EQ(result._cacheStatus, ad_utility::CacheStatus::computed);
+  EXPECT_THAT(result._resultPointer, Pointee("recomputed"s));
+}
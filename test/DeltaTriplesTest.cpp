@@ -9,6 +9,8 @@
 #include "./DeltaTriplesTestHelpers.h"
 #include "./util/GTestHelpers.h"
 #include "./util/IndexTestHelpers.h"
+#include "./util/RuntimeParametersTestHelpers.h"
+#include "absl/cleanup/cleanup.h"
 #include "absl/strings/str_split.h"
 #include "engine/ExportQueryExecutionTrees.h"
 #include "index/DeltaTriples.h"
@@ -330,6 +332,146 @@ TEST_F(DeltaTriplesTest, rewriteLocalVocabEntriesAndBlankNodes) {
   EXPECT_EQ(s4.getBits(), blank0.getBits());
 }
 
+// _____________________________________________________________________________
+TEST_F(DeltaTriplesTest, writeAheadLog) {
+  auto cancellationHandle =
+      std::make_shared<ad_utility::CancellationHandle<>>();
+  auto& vocab = testQec->getIndex().getVocab();
+  const std::string filename = "DeltaTriplesTest_writeAheadLog.update-triples";
+  ad_utility::deleteFile(filename, false);
+  absl::Cleanup cleanup{[&filename]() { ad_utility::deleteFile(filename); }};
+
+  LocalVocab localVocab;
+  auto triplesWithBlankNode =
+      makeIdTriples(vocab, localVocab, {"<A> <notInVocab> <B>"});
+  triplesWithBlankNode[0].ids_[2] =
+      Id::makeFromBlankNodeIndex(BlankNodeIndex::make(999'888'777));
+  {
+    DeltaTriples deltaTriples(testQec->getIndex());
+    deltaTriples.enableWriteAheadLog(filename, cancellationHandle);
+    deltaTriples.insertTriples(
+        cancellationHandle,
+        makeIdTriples(vocab, localVocab, {"<a> <UPP> <A>", "<b> <UPP> <B>"}));
+    deltaTriples.deleteTriples(
+        cancellationHandle,
+        makeIdTriples(vocab, localVocab, {"<A> <low> <a>", "<b> <UPP> <B>"}));
+    deltaTriples.insertTriples(cancellationHandle, triplesWithBlankNode);
+    EXPECT_THAT(deltaTriples, NumTriples(2, 2, 4));
+  }
+
+  // A new `DeltaTriples` restores all the updates from the log.
+  {
+    DeltaTriples deltaTriples(testQec->getIndex());
+    deltaTriples.enableWriteAheadLog(filename, cancellationHandle);
+    EXPECT_THAT(deltaTriples, NumTriples(2, 2, 4));
+    const auto& locatedSPO =
+        deltaTriples.getLocatedTriplesForPermutation(Permutation::SPO);
+    auto triples = makeIdTriples(vocab, localVocab,
+                                 {"<A> <low> <a>", "<b> <UPP> <B>"});
+    EXPECT_TRUE(locatedSPO.isLocatedTriple(triples.at(0), false));
+    EXPECT_TRUE(locatedSPO.isLocatedTriple(triples.at(1), false));
+
+    // Further updates are appended to the existing log.
+    deltaTriples.insertTriples(
+        cancellationHandle,
+        makeIdTriples(vocab, localVocab, {"<c> <UPP> <C>"}));
+    EXPECT_THAT(deltaTriples, NumTriples(3, 2, 5));
+
+    // A cancelled update is neither applied nor written to the log.
+    auto sizeBeforeCancelledUpdate = std::filesystem::file_size(filename);
+    auto cancelledHandle = std::make_shared<ad_utility::CancellationHandle<>>();
+    cancelledHandle->cancel(ad_utility::CancellationState::MANUAL);
+    EXPECT_THROW(deltaTriples.insertTriples(
+                     cancelledHandle,
+                     makeIdTriples(vocab, localVocab, {"<c> <UPP> <A>"})),
+                 ad_utility::CancellationException);
+    EXPECT_THAT(deltaTriples, NumTriples(3, 2, 5));
+    EXPECT_EQ(std::filesystem::file_size(filename), sizeBeforeCancelledUpdate);
+  }
+
+  // An incompletely written last entry is ignored and removed from the log.
+  auto sizeBefore = std::filesystem::file_size(filename);
+  {
+    ad_utility::File file{filename, "a"};
+    uint64_t numBytesOfIncompleteEntry = 1000;
+    file.write(&numBytesOfIncompleteEntry, sizeof(numBytesOfIncompleteEntry));
+    file.write("abc", 3);
+  }
+  {
+    DeltaTriples deltaTriples(testQec->getIndex());
+    deltaTriples.enableWriteAheadLog(filename, cancellationHandle);
+    EXPECT_EQ(std::filesystem::file_size(filename), sizeBefore);
+    EXPECT_THAT(deltaTriples, NumTriples(3, 2, 5));
+
+    // Clearing the `DeltaTriples` also clears the log.
+    deltaTriples.clear();
+    EXPECT_THAT(deltaTriples, NumTriples(0, 0, 0));
+    deltaTriples.insertTriples(
+        cancellationHandle,
+        makeIdTriples(vocab, localVocab, {"<c> <UPP> <C>"}));
+  }
+  {
+    DeltaTriples deltaTriples(testQec->getIndex());
+    deltaTriples.enableWriteAheadLog(filename, cancellationHandle);
+    EXPECT_THAT(deltaTriples, NumTriples(1, 0, 1));
+    // The log can only be enabled once.
+    EXPECT_ANY_THROW(
+        deltaTriples.enableWriteAheadLog(filename, cancellationHandle));
+  }
+}
+
+// _____________________________________________________________________________
+TEST_F(DeltaTriplesTest, compactWriteAheadLog) {
+  auto cancellationHandle =
+      std::make_shared<ad_utility::CancellationHandle<>>();
+  auto& vocab = testQec->getIndex().getVocab();
+  const std::string filename =
+      "DeltaTriplesTest_compactWriteAheadLog.update-triples";
+  ad_utility::deleteFile(filename, false);
+  absl::Cleanup cleanup{[&filename]() { ad_utility::deleteFile(filename); }};
+  auto compactionCleanup =
+      setRuntimeParameterForTest<"write-ahead-log-min-triples-for-compaction">(
+          10);
+
+  LocalVocab localVocab;
+  auto toggledTriple = makeIdTriples(vocab, localVocab, {"<a> <UPP> <A>"});
+  {
+    DeltaTriples deltaTriples(testQec->getIndex());
+    deltaTriples.enableWriteAheadLog(filename, cancellationHandle);
+    auto sizeOfHeader = std::filesystem::file_size(filename);
+    deltaTriples.insertTriples(
+        cancellationHandle,
+        makeIdTriples(vocab, localVocab, {"<A> <notInVocab> <B>"}));
+    auto sizeOfEntry = std::filesystem::file_size(filename) - sizeOfHeader;
+
+    // Without the compaction, the log would contain 101 entries.
+    for (size_t i = 0; i < 50; ++i) {
+      deltaTriples.insertTriples(cancellationHandle, toggledTriple);
+      deltaTriples.deleteTriples(cancellationHandle, toggledTriple);
+    }
+    EXPECT_THAT(deltaTriples, NumTriples(1, 1, 2));
+    EXPECT_LT(std::filesystem::file_size(filename),
+              sizeOfHeader + 12 * sizeOfEntry);
+    EXPECT_FALSE(std::filesystem::exists(filename + ".compacted"));
+
+    // Updates after a compaction are appended to the compacted log.
+    deltaTriples.insertTriples(
+        cancellationHandle,
+        makeIdTriples(vocab, localVocab, {"<b> <UPP> <B>"}));
+    EXPECT_THAT(deltaTriples, NumTriples(2, 1, 3));
+  }
+
+  // The compacted log restores the same state.
+  {
+    DeltaTriples deltaTriples(testQec->getIndex());
+    deltaTriples.enableWriteAheadLog(filename, cancellationHandle);
+    EXPECT_THAT(deltaTriples, NumTriples(2, 1, 3));
+    const auto& locatedSPO =
+        deltaTriples.getLocatedTriplesForPermutation(Permutation::SPO);
+    EXPECT_TRUE(locatedSPO.isLocatedTriple(toggledTriple.at(0), false));
+  }
+}
+
 // _____________________________________________________________________________
 TEST_F(DeltaTriplesTest, DeltaTriplesManager) {
   // Preparation.
@@ -368,3 +368,59 @@ TEST(Engine, countDistinct) {
                                  ::testing::HasSubstr("must be sorted"));
   }
 }
+
+// _____________________________________________________________________________
+TEST(Engine, radixSort) {
+  using enum Engine::RadixKey;
+  auto I = ad_utility::testing::IntId;
+  auto V = ad_utility::testing::VocabId;
+  auto U = Id::makeUndefined();
+
+  auto table = makeIdTableFromVector(
+      {{V(3), I(5), V(1)},
+       {V(1), I(-2), V(2)},
+       {V(3), U, V(3)},
+       {V(1), I(7), V(4)},
+       {V(3), I(-300), V(5)},
+       {V(1), I(-2), V(6)}});
+  auto sorted = table.clone();
+  Engine::radixSort(sorted, {{0}, {1, SignedInt}});
+  EXPECT_EQ(sorted, makeIdTableFromVector({{V(1), I(-2), V(2)},
+                                           {V(1), I(-2), V(6)},
+                                           {V(1), I(7), V(4)},
+                                           {V(3), U, V(3)},
+                                           {V(3), I(-300), V(5)},
+                                           {V(3), I(5), V(1)}}));
+
+  sorted = table.clone();
+  Engine::radixSort(sorted, {{1, SignedInt, true}, {2, Bits, true}});
+  EXPECT_EQ(sorted, makeIdTableFromVector({{V(3), U, V(3)},
+                                           {V(1), I(7), V(4)},
+                                           {V(3), I(5), V(1)},
+                                           {V(1), I(-2), V(6)},
+                                           {V(1), I(-2), V(2)},
+                                           {V(3), I(-300), V(5)}}));
+
+  // Sorting by `Bits` yields the same order as sorting by the IDs.
+  ad_utility::SlowRandomIntGenerator<uint64_t> random{0, 1'000'000'000};
+  IdTable large{3, ad_utility::testing::makeAllocator()};
+  for (size_t i = 0; i < Engine::RADIX_SORT_MIN_NUM_ROWS + 17; ++i) {
+    int64_t value = static_cast<int64_t>(random()) - 500'000'000;
+    large.push_back({V(random() % 100), I(value), V(random())});
+  }
+  auto expected = large.clone();
+  auto key = [](const auto& row) {
+    return std::array<Id, 3>{row[2], row[0], row[1]};
+  };
+  Engine::sort<3>(&expected, [&key](const auto& a, const auto& b) {
+    return key(a) < key(b);
+  });
+  auto actual = large.clone();
+  Engine::radixSort(actual, {{2}, {0}, {1}});
+  EXPECT_EQ(actual, expected);
+
+  // `Engine::sort` uses the radix sort for large inputs.
+  actual = large.clone();
+  Engine::sort(actual, {2, 0, 1});
+  EXPECT_EQ(actual, expected);
+}
@@ -51,6 +51,20 @@ TEST(File, move) {
   ASSERT_EQ(0u, fileRead3.read(s.data(), 9));
   ad_utility::deleteFile(filename);
 }
+
+TEST(File, sync) {
+  std::string filename = "testFileSync.tmp";
+  File file(filename, "w");
+  file.write("abc", 3);
+  // After `sync`, the data is visible without closing the file.
+  file.sync();
+  File fileRead(filename, "r");
+  std::string s(3, ' ');
+  ASSERT_EQ(fileRead.read(s.data(), 3), 3u);
+  ASSERT_EQ(s, "abc");
+  file.close();
+  ad_utility::deleteFile(filename);
+}
 }  // namespace ad_utility
 
 TEST(File, makeFilestream) {
@@ -13,6 +13,7 @@
 #include "engine/sparqlExpressions/SparqlExpression.h"
 #include "util/IdTableHelpers.h"
 #include "util/IndexTestHelpers.h"
+#include "util/RuntimeParametersTestHelpers.h"
 
 using ::testing::ElementsAre;
 using ::testing::Eq;
@@ -184,8 +185,18 @@ TEST(Filter, verifySetPrefilterExpressionVariablePairForIndexScanChild) {
       {makeSparqlExpression::Iri::fromIriref("<a>"), "<p>", Variable{"?z"}},
       eqSprql(Variable{"?z"}, DoubleId(22.5)), eq(DoubleId(22.5)), 2, true);
 
-  // We expect that no <PrefilterExpression, Variable> pair is assigned
-  // (no prefilter procedure applicable) with Filter construction.
+  // For a Variable that doesn't correspond to the first sorted column, the
+  // pair is assigned for its column (only the column summaries of the blocks
+  // are used for the prefiltering).
+  checkSetPrefilterExpressionVariablePair(
+      qec, Permutation::PSO, {Variable{"?x"}, "<p>", Variable{"?z"}},
+      eqSprql(Variable{"?z"}, DoubleId(22.5)), eq(DoubleId(22.5)), 2, true);
+  checkSetPrefilterExpressionVariablePair(
+      qec, Permutation::POS, {Variable{"?x"}, "<p>", Variable{"?z"}},
+      gtSprql(Variable{"?x"}, VocabId(10)), gt(VocabId(10)), 2, true);
+
+  // We expect that no <PrefilterExpression, Variable> pair is assigned for
+  // the first sorted column with Filter construction.
   checkSetPrefilterExpressionVariablePair(
       qec, Permutation::PSO, {Variable{"?x"}, "<p>", Variable{"?z"}},
       eqSprql(Variable{"?z"}, DoubleId(22.5)), eq(DoubleId(22.5)), 1, false);
@@ -223,3 +234,47 @@ TEST(Filter, lazyChildMaterializedResultBinaryFilter) {
   EXPECT_EQ(result->idTable(),
             makeIdTableFromVector({{5}, {6}, {7}, {8}, {8}}, I));
 }
+
+// _____________________________________________________________________________
+TEST(Filter, evaluationInChunks) {
+  using namespace makeSparqlExpression;
+  QueryExecutionContext* qec = ad_utility::testing::getQec();
+  auto I = ad_utility::testing::IntId;
+  auto varX = Variable{"?x"};
+  auto varY = Variable{"?y"};
+  // The input is sorted by `?x`, s.t. `?x < 5` is evaluated via binary search
+  // (with a `SetOfIntervals` as the result), and `?y` is evaluated row by row.
+  IdTable input = makeIdTableFromVector(
+      {{1, 0}, {2, 1}, {3, 0}, {4, 1}, {5, 1}, {6, 0}, {7, 1}, {8, 1}}, I);
+
+  auto computeFilter = [&](auto expression) {
+    qec->getQueryTreeCache().clearAll();
+    ValuesForTesting values{
+        qec,          input.clone(), {varX, varY}, false, {0},
+        LocalVocab{}, std::nullopt,  true};
+    QueryExecutionTree subTree{
+        qec, std::make_shared<ValuesForTesting>(std::move(values))};
+    Filter filter{qec, std::make_shared<QueryExecutionTree>(std::move(subTree)),
+                  {std::move(expression), "filter"}};
+    auto result = filter.getResult(false, ComputationMode::FULLY_MATERIALIZED);
+    return result->idTable().clone();
+  };
+
+  for (size_t chunkSize : {0, 1, 3, 8, 1024}) {
+    auto cleanup =
+        setRuntimeParameterForTest<"expression-evaluation-chunk-size">(
+            chunkSize);
+    auto y = [&varY]() {
+      return std::make_unique<sparqlExpression::VariableExpression>(varY);
+    };
+    EXPECT_EQ(computeFilter(notSprqlExpr(ltSprql(varX, I(5)))),
+              makeIdTableFromVector({{5, 1}, {6, 0}, {7, 1}, {8, 1}}, I))
+        << chunkSize;
+    EXPECT_EQ(computeFilter(y()), makeIdTableFromVector(
+                               {{2, 1}, {4, 1}, {5, 1}, {7, 1}, {8, 1}}, I))
+        << chunkSize;
+    EXPECT_EQ(computeFilter(andSprqlExpr(ltSprql(varX, I(5)), y())),
+              makeIdTableFromVector({{2, 1}, {4, 1}}, I))
+        << chunkSize;
+  }
+}
@@ -10,6 +10,7 @@
 
 #include "./util/GTestHelpers.h"
 #include "./util/IdTableHelpers.h"
+#include "./util/RuntimeParametersTestHelpers.h"
 #include "./util/TripleComponentTestHelpers.h"
 #include "engine/GroupBy.h"
 #include "engine/IndexScan.h"
@@ -30,6 +31,7 @@
 #include "index/ConstantsIndexBuilding.h"
 #include "parser/SparqlParser.h"
 #include "util/IndexTestHelpers.h"
+#include "util/Random.h"
 
 using namespace ad_utility::testing;
 using ::testing::Eq;
@@ -793,6 +795,202 @@ TEST_F(GroupByOptimizations, hashMapOptimizationLazyAndMaterializedInputs) {
   RuntimeParameters().set<"group-by-hash-map-enabled">(false);
 }
 
+// _____________________________________________________________________________
+TEST_F(GroupByOptimizations, hashMapOptimizationPartitionedAndSpilled) {
+  /* Setup query:
+  SELECT ?x (COUNT(?y) as ?count) (SUM(?y) as ?sum) (AVG(?y) as ?avg)
+            (MIN(?y) as ?min) (MAX(?y) as ?max)
+            (GROUP_CONCAT(?y) as ?concat) (SUM(?y + ?x) + ?x as ?nested)
+            WHERE {
+    # explicitly defined subresult.
+  } GROUP BY ?x
+ */
+  ad_utility::SlowRandomIntGenerator<int64_t> randomX{0, 300};
+  ad_utility::SlowRandomIntGenerator<int64_t> randomY{-1000, 1000};
+  std::vector<IdTable> tables;
+  for (size_t i = 0; i < 10; ++i) {
+    IdTable table{2, makeAllocator()};
+    for (size_t j = 0; j < 200; ++j) {
+      table.push_back({I(randomX()), I(randomY())});
+    }
+    tables.push_back(std::move(table));
+  }
+
+  auto nested = makeAddExpression(
+      std::make_unique<SumExpression>(
+          false, makeAddExpression(makeVariableExpression(varY),
+                                   makeVariableExpression(varX))),
+      makeVariableExpression(varX));
+  std::vector<Alias> aliases{
+      Alias{makeCountPimpl(varY), Variable{"?count"}},
+      Alias{makeSumPimpl(varY), Variable{"?sum"}},
+      Alias{makeAvgPimpl(varY), Variable{"?avg"}},
+      Alias{makeMinPimpl(varY), Variable{"?min"}},
+      Alias{makeMaxPimpl(varY), Variable{"?max"}},
+      Alias{makeGroupConcatPimpl(varY), Variable{"?concat"}},
+      Alias{SparqlExpressionPimpl{std::move(nested), "SUM(?y + ?x) + ?x"},
+            Variable{"?nested"}}};
+
+  // Compute the GROUP BY on lazy `tables` and return the result, and the
+  // number of spilled partitions and of the rounds in which the spilled rows
+  // were aggregated if the hash map optimization was used.
+  auto computeGroupBy = [&]() {
+    std::vector<IdTable> clones;
+    for (const auto& table : tables) {
+      clones.push_back(table.clone());
+    }
+    qec->getQueryTreeCache().clearAll();
+    auto subtree = ad_utility::makeExecutionTree<ValuesForTesting>(
+        qec, std::move(clones),
+        std::vector<std::optional<Variable>>{varX, varY});
+    GroupBy groupBy{qec, variablesOnlyX, aliases, std::move(subtree)};
+    auto result = groupBy.computeResultOnlyForTesting();
+    const auto& details = groupBy.runtimeInfo().details_;
+    auto getDetail = [&details](const std::string& key) {
+      return details.contains(key) ? details[key].get<size_t>() : 0;
+    };
+    return std::tuple{result.idTable().clone(),
+                      getDetail("numSpilledPartitions"),
+                      getDetail("numSpillRounds")};
+  };
+
+  auto [expected, numSpilledWithoutHashMap, numRoundsWithoutHashMap] =
+      computeGroupBy();
+  EXPECT_EQ(numSpilledWithoutHashMap, 0u);
+
+  auto cleanupHashMap =
+      setRuntimeParameterForTest<"group-by-hash-map-enabled">(true);
+  for (size_t numPartitions : {1, 4}) {
+    auto cleanupPartitions =
+        setRuntimeParameterForTest<"group-by-hash-map-num-partitions">(
+            numPartitions);
+    {
+      auto [result, numSpilledPartitions, numSpillRounds] = computeGroupBy();
+      EXPECT_EQ(result, expected);
+      EXPECT_EQ(numSpilledPartitions, 0u);
+    }
+    // With a tiny memory budget, every partition is spilled after the first
+    // block.
+    auto cleanupThreshold =
+        setRuntimeParameterForTest<"group-by-hash-map-memory-threshold">(
+            ad_utility::MemorySize::bytes(1));
+    auto [result, numSpilledPartitions, numSpillRounds] = computeGroupBy();
+    EXPECT_EQ(result, expected);
+    EXPECT_EQ(numSpilledPartitions, numPartitions);
+    EXPECT_GE(numSpillRounds, numPartitions);
+  }
+}
+
+// _____________________________________________________________________________
+TEST_F(GroupByOptimizations, hashMapOptimizationSpillsRepeatedly) {
+  // `SELECT ?x (COUNT(?y) as ?count) WHERE { ... } GROUP BY ?x` on 200'000
+  // rows with distinct values for `?x`. The spilled rows are written in
+  // several blocks, and with a tiny memory budget, each round of aggregating
+  // the spilled rows only aggregates the groups of the first block and spills
+  // the other rows again.
+  std::vector<IdTable> tables;
+  for (int64_t i = 0; i < 4; ++i) {
+    IdTable table{2, makeAllocator()};
+    for (int64_t j = 0; j < 50'000; ++j) {
+      table.push_back({I(i * 50'000 + j), I(j)});
+    }
+    tables.push_back(std::move(table));
+  }
+  std::vector<Alias> aliases{Alias{makeCountPimpl(varY), Variable{"?count"}}};
+  auto computeGroupBy = [&]() {
+    std::vector<IdTable> clones;
+    for (const auto& table : tables) {
+      clones.push_back(table.clone());
+    }
+    qec->getQueryTreeCache().clearAll();
+    auto subtree = ad_utility::makeExecutionTree<ValuesForTesting>(
+        qec, std::move(clones),
+        std::vector<std::optional<Variable>>{varX, varY});
+    GroupBy groupBy{qec, variablesOnlyX, aliases, std::move(subtree)};
+    auto result = groupBy.computeResultOnlyForTesting();
+    auto& details = groupBy.runtimeInfo().details_;
+    size_t numSpillRounds = details.contains("numSpillRounds")
+                                ? details["numSpillRounds"].get<size_t>()
+                                : 0;
+    return std::pair{result.idTable().clone(), numSpillRounds};
+  };
+  auto [expected, numRoundsWithoutHashMap] = computeGroupBy();
+  EXPECT_EQ(expected.numRows(), 200'000u);
+
+  auto cleanupHashMap =
+      setRuntimeParameterForTest<"group-by-hash-map-enabled">(true);
+  auto cleanupPartitions =
+      setRuntimeParameterForTest<"group-by-hash-map-num-partitions">(1);
+  auto cleanupThreshold =
+      setRuntimeParameterForTest<"group-by-hash-map-memory-threshold">(
+          ad_utility::MemorySize::bytes(1));
+  auto [result, numSpillRounds] = computeGroupBy();
+  EXPECT_EQ(result, expected);
+  EXPECT_GT(numSpillRounds, 1u);
+}
+
+// _____________________________________________________________________________
+TEST_F(GroupByOptimizations, hashMapOptimizationCountsGroupConcatStrings) {
+  // `SELECT ?x (COUNT(?y) as ?count) [(GROUP_CONCAT(?y) as ?concat)] WHERE {
+  // ... } GROUP BY ?x` on two blocks with the same 100 groups. The hash map
+  // and the counts need far less memory than the budget, but the strings of
+  // the `GROUP_CONCAT` (which reserve memory for long results) exceed it, so
+  // the partition is spilled after the first block only with `GROUP_CONCAT`.
+  std::vector<IdTable> tables;
+  for (size_t i = 0; i < 2; ++i) {
+    IdTable table{2, makeAllocator()};
+    for (int64_t j = 0; j < 100; ++j) {
+      table.push_back({I(j), I(j + 1000)});
+    }
+    tables.push_back(std::move(table));
+  }
+  auto computeGroupBy = [&](std::vector<Alias> aliases) {
+    std::vector<IdTable> clones;
+    for (const auto& table : tables) {
+      clones.push_back(table.clone());
+    }
+    qec->getQueryTreeCache().clearAll();
+    auto subtree = ad_utility::makeExecutionTree<ValuesForTesting>(
+        qec, std::move(clones),
+        std::vector<std::optional<Variable>>{varX, varY});
+    GroupBy groupBy{qec, variablesOnlyX, std::move(aliases),
+                    std::move(subtree)};
+    auto result = groupBy.computeResultOnlyForTesting();
+    auto& details = groupBy.runtimeInfo().details_;
+    size_t numSpilledPartitions =
+        details.contains("numSpilledPartitions")
+            ? details["numSpilledPartitions"].get<size_t>()
+            : 0;
+    return std::pair{result.idTable().clone(), numSpilledPartitions};
+  };
+  auto makeAliases = [](bool withGroupConcat) {
+    std::vector<Alias> aliases{Alias{makeCountPimpl(varY), Variable{"?count"}}};
+    if (withGroupConcat) {
+      aliases.push_back(
+          Alias{makeGroupConcatPimpl(varY), Variable{"?concat"}});
+    }
+    return aliases;
+  };
+  auto expectedCount = computeGroupBy(makeAliases(false)).first;
+  auto expectedConcat = computeGroupBy(makeAliases(true)).first;
+
+  auto cleanupHashMap =
+      setRuntimeParameterForTest<"group-by-hash-map-enabled">(true);
+  auto cleanupPartitions =
+      setRuntimeParameterForTest<"group-by-hash-map-num-partitions">(1);
+  auto cleanupThreshold =
+      setRuntimeParameterForTest<"group-by-hash-map-memory-threshold">(
+          ad_utility::MemorySize::megabytes(1));
+  {
+    auto [result, numSpilledPartitions] = computeGroupBy(makeAliases(false));
+    EXPECT_EQ(result, expectedCount);
+    EXPECT_EQ(numSpilledPartitions, 0u);
+  }
+  auto [result, numSpilledPartitions] = computeGroupBy(makeAliases(true));
+  EXPECT_EQ(result, expectedConcat);
+  EXPECT_EQ(numSpilledPartitions, 1u);
+}
+
 // _____________________________________________________________________________
 TEST_F(GroupByOptimizations, correctResultForHashMapOptimizationForCountStar) {
   /* Setup query:
@@ -1338,19 +1536,18 @@ TEST_F(GroupByOptimizations, hashMapOptimizationGroupConcatIndex) {
   const auto& table = result->idTable();
 
   auto getId = makeGetId(qec->getIndex());
-  auto getLocalVocabId = [&result](const std::string& word) {
+  // Note: The results are short enough to be stored as an `InlineString`.
+  auto getInlineStringId = [&result](const std::string& word) {
     auto lit =
         ad_utility::triple_component::LiteralOrIri::literalWithoutQuotes(word);
-    auto value = result->localVocab().getIndexOrNullopt(lit);
-    if (value.has_value())
-      return ValueId::makeFromLocalVocabIndex(value.value());
-    else
-      AD_THROW("");
+    EXPECT_FALSE(result->localVocab().getIndexOrNullopt(lit).has_value());
+    return ValueId::makeFromInlineString(
+        InlineString::make(lit.toStringRepresentation()).value());
   };
 
   auto expected = makeIdTableFromVector(
-      {{getId("<x>"), getLocalVocabId("A B C"), getLocalVocabId("A,B,C")},
-       {getId("<y>"), getLocalVocabId("f g h"), getLocalVocabId("f,g,h")}});
+      {{getId("<x>"), getInlineStringId("A B C"), getInlineStringId("A,B,C")},
+       {getId("<y>"), getInlineStringId("f g h"), getInlineStringId("f,g,h")}});
   EXPECT_EQ(table, expected);
 
   RuntimeParameters().set<"group-by-hash-map-enabled">(false);
@@ -1387,19 +1584,18 @@ TEST_F(GroupByOptimizations, hashMapOptimizationGroupConcatLocalVocab) {
 
   auto getId = makeGetId(qec->getIndex());
   auto d = DoubleId;
-  auto getLocalVocabId = [&result](const std::string& word) {
+  // Note: The results are short enough to be stored as an `InlineString`.
+  auto getInlineStringId = [&result](const std::string& word) {
     auto lit =
         ad_utility::triple_component::LiteralOrIri::literalWithoutQuotes(word);
-    auto value = result->localVocab().getIndexOrNullopt(lit);
-    if (value.has_value())
-      return ValueId::makeFromLocalVocabIndex(value.value());
-    else
-      AD_THROW("");
+    EXPECT_FALSE(result->localVocab().getIndexOrNullopt(lit).has_value());
+    return ValueId::makeFromInlineString(
+        InlineString::make(lit.toStringRepresentation()).value());
   };
 
   auto expected = makeIdTableFromVector(
-      {{d(1), getLocalVocabId("B A C"), getLocalVocabId("B,A,C")},
-       {d(3), getLocalVocabId("g h f"), getLocalVocabId("g,h,f")}});
+      {{d(1), getInlineStringId("B A C"), getInlineStringId("B,A,C")},
+       {d(3), getInlineStringId("g h f"), getInlineStringId("g,h,f")}});
   EXPECT_EQ(table, expected);
 
   RuntimeParameters().set<"group-by-hash-map-enabled">(false);
@@ -2226,8 +2422,10 @@ TEST_P(GroupByLazyFixture, groupsOfSize1AreAggregatedCorrectly) {
 
 // _____________________________________________________________________________
 TEST_P(GroupByLazyFixture, nestedAggregateFunctionsWork) {
-  // Test queries of the class `SELECT (CONCAT(SUM(?x), "---") as ?result) ...`
-  // where the aggregate function is not on top of the expression tree.
+  // Test queries of the class
+  // `SELECT (CONCAT(SUM(?x), "--------") as ?result) ...` where the aggregate
+  // function is not on top of the expression tree. The results are long
+  // enough to not be stored as an `InlineString`.
   using L = TripleComponent::Literal;
   std::vector<IdTable> idTables;
   idTables.push_back(makeIntTable({{1, 0}}));
@@ -2239,9 +2437,9 @@ TEST_P(GroupByLazyFixture, nestedAggregateFunctionsWork) {
   std::vector<std::unique_ptr<SparqlExpression>> children;
   children.push_back(makeSum("?x"));
   children.push_back(std::make_unique<StringLiteralExpression>(
-      L::fromStringRepresentation("\"---\"")));
+      L::fromStringRepresentation("\"--------\"")));
   Alias alias{SparqlExpressionPimpl{makeConcatExpression(std::move(children)),
-                                    "CONCAT(SUM(?x), \"---\")"},
+                                    "CONCAT(SUM(?x), \"--------\")"},
               V{"?result"}};
   GroupBy groupBy{qec_, {V{"?y"}}, {std::move(alias)}, std::move(subtree)};
   // From here the code is similar to `expectReturningIdTables`, but checks the
@@ -2268,15 +2466,15 @@ TEST_P(GroupByLazyFixture, nestedAggregateFunctionsWork) {
     auto iterator = generator.begin();
     ASSERT_NE(iterator, generator.end());
     EXPECT_EQ(iterator->localVocab_.size(), 2);
-    auto entry1 = makeEntry("\"1---\"", iterator->localVocab_);
-    auto entry2 = makeEntry("\"6---\"", iterator->localVocab_);
+    auto entry1 = makeEntry("\"1--------\"", iterator->localVocab_);
+    auto entry2 = makeEntry("\"6--------\"", iterator->localVocab_);
     EXPECT_EQ(iterator->idTable_,
               makeIdTableFromVector(
                   {{i(0), entryToId(entry1)}, {i(1), entryToId(entry2)}}));
     ++iterator;
     ASSERT_NE(iterator, generator.end());
     EXPECT_EQ(iterator->localVocab_.size(), 1);
-    auto entry3 = makeEntry("\"8---\"", iterator->localVocab_);
+    auto entry3 = makeEntry("\"8--------\"", iterator->localVocab_);
     EXPECT_EQ(iterator->idTable_,
               makeIdTableFromVector({{i(2), entryToId(entry3)}}));
 
@@ -2284,9 +2482,9 @@ TEST_P(GroupByLazyFixture, nestedAggregateFunctionsWork) {
 
   } else {
     EXPECT_EQ(result.localVocab().size(), 3);
-    auto entry1 = makeEntry("\"1---\"", result.localVocab());
-    auto entry2 = makeEntry("\"6---\"", result.localVocab());
-    auto entry3 = makeEntry("\"8---\"", result.localVocab());
+    auto entry1 = makeEntry("\"1--------\"", result.localVocab());
+    auto entry2 = makeEntry("\"6--------\"", result.localVocab());
+    auto entry3 = makeEntry("\"8--------\"", result.localVocab());
 
     ASSERT_TRUE(entry1.has_value());
     ASSERT_TRUE(entry2.has_value());
@@ -0,0 +1,234 @@
+//  Copyright 2025, University of Freiburg,
+//                  Chair of Algorithms and Data Structures.
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "./util/IdTableHelpers.h"
+#include "./util/IdTestHelpers.h"
+#include "./util/RuntimeParametersTestHelpers.h"
+#include "engine/HashJoin.h"
+#include "engine/LocalVocab.h"
+#include "engine/Join.h"
+#include "engine/ValuesForTesting.h"
+#include "util/IndexTestHelpers.h"
+#include "util/Random.h"
+
+namespace {
+auto I = ad_utility::testing::IntId;
+using Vars = std::vector<std::optional<Variable>>;
+
+// The rows of the `table` in sorted order, s.t. the results of a `HashJoin`
+// can be compared independently of their order.
+std::vector<std::vector<Id>> getSortedRows(const IdTable& table) {
+  std::vector<std::vector<Id>> rows;
+  for (const auto& row : table) {
+    rows.emplace_back(row.begin(), row.end());
+  }
+  ql::ranges::sort(rows);
+  return rows;
+}
+
+std::shared_ptr<QueryExecutionTree> makeValuesTree(QueryExecutionContext* qec,
+                                                   IdTable table, Vars vars) {
+  return ad_utility::makeExecutionTree<ValuesForTesting>(
+      qec, std::move(table), std::move(vars));
+}
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(HashJoin, smallExample) {
+  auto qec = ad_utility::testing::getQec();
+  qec->getQueryTreeCache().clearAll();
+  auto left = makeValuesTree(
+      qec, makeIdTableFromVector({{3, 10}, {1, 11}, {2, 12}, {3, 13}}, I),
+      Vars{Variable{"?x"}, Variable{"?a"}});
+  auto right = makeValuesTree(
+      qec, makeIdTableFromVector({{20, 3}, {21, 1}, {22, 5}, {23, 3}}, I),
+      Vars{Variable{"?b"}, Variable{"?x"}});
+  // The order of the children is deterministic.
+  HashJoin hashJoin{qec, left, right, 0, 1};
+  HashJoin hashJoinSwapped{qec, right, left, 1, 0};
+  EXPECT_EQ(hashJoin.getCacheKey(), hashJoinSwapped.getCacheKey());
+  EXPECT_EQ(hashJoin.getDescriptor(), "HashJoin on ?x");
+  EXPECT_EQ(hashJoin.getResultWidth(), 3);
+  EXPECT_TRUE(hashJoin.resultSortedOn().empty());
+
+  auto result = hashJoin.getResult();
+  // The expected column order depends on the order of the children.
+  bool leftIsFirst =
+      hashJoin.getChildren().at(0)->getCacheKey() == left->getCacheKey();
+  IdTable expected = leftIsFirst ? makeIdTableFromVector({{3, 10, 20},
+                                                          {3, 10, 23},
+                                                          {1, 11, 21},
+                                                          {3, 13, 20},
+                                                          {3, 13, 23}},
+                                                         I)
+                                 : makeIdTableFromVector({{20, 3, 10},
+                                                          {20, 3, 13},
+                                                          {21, 1, 11},
+                                                          {23, 3, 10},
+                                                          {23, 3, 13}},
+                                                         I);
+  EXPECT_EQ(getSortedRows(result->idTable()), getSortedRows(expected));
+
+  const auto& details = hashJoin.runtimeInfo().details_;
+  EXPECT_EQ(details["numBuildRows"], 4);
+  EXPECT_EQ(details["numProbeRows"], 4);
+  EXPECT_TRUE(details.contains("numPartitions"));
+}
+
+// _____________________________________________________________________________
+TEST(HashJoin, randomInputs) {
+  ad_utility::SlowRandomIntGenerator<int64_t> randomValue{0, 200};
+  auto makeTable = [&randomValue](size_t numRows) {
+    IdTable table{2, ad_utility::testing::makeAllocator()};
+    for (size_t i = 0; i < numRows; ++i) {
+      table.push_back({I(randomValue()), I(randomValue())});
+    }
+    return table;
+  };
+  IdTable leftTable = makeTable(1000);
+  IdTable rightTable = makeTable(300);
+
+  auto qec = ad_utility::testing::getQec();
+  qec->getQueryTreeCache().clearAll();
+  auto left = makeValuesTree(qec, leftTable.clone(),
+                             Vars{Variable{"?x"}, Variable{"?a"}});
+  auto right = makeValuesTree(qec, rightTable.clone(),
+                              Vars{Variable{"?b"}, Variable{"?x"}});
+  Join join{qec, left, right, 0, 1};
+  HashJoin hashJoin{qec, left, right, 0, 1};
+  // Both operations have the same size estimate.
+  EXPECT_EQ(join.getSizeEstimate(), hashJoin.getSizeEstimate());
+
+  // The expected result, computed by a nested loop join in the column order of
+  // the `hashJoin`, which might have swapped its children.
+  bool leftIsFirst =
+      hashJoin.getChildren().at(0)->getCacheKey() == left->getCacheKey();
+  const IdTable& hashJoinLeft = leftIsFirst ? leftTable : rightTable;
+  const IdTable& hashJoinRight = leftIsFirst ? rightTable : leftTable;
+  ColumnIndex leftJoinColumn = leftIsFirst ? 0 : 1;
+  ColumnIndex rightJoinColumn = 1 - leftJoinColumn;
+  std::vector<std::vector<Id>> expected;
+  for (const auto& leftRow : hashJoinLeft) {
+    for (const auto& rightRow : hashJoinRight) {
+      if (leftRow[leftJoinColumn] == rightRow[rightJoinColumn]) {
+        expected.push_back(
+            {leftRow[0], leftRow[1], rightRow[1 - rightJoinColumn]});
+      }
+    }
+  }
+  ql::ranges::sort(expected);
+  ASSERT_FALSE(expected.empty());
+  EXPECT_EQ(join.getResult()->idTable().size(), expected.size());
+
+  // The result doesn't depend on the number of partitions and threads.
+  for (size_t numRadixBits : {0, 1, 4, 10}) {
+    for (size_t numThreads : {1, 4}) {
+      IdTable result{3, ad_utility::testing::makeAllocator()};
+      hashJoin.join(hashJoinLeft, leftJoinColumn, hashJoinRight,
+                    rightJoinColumn, numRadixBits, numThreads, result);
+      EXPECT_EQ(getSortedRows(result), expected)
+          << numRadixBits << ' ' << numThreads;
+    }
+  }
+
+  // The same via the runtime parameter.
+  auto cleanup = setRuntimeParameterForTest<"hash-join-num-radix-bits">(3);
+  qec->getQueryTreeCache().clearAll();
+  EXPECT_EQ(getSortedRows(hashJoin.getResult()->idTable()), expected);
+  EXPECT_EQ(hashJoin.runtimeInfo().details_["numPartitions"], 8);
+}
+
+// _____________________________________________________________________________
+TEST(HashJoin, randomInputsWithLocalVocabAndInlineStrings) {
+  auto qec = ad_utility::testing::getQec();
+  auto getId = ad_utility::testing::makeGetId(qec->getIndex());
+  auto inlineId = [](std::string_view word) {
+    return Id::makeFromInlineString(InlineString::make(word).value());
+  };
+  // Each input has its own `LocalVocab` (like the results of two different
+  // operations), so the same word has different bits in the two inputs.
+  using ad_utility::triple_component::LiteralOrIri;
+  LocalVocab leftVocab;
+  LocalVocab rightVocab;
+  auto localVocabId = [](LocalVocab& vocab, const std::string& word) {
+    return Id::makeFromLocalVocabIndex(
+        vocab.getIndexAndAddIfNotContained(LiteralOrIri::iriref(word)));
+  };
+  // The values of the join columns. Values in the same inner vector are
+  // equal, but have different bits (or are the same `Id`).
+  std::vector<std::vector<Id>> leftValues{
+      {I(1)},
+      {getId("<x>"), inlineId("<x>")},
+      {localVocabId(leftVocab, "<new1>"), inlineId("<new1>")},
+      {localVocabId(leftVocab, "<newWord2>")}};
+  std::vector<std::vector<Id>> rightValues{
+      {I(1)},
+      {getId("<x>"), inlineId("<x>")},
+      {localVocabId(rightVocab, "<new1>"), inlineId("<new1>")},
+      {localVocabId(rightVocab, "<newWord2>")}};
+  ASSERT_EQ(leftValues.at(2).at(0), rightValues.at(2).at(0));
+  ASSERT_NE(leftValues.at(2).at(0).getBits(),
+            rightValues.at(2).at(0).getBits());
+  ASSERT_EQ(leftValues.at(1).at(0), leftValues.at(1).at(1));
+
+  ad_utility::SlowRandomIntGenerator<size_t> randomIndex{0, 1000};
+  auto makeTable = [&randomIndex](const auto& values, size_t numRows) {
+    IdTable table{2, ad_utility::testing::makeAllocator()};
+    for (size_t i = 0; i < numRows; ++i) {
+      const auto& equalValues = values.at(randomIndex() % values.size());
+      table.push_back({equalValues.at(randomIndex() % equalValues.size()),
+                       I(static_cast<int64_t>(i))});
+    }
+    return table;
+  };
+  IdTable left = makeTable(leftValues, 200);
+  IdTable right = makeTable(rightValues, 100);
+
+  // The expected result, computed by a nested loop join.
+  std::vector<std::vector<Id>> expected;
+  for (const auto& leftRow : left) {
+    for (const auto& rightRow : right) {
+      if (leftRow[0] == rightRow[0]) {
+        expected.push_back({leftRow[0], leftRow[1], rightRow[1]});
+      }
+    }
+  }
+  ql::ranges::sort(expected);
+  ASSERT_FALSE(expected.empty());
+
+  Vars vars{Variable{"?x"}, std::nullopt};
+  HashJoin hashJoin{qec, makeValuesTree(qec, left.clone(), vars),
+                    makeValuesTree(qec, right.clone(), vars), 0, 0};
+  for (size_t numRadixBits : {0, 1, 4}) {
+    IdTable result{3, ad_utility::testing::makeAllocator()};
+    hashJoin.join(left, 0, right, 0, numRadixBits, 2, result);
+    EXPECT_EQ(getSortedRows(result), expected) << numRadixBits;
+  }
+  EXPECT_EQ(hashJoin.runtimeInfo().details_["canonicalizedJoinColumns"], true);
+}
+
+// _____________________________________________________________________________
+TEST(HashJoin, costEstimateAndUndefValues) {
+  auto qec = ad_utility::testing::getQec();
+  auto left = makeValuesTree(qec, makeIdTableFromVector({{1}, {2}}, I),
+                             Vars{Variable{"?x"}});
+  auto right = makeValuesTree(qec, makeIdTableFromVector({{2}, {3}, {4}}, I),
+                              Vars{Variable{"?x"}});
+  HashJoin hashJoin{qec, left, right, 0, 0};
+  // Two rows are inserted into the hash map and three are looked up.
+  EXPECT_EQ(hashJoin.getCostEstimate(),
+            hashJoin.getSizeEstimate() +
+                static_cast<size_t>(
+                    2 * qec->getCostFactor("HASH_JOIN_BUILD_COST") +
+                    3 * qec->getCostFactor("HASH_JOIN_PROBE_COST")) +
+                left->getCostEstimate() + right->getCostEstimate());
+
+  // Join columns with UNDEF values are not supported.
+  auto undef = makeValuesTree(
+      qec, makeIdTableFromVector({{Id::makeUndefined()}, {I(2)}}),
+      Vars{Variable{"?x"}});
+  EXPECT_ANY_THROW(HashJoin(qec, left, undef, 0, 0));
+}
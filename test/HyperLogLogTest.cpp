@@ -0,0 +1,81 @@
+//  Copyright 2025, University of Freiburg,
+//                  Chair of Algorithms and Data Structures.
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "util/HyperLogLog.h"
+#include "util/Serializer/ByteBufferSerializer.h"
+
+using ad_utility::HyperLogLog;
+
+namespace {
+// Return true iff the `estimate` is within `relativeError` of the `expected`
+// value.
+bool isClose(uint64_t estimate, uint64_t expected, double relativeError) {
+  return std::abs(static_cast<double>(estimate) -
+                  static_cast<double>(expected)) <=
+         relativeError * static_cast<double>(expected);
+}
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(HyperLogLog, estimate) {
+  HyperLogLog sketch;
+  EXPECT_EQ(sketch.precision(), HyperLogLog::DEFAULT_PRECISION);
+  EXPECT_EQ(sketch.estimate(), 0);
+  // Small cardinalities are (almost) exact because of the linear counting.
+  for (uint64_t key = 0; key < 100; ++key) {
+    sketch.add(key);
+    sketch.add(key);
+  }
+  EXPECT_TRUE(isClose(sketch.estimate(), 100, 0.02)) << sketch.estimate();
+  // Large cardinalities are estimated within a few standard errors (1.6%).
+  for (uint64_t key = 100; key < 1'000'000; ++key) {
+    sketch.add(key);
+  }
+  EXPECT_TRUE(isClose(sketch.estimate(), 1'000'000, 0.05))
+      << sketch.estimate();
+}
+
+// _____________________________________________________________________________
+TEST(HyperLogLog, merge) {
+  HyperLogLog a;
+  HyperLogLog b;
+  HyperLogLog both;
+  for (uint64_t key = 0; key < 50'000; ++key) {
+    a.add(key);
+    both.add(key);
+  }
+  for (uint64_t key = 25'000; key < 100'000; ++key) {
+    b.add(key);
+    both.add(key);
+  }
+  a.merge(b);
+  // Merging is lossless.
+  EXPECT_EQ(a, both);
+  EXPECT_TRUE(isClose(a.estimate(), 100'000, 0.05)) << a.estimate();
+
+  // Sketches with a different precision can't be merged.
+  HyperLogLog lowPrecision{4};
+  EXPECT_ANY_THROW(a.merge(lowPrecision));
+  EXPECT_ANY_THROW(HyperLogLog{3});
+  EXPECT_ANY_THROW(HyperLogLog{17});
+}
+
+// _____________________________________________________________________________
+TEST(HyperLogLog, serialization) {
+  HyperLogLog sketch{8};
+  for (uint64_t key = 0; key < 1000; ++key) {
+    sketch.add(key * 7);
+  }
+  ad_utility::serialization::ByteBufferWriteSerializer writer;
+  writer << sketch;
+  ad_utility::serialization::ByteBufferReadSerializer reader{
+      std::move(writer).data()};
+  HyperLogLog deserialized;
+  reader >> deserialized;
+  EXPECT_EQ(deserialized, sketch);
+  EXPECT_EQ(deserialized.precision(), 8);
+  EXPECT_EQ(deserialized.estimate(), sketch.estimate());
+}
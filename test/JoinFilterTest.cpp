@@ -0,0 +1,275 @@
+//  Copyright 2025, University of Freiburg,
+//                  Chair of Algorithms and Data Structures.
+
+#include <absl/strings/str_cat.h>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "./util/IdTableHelpers.h"
+#include "./util/IdTestHelpers.h"
+#include "./util/RuntimeParametersTestHelpers.h"
+#include "engine/IndexScan.h"
+#include "engine/Join.h"
+#include "engine/JoinFilter.h"
+#include "engine/LocalVocab.h"
+#include "engine/ValuesForTesting.h"
+#include "parser/ParsedQuery.h"
+#include "util/IndexTestHelpers.h"
+
+namespace {
+auto I = ad_utility::testing::IntId;
+auto LV = ad_utility::testing::LocalVocabId;
+using Vars = std::vector<std::optional<Variable>>;
+using Var = Variable;
+using enum Permutation::Enum;
+
+// A knowledge graph with the triples `<a_i> <p> <b_{i % 2}>` for `i` in
+// `[0, 10)`, and `<b_i> <q> <c_i>` for `i` in `[0, 2)`.
+std::string makeKnowledgeGraph() {
+  std::string kg;
+  for (size_t i = 0; i < 10; ++i) {
+    absl::StrAppend(&kg, "<a", i, "> <p> <b", i % 2, "> .\n");
+  }
+  absl::StrAppend(&kg, "<b0> <q> <c0> .\n<b1> <q> <c1> .\n");
+  return kg;
+}
+
+// The scans `?x <p> ?y` (sorted by `?y`) and `?y <q> ?z` of the knowledge
+// graph above, together with their join on `?y`.
+struct Trees {
+  std::shared_ptr<QueryExecutionTree> scanXY_;
+  std::shared_ptr<QueryExecutionTree> scanYZ_;
+  std::shared_ptr<QueryExecutionTree> join_;
+
+  explicit Trees(QueryExecutionContext* qec) {
+    scanXY_ = ad_utility::makeExecutionTree<IndexScan>(
+        qec, POS, SparqlTriple{Var{"?x"}, "<p>", Var{"?y"}});
+    scanYZ_ = ad_utility::makeExecutionTree<IndexScan>(
+        qec, PSO, SparqlTriple{Var{"?y"}, "<q>", Var{"?z"}});
+    join_ = ad_utility::makeExecutionTree<Join>(qec, scanXY_, scanYZ_, 0, 0);
+  }
+
+  IndexScan& scanXY() {
+    return static_cast<IndexScan&>(*scanXY_->getRootOperation());
+  }
+};
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(JoinFilter, fromJoinColumn) {
+  auto column = std::vector{I(5), I(3), I(5), I(1)};
+  auto filter = JoinFilter::fromJoinColumn(column, 10);
+  ASSERT_TRUE(filter.has_value());
+  ASSERT_NE(filter->sortedKeys(), nullptr);
+  EXPECT_THAT(*filter->sortedKeys(), ::testing::ElementsAre(I(1), I(3), I(5)));
+  EXPECT_EQ(filter->numKeys(), 3);
+  EXPECT_EQ(filter->getDescriptor(), "sorted list of 3 values");
+  EXPECT_TRUE(filter->mayContain(I(3)));
+  EXPECT_FALSE(filter->mayContain(I(4)));
+  auto ids = std::vector{I(0), I(1), I(2), I(5)};
+  EXPECT_THAT(filter->evaluate(ids), ::testing::ElementsAre(0, 1, 0, 1));
+
+  // With more distinct values than `maxNumSortedKeys`, the filter is a Bloom
+  // filter, which contains all the values (and might contain others).
+  auto bloomFilter = JoinFilter::fromJoinColumn(column, 2);
+  ASSERT_TRUE(bloomFilter.has_value());
+  EXPECT_EQ(bloomFilter->sortedKeys(), nullptr);
+  EXPECT_EQ(bloomFilter->getDescriptor(), "Bloom filter of 3 values");
+  for (Id id : column) {
+    EXPECT_TRUE(bloomFilter->mayContain(id));
+  }
+  size_t numFalsePositives = 0;
+  for (int64_t i = 100; i < 1100; ++i) {
+    numFalsePositives += bloomFilter->mayContain(I(i));
+  }
+  EXPECT_LT(numFalsePositives, 100);
+
+  // UNDEF matches every value, so there is no filter.
+  EXPECT_FALSE(JoinFilter::fromJoinColumn(
+                   std::vector{I(1), Id::makeUndefined()}, 10)
+                   .has_value());
+
+  // Values from a local vocabulary are not stored, all strings pass the filter,
+  // and the sorted keys can't be used to skip blocks.
+  auto withLocalVocab =
+      JoinFilter::fromJoinColumn(std::vector{I(1), LV(1)}, 10);
+  ASSERT_TRUE(withLocalVocab.has_value());
+  EXPECT_EQ(withLocalVocab->numKeys(), 1);
+  EXPECT_EQ(withLocalVocab->sortedKeys(), nullptr);
+  EXPECT_TRUE(withLocalVocab->mayContain(LV(2)));
+  EXPECT_TRUE(withLocalVocab->mayContain(I(1)));
+  EXPECT_FALSE(withLocalVocab->mayContain(I(2)));
+}
+
+// _____________________________________________________________________________
+TEST(JoinFilter, stringsFromLocalVocabAndInlineStrings) {
+  auto qec = ad_utility::testing::getQec(makeKnowledgeGraph());
+  auto getId = ad_utility::testing::makeGetId(qec->getIndex());
+  auto inlineId = [](std::string_view word) {
+    return Id::makeFromInlineString(InlineString::make(word).value());
+  };
+  LocalVocab localVocab;
+  auto localVocabId = [&localVocab](const std::string& word) {
+    return Id::makeFromLocalVocabIndex(localVocab.getIndexAndAddIfNotContained(
+        ad_utility::triple_component::LiteralOrIri::iriref(word)));
+  };
+  // The same string as a `VocabIndex`, from a `LocalVocab`, and inline.
+  Id a1 = getId("<a1>");
+  ASSERT_EQ(a1.getDatatype(), Datatype::VocabIndex);
+  ASSERT_EQ(a1, localVocabId("<a1>"));
+  ASSERT_EQ(a1, inlineId("<a1>"));
+
+  for (size_t maxNumSortedKeys : {10, 0}) {
+    // With a value from a local vocabulary, all strings pass the filter.
+    auto withLocalVocab = JoinFilter::fromJoinColumn(
+        std::vector{localVocabId("<a1>"), I(1)}, maxNumSortedKeys);
+    ASSERT_TRUE(withLocalVocab.has_value());
+    EXPECT_TRUE(withLocalVocab->mayContain(a1));
+    EXPECT_TRUE(withLocalVocab->mayContain(getId("<a2>")));
+    EXPECT_TRUE(withLocalVocab->mayContain(inlineId("<a2>")));
+    EXPECT_TRUE(withLocalVocab->mayContain(I(1)));
+
+    // Inline strings and values from a local vocabulary in the column that is
+    // filtered are found if they are equal to one of the values.
+    auto withInlineString = JoinFilter::fromJoinColumn(
+        std::vector{inlineId("<a1>"), getId("<a3>"), I(1)}, maxNumSortedKeys);
+    ASSERT_TRUE(withInlineString.has_value());
+    EXPECT_TRUE(withInlineString->mayContain(a1));
+    EXPECT_TRUE(withInlineString->mayContain(inlineId("<a1>")));
+    EXPECT_TRUE(withInlineString->mayContain(localVocabId("<a1>")));
+    EXPECT_TRUE(withInlineString->mayContain(getId("<a3>")));
+    EXPECT_TRUE(withInlineString->mayContain(inlineId("<a3>")));
+    EXPECT_TRUE(withInlineString->mayContain(localVocabId("<a3>")));
+  }
+
+  // The sorted list is exact also for strings of different types.
+  auto sorted = JoinFilter::fromJoinColumn(
+      std::vector{inlineId("<a1>"), getId("<a3>")}, 10);
+  ASSERT_TRUE(sorted.has_value());
+  ASSERT_NE(sorted->sortedKeys(), nullptr);
+  EXPECT_EQ(sorted->numKeys(), 2);
+  EXPECT_FALSE(sorted->mayContain(getId("<a2>")));
+  EXPECT_FALSE(sorted->mayContain(inlineId("<a2>")));
+  EXPECT_FALSE(sorted->mayContain(localVocabId("<a2>")));
+}
+
+// _____________________________________________________________________________
+TEST(JoinFilter, pushDown) {
+  auto qec = ad_utility::testing::getQec(makeKnowledgeGraph());
+  qec->getQueryTreeCache().clearAll();
+  auto getId = ad_utility::testing::makeGetId(qec->getIndex());
+  Trees trees{qec};
+  auto filter = std::make_shared<const JoinFilter>(
+      JoinFilter::fromJoinColumn(std::vector{getId("<a1>"), getId("<a4>")}, 10)
+          .value());
+
+  // The filter for `?x` is only added to the scan that contains `?x`.
+  EXPECT_EQ(JoinFilter::pushDown(filter, Var{"?x"}, *trees.join_), 1);
+  EXPECT_FALSE(trees.join_->getRootOperation()->canResultBeCached());
+  EXPECT_FALSE(trees.scanXY_->getRootOperation()->canResultBeCached());
+  EXPECT_TRUE(trees.scanYZ_->getRootOperation()->canResultBeCached());
+
+  // The scan only yields the rows that pass the filter, as long as the filter
+  // is alive.
+  EXPECT_EQ(trees.scanXY_->getResult()->idTable().numRows(), 2);
+  EXPECT_EQ(trees.join_->getResult()->idTable().numRows(), 2);
+  filter.reset();
+  EXPECT_EQ(trees.scanXY_->getResult()->idTable().numRows(), 10);
+
+  // Filters are not pushed into operations that are not joins, sorts, or
+  // filters, and not into scans with a LIMIT.
+  filter = std::make_shared<const JoinFilter>(
+      JoinFilter::fromJoinColumn(std::vector{getId("<a1>")}, 10).value());
+  auto values = ad_utility::makeExecutionTree<ValuesForTesting>(
+      qec, makeIdTableFromVector({{getId("<a1>")}}), Vars{Var{"?x"}});
+  EXPECT_EQ(JoinFilter::pushDown(filter, Var{"?x"}, *values), 0);
+  EXPECT_EQ(JoinFilter::pushDown(filter, Var{"?w"}, *trees.join_), 0);
+  Trees limitedTrees{qec};
+  limitedTrees.scanXY().setLimit({5});
+  EXPECT_EQ(JoinFilter::pushDown(filter, Var{"?x"}, *limitedTrees.join_), 0);
+  EXPECT_TRUE(limitedTrees.join_->getRootOperation()->canResultBeCached());
+}
+
+// _____________________________________________________________________________
+TEST(JoinFilter, joinPushesFilterIntoScans) {
+  auto qec = ad_utility::testing::getQec(makeKnowledgeGraph());
+  auto getId = ad_utility::testing::makeGetId(qec->getIndex());
+  // Only the `Values` are materialized before the other input of the join.
+  auto cleanup =
+      setRuntimeParameterForTest<"lazy-index-scan-max-size-materialization">(
+          2);
+  // The scan `?x <p> ?y` has 10 rows, of which only one passes the filter
+  // (and possibly some false positives of a Bloom filter).
+  auto test = [&](size_t maxBuildSize, size_t maxNumSortedKeys,
+                  std::string expectedDescriptor, size_t minNumScanRows,
+                  size_t maxNumScanRows) {
+    auto cleanupBuildSize =
+        setRuntimeParameterForTest<"join-filter-max-build-size">(maxBuildSize);
+    auto cleanupSortedKeys =
+        setRuntimeParameterForTest<"join-filter-max-sorted-keys">(
+            maxNumSortedKeys);
+    qec->getQueryTreeCache().clearAll();
+    Trees trees{qec};
+    auto values = ad_utility::makeExecutionTree<ValuesForTesting>(
+        qec, makeIdTableFromVector({{getId("<a1>")}}), Vars{Var{"?x"}});
+    Join join{qec, values, trees.join_, 0,
+              trees.join_->getVariableColumn(Var{"?x"})};
+    auto result = join.getResult();
+    EXPECT_EQ(result->idTable(),
+              makeIdTableFromVector(
+                  {{getId("<a1>"), getId("<b1>"), getId("<c1>")}}));
+
+    auto& details = join.runtimeInfo().details_;
+    if (expectedDescriptor.empty()) {
+      EXPECT_FALSE(details.contains("join-filter"));
+    } else {
+      EXPECT_EQ(details["join-filter"], expectedDescriptor);
+      EXPECT_EQ(details["num-scans-with-join-filter"], 1);
+    }
+    size_t numScanRows = trees.scanXY().runtimeInfo().numRows_;
+    EXPECT_GE(numScanRows, minNumScanRows);
+    EXPECT_LE(numScanRows, maxNumScanRows);
+  };
+  test(100, 10, "sorted list of 1 values", 1, 1);
+  test(100, 0, "Bloom filter of 1 values", 1, 9);
+  // Zero disables the filters.
+  test(0, 10, "", 10, 10);
+}
+
+// _____________________________________________________________________________
+TEST(JoinFilter, joinWithStringsFromLocalVocabAndInlineStrings) {
+  auto qec = ad_utility::testing::getQec(makeKnowledgeGraph());
+  auto getId = ad_utility::testing::makeGetId(qec->getIndex());
+  auto cleanup =
+      setRuntimeParameterForTest<"lazy-index-scan-max-size-materialization">(
+          2);
+  // The value of the materialized input is equal to the word `<a1>` of the
+  // vocabulary, but is stored in a `LocalVocab` or inline.
+  auto test = [&](Id value, LocalVocab localVocab, size_t maxNumSortedKeys) {
+    auto cleanupSortedKeys =
+        setRuntimeParameterForTest<"join-filter-max-sorted-keys">(
+            maxNumSortedKeys);
+    qec->getQueryTreeCache().clearAll();
+    Trees trees{qec};
+    auto values = ad_utility::makeExecutionTree<ValuesForTesting>(
+        qec, makeIdTableFromVector({{value}}), Vars{Var{"?x"}}, false,
+        std::vector<ColumnIndex>{}, std::move(localVocab));
+    Join join{qec, values, trees.join_, 0,
+              trees.join_->getVariableColumn(Var{"?x"})};
+    auto result = join.getResult();
+    EXPECT_TRUE(join.runtimeInfo().details_.contains("join-filter"));
+    ASSERT_EQ(result->idTable().numRows(), 1);
+    EXPECT_EQ(result->idTable()(0, 0), getId("<a1>"));
+    EXPECT_EQ(result->idTable()(0, 1), getId("<b1>"));
+    EXPECT_EQ(result->idTable()(0, 2), getId("<c1>"));
+  };
+  for (size_t maxNumSortedKeys : {10, 0}) {
+    LocalVocab localVocab;
+    Id localVocabId =
+        Id::makeFromLocalVocabIndex(localVocab.getIndexAndAddIfNotContained(
+            ad_utility::triple_component::LiteralOrIri::iriref("<a1>")));
+    test(localVocabId, std::move(localVocab), maxNumSortedKeys);
+    test(Id::makeFromInlineString(InlineString::make("<a1>").value()),
+         LocalVocab{}, maxNumSortedKeys);
+  }
+}
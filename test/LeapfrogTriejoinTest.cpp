@@ -0,0 +1,200 @@
+//  Copyright 2025, University of Freiburg,
+//                  Chair of Algorithms and Data Structures.
+
+#include <absl/strings/str_cat.h>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "./util/IdTableHelpers.h"
+#include "./util/IdTestHelpers.h"
+#include "engine/Engine.h"
+#include "engine/LeapfrogTriejoin.h"
+#include "engine/QueryPlanner.h"
+#include "engine/ValuesForTesting.h"
+#include "parser/SparqlParser.h"
+#include "util/IndexTestHelpers.h"
+#include "util/Random.h"
+
+namespace {
+auto I = ad_utility::testing::IntId;
+using Vars = std::vector<std::optional<Variable>>;
+using Input = LeapfrogTriejoin::Input;
+
+// The rows of the `table` as vectors.
+std::vector<std::vector<Id>> getRows(const IdTable& table) {
+  std::vector<std::vector<Id>> rows;
+  for (const auto& row : table) {
+    rows.emplace_back(row.begin(), row.end());
+  }
+  return rows;
+}
+
+// The directed triangles `(a, b, c)` with the edges `a -> b`, `b -> c` and
+// `c -> a` of the graph with the given `edges` (with duplicates), in sorted
+// order.
+std::vector<std::vector<Id>> computeTriangles(const IdTable& edges) {
+  std::vector<std::vector<Id>> result;
+  auto rows = getRows(edges);
+  ql::ranges::sort(rows);
+  for (const auto& ab : rows) {
+    for (const auto& bc : rows) {
+      if (ab[1] != bc[0]) {
+        continue;
+      }
+      auto [begin, end] =
+          std::equal_range(rows.begin(), rows.end(), std::vector{bc[1], ab[0]});
+      for (auto it = begin; it != end; ++it) {
+        result.push_back({ab[0], ab[1], bc[1]});
+      }
+    }
+  }
+  ql::ranges::sort(result);
+  return result;
+}
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(LeapfrogTriejoin, joinTriangles) {
+  // A random graph with many triangles and duplicate edges.
+  ad_utility::SlowRandomIntGenerator<int64_t> random{0, 30};
+  IdTable edges{2, ad_utility::testing::makeAllocator()};
+  for (size_t i = 0; i < 300; ++i) {
+    edges.push_back({I(random()), I(random())});
+  }
+  // The three inputs are the edges `a -> b`, `b -> c` and `c -> a`, sorted
+  // by their variables in the variable order `a, b, c`.
+  IdTable sortedByFirst = edges.clone();
+  Engine::sort(sortedByFirst, {0, 1});
+  IdTable sortedBySecond = edges.clone();
+  Engine::sort(sortedBySecond, {1, 0});
+  std::vector<Input> inputs{{&sortedByFirst, {0, 1}, {0, 1}},
+                            {&sortedByFirst, {0, 1}, {1, 2}},
+                            {&sortedBySecond, {1, 0}, {0, 2}}};
+  IdTable result{3, ad_utility::testing::makeAllocator()};
+  LeapfrogTriejoin::join(inputs, 3, result);
+  // The result is sorted and contains each triangle once for each
+  // combination of duplicate edges.
+  auto expected = computeTriangles(edges);
+  EXPECT_FALSE(expected.empty());
+  EXPECT_EQ(getRows(result), expected);
+
+  // Inputs with an empty table or a variable that isn't contained in any
+  // input.
+  IdTable empty{2, ad_utility::testing::makeAllocator()};
+  std::vector<Input> withEmpty{{&sortedByFirst, {0, 1}, {0, 1}},
+                               {&empty, {0, 1}, {1, 2}}};
+  IdTable emptyResult{3, ad_utility::testing::makeAllocator()};
+  LeapfrogTriejoin::join(withEmpty, 3, emptyResult);
+  EXPECT_TRUE(emptyResult.empty());
+  std::vector<Input> missingVariable{{&sortedByFirst, {0, 1}, {0, 1}}};
+  EXPECT_ANY_THROW(LeapfrogTriejoin::join(missingVariable, 3, emptyResult));
+  // The variables of an input must be in the variable order.
+  std::vector<Input> wrongOrder{{&sortedByFirst, {0, 1}, {1, 0}}};
+  IdTable twoColumns{2, ad_utility::testing::makeAllocator()};
+  EXPECT_ANY_THROW(LeapfrogTriejoin::join(wrongOrder, 2, twoColumns));
+}
+
+// _____________________________________________________________________________
+TEST(LeapfrogTriejoin, operation) {
+  auto qec = ad_utility::testing::getQec();
+  qec->getQueryTreeCache().clearAll();
+  auto makeTree = [qec](IdTable table, Vars vars) {
+    return ad_utility::makeExecutionTree<ValuesForTesting>(
+        qec, std::move(table), std::move(vars));
+  };
+  // The triangles `1 2 3` and `1 2 4`, and the path `5 6 7`.
+  auto ab = makeTree(makeIdTableFromVector({{1, 2}, {5, 6}, {3, 1}}, I),
+                     Vars{Variable{"?a"}, Variable{"?b"}});
+  auto bc = makeTree(makeIdTableFromVector({{2, 3}, {6, 7}, {2, 4}}, I),
+                     Vars{Variable{"?b"}, Variable{"?c"}});
+  // The columns of this input are not in the variable order.
+  auto ca = makeTree(makeIdTableFromVector({{3, 1}, {4, 1}, {8, 5}}, I),
+                     Vars{Variable{"?c"}, Variable{"?a"}});
+  LeapfrogTriejoin join{qec, {ca, bc, ab}};
+  EXPECT_EQ(join.variableOrder(),
+            (std::vector{Variable{"?a"}, Variable{"?b"}, Variable{"?c"}}));
+  EXPECT_EQ(join.getDescriptor(), "Leapfrog Triejoin on ?a ?b ?c");
+  EXPECT_EQ(join.getResultWidth(), 3);
+  EXPECT_EQ(join.resultSortedOn(), (std::vector<ColumnIndex>{0, 1, 2}));
+  EXPECT_EQ(join.getChildren().size(), 3);
+  EXPECT_GT(join.getSizeEstimate(), 0);
+  EXPECT_GT(join.getCostEstimate(), join.getSizeEstimate());
+  // The order of the children doesn't matter.
+  LeapfrogTriejoin joinSwapped{qec, {ab, bc, ca}};
+  EXPECT_EQ(join.getCacheKey(), joinSwapped.getCacheKey());
+
+  auto result = join.getResult();
+  EXPECT_EQ(result->idTable(),
+            makeIdTableFromVector({{1, 2, 3}, {1, 2, 4}}, I));
+  EXPECT_EQ(result->sortedBy(), join.resultSortedOn());
+  EXPECT_EQ(join.getExternallyVisibleVariableColumns().at(Variable{"?c"})
+                .columnIndex_,
+            2);
+
+  // All columns of the inputs must be variables.
+  auto withoutVariable = makeTree(makeIdTableFromVector({{1, 2}}, I),
+                                  Vars{Variable{"?a"}, std::nullopt});
+  EXPECT_ANY_THROW((LeapfrogTriejoin{qec, {withoutVariable, bc}}));
+  EXPECT_ANY_THROW((LeapfrogTriejoin{qec, {ab}}));
+}
+
+// _____________________________________________________________________________
+TEST(LeapfrogTriejoin, cycleDetection) {
+  auto qec = ad_utility::testing::getQec();
+  auto makePlan = [qec](std::string a, std::string b, uint64_t nodeId) {
+    QueryPlanner::SubtreePlan plan{
+        qec, std::make_shared<ValuesForTesting>(
+                 qec, makeIdTableFromVector({{1, 2}}, I),
+                 Vars{Variable{std::move(a)}, Variable{std::move(b)}})};
+    plan._idsOfIncludedNodes = nodeId;
+    return plan;
+  };
+  using QueryGraph = QueryPlanner::QueryGraph;
+  // A path and a star are acyclic, even with alternative plans for the same
+  // triple.
+  EXPECT_FALSE(QueryGraph::hasCycleOfVariables(
+      {makePlan("?a", "?b", 1), makePlan("?b", "?a", 1),
+       makePlan("?b", "?c", 2), makePlan("?c", "?d", 4)}));
+  EXPECT_FALSE(QueryGraph::hasCycleOfVariables(
+      {makePlan("?a", "?b", 1), makePlan("?a", "?c", 2),
+       makePlan("?a", "?d", 4)}));
+  // A triangle, a square, and two triples between the same variables.
+  EXPECT_TRUE(QueryGraph::hasCycleOfVariables({makePlan("?a", "?b", 1),
+                                               makePlan("?b", "?c", 2),
+                                               makePlan("?c", "?a", 4)}));
+  EXPECT_TRUE(QueryGraph::hasCycleOfVariables(
+      {makePlan("?a", "?b", 1), makePlan("?b", "?c", 2),
+       makePlan("?c", "?d", 4), makePlan("?a", "?d", 8)}));
+  EXPECT_TRUE(QueryGraph::hasCycleOfVariables(
+      {makePlan("?a", "?b", 1), makePlan("?b", "?a", 2)}));
+}
+
+// _____________________________________________________________________________
+TEST(LeapfrogTriejoin, queryPlanner) {
+  // A complete directed graph on 12 nodes, which has `12 * 11 * 10` directed
+  // triangles.
+  std::string kg;
+  for (size_t i = 0; i < 12; ++i) {
+    for (size_t j = 0; j < 12; ++j) {
+      if (i != j) {
+        absl::StrAppend(&kg, "<n", i, "> <p> <n", j, "> .\n");
+      }
+    }
+  }
+  auto qec = ad_utility::testing::getQec(kg);
+  qec->getQueryTreeCache().clearAll();
+  ParsedQuery pq = SparqlParser::parseQuery(
+      "SELECT * WHERE { ?a <p> ?b . ?b <p> ?c . ?c <p> ?a }");
+  auto qet =
+      QueryPlanner{qec, std::make_shared<ad_utility::CancellationHandle<>>()}
+          .createExecutionTree(pq);
+  auto* join = dynamic_cast<const LeapfrogTriejoin*>(
+      qet.getRootOperation().get());
+  ASSERT_NE(join, nullptr) << qet.getCacheKey();
+  // The scans are chosen such that no sorting is required.
+  for (auto* child : qet.getRootOperation()->getChildren()) {
+    EXPECT_TRUE(child->getRootOperation()->isIndexScanWithNumVariables(2))
+        << child->getCacheKey();
+  }
+  EXPECT_EQ(qet.getResult()->idTable().size(), 12 * 11 * 10);
+}
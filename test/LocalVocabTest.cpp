@@ -452,3 +452,27 @@ TEST(LocalVocab, sizeIsProperlyUpdatedOnMerge) {
   EXPECT_THAT(clone2.getAllWordsForTesting(),
               UnorderedElementsAre(LiteralOrIri::literalWithoutQuotes("test")));
 }
+
+// _____________________________________________________________________________
+TEST(LocalVocab, getIdAndAddIfNotContained) {
+  using ad_utility::triple_component::LiteralOrIri;
+  LocalVocab localVocab;
+
+  // Short words are stored directly in the `Id`.
+  Id shortWord = localVocab.getIdAndAddIfNotContained(
+      LocalVocabEntry{LiteralOrIri::literalWithoutQuotes("short")});
+  ASSERT_EQ(shortWord.getDatatype(), Datatype::InlineString);
+  EXPECT_EQ(shortWord.getInlineString().view(), "\"short\"");
+  EXPECT_TRUE(localVocab.empty());
+
+  // Longer words are added to the local vocab.
+  LocalVocabEntry longEntry{LiteralOrIri::literalWithoutQuotes("longer")};
+  Id longWord = localVocab.getIdAndAddIfNotContained(longEntry);
+  ASSERT_EQ(longWord.getDatatype(), Datatype::LocalVocabIndex);
+  EXPECT_EQ(longWord.getLocalVocabIndex()->toStringRepresentation(),
+            "\"longer\"");
+  EXPECT_EQ(localVocab.size(), 1);
+  EXPECT_EQ(localVocab.getIdAndAddIfNotContained(longEntry).getBits(),
+            longWord.getBits());
+  EXPECT_EQ(localVocab.size(), 1);
+}
@@ -95,7 +95,7 @@ TEST_F(LocatedTriplesTest, numTriplesInBlock) {
     return testing::ResultOf(
         absl::StrCat(".map_.at(", std::to_string(blockIndex), ")"),
         [blockIndex](const LocatedTriplesPerBlock& ltpb) {
-          return ltpb.map_.at(blockIndex);
+          return *ltpb.map_.at(blockIndex);
         },
         testing::Eq(expectedLTs));
   };
@@ -112,7 +112,8 @@ TEST_F(LocatedTriplesTest, numTriplesInBlock) {
               return locatedTriplesInBlock(blockIndex, expectedLTs);
             });
         // The macro does not work with templated types.
-        using HashMapType = ad_utility::HashMap<size_t, LocatedTriples>;
+        using HashMapType =
+            ad_utility::HashMap<size_t, std::shared_ptr<LocatedTriples>>;
         return testing::AllOf(
             AD_FIELD(LocatedTriplesPerBlock, map_,
                      AD_PROPERTY(HashMapType, size,
@@ -208,6 +209,67 @@ TEST_F(LocatedTriplesTest, numTriplesInBlock) {
   EXPECT_THAT(locatedTriplesPerBlock, locatedTriplesAre({}));
 }
 
+// Test that snapshots share the unmodified blocks with the previous snapshot
+// and are not affected by later modifications.
+TEST_F(LocatedTriplesTest, copyForSnapshot) {
+  using LT = LocatedTriple;
+  std::vector<CompressedBlockMetadata> metadata{
+      CBM(PT(5, 1, 1), PT(15, 1, 1)), CBM(PT(15, 1, 2), PT(25, 1, 1)),
+      CBM(PT(25, 1, 2), PT(30, 1, 1)), CBM(PT(30, 1, 2), PT(35, 1, 1))};
+  auto LT1 = LT{1, IT(10, 1, 0), false};
+  auto LT2 = LT{2, IT(20, 4, 0), true};
+  auto LT3 = LT{3, IT(25, 5, 0), true};
+  auto LT4 = LT{3, IT(26, 5, 0), false};
+
+  LocatedTriplesPerBlock locatedTriplesPerBlock;
+  locatedTriplesPerBlock.setOriginalMetadata(metadata);
+  locatedTriplesPerBlock.add(std::vector{LT1, LT2});
+
+  auto snapshot1 = locatedTriplesPerBlock.copyForSnapshot();
+  EXPECT_THAT(snapshot1, numBlocks(2));
+  EXPECT_THAT(snapshot1, numTriplesTotal(2));
+  EXPECT_THAT(snapshot1.getAugmentedMetadata(),
+              testing::ElementsAreArray(
+                  locatedTriplesPerBlock.getAugmentedMetadata()));
+  // The sets of the snapshot are copies and not shared with the modifiable
+  // object.
+  EXPECT_NE(snapshot1.map_.at(1), locatedTriplesPerBlock.map_.at(1));
+
+  auto handles = locatedTriplesPerBlock.add(std::vector{LT3, LT4});
+  auto snapshot2 = locatedTriplesPerBlock.copyForSnapshot();
+  EXPECT_THAT(snapshot1, numBlocks(2));
+  EXPECT_THAT(snapshot1, numTriplesTotal(2));
+  EXPECT_THAT(snapshot1, numTriplesInBlock(3, {0, 0}));
+  EXPECT_THAT(snapshot2, numBlocks(3));
+  EXPECT_THAT(snapshot2, numTriplesTotal(4));
+  EXPECT_THAT(snapshot2, numTriplesInBlock(3, {1, 1}));
+  // The unmodified blocks are shared between the two snapshots.
+  EXPECT_EQ(snapshot1.map_.at(1), snapshot2.map_.at(1));
+  EXPECT_EQ(snapshot1.map_.at(2), snapshot2.map_.at(2));
+  EXPECT_NE(snapshot1.getAugmentedMetadata(),
+            snapshot2.getAugmentedMetadata());
+
+  // Erasing from the modifiable object does not affect the snapshots.
+  locatedTriplesPerBlock.erase(3, handles[0]);
+  locatedTriplesPerBlock.erase(3, handles[1]);
+  EXPECT_THAT(locatedTriplesPerBlock, numBlocks(2));
+  EXPECT_THAT(snapshot2, numBlocks(3));
+  EXPECT_TRUE(snapshot2.isLocatedTriple(LT3.triple_, true));
+  auto snapshot3 = locatedTriplesPerBlock.copyForSnapshot();
+  EXPECT_THAT(snapshot3, numBlocks(2));
+  EXPECT_FALSE(snapshot3.isLocatedTriple(LT3.triple_, true));
+  EXPECT_EQ(snapshot3.map_.at(2), snapshot1.map_.at(2));
+
+  // After clearing, the next snapshot is empty.
+  locatedTriplesPerBlock.clear();
+  auto snapshot4 = locatedTriplesPerBlock.copyForSnapshot();
+  EXPECT_THAT(snapshot4, numBlocks(0));
+  EXPECT_THAT(snapshot4, numTriplesTotal(0));
+  EXPECT_THAT(snapshot4.getAugmentedMetadata(),
+              testing::ElementsAreArray(metadata));
+  EXPECT_THAT(snapshot3, numBlocks(2));
+}
+
 // Test the method that merges the matching `LocatedTriple`s from a block into
 // an `IdTable`.
 TEST_F(LocatedTriplesTest, mergeTriples) {
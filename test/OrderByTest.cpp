@@ -7,10 +7,13 @@
 
 #include "./util/IdTableHelpers.h"
 #include "./util/IdTestHelpers.h"
+#include "./util/RuntimeParametersTestHelpers.h"
+#include "engine/Engine.h"
 #include "engine/OrderBy.h"
 #include "engine/ValuesForTesting.h"
 #include "global/ValueIdComparators.h"
 #include "util/IndexTestHelpers.h"
+#include "util/Random.h"
 
 using namespace std::string_literals;
 using namespace std::chrono_literals;
@@ -257,3 +260,115 @@ TEST(OrderBy, verifyOperationIsPreemptivelyAbortedWithNoRemainingTime) {
       orderBy.getResult(true), ::testing::HasSubstr("time estimate exceeded"),
       ad_utility::CancellationException);
 }
+
+// _____________________________________________________________________________
+TEST(OrderBy, externalSortForLazyResults) {
+  auto qec = ad_utility::testing::getQec();
+  qec->getQueryTreeCache().clearAll();
+  // Every input with more than two rows is too large to be sorted in RAM.
+  auto cleanup = setRuntimeParameterForTest<"sort-in-memory-threshold">(
+      ad_utility::MemorySize::bytes(2 * 2 * sizeof(Id)));
+  auto I = ad_utility::testing::IntId;
+  auto D = ad_utility::testing::DoubleId;
+  std::vector<IdTable> blocks;
+  blocks.push_back(makeIdTableFromVector({{I(3), D(1.5)}, {I(-2), D(0.5)}}));
+  blocks.push_back(makeIdTableFromVector({{I(3), D(-1.0)}, {I(7), D(2.0)}}));
+  blocks.push_back(makeIdTableFromVector({{I(-2), D(3.0)}}));
+  auto subtree = ad_utility::makeExecutionTree<ValuesForTesting>(
+      qec, std::move(blocks),
+      std::vector<std::optional<Variable>>{Variable{"?0"}, Variable{"?1"}});
+  OrderBy orderBy{qec, std::move(subtree), {{0, true}, {1, false}}};
+  auto result = orderBy.getResult(true);
+  ASSERT_FALSE(result->isFullyMaterialized());
+  auto expected = makeIdTableFromVector({{I(7), D(2.0)},
+                                         {I(3), D(-1.0)},
+                                         {I(3), D(1.5)},
+                                         {I(-2), D(0.5)},
+                                         {I(-2), D(3.0)}});
+  EXPECT_EQ(aggregateTables(std::move(result->idTables()), 2).first,
+            expected);
+}
+
+// _____________________________________________________________________________
+TEST(OrderBy, lazyOrderByOnSortedPrefix) {
+  auto qec = ad_utility::testing::getQec();
+  auto I = ad_utility::testing::IntId;
+  auto V = ad_utility::testing::VocabId;
+  // The input is sorted by the internal order of its first column, in which
+  // the integers are not sorted by their value.
+  auto input = makeIdTableFromVector({{V(3), I(5)},
+                                      {I(-3), I(2)},
+                                      {V(1), I(3)},
+                                      {I(0), I(1)},
+                                      {V(3), I(-1)},
+                                      {V(1), I(1)},
+                                      {I(5), I(0)},
+                                      {V(1), I(2)},
+                                      {V(2), I(0)}});
+  Engine::sort(input, {0});
+  auto expected = makeIdTableFromVector({{I(-3), I(2)},
+                                         {I(0), I(1)},
+                                         {I(5), I(0)},
+                                         {V(1), I(1)},
+                                         {V(1), I(2)},
+                                         {V(1), I(3)},
+                                         {V(2), I(0)},
+                                         {V(3), I(-1)},
+                                         {V(3), I(5)}});
+
+  for (size_t blockSize : {1, 2, 4, 9}) {
+    qec->getQueryTreeCache().clearAll();
+    std::vector<IdTable> blocks;
+    for (size_t i = 0; i < input.numRows(); i += blockSize) {
+      IdTable block{2, qec->getAllocator()};
+      block.insertAtEnd(input, i, std::min(i + blockSize, input.numRows()));
+      blocks.push_back(std::move(block));
+    }
+    auto subtree = ad_utility::makeExecutionTree<ValuesForTesting>(
+        qec, std::move(blocks),
+        std::vector<std::optional<Variable>>{Variable{"?0"}, Variable{"?1"}},
+        false, std::vector<ColumnIndex>{0});
+    OrderBy orderBy{qec, std::move(subtree), {{0, false}, {1, false}}};
+    auto result = orderBy.getResult(true);
+    ASSERT_FALSE(result->isFullyMaterialized());
+    EXPECT_EQ(aggregateTables(std::move(result->idTables()), 2).first,
+              expected);
+    EXPECT_EQ(orderBy.runtimeInfo().details_["num-presorted-columns"], 1);
+  }
+
+  // If the first column is sorted descending, the sorted prefix can't be used.
+  qec->getQueryTreeCache().clearAll();
+  auto subtree = ad_utility::makeExecutionTree<ValuesForTesting>(
+      qec, input.clone(),
+      std::vector<std::optional<Variable>>{Variable{"?0"}, Variable{"?1"}},
+      false, std::vector<ColumnIndex>{0});
+  OrderBy orderBy{qec, std::move(subtree), {{0, true}, {1, false}}};
+  auto result = orderBy.getResult(true);
+  ASSERT_TRUE(result->isFullyMaterialized());
+  EXPECT_FALSE(
+      orderBy.runtimeInfo().details_.contains("num-presorted-columns"));
+}
+
+// _____________________________________________________________________________
+TEST(OrderBy, radixSortForLargeInputs) {
+  auto qec = ad_utility::testing::getQec();
+  auto I = ad_utility::testing::IntId;
+  auto V = ad_utility::testing::VocabId;
+  ad_utility::SlowRandomIntGenerator<int64_t> random{-1000, 1000};
+  IdTable input{2, qec->getAllocator()};
+  for (size_t i = 0; i < Engine::RADIX_SORT_MIN_NUM_ROWS + 5; ++i) {
+    int64_t value = random();
+    input.push_back({value % 7 == 0 ? Id::makeUndefined() : I(value),
+                     V(static_cast<uint64_t>(random() + 1000))});
+  }
+  for (const OrderBy::SortIndices& sortIndices :
+       {OrderBy::SortIndices{{0, false}, {1, true}},
+        OrderBy::SortIndices{{1, false}, {0, true}}}) {
+    auto expected = input.clone();
+    Engine::sort<2>(&expected, OrderBy::makeComparator(sortIndices));
+    auto orderBy = makeOrderBy(input.clone(), sortIndices);
+    // Rows that are equal on all sort columns are equal, so the result is
+    // unique.
+    EXPECT_EQ(orderBy.getResult()->idTable(), expected);
+  }
+}
@@ -0,0 +1,138 @@
+//  Copyright 2025, University of Freiburg,
+//                  Chair of Algorithms and Data Structures.
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+
+#include "./util/IdTableHelpers.h"
+#include "./util/IdTestHelpers.h"
+#include "engine/PersistentResultCache.h"
+#include "util/IndexTestHelpers.h"
+
+using namespace std::chrono_literals;
+
+namespace {
+auto I = ad_utility::testing::IntId;
+using ad_utility::triple_component::LiteralOrIri;
+
+// A directory for the `PersistentResultCache` that is removed when the test
+// ends.
+struct TemporaryDirectory {
+  std::string name_;
+  explicit TemporaryDirectory(std::string name) : name_{std::move(name)} {
+    std::filesystem::remove_all(name_);
+  }
+  ~TemporaryDirectory() { std::filesystem::remove_all(name_); }
+};
+
+// Return a `CacheValue` with the `idTable` and the `localVocab` that took
+// 42ms to compute.
+std::shared_ptr<const CacheValue> makeCacheValue(IdTable idTable,
+                                                 LocalVocab localVocab) {
+  RuntimeInformation runtimeInfo;
+  runtimeInfo.totalTime_ = 42ms;
+  runtimeInfo.descriptor_ = "some operation";
+  runtimeInfo.addDetail("some-detail", 17);
+  return std::make_shared<CacheValue>(
+      Result{std::move(idTable), {0}, std::move(localVocab)},
+      std::move(runtimeInfo));
+}
+
+// Store the `value` under the `key` and wait until it has been written.
+void storeAndWait(PersistentResultCache& cache, const QueryCacheKey& key,
+                  std::shared_ptr<const CacheValue> value) {
+  cache.store(key, std::move(value));
+  cache.waitForPendingWrites();
+}
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(PersistentResultCache, storeAndLoad) {
+  TemporaryDirectory directory{"PersistentResultCacheTest.storeAndLoad"};
+  auto allocator = ad_utility::testing::makeAllocator();
+
+  LocalVocab localVocab;
+  auto word = [&localVocab](std::string iri) {
+    return Id::makeFromLocalVocabIndex(localVocab.getIndexAndAddIfNotContained(
+        LocalVocabEntry{LiteralOrIri::iriref(iri)}));
+  };
+  auto x = word("<x>");
+  auto y = word("<y>");
+  auto idTable = makeIdTableFromVector({{I(1), x}, {I(2), y}, {I(3), x}});
+  QueryCacheKey key{"the cache key", 0};
+  {
+    PersistentResultCache cache{directory.name_, "index-id", allocator};
+    EXPECT_EQ(cache.load(key), nullptr);
+    storeAndWait(cache, key,
+                 makeCacheValue(idTable.clone(), std::move(localVocab)));
+    EXPECT_TRUE(std::filesystem::exists(cache.getFilename(key)));
+  }
+
+  // The result survives the destruction of the cache (and thus a restart).
+  PersistentResultCache cache{directory.name_, "index-id", allocator};
+  auto value = cache.load(key);
+  ASSERT_NE(value, nullptr);
+  const auto& result = value->resultTable();
+  EXPECT_THAT(result.sortedBy(), ::testing::ElementsAre(0));
+  const auto& loaded = result.idTable();
+  ASSERT_EQ(loaded.numRows(), 3u);
+  ASSERT_EQ(loaded.numColumns(), 2u);
+  EXPECT_EQ(loaded(0, 0), I(1));
+  EXPECT_EQ(loaded(2, 0), I(3));
+  // The words are contained in the new local vocab of the result.
+  EXPECT_EQ(result.localVocab().size(), 2u);
+  auto getWord = [&loaded](size_t row) {
+    return loaded(row, 1).getLocalVocabIndex()->toStringRepresentation();
+  };
+  EXPECT_EQ(getWord(0), "<x>");
+  EXPECT_EQ(getWord(1), "<y>");
+  EXPECT_EQ(loaded(0, 1), loaded(2, 1));
+  EXPECT_EQ(value->runtimeInfo().totalTime_, 42ms);
+  EXPECT_EQ(value->runtimeInfo().descriptor_, "some operation");
+  EXPECT_EQ(value->runtimeInfo().details_["some-detail"], 17);
+
+  // Other keys and other indices are not found.
+  EXPECT_EQ(cache.load({"another cache key", 0}), nullptr);
+  PersistentResultCache otherIndex{directory.name_, "other-id", allocator};
+  EXPECT_EQ(otherIndex.load(key), nullptr);
+}
+
+// _____________________________________________________________________________
+TEST(PersistentResultCache, resultsThatAreNotStored) {
+  TemporaryDirectory directory{"PersistentResultCacheTest.notStored"};
+  PersistentResultCache cache{directory.name_, "index-id",
+                              ad_utility::testing::makeAllocator()};
+  auto idTable = makeIdTableFromVector({{I(1), I(2)}});
+
+  // Only results for the snapshot without updates are stored.
+  QueryCacheKey keyWithUpdates{"key", 1};
+  storeAndWait(cache, keyWithUpdates,
+               makeCacheValue(idTable.clone(), LocalVocab{}));
+  EXPECT_FALSE(std::filesystem::exists(cache.getFilename(keyWithUpdates)));
+  EXPECT_EQ(cache.load(keyWithUpdates), nullptr);
+
+  // Results with blank nodes of their local vocab are not stored.
+  LocalVocab localVocab;
+  auto* blankNodeManager =
+      ad_utility::testing::getQec()->getIndex().getBlankNodeManager();
+  auto blankNode = Id::makeFromBlankNodeIndex(
+      localVocab.getBlankNodeIndex(blankNodeManager));
+  QueryCacheKey key{"key", 0};
+  storeAndWait(cache, key,
+               makeCacheValue(makeIdTableFromVector({{I(1), blankNode}}),
+                              std::move(localVocab)));
+  EXPECT_FALSE(std::filesystem::exists(cache.getFilename(key)));
+  EXPECT_EQ(cache.load(key), nullptr);
+
+  // A corrupt file is ignored and removed.
+  std::filesystem::create_directories(directory.name_);
+  {
+    std::ofstream file{cache.getFilename(key)};
+    file << "not a stored result";
+  }
+  EXPECT_EQ(cache.load(key), nullptr);
+  EXPECT_FALSE(std::filesystem::exists(cache.getFilename(key)));
+}
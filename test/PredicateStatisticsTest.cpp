@@ -0,0 +1,239 @@
+//  Copyright 2025, University of Freiburg,
+//                  Chair of Algorithms and Data Structures.
+
+#include <absl/strings/str_cat.h>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "./PrefilterExpressionTestHelpers.h"
+#include "engine/Filter.h"
+#include "engine/IndexScan.h"
+#include "engine/Join.h"
+#include "index/PredicateStatistics.h"
+#include "util/IdTestHelpers.h"
+#include "util/IndexTestHelpers.h"
+
+namespace {
+auto I = ad_utility::testing::IntId;
+
+// The `Id`s of the integers `[begin, end)`.
+std::vector<Id> makeIds(int64_t begin, int64_t end) {
+  std::vector<Id> ids;
+  for (int64_t i = begin; i < end; ++i) {
+    ids.push_back(I(i));
+  }
+  return ids;
+}
+
+// A knowledge graph where the objects of the predicate `<p>` are `0, ..., 99`,
+// the objects of `<q>` are `200, ..., 299`, and those of `<r>` are `50, ...,
+// 149`.
+std::string makeKnowledgeGraph() {
+  std::string kg;
+  for (size_t i = 0; i < 100; ++i) {
+    absl::StrAppend(&kg, "<s", i, "> <p> ", i, " .\n");
+    absl::StrAppend(&kg, "<s", i, "> <q> ", 200 + i, " .\n");
+    absl::StrAppend(&kg, "<s", i, "> <r> ", 50 + i, " .\n");
+  }
+  return kg;
+}
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(ValueHistogram, exactHistogram) {
+  // Each value occurs twice, except for `5`, which occurs ten times.
+  std::vector<Id> sample;
+  for (Id id : makeIds(0, 10)) {
+    sample.insert(sample.end(), id == I(5) ? 10 : 2, id);
+  }
+  auto histogram =
+      ValueHistogram::fromSortedSample(sample, sample.size(), 10, 4);
+  EXPECT_EQ(histogram.numValues(), 28);
+  EXPECT_EQ(histogram.numDistinctValues(), 10);
+  // The target size of the buckets is 7, but the values are never split, so
+  // there are only three buckets.
+  const auto& buckets = histogram.buckets();
+  ASSERT_EQ(buckets.size(), 3);
+  EXPECT_EQ(buckets[0].summary_.min_, I(0));
+  EXPECT_EQ(buckets[0].summary_.max_, I(3));
+  EXPECT_EQ(buckets[0].numValues_, 8);
+  EXPECT_EQ(buckets[0].numDistinctValues_, 4);
+  EXPECT_EQ(buckets[1].summary_.min_, I(4));
+  EXPECT_EQ(buckets[1].summary_.max_, I(5));
+  EXPECT_EQ(buckets[1].numValues_, 12);
+  EXPECT_EQ(buckets[1].numDistinctValues_, 2);
+  EXPECT_EQ(buckets[2].summary_.min_, I(6));
+  EXPECT_EQ(buckets[2].summary_.max_, I(9));
+  EXPECT_EQ(buckets[2].numValues_, 8);
+  EXPECT_TRUE(buckets[2].summary_.containsDatatype(Datatype::Int));
+  EXPECT_FALSE(buckets[2].summary_.containsDatatype(Datatype::Double));
+
+  // An empty histogram.
+  auto empty = ValueHistogram::fromSortedSample({}, 0, 0, 4);
+  EXPECT_TRUE(empty.buckets().empty());
+  EXPECT_EQ(empty.numValues(), 0);
+  // The sample has to be sorted.
+  auto unsorted = makeIds(0, 3);
+  ql::ranges::reverse(unsorted);
+  EXPECT_ANY_THROW(ValueHistogram::fromSortedSample(unsorted, 3, 3, 4));
+}
+
+// _____________________________________________________________________________
+TEST(ValueHistogram, scaledHistogram) {
+  // A sample of 100 distinct values for a column with 10'000 values, of which
+  // 1'000 are distinct.
+  auto sample = makeIds(0, 100);
+  auto histogram = ValueHistogram::fromSortedSample(sample, 10'000, 1'000, 10);
+  ASSERT_EQ(histogram.buckets().size(), 10);
+  for (const auto& bucket : histogram.buckets()) {
+    EXPECT_EQ(bucket.numValues_, 1'000);
+    EXPECT_EQ(bucket.numDistinctValues_, 100);
+  }
+  // The number of distinct values is at most the number of values.
+  histogram = ValueHistogram::fromSortedSample(sample, 200, 1'000, 10);
+  EXPECT_EQ(histogram.numDistinctValues(), 200);
+  EXPECT_EQ(histogram.buckets().at(0).numDistinctValues_, 20);
+}
+
+// _____________________________________________________________________________
+TEST(ValueHistogram, estimateFractionInRangeOf) {
+  auto makeHistogram = [](int64_t begin, int64_t end) {
+    auto sample = makeIds(begin, end);
+    return ValueHistogram::fromSortedSample(sample, sample.size(),
+                                            sample.size(), 10);
+  };
+  auto h0To100 = makeHistogram(0, 100);
+  auto h50To150 = makeHistogram(50, 150);
+  auto h200To300 = makeHistogram(200, 300);
+  EXPECT_DOUBLE_EQ(h0To100.estimateFractionInRangeOf(h0To100), 1.0);
+  EXPECT_DOUBLE_EQ(h0To100.estimateFractionInRangeOf(h50To150), 0.5);
+  EXPECT_DOUBLE_EQ(h50To150.estimateFractionInRangeOf(h0To100), 0.5);
+  EXPECT_DOUBLE_EQ(h0To100.estimateFractionInRangeOf(h200To300), 0.0);
+  // Without values, no values can be excluded.
+  EXPECT_DOUBLE_EQ(h0To100.estimateFractionInRangeOf(ValueHistogram{}), 1.0);
+}
+
+// _____________________________________________________________________________
+TEST(PredicateStatistics, builder) {
+  PredicateStatistics::Builder builder{16, 4};
+  // As many values for `I(1)` as fit into the sample (exact), many values for
+  // `I(2)` (sampled).
+  for (Id object : makeIds(0, 8)) {
+    builder.addTriple(I(1), object);
+    builder.addTriple(I(1), object);
+  }
+  for (size_t i = 0; i < 10; ++i) {
+    for (Id object : makeIds(100, 200)) {
+      builder.addTriple(I(2), object);
+    }
+  }
+  auto statistics = std::move(builder).finish();
+  EXPECT_EQ(statistics.numPredicates(), 2);
+  EXPECT_EQ(statistics.getObjectHistogram(I(3)), nullptr);
+
+  const auto* exact = statistics.getObjectHistogram(I(1));
+  ASSERT_NE(exact, nullptr);
+  EXPECT_EQ(exact->numValues(), 16);
+  EXPECT_EQ(exact->numDistinctValues(), 8);
+  ASSERT_EQ(exact->buckets().size(), 4);
+  EXPECT_EQ(exact->buckets().front().summary_.min_, I(0));
+  EXPECT_EQ(exact->buckets().front().numValues_, 4);
+  EXPECT_EQ(exact->buckets().back().summary_.max_, I(7));
+
+  const auto* sampled = statistics.getObjectHistogram(I(2));
+  ASSERT_NE(sampled, nullptr);
+  EXPECT_EQ(sampled->numValues(), 1000);
+  EXPECT_NEAR(sampled->numDistinctValues(), 100, 5);
+  EXPECT_LE(sampled->buckets().size(), 4);
+  uint64_t numValuesInBuckets = 0;
+  for (const auto& bucket : sampled->buckets()) {
+    EXPECT_GE(bucket.summary_.min_, I(100));
+    EXPECT_LE(bucket.summary_.max_, I(199));
+    numValuesInBuckets += bucket.numValues_;
+  }
+  EXPECT_NEAR(numValuesInBuckets, 1000, 10);
+
+  // The triples have to be grouped by their predicate.
+  PredicateStatistics::Builder ungrouped;
+  ungrouped.addTriple(I(1), I(0));
+  ungrouped.addTriple(I(2), I(0));
+  EXPECT_ANY_THROW(ungrouped.addTriple(I(1), I(0)));
+}
+
+// _____________________________________________________________________________
+TEST(PredicateStatistics, writeAndRead) {
+  PredicateStatistics::Builder builder;
+  for (Id object : makeIds(0, 100)) {
+    builder.addTriple(I(1), object);
+    builder.addTriple(I(2), object);
+  }
+  auto statistics = std::move(builder).finish();
+  std::string filename = "PredicateStatisticsTest.writeAndRead.dat";
+  statistics.writeToFile(filename);
+  auto read = PredicateStatistics::readFromFile(filename);
+  ad_utility::deleteFile(filename);
+  EXPECT_EQ(read.numPredicates(), 2);
+  ASSERT_NE(read.getObjectHistogram(I(1)), nullptr);
+  EXPECT_EQ(*read.getObjectHistogram(I(1)),
+            *statistics.getObjectHistogram(I(1)));
+}
+
+// _____________________________________________________________________________
+TEST(PredicateStatistics, estimateSelectivity) {
+  using namespace makeFilterExpression;
+  auto sample = makeIds(0, 100);
+  auto histogram =
+      ValueHistogram::fromSortedSample(sample, sample.size(), 100, 25);
+  EXPECT_DOUBLE_EQ(lt(I(10))->estimateSelectivity(histogram), 0.1);
+  EXPECT_DOUBLE_EQ(ge(I(50))->estimateSelectivity(histogram), 0.5);
+  EXPECT_DOUBLE_EQ(eq(I(42))->estimateSelectivity(histogram), 0.01);
+  EXPECT_DOUBLE_EQ(gt(I(1000))->estimateSelectivity(histogram), 0.0);
+  EXPECT_DOUBLE_EQ(
+      andExpr(ge(I(20)), lt(I(40)))->estimateSelectivity(histogram), 0.2);
+  // The column only contains integers.
+  EXPECT_DOUBLE_EQ(
+      lt(ad_utility::testing::DoubleId(1000.0))->estimateSelectivity(histogram),
+      1.0);
+  EXPECT_DOUBLE_EQ(
+      eq(ad_utility::testing::BoolId(true))->estimateSelectivity(histogram),
+      0.0);
+  EXPECT_DOUBLE_EQ(lt(I(10))->estimateSelectivity(ValueHistogram{}), 1.0);
+}
+
+// _____________________________________________________________________________
+TEST(PredicateStatistics, estimatesOfOperations) {
+  using namespace makeSparqlExpression;
+  auto qec = ad_utility::testing::getQec(makeKnowledgeGraph());
+  ASSERT_NE(qec->getIndex().getPredicateStatistics(), nullptr);
+  // A scan of `?subject <predicate> ?o`, where `?o` is the first column.
+  auto makeScan = [qec](const std::string& predicate,
+                        const std::string& subject) {
+    return ad_utility::makeExecutionTree<IndexScan>(
+        qec, Permutation::POS,
+        SparqlTripleSimple{Variable{subject},
+                           TripleComponent::Iri::fromIriref(predicate),
+                           Variable{"?o"}});
+  };
+
+  // The object column of a scan with a fixed predicate has the histogram of
+  // the predicate.
+  auto scanP = makeScan("<p>", "?x");
+  const ValueHistogram* histogram =
+      scanP->getRootOperation()->getValueHistogram(0);
+  ASSERT_NE(histogram, nullptr);
+  EXPECT_EQ(histogram->numValues(), 100);
+  EXPECT_EQ(histogram->numDistinctValues(), 100);
+  EXPECT_EQ(scanP->getRootOperation()->getValueHistogram(1), nullptr);
+
+  // The size estimate of a `Filter` uses the histogram.
+  Filter filter{qec, scanP, {ltSprql(Variable{"?o"}, I(10)), "?o < 10"}};
+  EXPECT_EQ(filter.getSizeEstimate(), 10);
+
+  // Joins on columns with disjoint values are estimated to be small.
+  auto scanQ = makeScan("<q>", "?y");
+  auto scanR = makeScan("<r>", "?z");
+  Join disjoint{qec, makeScan("<p>", "?x"), scanQ, 0, 0};
+  Join overlapping{qec, makeScan("<p>", "?x"), scanR, 0, 0};
+  EXPECT_EQ(disjoint.getSizeEstimate(), 1);
+  EXPECT_GT(overlapping.getSizeEstimate(), 10);
+}
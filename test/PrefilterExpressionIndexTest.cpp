@@ -682,6 +682,116 @@ TEST_F(PrefilterExpressionOnMetadataTest, testEqualityOperator) {
                *orExpr(eq(IntId(0)), le(IntId(0))));
 }
 
+//______________________________________________________________________________
+// Test the evaluation of PrefilterExpressions on the single rows of a column
+// (`evaluateOnIds`).
+TEST(PrefilterExpressionOnIdsTest, testEvaluateOnIds) {
+  using Mask = std::vector<uint8_t>;
+  auto evaluate = [](const std::unique_ptr<PrefilterExpression>& expr,
+                     const std::vector<Id>& ids) {
+    return expr->evaluateOnIds(ids);
+  };
+  // Columns with a single datatype.
+  const std::vector<Id> ints{IntId(-3), IntId(0), IntId(2), IntId(5),
+                             IntId(7)};
+  EXPECT_EQ(evaluate(lt(IntId(2)), ints), (Mask{1, 1, 0, 0, 0}));
+  EXPECT_EQ(evaluate(le(IntId(2)), ints), (Mask{1, 1, 1, 0, 0}));
+  EXPECT_EQ(evaluate(eq(IntId(2)), ints), (Mask{0, 0, 1, 0, 0}));
+  EXPECT_EQ(evaluate(neq(IntId(2)), ints), (Mask{1, 1, 0, 1, 1}));
+  EXPECT_EQ(evaluate(ge(IntId(2)), ints), (Mask{0, 0, 1, 1, 1}));
+  EXPECT_EQ(evaluate(gt(IntId(-4)), ints), (Mask{1, 1, 1, 1, 1}));
+  EXPECT_EQ(evaluate(gt(DoubleId(0.5)), ints), (Mask{0, 0, 1, 1, 1}));
+  EXPECT_EQ(evaluate(lt(VocabId(10)), ints), (Mask{0, 0, 0, 0, 0}));
+  const std::vector<Id> vocab{VocabId(1), VocabId(10), VocabId(10),
+                              VocabId(20)};
+  EXPECT_EQ(evaluate(lt(VocabId(10)), vocab), (Mask{1, 0, 0, 0}));
+  EXPECT_EQ(evaluate(eq(VocabId(10)), vocab), (Mask{0, 1, 1, 0}));
+  EXPECT_EQ(evaluate(ge(VocabId(10)), vocab), (Mask{0, 1, 1, 1}));
+  EXPECT_EQ(evaluate(eq(IntId(10)), vocab), (Mask{0, 0, 0, 0}));
+  EXPECT_TRUE(evaluate(lt(IntId(2)), {}).empty());
+
+  // Columns with mixed datatypes. Values that can't be compared to the
+  // reference value are never relevant.
+  const std::vector<Id> mixed{IntId(3), DoubleId(2.5), VocabId(10), UndefId(),
+                              DoubleId(4), IntId(1)};
+  EXPECT_EQ(evaluate(gt(IntId(2)), mixed), (Mask{1, 1, 0, 0, 1, 0}));
+  EXPECT_EQ(evaluate(neq(DoubleId(3)), mixed), (Mask{0, 1, 0, 0, 1, 1}));
+  EXPECT_EQ(evaluate(le(VocabId(10)), mixed), (Mask{0, 0, 1, 0, 0, 0}));
+
+  // Logical expressions.
+  EXPECT_EQ(evaluate(andExpr(gt(IntId(0)), lt(IntId(7))), ints),
+            (Mask{0, 0, 1, 1, 0}));
+  EXPECT_EQ(evaluate(orExpr(lt(IntId(0)), ge(IntId(7))), ints),
+            (Mask{1, 0, 0, 0, 1}));
+  EXPECT_EQ(evaluate(notExpr(eq(IntId(2))), ints), (Mask{1, 1, 0, 1, 1}));
+  EXPECT_EQ(evaluate(notExpr(andExpr(gt(IntId(0)), lt(IntId(7)))), ints),
+            (Mask{1, 1, 0, 0, 1}));
+  EXPECT_EQ(evaluate(notExpr(notExpr(gt(IntId(2)))), mixed),
+            (Mask{1, 1, 0, 0, 1, 0}));
+  EXPECT_EQ(evaluate(orExpr(eq(VocabId(10)), lt(DoubleId(2))), mixed),
+            (Mask{0, 0, 1, 0, 0, 1}));
+}
+
+//______________________________________________________________________________
+// Test the evaluation of PrefilterExpressions on the column summaries of the
+// blocks (`mayContainRelevantIds` and `evaluateOnColumnSummaries`).
+TEST(PrefilterExpressionOnColumnSummariesTest, testMayContainRelevantIds) {
+  using Mask = std::vector<uint8_t>;
+  auto summary = [](const std::vector<Id>& ids) {
+    ColumnSummary result;
+    for (Id id : ids) {
+      result.add(id);
+    }
+    return result;
+  };
+  const std::vector<ColumnSummary> summaries{
+      summary({IntId(1), IntId(5), IntId(3)}),
+      summary({IntId(-7), IntId(-2)}),
+      // Mixed numeric datatypes.
+      summary({DoubleId(2.5), IntId(10)}),
+      summary({VocabId(10), VocabId(20), VocabId(15)}),
+      // Mixed datatypes that can't be compared to each other.
+      summary({VocabId(10), IntId(3)}),
+      summary({IntId(3), IntId(3)})};
+  auto evaluate = [&summaries](const std::unique_ptr<PrefilterExpression>& e) {
+    return e->mayContainRelevantIds(summaries);
+  };
+  EXPECT_EQ(evaluate(gt(IntId(4))), (Mask{1, 0, 1, 0, 1, 0}));
+  EXPECT_EQ(evaluate(lt(IntId(0))), (Mask{0, 1, 1, 0, 1, 0}));
+  EXPECT_EQ(evaluate(eq(IntId(4))), (Mask{1, 0, 1, 0, 1, 0}));
+  EXPECT_EQ(evaluate(eq(IntId(6))), (Mask{0, 0, 1, 0, 1, 0}));
+  EXPECT_EQ(evaluate(eq(IntId(3))), (Mask{1, 0, 1, 0, 1, 1}));
+  EXPECT_EQ(evaluate(neq(IntId(3))), (Mask{1, 1, 1, 0, 1, 0}));
+  EXPECT_EQ(evaluate(ge(VocabId(15))), (Mask{0, 0, 0, 1, 1, 0}));
+  EXPECT_EQ(evaluate(lt(VocabId(10))), (Mask{0, 0, 0, 0, 1, 0}));
+  EXPECT_EQ(evaluate(andExpr(gt(IntId(0)), lt(VocabId(0)))),
+            (Mask{0, 0, 0, 0, 1, 0}));
+  EXPECT_EQ(evaluate(orExpr(lt(IntId(0)), ge(VocabId(15)))),
+            (Mask{0, 1, 1, 1, 1, 0}));
+  EXPECT_EQ(evaluate(notExpr(ge(IntId(1)))), (Mask{0, 1, 1, 0, 1, 0}));
+  EXPECT_TRUE(gt(IntId(4))->mayContainRelevantIds({}).empty());
+
+  // Blocks without summaries are always relevant.
+  auto makeBlock = [](size_t blockIndex,
+                      std::optional<ColumnSummary> summaryCol2) {
+    BlockMetadata block{};
+    block.blockIndex_ = blockIndex;
+    if (summaryCol2.has_value()) {
+      block.columnSummaries_ =
+          std::array{ColumnSummary{}, ColumnSummary{}, summaryCol2.value()};
+    }
+    return block;
+  };
+  const std::vector<BlockMetadata> blocks{
+      makeBlock(0, summary({IntId(1), IntId(5)})), makeBlock(1, std::nullopt),
+      makeBlock(2, summary({IntId(-7)})), makeBlock(3, summary({IntId(7)}))};
+  EXPECT_THAT(gt(IntId(4))->evaluateOnColumnSummaries(blocks, 2),
+              ::testing::ElementsAre(blocks[0], blocks[1], blocks[3]));
+  EXPECT_THAT(lt(IntId(-10))->evaluateOnColumnSummaries(blocks, 2),
+              ::testing::ElementsAre(blocks[1]));
+  EXPECT_ANY_THROW(gt(IntId(4))->evaluateOnColumnSummaries(blocks, 3));
+}
+
 //______________________________________________________________________________
 // Test PrefilterExpression content formatting for debugging.
 TEST(PrefilterExpressionExpressionOnMetadataTest,
@@ -3,9 +3,11 @@
 // Authors: Björn Buchhold <buchhold@cs.uni-freiburg.de> [2015 - 2017]
 //          Johannes Kalmbach <kalmbach@cs.uni-freiburg.de> [2018 - 2024]
 
+#include <absl/strings/str_join.h>
 #include <gmock/gmock.h>
 
 #include "./printers/PayloadVariablePrinters.h"
+#include "./util/RuntimeParametersTestHelpers.h"
 #include "QueryPlannerTestHelpers.h"
 #include "engine/QueryPlanner.h"
 #include "engine/SpatialJoin.h"
@@ -312,6 +314,20 @@ TEST(QueryPlanner, testActorsBornInEurope) {
                             scan("?c", "<pre/in>", "<pre/Europe>"))));
 }
 
+// _____________________________________________________________________________
+TEST(QueryPlanner, orderByWithLimitUsesTopK) {
+  auto scan = h::IndexScanFromStrings;
+  using enum ::OrderBy::AscOrDesc;
+  h::expect("SELECT * { ?x <p> ?y } ORDER BY DESC(?y) LIMIT 10 OFFSET 5",
+            h::TopK({{Variable{"?y"}, Desc}}, scan("?x", "<p>", "?y")));
+  // No limit, or a limit that is too large for the `TopK` operation.
+  h::expect("SELECT * { ?x <p> ?y } ORDER BY DESC(?y) OFFSET 5",
+            h::OrderBy({{Variable{"?y"}, Desc}}, scan("?x", "<p>", "?y")));
+  auto cleanup = setRuntimeParameterForTest<"top-k-max-num-rows">(size_t{14});
+  h::expect("SELECT * { ?x <p> ?y } ORDER BY DESC(?y) LIMIT 10 OFFSET 5",
+            h::OrderBy({{Variable{"?y"}, Desc}}, scan("?x", "<p>", "?y")));
+}
+
 TEST(QueryPlanner, testStarTwoFree) {
   auto scan = h::IndexScanFromStrings;
   h::expect(
@@ -2913,3 +2929,55 @@ TEST(QueryPlanner, GroupByRedundanteParensAndVariables) {
   h::expect("SELECT ?x { ?x ?y ?z} GROUP BY ?x ?x", matcher);
   h::expect("SELECT ?x { ?x ?y ?z} GROUP BY ?x ?x (?x)", matcher);
 }
+
+// ____________________________________________________________________________
+TEST(QueryPlanner, HashJoinIsChosenForUnsortedInputs) {
+  // Return a `VALUES` clause for `?x` with `numRows` rows, and the cache key
+  // of the corresponding `Values` operation. A `VALUES` clause is not sorted,
+  // so a `Join` would have to sort it.
+  auto values = [](size_t numRows, bool withUndef = false) {
+    std::vector<std::string> rows;
+    for (size_t i = 0; i < numRows; ++i) {
+      rows.push_back(absl::StrCat("<a", i, ">"));
+    }
+    if (withUndef) {
+      rows.back() = "UNDEF";
+    }
+    return std::pair{
+        absl::StrCat("VALUES ?x { ", absl::StrJoin(rows, " "), " }"),
+        absl::StrCat("VALUES (?x) { (", absl::StrJoin(rows, ") ("), ") }")};
+  };
+  auto [values16, key16] = values(16);
+  auto [values20, key20] = values(20);
+  std::string query =
+      absl::StrCat("SELECT * { ", values16, " ", values20, " }");
+  auto isJoin = h::RootOperation<::Join>(::testing::_);
+
+  // With the default `hash-join-min-input-size`, the inputs are too small.
+  h::expect(query, isJoin);
+
+  auto cleanup =
+      setRuntimeParameterForTest<"hash-join-min-input-size">(size_t{1});
+  h::expect(query, h::HashJoin(h::ValuesClause(key16), h::ValuesClause(key20)));
+
+  // The join column of one of the inputs might be undefined.
+  auto [valuesWithUndef, keyWithUndef] = values(16, true);
+  h::expect(absl::StrCat("SELECT * { ", valuesWithUndef, " ", values20, " }"),
+            isJoin);
+
+  // One of the inputs is already sorted on the join column.
+  h::expect(absl::StrCat("SELECT * { ", values16, " ?x <p> ?y }"), isJoin);
+
+  // The build side (16 rows with a single column) does not fit into the
+  // memory that a `HashJoin` may use for it.
+  {
+    auto cleanupMemory =
+        setRuntimeParameterForTest<"hash-join-max-build-side-size">(
+            ad_utility::MemorySize::bytes(16 * sizeof(Id) - 1));
+    h::expect(query, isJoin);
+  }
+  auto cleanupMemory =
+      setRuntimeParameterForTest<"hash-join-max-build-side-size">(
+          ad_utility::MemorySize::bytes(16 * sizeof(Id)));
+  h::expect(query, h::HashJoin(h::ValuesClause(key16), h::ValuesClause(key20)));
+}
@@ -17,6 +17,7 @@
 #include "engine/Describe.h"
 #include "engine/Filter.h"
 #include "engine/GroupBy.h"
+#include "engine/HashJoin.h"
 #include "engine/IndexScan.h"
 #include "engine/Join.h"
 #include "engine/Minus.h"
@@ -32,6 +33,7 @@
 #include "engine/TextIndexScanForEntity.h"
 #include "engine/TextIndexScanForWord.h"
 #include "engine/TextLimit.h"
+#include "engine/TopK.h"
 #include "engine/TransitivePathBase.h"
 #include "engine/Union.h"
 #include "engine/Values.h"
@@ -239,6 +241,7 @@ inline auto IndexScanFromStrings =
 // For the following Join algorithms the order of the children is not important.
 inline auto MultiColumnJoin = MatchTypeAndUnorderedChildren<::MultiColumnJoin>;
 inline auto Join = MatchTypeAndUnorderedChildren<::Join>;
+inline auto HashJoin = MatchTypeAndUnorderedChildren<::HashJoin>;
 
 constexpr auto OptionalJoin = MatchTypeAndOrderedChildren<::OptionalJoin>;
 
@@ -393,6 +396,14 @@ constexpr auto OrderBy = [](const ::OrderBy::SortedVariables& sortedVariables,
             AD_PROPERTY(::OrderBy, getSortedVariables, Eq(sortedVariables))));
 };
 
+// Match a `TopK` operation
+constexpr auto TopK = [](const ::OrderBy::SortedVariables& sortedVariables,
+                         const QetMatcher& childMatcher) {
+  return RootOperation<::TopK>(
+      AllOf(children(childMatcher),
+            AD_PROPERTY(::TopK, getSortedVariables, Eq(sortedVariables))));
+};
+
 // Match a `UNION` operation.
 constexpr auto Union = MatchTypeAndOrderedChildren<::Union>;
 
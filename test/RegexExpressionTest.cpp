@@ -2,16 +2,23 @@
 // Chair of Algorithms and Data Structures
 // Author: Johannes Kalmbach <kalmbacj@cs.uni-freiburg.de>
 
+#include <absl/strings/str_cat.h>
+
 #include <optional>
 #include <string>
 
 #include "./SparqlExpressionTestHelpers.h"
 #include "./util/GTestHelpers.h"
 #include "./util/TripleComponentTestHelpers.h"
+#include "absl/cleanup/cleanup.h"
+#include "engine/QueryExecutionContext.h"
 #include "engine/sparqlExpressions/LiteralExpression.h"
 #include "engine/sparqlExpressions/NaryExpression.h"
 #include "engine/sparqlExpressions/RegexExpression.h"
+#include "gmock/gmock.h"
 #include "gtest/gtest.h"
+#include "index/IndexImpl.h"
+#include "util/File.h"
 
 using namespace sparqlExpression;
 using ad_utility::source_location;
@@ -193,6 +200,164 @@ TEST(RegexExpression, getPrefixRegex) {
   ASSERT_THROW(getPrefixRegex(R"(^\")"), std::runtime_error);
 }
 
+// Test the computation of the candidate words for a regex with the help of the
+// trigram index of the vocabulary.
+TEST(RegexExpression, regexVocabularyPrefilter) {
+  using namespace sparqlExpression::detail;
+  using ::testing::ElementsAre;
+  using ::testing::Optional;
+  std::vector<std::string> words{"\"Berlin\"@en", "\"berliner\"",
+                                 "<http://example.org/Berlin>", "\"Munich\"",
+                                 "\"Bern\"",        "\"ΟΔΟΣ\"",
+                                 "\"οδός\""};
+  std::string filename = "regexVocabularyPrefilter.trigrams";
+  VocabularyTrigramIndex::build(filename, "#testIndex", words.size(),
+                                [&words](size_t i) { return words.at(i); });
+  auto index = VocabularyTrigramIndex::readFromFile(filename);
+  ad_utility::deleteFile(filename);
+  ad_utility::deleteFile(
+      absl::StrCat(filename, VocabularyTrigramIndex::postingsSuffix_));
+  auto candidates = [&index](const std::string& regex) {
+    RegexVocabularyPrefilter prefilter{regex};
+    return prefilter.computeCandidates(index);
+  };
+
+  // The required substrings are lowercase and case-insensitive regexes are
+  // also supported.
+  EXPECT_THAT(RegexVocabularyPrefilter{"Berlin"}.requiredSubstrings(),
+              ElementsAre("berlin"));
+  EXPECT_THAT(candidates("Berlin"), Optional(ElementsAre(0, 1, 2)));
+  EXPECT_THAT(candidates("(?i:bErLiN)"), Optional(ElementsAre(0, 1, 2)));
+  EXPECT_THAT(candidates("berliner|munich"), Optional(ElementsAre(1, 3)));
+  EXPECT_THAT(candidates("ber.*lin"), Optional(ElementsAre(0, 1, 2)));
+  EXPECT_THAT(candidates("hamburg"), Optional(ElementsAre()));
+
+  // Non-ASCII substrings. RE2 lowercases each code point of the required
+  // substrings on its own (so the final sigma becomes a regular sigma), which
+  // must be consistent with the normalization of the words.
+  EXPECT_THAT(candidates("ΟΔΟΣ"), Optional(ElementsAre(5)));
+  EXPECT_THAT(candidates("(?i)οδος"), Optional(ElementsAre(5)));
+  EXPECT_THAT(candidates("(?i)ΟΔΌΣ"), Optional(ElementsAre(6)));
+
+  // Regexes that can match without a substring of at least three characters.
+  EXPECT_FALSE(RegexVocabularyPrefilter{"b.*"}.isApplicable());
+  EXPECT_FALSE(RegexVocabularyPrefilter{"berlin|xy"}.isApplicable());
+  EXPECT_FALSE(RegexVocabularyPrefilter{"(ber)?"}.isApplicable());
+  EXPECT_EQ(candidates("b.*"), std::nullopt);
+}
+
+// Evaluate regexes on an index that has a trigram index of its vocabulary.
+TEST(RegexExpression, evaluateWithVocabularyTrigramIndex) {
+  std::string basename = "regexWithVocabularyTrigramIndex";
+  std::string turtle =
+      "<x> <label> \"Berlin\" . <x> <label> \"Munich\" . "
+      "<x> <label> <http://example.org/Berlin> .";
+  auto trigramIndexFilename =
+      absl::StrCat(basename, VOCAB_TRIGRAM_INDEX_SUFFIX);
+  auto postingsFilename = absl::StrCat(trigramIndexFilename,
+                                       VocabularyTrigramIndex::postingsSuffix_);
+  absl::Cleanup cleanup{[&]() {
+    for (const auto& filename :
+         ad_utility::testing::getAllIndexFilenames(basename)) {
+      ad_utility::deleteFile(filename, false);
+    }
+    ad_utility::deleteFile(trigramIndexFilename, false);
+    ad_utility::deleteFile(postingsFilename, false);
+  }};
+  ad_utility::testing::makeTestIndex(basename, turtle)
+      .buildVocabularyTrigramIndex();
+  auto loadIndex = [&basename]() {
+    auto index =
+        std::make_unique<Index>(ad_utility::makeUnlimitedAllocator<Id>());
+    index->createFromOnDiskIndex(basename);
+    return index;
+  };
+  auto index = loadIndex();
+  index->getImpl().setGlobalIndexAndComparatorOnlyForTesting();
+  ASSERT_NE(index->getVocabularyTrigramIndex(), nullptr);
+
+  QueryResultCache cache;
+  QueryExecutionContext qec{*index, &cache,
+                            ad_utility::makeUnlimitedAllocator<Id>(),
+                            SortPerformanceEstimator{}};
+  auto getId = ad_utility::testing::makeGetId(*index);
+  LocalVocab localVocab;
+  auto localLiteral = [&localVocab](std::string_view s) {
+    return Id::makeFromLocalVocabIndex(localVocab.getIndexAndAddIfNotContained(
+        ad_utility::triple_component::LiteralOrIri::literalWithoutQuotes(s)));
+  };
+  auto inlineLiteral = [](std::string_view s) {
+    return Id::makeFromInlineString(
+        InlineString::make(absl::StrCat("\"", s, "\"")).value());
+  };
+  // The vocabulary words `"Munich"` and `<x>` are not candidates for the
+  // regex `Ber`, the others are.
+  auto candidates = sparqlExpression::detail::RegexVocabularyPrefilter{"Ber"}
+                        .computeCandidates(*index->getVocabularyTrigramIndex());
+  ASSERT_TRUE(candidates.has_value());
+  auto isCandidate = [&candidates, &getId](const std::string& word) {
+    return ql::ranges::binary_search(candidates.value(),
+                                     getId(word).getVocabIndex().get());
+  };
+  EXPECT_TRUE(isCandidate("\"Berlin\""));
+  EXPECT_TRUE(isCandidate("<http://example.org/Berlin>"));
+  EXPECT_FALSE(isCandidate("\"Munich\""));
+  EXPECT_FALSE(isCandidate("<x>"));
+  IdTable table{1, ad_utility::makeUnlimitedAllocator<Id>()};
+  for (Id id : {getId("\"Berlin\""), getId("\"Munich\""),
+                getId("<http://example.org/Berlin>"), getId("<x>"),
+                localLiteral("Berliner"), localLiteral("Hamburg"),
+                inlineLiteral("Bern"), inlineLiteral("Rom")}) {
+    table.push_back({id});
+  }
+  VariableToColumnMap varToColMap;
+  varToColMap[Variable{"?s"}] = makeAlwaysDefinedColumn(0);
+  sparqlExpression::EvaluationContext context{
+      qec,
+      varToColMap,
+      table,
+      qec.getAllocator(),
+      localVocab,
+      std::make_shared<ad_utility::CancellationHandle<>>(),
+      EvaluationContext::TimePoint::max()};
+  context._beginIndex = 0;
+  context._endIndex = table.size();
+
+  auto test = [&context](std::string regex, bool childAsStr,
+                         const std::vector<Id>& expected,
+                         source_location l = source_location::current()) {
+    auto trace = generateLocationTrace(l);
+    auto expr = makeRegexExpression("?s", std::move(regex), std::nullopt,
+                                    childAsStr);
+    ASSERT_FALSE(expr.isPrefixExpression());
+    auto result = expr.evaluate(&context);
+    EXPECT_THAT(std::get<VectorWithMemoryLimit<Id>>(result),
+                ::testing::ElementsAreArray(expected));
+  };
+  // Words of the vocabulary that are no candidates are `false` without looking
+  // at them. Without `STR()`, IRIs are `UNDEF`, so for those the trigram index
+  // is not used. Words from the local vocab and inline strings are always
+  // evaluated.
+  test("Ber", false, {T, F, U, U, T, F, T, F});
+  test("Ber", true, {T, F, T, F, T, F, T, F});
+  test("(?i)bErLiN", true, {T, F, T, F, T, F, F, F});
+  test("Berlin|Munich", false, {T, T, U, U, T, F, F, F});
+  // A regex that the trigram index can't be used for.
+  test("B.r", false, {T, F, U, U, T, F, T, F});
+
+  // A trigram index that was built for a different index is ignored.
+  VocabularyTrigramIndex::build(trigramIndexFilename, "#otherIndex",
+                                index->getVocab().size(),
+                                [](size_t) { return std::string{"\"Rom\""}; });
+  EXPECT_EQ(loadIndex()->getVocabularyTrigramIndex(), nullptr);
+
+  // Building an index removes the trigram index of a previous index with the
+  // same name.
+  ad_utility::testing::makeTestIndex(basename, turtle);
+  EXPECT_FALSE(std::filesystem::exists(trigramIndexFilename));
+  EXPECT_FALSE(std::filesystem::exists(postingsFilename));
+}
+
 auto testPrefixRegexUnorderedColumn =
     [](std::string variable, std::string regex,
        const std::vector<Id>& expectedResult, bool childAsStr = false,
@@ -0,0 +1,183 @@
+//  Copyright 2025, University of Freiburg,
+//                  Chair of Algorithms and Data Structures.
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <mutex>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "util/SharedWorkerPool.h"
+#include "util/jthread.h"
+
+using ad_utility::SharedWorkerPool;
+
+namespace {
+// Return a producer that yields the values `0, ..., numValues - 1` (with
+// matching indices) and keeps track of the maximal number of concurrent calls
+// in `maxNumConcurrentCalls`.
+auto makeProducer(size_t numValues, std::atomic<size_t>& maxNumConcurrentCalls,
+                  std::atomic<size_t>& numConcurrentCalls) {
+  auto mutex = std::make_shared<std::mutex>();
+  auto next = std::make_shared<size_t>(0);
+  return [numValues, mutex, next, &maxNumConcurrentCalls,
+          &numConcurrentCalls]() -> std::optional<std::pair<size_t, size_t>> {
+    auto numCalls = ++numConcurrentCalls;
+    size_t previous = maxNumConcurrentCalls.load();
+    while (previous < numCalls &&
+           !maxNumConcurrentCalls.compare_exchange_weak(previous, numCalls)) {
+    }
+    std::unique_lock lock{*mutex};
+    auto i = (*next)++;
+    lock.unlock();
+    // Make the values arrive out of order.
+    std::this_thread::sleep_for(std::chrono::microseconds((i * 7) % 5 * 50));
+    --numConcurrentCalls;
+    if (i >= numValues) {
+      return std::nullopt;
+    }
+    return std::pair{i, i};
+  };
+}
+
+// Consume the `generator` and return the yielded values.
+std::vector<size_t> toVector(cppcoro::generator<size_t> generator) {
+  std::vector<size_t> result;
+  for (size_t value : generator) {
+    result.push_back(value);
+  }
+  return result;
+}
+
+std::vector<size_t> iota(size_t n) {
+  std::vector<size_t> result(n);
+  std::iota(result.begin(), result.end(), 0);
+  return result;
+}
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(SharedWorkerPool, valuesAreYieldedInOrder) {
+  SharedWorkerPool pool{4};
+  EXPECT_EQ(pool.numThreads(), 4);
+  std::atomic<size_t> maxNumConcurrentCalls = 0;
+  std::atomic<size_t> numConcurrentCalls = 0;
+  auto producer = makeProducer(200, maxNumConcurrentCalls, numConcurrentCalls);
+  EXPECT_THAT(toVector(pool.orderedGenerator<size_t>(10, 3, producer)),
+              ::testing::ElementsAreArray(iota(200)));
+  EXPECT_LE(maxNumConcurrentCalls, 3);
+  EXPECT_GT(pool.busyTime().count(), 0);
+
+  // A pool with zero threads still has a single worker.
+  SharedWorkerPool smallPool{0};
+  EXPECT_EQ(smallPool.numThreads(), 1);
+  auto smallProducer =
+      makeProducer(20, maxNumConcurrentCalls, numConcurrentCalls);
+  EXPECT_THAT(toVector(smallPool.orderedGenerator<size_t>(2, 2, smallProducer)),
+              ::testing::ElementsAreArray(iota(20)));
+
+  // Zero values in flight are not allowed.
+  EXPECT_ANY_THROW(toVector(pool.orderedGenerator<size_t>(0, 1, producer)));
+}
+
+// _____________________________________________________________________________
+TEST(SharedWorkerPool, concurrentJobs) {
+  SharedWorkerPool pool{3};
+  std::vector<std::atomic<size_t>> maxNumConcurrentCalls(5);
+  std::vector<std::atomic<size_t>> numConcurrentCalls(5);
+  std::vector<std::vector<size_t>> results(5);
+  {
+    std::vector<ad_utility::JThread> consumers;
+    for (size_t i = 0; i < 5; ++i) {
+      consumers.emplace_back([&, i]() {
+        results[i] = toVector(pool.orderedGenerator<size_t>(
+            4, 2,
+            makeProducer(100 * (i + 1), maxNumConcurrentCalls[i],
+                         numConcurrentCalls[i])));
+      });
+    }
+  }
+  for (size_t i = 0; i < 5; ++i) {
+    EXPECT_THAT(results[i], ::testing::ElementsAreArray(iota(100 * (i + 1))));
+    EXPECT_LE(maxNumConcurrentCalls[i], 2);
+  }
+}
+
+// _____________________________________________________________________________
+TEST(SharedWorkerPool, backPressure) {
+  SharedWorkerPool pool{4};
+  std::atomic<size_t> numCalls = 0;
+  auto producer = [&numCalls]() -> std::optional<std::pair<size_t, size_t>> {
+    auto i = numCalls++;
+    return std::pair{i, i};
+  };
+  auto generator = pool.orderedGenerator<size_t>(3, 4, producer);
+  auto it = generator.begin();
+  EXPECT_EQ(*it, 0);
+  // Give the workers the chance to run ahead. The generator has yielded one
+  // value, so at most one value plus the three values in flight can have been
+  // produced.
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  EXPECT_LE(numCalls, 4);
+  ++it;
+  EXPECT_EQ(*it, 1);
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  EXPECT_LE(numCalls, 5);
+}
+
+// _____________________________________________________________________________
+TEST(SharedWorkerPool, exceptionIsPropagated) {
+  SharedWorkerPool pool{2};
+  std::atomic<size_t> numCalls = 0;
+  auto producer = [&numCalls]() -> std::optional<std::pair<size_t, size_t>> {
+    auto i = numCalls++;
+    if (i == 5) {
+      throw std::runtime_error{"producer failed"};
+    }
+    return std::pair{i, i};
+  };
+  EXPECT_THROW(toVector(pool.orderedGenerator<size_t>(2, 2, producer)),
+               std::runtime_error);
+
+  // The pool is still usable after the failure.
+  std::atomic<size_t> maxNumConcurrentCalls = 0;
+  std::atomic<size_t> numConcurrentCalls = 0;
+  auto validProducer =
+      makeProducer(30, maxNumConcurrentCalls, numConcurrentCalls);
+  EXPECT_THAT(toVector(pool.orderedGenerator<size_t>(5, 2, validProducer)),
+              ::testing::ElementsAreArray(iota(30)));
+}
+
+// _____________________________________________________________________________
+TEST(SharedWorkerPool, generatorIsDestroyedEarly) {
+  SharedWorkerPool pool{4};
+  std::atomic<size_t> numCalls = 0;
+  auto producer = [&numCalls]() -> std::optional<std::pair<size_t, size_t>> {
+    auto i = numCalls++;
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    return std::pair{i, i};
+  };
+  {
+    auto generator = pool.orderedGenerator<size_t>(8, 4, producer);
+    size_t numConsumed = 0;
+    for (size_t value : generator) {
+      EXPECT_EQ(value, numConsumed);
+      if (++numConsumed == 10) {
+        break;
+      }
+    }
+  }
+  // After the generator has been destroyed, the producer is not called
+  // anymore.
+  auto numCallsAfterDestruction = numCalls.load();
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  EXPECT_EQ(numCalls, numCallsAfterDestruction);
+
+  // A generator that is destroyed before it is started never registers a job.
+  { auto unused = pool.orderedGenerator<size_t>(8, 4, producer); }
+  EXPECT_EQ(numCalls, numCallsAfterDestruction);
+}
@@ -6,6 +6,8 @@
 #include <gtest/gtest.h>
 
 #include "./util/IdTableHelpers.h"
+#include "./util/RuntimeParametersTestHelpers.h"
+#include "engine/ExternalSort.h"
 #include "engine/Sort.h"
 #include "engine/ValuesForTesting.h"
 #include "global/ValueIdComparators.h"
@@ -196,3 +198,142 @@ TEST(Sort, verifyOperationIsPreemptivelyAbortedWithNoRemainingTime) {
       sort.getResult(true), ::testing::HasSubstr("time estimate exceeded"),
       ad_utility::CancellationException);
 }
+
+// _____________________________________________________________________________
+TEST(Sort, externalSortForLazyResults) {
+  auto qec = ad_utility::testing::getQec();
+  // Every input with more than four rows is too large to be sorted in RAM.
+  auto cleanup = setRuntimeParameterForTest<"sort-in-memory-threshold">(
+      ad_utility::MemorySize::bytes(4 * 2 * sizeof(Id)));
+  std::vector<IdTable> blocks;
+  blocks.push_back(makeIdTableFromVector({{7, 1}, {3, 2}, {5, 0}}));
+  blocks.push_back(makeIdTableFromVector({{3, 1}, {8, 8}}));
+  blocks.push_back(makeIdTableFromVector({{0, 4}, {7, 0}, {1, 1}, {2, 9}}));
+  auto expected = makeIdTableFromVector({{5, 0},
+                                         {7, 0},
+                                         {1, 1},
+                                         {3, 1},
+                                         {7, 1},
+                                         {3, 2},
+                                         {0, 4},
+                                         {8, 8},
+                                         {2, 9}});
+  auto makeTree = [&qec](std::vector<IdTable> tables) {
+    return ad_utility::makeExecutionTree<ValuesForTesting>(
+        qec, std::move(tables),
+        std::vector<std::optional<Variable>>{Variable{"?0"}, Variable{"?1"}});
+  };
+  auto cloneBlocks = [&blocks]() {
+    std::vector<IdTable> clones;
+    for (const auto& block : blocks) {
+      clones.push_back(block.clone());
+    }
+    return clones;
+  };
+
+  // A lazy input is sorted externally and yields a lazy result.
+  {
+    qec->getQueryTreeCache().clearAll();
+    Sort sort{qec, makeTree(cloneBlocks()), {1, 0}};
+    auto result = sort.getResult(true);
+    ASSERT_FALSE(result->isFullyMaterialized());
+    EXPECT_EQ(aggregateTables(std::move(result->idTables()), 2).first,
+              expected);
+    EXPECT_EQ(sort.runtimeInfo().details_["external-sort"], true);
+  }
+
+  // A small lazy input is still sorted in RAM.
+  {
+    qec->getQueryTreeCache().clearAll();
+    std::vector<IdTable> tables;
+    tables.push_back(blocks.at(1).clone());
+    tables.push_back(makeIdTableFromVector({{0, 0}}));
+    Sort sort{qec, makeTree(std::move(tables)), {0}};
+    auto result = sort.getResult(true);
+    ASSERT_TRUE(result->isFullyMaterialized());
+    EXPECT_EQ(result->idTable(),
+              makeIdTableFromVector({{0, 0}, {3, 1}, {8, 8}}));
+  }
+
+  // A large materialized input is also sorted externally if the result is
+  // requested lazily, but not if it is requested fully materialized.
+  {
+    qec->getQueryTreeCache().clearAll();
+    IdTable input{2, qec->getAllocator()};
+    for (const auto& block : blocks) {
+      input.insertAtEnd(block);
+    }
+    auto makeSortForMaterializedInput = [&]() {
+      return Sort{qec,
+                  ad_utility::makeExecutionTree<ValuesForTesting>(
+                      qec, input.clone(),
+                      std::vector<std::optional<Variable>>{Variable{"?0"},
+                                                           Variable{"?1"}},
+                      false, std::vector<ColumnIndex>{}, LocalVocab{},
+                      std::nullopt, true),
+                  {1, 0}};
+    };
+    auto sort = makeSortForMaterializedInput();
+    auto result = sort.getResult(true);
+    ASSERT_FALSE(result->isFullyMaterialized());
+    EXPECT_EQ(aggregateTables(std::move(result->idTables()), 2).first,
+              expected);
+
+    qec->getQueryTreeCache().clearAll();
+    auto sort2 = makeSortForMaterializedInput();
+    auto result2 = sort2.getResult(false);
+    ASSERT_TRUE(result2->isFullyMaterialized());
+    EXPECT_EQ(result2->idTable(), expected);
+  }
+}
+
+// _____________________________________________________________________________
+TEST(Sort, externalSortRespectsMemoryLimit) {
+  using ad_utility::MemorySize;
+  auto cleanup = setRuntimeParameterForTest<"sort-in-memory-threshold">(
+      MemorySize::bytes(1000 * sizeof(Id)));
+  // The maximal size for a sort in RAM is the minimum of the threshold and
+  // half of the memory that is left.
+  auto unlimited = ad_utility::makeUnlimitedAllocator<Id>();
+  EXPECT_FALSE(externalSort::isTooLargeForSortInMemory(500, 2, unlimited));
+  EXPECT_TRUE(externalSort::isTooLargeForSortInMemory(501, 2, unlimited));
+  auto limited =
+      ad_utility::makeAllocatorWithLimit<Id>(MemorySize::bytes(400 * 8));
+  EXPECT_FALSE(externalSort::isTooLargeForSortInMemory(100, 2, limited));
+  EXPECT_TRUE(externalSort::isTooLargeForSortInMemory(101, 2, limited));
+
+  // A lazy input that doesn't fit into the memory limit is only read until
+  // the external sort has to take over, instead of exceeding the limit.
+  auto qec = ad_utility::testing::getQec();
+  qec->getQueryTreeCache().clearAll();
+  std::vector<IdTable> blocks;
+  for (int64_t i = 0; i < 20; ++i) {
+    blocks.push_back(makeIdTableFromVector({{i, 0}, {i, 1}}));
+  }
+  ValuesForTesting values{
+      qec, std::move(blocks),
+      std::vector<std::optional<Variable>>{Variable{"?0"}, Variable{"?1"}}};
+  auto input = externalSort::readLazyInput(
+      values.getResult(true), 2,
+      ad_utility::makeAllocatorWithLimit<Id>(MemorySize::bytes(40 * 8)));
+  EXPECT_FALSE(input.isCompletelyRead());
+  EXPECT_LT(input.readRows_.numRows(), 20);
+}
+
+// _____________________________________________________________________________
+TEST(Sort, spillDirectory) {
+  auto qec = ad_utility::testing::getQec();
+  const auto& index = qec->getIndex();
+  // By default, the temporary files are written next to the index files.
+  EXPECT_THAT(getSpillFilename(index, "external-sort"),
+              ::testing::StartsWith(index.getOnDiskBase() + ".external-sort."));
+  auto directory = std::filesystem::temp_directory_path().string();
+  auto cleanup = setRuntimeParameterForTest<"spill-directory">(directory);
+  auto filename = getSpillFilename(index, "external-sort");
+  EXPECT_EQ(std::filesystem::path{filename}.parent_path(),
+            std::filesystem::path{directory});
+  EXPECT_THAT(filename, ::testing::HasSubstr(".external-sort."));
+  EXPECT_NE(filename, getSpillFilename(index, "external-sort"));
+  EXPECT_ANY_THROW(RuntimeParameters().set<"spill-directory">(
+      "/this/directory/does/not/exist"));
+}
@@ -0,0 +1,148 @@
+//  Copyright 2025, University of Freiburg,
+//                  Chair of Algorithms and Data Structures.
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "./util/IdTableHelpers.h"
+#include "./util/IdTestHelpers.h"
+#include "engine/OrderBy.h"
+#include "engine/TopK.h"
+#include "engine/ValuesForTesting.h"
+#include "util/IndexTestHelpers.h"
+#include "util/Random.h"
+
+using namespace std::string_literals;
+using ad_utility::source_location;
+
+namespace {
+auto I = ad_utility::testing::IntId;
+auto D = ad_utility::testing::DoubleId;
+
+// Create a `TopK` operation on the `blocks`. If `lazyInput` is true, then the
+// blocks are passed to the `TopK` lazily, else they are concatenated to a
+// single table.
+TopK makeTopK(std::vector<IdTable> blocks, const TopK::SortIndices& sortColumns,
+              bool lazyInput) {
+  auto qec = ad_utility::testing::getQec();
+  qec->getQueryTreeCache().clearAll();
+  std::vector<std::optional<Variable>> vars;
+  for (size_t i = 0; i < blocks.at(0).numColumns(); ++i) {
+    vars.emplace_back("?"s + std::to_string(i));
+  }
+  std::shared_ptr<QueryExecutionTree> subtree;
+  if (lazyInput) {
+    subtree = ad_utility::makeExecutionTree<ValuesForTesting>(
+        qec, std::move(blocks), vars);
+  } else {
+    IdTable input{vars.size(), ad_utility::testing::makeAllocator()};
+    for (const auto& block : blocks) {
+      input.insertAtEnd(block);
+    }
+    subtree = ad_utility::makeExecutionTree<ValuesForTesting>(
+        qec, std::move(input), vars, false, std::vector<ColumnIndex>{},
+        LocalVocab{}, std::nullopt, true);
+  }
+  return TopK{qec, std::move(subtree), sortColumns};
+}
+
+// Test that the `TopK` on the `blocks` (lazily and fully materialized) yields
+// the `expected` result.
+void testTopK(const std::vector<IdTable>& blocks,
+              const TopK::SortIndices& sortColumns,
+              LimitOffsetClause limitOffset, const IdTable& expected,
+              source_location l = source_location::current()) {
+  auto trace = generateLocationTrace(l);
+  for (bool lazyInput : {true, false}) {
+    std::vector<IdTable> clones;
+    for (const auto& block : blocks) {
+      clones.push_back(block.clone());
+    }
+    auto topK = makeTopK(std::move(clones), sortColumns, lazyInput);
+    topK.setLimit(limitOffset);
+    auto result = topK.getResult();
+    EXPECT_EQ(result->idTable(), expected);
+  }
+}
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(TopK, simpleLimitAndOffset) {
+  std::vector<IdTable> blocks;
+  blocks.push_back(makeIdTableFromVector({{I(3), D(1.5)}, {I(-2), D(0.5)}}));
+  blocks.push_back(makeIdTableFromVector({{I(3), D(-1.0)}, {I(7), D(2.0)}}));
+  blocks.push_back(makeIdTableFromVector({{I(-2), D(3.0)}}));
+  TopK::SortIndices sortColumns{{0, true}, {1, false}};
+
+  testTopK(blocks, sortColumns, {2, 0},
+           makeIdTableFromVector({{I(7), D(2.0)}, {I(3), D(-1.0)}}));
+  testTopK(blocks, sortColumns, {2, 1},
+           makeIdTableFromVector({{I(3), D(-1.0)}, {I(3), D(1.5)}}));
+  testTopK(blocks, sortColumns, {0, 0},
+           IdTable{2, ad_utility::testing::makeAllocator()});
+  testTopK(blocks, sortColumns, {3, 4},
+           makeIdTableFromVector({{I(-2), D(3.0)}}));
+  testTopK(blocks, sortColumns, {10, 0},
+           makeIdTableFromVector({{I(7), D(2.0)},
+                                  {I(3), D(-1.0)},
+                                  {I(3), D(1.5)},
+                                  {I(-2), D(0.5)},
+                                  {I(-2), D(3.0)}}));
+}
+
+// _____________________________________________________________________________
+TEST(TopK, sameResultAsOrderBy) {
+  ad_utility::SlowRandomIntGenerator<int64_t> randomValue{-50, 50};
+  std::vector<IdTable> blocks;
+  IdTable all{2, ad_utility::testing::makeAllocator()};
+  for (size_t i = 0; i < 20; ++i) {
+    IdTable block{2, ad_utility::testing::makeAllocator()};
+    for (size_t j = 0; j < 37; ++j) {
+      block.push_back({I(randomValue()), I(randomValue())});
+    }
+    all.insertAtEnd(block);
+    blocks.push_back(std::move(block));
+  }
+  TopK::SortIndices sortColumns{{1, false}, {0, true}};
+
+  auto qec = ad_utility::testing::getQec();
+  qec->getQueryTreeCache().clearAll();
+  OrderBy orderBy{qec,
+                  ad_utility::makeExecutionTree<ValuesForTesting>(
+                      qec, all.clone(),
+                      std::vector<std::optional<Variable>>{Variable{"?0"},
+                                                           Variable{"?1"}}),
+                  sortColumns};
+  auto sorted = orderBy.getResult()->idTable().clone();
+
+  for (size_t limit : {1, 5, 36, 37, 100, 1000}) {
+    for (size_t offset : {0, 3, 500}) {
+      LimitOffsetClause limitOffset{limit, offset};
+      size_t begin = limitOffset.actualOffset(sorted.size());
+      size_t end = limitOffset.upperBound(sorted.size());
+      IdTable expected{2, ad_utility::testing::makeAllocator()};
+      expected.insertAtEnd(sorted, begin, end);
+      testTopK(blocks, sortColumns, limitOffset, expected);
+    }
+  }
+}
+
+// _____________________________________________________________________________
+TEST(TopK, simpleMemberFunctions) {
+  std::vector<IdTable> blocks;
+  blocks.push_back(makeIdTableFromVector({{1, 2}}));
+  auto topK = makeTopK(std::move(blocks), {{1, true}, {0, false}}, true);
+  topK.setLimit({5, 0});
+  EXPECT_TRUE(topK.supportsLimit());
+  EXPECT_EQ(topK.getResultWidth(), 2u);
+  EXPECT_TRUE(topK.resultSortedOn().empty());
+  EXPECT_EQ(topK.getDescriptor(), "TopK on DESC(?1) ASC(?0)");
+  using enum OrderBy::AscOrDesc;
+  EXPECT_THAT(topK.getSortedVariables(),
+              ::testing::ElementsAre(::testing::Pair(Variable{"?1"}, Desc),
+                                     ::testing::Pair(Variable{"?0"}, Asc)));
+  EXPECT_THAT(topK.getCacheKey(),
+              ::testing::AllOf(::testing::HasSubstr("TOP K ORDER BY"),
+                               ::testing::HasSubstr("desc(1) asc(0)"),
+                               ::testing::HasSubstr("LIMIT 5")));
+}
@@ -2,6 +2,7 @@
 //  Chair of Algorithms and Data Structures.
 //  Author: Johannes Kalmbach <kalmbach@cs.uni-freiburg.de>
 
+#include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
 #include <bitset>
@@ -320,6 +321,8 @@ TEST_F(ValueIdTest, toDebugString) {
       ad_utility::triple_component::LiteralOrIri::literalWithoutQuotes(
           "SomeValue")};
   test(ValueId::makeFromLocalVocabIndex(&str), "L:\"SomeValue\"");
+  test(ValueId::makeFromInlineString(InlineString::make("<x>").value()),
+       "I:<x>");
   test(makeTextRecordId(37), "T:37");
   test(makeWordVocabId(42), "W:42");
   test(makeBlankNodeId(27), "B:27");
@@ -332,6 +335,83 @@ TEST_F(ValueIdTest, toDebugString) {
   ASSERT_ANY_THROW(test(ValueId::max(), "blim"));
 }
 
+TEST_F(ValueIdTest, InlineString) {
+  auto makeId = [](std::string_view word) {
+    return ValueId::makeFromInlineString(InlineString::make(word).value());
+  };
+  for (std::string_view word : {"", "<x>", "\"de\"", "\"ä\"", "1234567"}) {
+    auto id = makeId(word);
+    EXPECT_EQ(id.getDatatype(), Datatype::InlineString);
+    EXPECT_EQ(id.getInlineString().view(), word);
+  }
+  EXPECT_FALSE(InlineString::make("12345678").has_value());
+
+  // Equal strings have the same bits, different strings (also prefixes of each
+  // other) have different bits.
+  EXPECT_EQ(makeId("<x>").getBits(), makeId("<x>").getBits());
+  EXPECT_NE(makeId("<x>").getBits(), makeId("<xy>").getBits());
+  EXPECT_NE(makeId("ab").getBits(),
+            makeId(std::string_view{"ab\0", 3}).getBits());
+}
+
+TEST_F(ValueIdTest, InlineStringOrdering) {
+  auto getId =
+      ad_utility::testing::makeGetId(ad_utility::testing::getQec()->getIndex());
+  auto makeId = [](std::string_view word) {
+    return ValueId::makeFromInlineString(InlineString::make(word).value());
+  };
+  using ad_utility::triple_component::LiteralOrIri;
+  LocalVocabEntry entry{LiteralOrIri::iriref("<xy>")};
+  auto localVocabId = ValueId::makeFromLocalVocabIndex(&entry);
+
+  // Words from the vocabulary are equal to their `VocabIndex`, and the other
+  // words are sorted in between. `InlineString`s are also equal to the same
+  // word from a `LocalVocab`.
+  EXPECT_EQ(makeId("<x>"), getId("<x>"));
+  EXPECT_EQ(makeId("\"alpha\""), getId("\"alpha\""));
+  EXPECT_EQ(makeId("<xy>"), localVocabId);
+  EXPECT_LT(getId("<x>"), makeId("<xy>"));
+  EXPECT_GT(getId("<y>"), makeId("<xy>"));
+  EXPECT_LT(makeId("<a>"), localVocabId);
+  EXPECT_GT(makeId("<z>"), localVocabId);
+
+  std::vector<ValueId> ids{getId("<y>"), makeId("<xy>"), getId("<x>"),
+                           makeId("<a>"), ValueId::makeFromInt(42)};
+  ql::ranges::sort(ids);
+  EXPECT_THAT(ids, ::testing::ElementsAre(ValueId::makeFromInt(42),
+                                          makeId("<a>"), getId("<x>"),
+                                          localVocabId, getId("<y>")));
+
+  // Comparisons with other types are done by the datatype.
+  EXPECT_LT(ValueId::makeFromInt(42), makeId("<a>"));
+  EXPECT_GT(makeTextRecordId(0), makeId("<a>"));
+}
+
+TEST_F(ValueIdTest, InlineStringPositionInVocab) {
+  ad_utility::testing::getQec();
+  using ad_utility::triple_component::LiteralOrIri;
+  // More distinct words than fit into the cache per thread, so the positions
+  // are also read from the global cache.
+  for (size_t pass = 0; pass < 2; ++pass) {
+    for (size_t i = 0; i < 1000; ++i) {
+      auto word = absl::StrCat("<x", i, ">");
+      auto position =
+          LocalVocabEntry::positionInVocab(InlineString::make(word).value());
+      auto expected = LocalVocabEntry{LiteralOrIri::iriref(word)}
+                          .positionInVocab();
+      EXPECT_EQ(position.lowerBound_.get(), expected.lowerBound_.get());
+      EXPECT_EQ(position.upperBound_.get(), expected.upperBound_.get());
+    }
+  }
+  // A word from the vocabulary.
+  auto x = ad_utility::testing::makeGetId(
+      ad_utility::testing::getQec()->getIndex())("<x>");
+  auto position =
+      LocalVocabEntry::positionInVocab(InlineString::make("<x>").value());
+  EXPECT_EQ(position.lowerBound_.get(), x.getVocabIndex().get());
+  EXPECT_EQ(position.upperBound_.get(), x.getVocabIndex().get() + 1);
+}
+
 TEST_F(ValueIdTest, InvalidDatatypeEnumValue) {
   ASSERT_ANY_THROW(toString(static_cast<Datatype>(2345)));
 }
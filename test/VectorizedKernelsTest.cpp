@@ -0,0 +1,145 @@
+//  Copyright 2025, University of Freiburg,
+//                  Chair of Algorithms and Data Structures.
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include "./util/IdTestHelpers.h"
+#include "engine/sparqlExpressions/VectorizedKernels.h"
+
+using namespace sparqlExpression::vectorized;
+using ad_utility::testing::BoolId;
+using ad_utility::testing::DoubleId;
+using ad_utility::testing::IntId;
+using ad_utility::testing::UndefId;
+using ad_utility::testing::VocabId;
+
+namespace {
+// Evaluate the binary `op` on `a` and `b` and return the result, or
+// `std::nullopt` if the kernel doesn't support the operands.
+std::optional<std::vector<Id>> binary(BinaryOperation op, const Operand& a,
+                                      const Operand& b, size_t size) {
+  std::vector<Id> result(size);
+  if (!evaluateBinaryOperation(op, a, b, result)) {
+    return std::nullopt;
+  }
+  return result;
+}
+
+// Same as `binary` above, but for a comparison.
+std::optional<std::vector<Id>> compare(Comparison comparison, const Operand& a,
+                                       const Operand& b, size_t size) {
+  std::vector<Id> result(size);
+  if (!evaluateComparison(comparison, a, b, result)) {
+    return std::nullopt;
+  }
+  return result;
+}
+
+using Ids = std::vector<Id>;
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(VectorizedKernels, getCommonDatatype) {
+  EXPECT_EQ(getCommonDatatype(Ids{}), std::nullopt);
+  EXPECT_EQ(getCommonDatatype(Ids{IntId(3), IntId(-4)}), Datatype::Int);
+  EXPECT_EQ(getCommonDatatype(Ids{DoubleId(3.0)}), Datatype::Double);
+  EXPECT_EQ(getCommonDatatype(Ids{IntId(3), DoubleId(4.0)}), std::nullopt);
+  EXPECT_EQ(getCommonDatatype(Ids{IntId(3), UndefId()}), std::nullopt);
+}
+
+// _____________________________________________________________________________
+TEST(VectorizedKernels, arithmetic) {
+  using enum BinaryOperation;
+  Ids ints{IntId(3), IntId(-4), IntId(0)};
+  Ids doubles{DoubleId(1.5), DoubleId(-2.0), DoubleId(0.0)};
+
+  EXPECT_THAT(binary(Add, ints, ints, 3),
+              ::testing::Optional(Ids{IntId(6), IntId(-8), IntId(0)}));
+  EXPECT_THAT(binary(Subtract, ints, IntId(1), 3),
+              ::testing::Optional(Ids{IntId(2), IntId(-5), IntId(-1)}));
+  EXPECT_THAT(binary(Multiply, IntId(-2), ints, 3),
+              ::testing::Optional(Ids{IntId(-6), IntId(8), IntId(0)}));
+  // Mixing `Int` and `Double` and dividing always yields `Double`s.
+  EXPECT_THAT(binary(Add, ints, doubles, 3),
+              ::testing::Optional(
+                  Ids{DoubleId(4.5), DoubleId(-6.0), DoubleId(0.0)}));
+  EXPECT_THAT(binary(Divide, ints, IntId(2), 3),
+              ::testing::Optional(
+                  Ids{DoubleId(1.5), DoubleId(-2.0), DoubleId(0.0)}));
+  auto quotients = binary(Divide, ints, IntId(0), 3);
+  ASSERT_TRUE(quotients.has_value());
+  EXPECT_EQ(quotients->at(0), DoubleId(INFINITY));
+  EXPECT_EQ(quotients->at(1), DoubleId(-INFINITY));
+  EXPECT_TRUE(std::isnan(quotients->at(2).getDouble()));
+
+  // Non-homogeneous and non-numeric inputs are not supported.
+  EXPECT_EQ(binary(Add, Ids{IntId(3), DoubleId(4.0)}, ints, 2), std::nullopt);
+  EXPECT_EQ(binary(Add, ints, UndefId(), 3), std::nullopt);
+  EXPECT_EQ(binary(Add, ints, VocabId(3), 3), std::nullopt);
+  EXPECT_EQ(binary(And, ints, ints, 3), std::nullopt);
+}
+
+// _____________________________________________________________________________
+TEST(VectorizedKernels, logical) {
+  using enum BinaryOperation;
+  Ids a{BoolId(false), BoolId(false), BoolId(true), BoolId(true)};
+  Ids b{BoolId(false), BoolId(true), BoolId(false), BoolId(true)};
+  EXPECT_THAT(binary(And, a, b, 4),
+              ::testing::Optional(Ids{BoolId(false), BoolId(false),
+                                      BoolId(false), BoolId(true)}));
+  EXPECT_THAT(binary(Or, a, b, 4),
+              ::testing::Optional(Ids{BoolId(false), BoolId(true),
+                                      BoolId(true), BoolId(true)}));
+  EXPECT_THAT(binary(Or, a, BoolId(true), 4),
+              ::testing::Optional(Ids(4, BoolId(true))));
+  // Other datatypes have a different effective boolean value, so they are not
+  // supported.
+  EXPECT_EQ(binary(And, a, IntId(1), 4), std::nullopt);
+  EXPECT_EQ(binary(Or, a, Ids{BoolId(true), UndefId(), BoolId(false),
+                              BoolId(true)},
+                   4),
+            std::nullopt);
+}
+
+// _____________________________________________________________________________
+TEST(VectorizedKernels, comparison) {
+  using enum Comparison;
+  Ids ints{IntId(3), IntId(-4), IntId(7)};
+  Ids doubles{DoubleId(3.0), DoubleId(-4.5), DoubleId(NAN)};
+  auto bools = [](std::vector<bool> values) {
+    Ids result;
+    for (bool value : values) {
+      result.push_back(BoolId(value));
+    }
+    return result;
+  };
+
+  EXPECT_THAT(compare(LT, ints, IntId(3), 3),
+              ::testing::Optional(bools({false, true, false})));
+  EXPECT_THAT(compare(GE, ints, IntId(3), 3),
+              ::testing::Optional(bools({true, false, true})));
+  // Mixed `Int`s and `Double`s are compared by their values, `NaN` is neither
+  // equal to, nor less than, nor greater than any value.
+  EXPECT_THAT(compare(EQ, ints, doubles, 3),
+              ::testing::Optional(bools({true, false, false})));
+  EXPECT_THAT(compare(NE, ints, doubles, 3),
+              ::testing::Optional(bools({false, true, true})));
+  EXPECT_THAT(compare(GT, ints, doubles, 3),
+              ::testing::Optional(bools({false, true, false})));
+  EXPECT_THAT(compare(LE, doubles, DoubleId(-4.5), 3),
+              ::testing::Optional(bools({false, true, false})));
+
+  auto date = [](std::string_view s) {
+    return Id::makeFromDate(DateYearOrDuration::parseXsdDate(s));
+  };
+  Ids dates{date("1999-11-11"), date("2005-02-27"), date("-0200-01-01")};
+  EXPECT_THAT(compare(LT, dates, date("2000-01-01"), 3),
+              ::testing::Optional(bools({true, false, true})));
+
+  EXPECT_EQ(compare(LT, dates, ints, 3), std::nullopt);
+  EXPECT_EQ(compare(EQ, ints, VocabId(3), 3), std::nullopt);
+  EXPECT_EQ(compare(EQ, Ids{IntId(3), UndefId()}, IntId(3), 2), std::nullopt);
+}
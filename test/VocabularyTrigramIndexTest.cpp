@@ -0,0 +1,108 @@
+//  Copyright 2025, University of Freiburg,
+//                  Chair of Algorithms and Data Structures.
+
+#include <absl/strings/str_cat.h>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <filesystem>
+
+#include "index/VocabularyTrigramIndex.h"
+#include "util/File.h"
+
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+
+namespace {
+const std::vector<std::string> words{"\"Berlin\"@en", "\"berliner\"",
+                                     "<http://example.org/Berlin>",
+                                     "\"Munich\"", "\"Bern\""};
+
+// Build the index for the `words` and read it from disk. The files are deleted
+// right away, the posting lists stay mapped until the index is destroyed.
+VocabularyTrigramIndex makeIndex(
+    const std::vector<std::string>& words = ::words) {
+  std::string filename = "vocabularyTrigramIndexTest.trigrams";
+  VocabularyTrigramIndex::build(filename, "#testIndex", words.size(),
+                                [&words](size_t i) { return words.at(i); });
+  auto index = VocabularyTrigramIndex::readFromFile(filename);
+  ad_utility::deleteFile(filename);
+  ad_utility::deleteFile(
+      absl::StrCat(filename, VocabularyTrigramIndex::postingsSuffix_));
+  return index;
+}
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(VocabularyTrigramIndex, getTrigrams) {
+  using T = VocabularyTrigramIndex::Trigram;
+  auto trigram = [](std::string_view s) {
+    return (T{static_cast<unsigned char>(s[0])} << 16) |
+           (T{static_cast<unsigned char>(s[1])} << 8) |
+           T{static_cast<unsigned char>(s[2])};
+  };
+  EXPECT_THAT(VocabularyTrigramIndex::getTrigrams("ab"), IsEmpty());
+  EXPECT_THAT(VocabularyTrigramIndex::getTrigrams("abab"),
+              ElementsAre(trigram("aba"), trigram("bab")));
+  EXPECT_EQ(VocabularyTrigramIndex::normalize("BeRLiN ÄÖ"), "berlin äö");
+}
+
+// _____________________________________________________________________________
+TEST(VocabularyTrigramIndex, normalize) {
+  using V = VocabularyTrigramIndex;
+  // Each code point is case-folded on its own, in particular there is no
+  // special final sigma like in the full lowercase mapping, and all the
+  // variants of a letter that RE2 matches case-insensitively are equal.
+  EXPECT_EQ(V::normalize("ΟΔΟΣ"), "οδοσ");
+  EXPECT_EQ(V::normalize("οδος"), "οδοσ");
+  // The Kelvin sign and the long s.
+  EXPECT_EQ(V::normalize("\u212A" "ELVIN"), "kelvin");
+  EXPECT_EQ(V::normalize("\u017F" "TOP"), "stop");
+  // Invalid UTF-8 is kept.
+  EXPECT_EQ(V::normalize("A\xFF" "B\xC3"), "a\xFF" "b\xC3");
+
+  // Words with non-ASCII letters are found with the (differently cased)
+  // substrings.
+  auto index = makeIndex({"\"ΟΔΟΣ\"", "\"οδός\"", "\"Straße\""});
+  EXPECT_THAT(index.getCandidates(V::normalize("ΟΔΟΣ")), ElementsAre(0));
+  EXPECT_THAT(index.getCandidates(V::normalize("οδοσ")), ElementsAre(0));
+  EXPECT_THAT(index.getCandidates(V::normalize("STRASSE")), IsEmpty());
+  EXPECT_THAT(index.getCandidates(V::normalize("STRAẞE")), ElementsAre(2));
+}
+
+// _____________________________________________________________________________
+TEST(VocabularyTrigramIndex, getCandidates) {
+  auto index = makeIndex();
+  EXPECT_THAT(index.getCandidates("berlin"), ElementsAre(0, 1, 2));
+  EXPECT_THAT(index.getCandidates("ber"), ElementsAre(0, 1, 2, 4));
+  EXPECT_THAT(index.getCandidates("liner"), ElementsAre(1));
+  EXPECT_THAT(index.getCandidates("munich\""), ElementsAre(3));
+  EXPECT_THAT(index.getCandidates("hamburg"), IsEmpty());
+  // The candidates are only a superset of the words that contain the
+  // substring.
+  EXPECT_THAT(index.getCandidates("berlinerlin"), ElementsAre(1));
+  EXPECT_ANY_THROW(index.getCandidates("be"));
+}
+
+// _____________________________________________________________________________
+TEST(VocabularyTrigramIndex, writeAndRead) {
+  std::string filename = "vocabularyTrigramIndexWriteAndRead.trigrams";
+  std::string postingsFilename =
+      absl::StrCat(filename, VocabularyTrigramIndex::postingsSuffix_);
+  VocabularyTrigramIndex::build(filename, "#testIndex", words.size(),
+                                [](size_t i) { return words.at(i); });
+  EXPECT_TRUE(std::filesystem::exists(postingsFilename));
+  {
+    auto index = VocabularyTrigramIndex::readFromFile(filename);
+    EXPECT_EQ(index.indexId(), "#testIndex");
+    EXPECT_EQ(index.numWords(), words.size());
+    EXPECT_EQ(index.numTrigrams(), makeIndex().numTrigrams());
+    EXPECT_THAT(index.getCandidates("berlin"), ElementsAre(0, 1, 2));
+  }
+  // An empty vocabulary.
+  VocabularyTrigramIndex::build(filename, "#emptyIndex", 0,
+                                [](size_t) -> std::string { AD_FAIL(); });
+  EXPECT_EQ(VocabularyTrigramIndex::readFromFile(filename).numTrigrams(), 0u);
+  ad_utility::deleteFile(filename);
+  ad_utility::deleteFile(postingsFilename);
+}
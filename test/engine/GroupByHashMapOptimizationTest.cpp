@@ -39,8 +39,12 @@ class GroupByHashMapOptimizationTest : public ::testing::Test {
   }
 
   std::string idToString(Id result) const {
-    auto index = result.getLocalVocabIndex();
-    auto resultString = localVocab_.getWord(index).toStringRepresentation();
+    // Short results are stored directly in the `Id`.
+    auto resultString =
+        result.getDatatype() == Datatype::InlineString
+            ? std::string{result.getInlineString().view()}
+            : localVocab_.getWord(result.getLocalVocabIndex())
+                  .toStringRepresentation();
     // Strip leading and trailing quotes.
     AD_CORRECTNESS_CHECK(resultString.size() >= 2);
     size_t endIndex = resultString.size() - 1;
@@ -10,6 +10,7 @@
 #include "../util/GTestHelpers.h"
 #include "../util/IdTableHelpers.h"
 #include "../util/IndexTestHelpers.h"
+#include "../util/RuntimeParametersTestHelpers.h"
 #include "../util/TripleComponentTestHelpers.h"
 #include "engine/IndexScan.h"
 #include "index/IndexImpl.h"
@@ -683,16 +684,37 @@ TEST(IndexScan, SetPrefilterVariablePairAndCheckCacheKey) {
   EXPECT_THAT(updatedQet.value()->getRootOperation()->getCacheKey(),
               ::testing::HasSubstr(os.str()));
 
-  // Assert that we don't set a <PrefilterExpression, ColumnIndex> pair for the
-  // second Variable.
+  // For the second Variable, the <PrefilterExpression, ColumnIndex> pair is
+  // also set (only the column summaries of the blocks are used for it).
   prefilterPairs = makePrefilterVec(pr(lt(IntId(10)), V{"?a"}),
                                     pr(gt(DoubleId(22)), V{"?z"}),
                                     pr(gt(IntId(10)), V{"?b"}));
   updatedQet =
       scan.setPrefilterGetUpdatedQueryExecutionTree(std::move(prefilterPairs));
-  // No PrefilterExpression should be set for this IndexScan, we don't expect a
-  // updated QueryExecutionTree.
-  EXPECT_TRUE(!updatedQet.has_value());
+  ASSERT_TRUE(updatedQet.has_value());
+  std::stringstream os2;
+  os2 << "Added PrefiterExpression: \n";
+  os2 << *gt(DoubleId(22));
+  os2 << "\nApplied on column: " << 2 << ".";
+  EXPECT_THAT(updatedQet.value()->getRootOperation()->getCacheKey(),
+              ::testing::HasSubstr(os2.str()));
+
+  // The first sorted Variable is preferred.
+  prefilterPairs = makePrefilterVec(pr(gt(DoubleId(22)), V{"?z"}),
+                                    pr(lt(IntId(5)), V{"?x"}));
+  updatedQet =
+      scan.setPrefilterGetUpdatedQueryExecutionTree(std::move(prefilterPairs));
+  ASSERT_TRUE(updatedQet.has_value());
+  EXPECT_THAT(updatedQet.value()->getRootOperation()->getCacheKey(),
+              ::testing::HasSubstr(os.str()));
+
+  // No PrefilterExpression is set if none of the Variables is contained in the
+  // IndexScan, we don't expect an updated QueryExecutionTree.
+  prefilterPairs = makePrefilterVec(pr(lt(IntId(10)), V{"?a"}),
+                                    pr(gt(IntId(10)), V{"?b"}));
+  updatedQet =
+      scan.setPrefilterGetUpdatedQueryExecutionTree(std::move(prefilterPairs));
+  EXPECT_FALSE(updatedQet.has_value());
 }
 
 // _____________________________________________________________________________
@@ -733,15 +755,15 @@ TEST(IndexScan, checkEvaluationWithPrefiltering) {
 
   // For the following tests, the first sorted column given the permutation
   // doesn't match with the corresponding column for the Variable of the
-  // <PrefilterExpression, Variable> pair. We expect that the provided prefilter
-  // is not applicable (and can't be set).
-  testSetAndMakeScanWithPrefilterExpr(
-      kg, triple, Permutation::PSO,
-      pr(andExpr(gt(DoubleId(12.00)), le(IntId(174))), Variable{"?price"}), {},
-      false);
+  // <PrefilterExpression, Variable> pair. The prefilter can still be set, but
+  // only the column summaries of the blocks are used. In these examples, none
+  // of the blocks contains a relevant value.
+  testSetAndMakeScanWithPrefilterExpr(kg, triple, Permutation::PSO,
+                                      pr(gt(DoubleId(200)), Variable{"?price"}),
+                                      {});
   testSetAndMakeScanWithPrefilterExpr(
       kg, triple, Permutation::POS,
-      pr(andExpr(gt(VocabId(0)), lt(VocabId(100))), Variable{"?x"}), {}, false);
+      pr(orExpr(lt(IntId(0)), gt(DoubleId(0))), Variable{"?x"}), {});
 
   // This knowledge graph yields an incomplete first and last block.
   std::string kgFirstAndLastIncomplete =
@@ -751,7 +773,20 @@ TEST(IndexScan, checkEvaluationWithPrefiltering) {
       ".";
   // The following test verifies that the prefilter procedure is successfully
   // applicable under the condition that the first and last block are
-  // potentially incomplete.
+  // potentially incomplete. The rows of the relevant blocks are also filtered
+  // by the prefilter.
+  testSetAndMakeScanWithPrefilterExpr(
+      kgFirstAndLastIncomplete, triple, Permutation::POS,
+      pr(orExpr(gt(IntId(100)), le(IntId(10))), Variable{"?price"}),
+      {I(10), I(147), I(189), I(194)});
+  testSetAndMakeScanWithPrefilterExpr(
+      kgFirstAndLastIncomplete, triple, Permutation::POS,
+      pr(andExpr(gt(IntId(10)), lt(IntId(194))), Variable{"?price"}),
+      {I(12), I(18), I(22), I(25), I(147), I(189)});
+
+  // Without the filtering of the rows, only the irrelevant blocks are removed.
+  auto cleanup =
+      setRuntimeParameterForTest<"index-scan-filter-rows-by-prefilter">(false);
   testSetAndMakeScanWithPrefilterExpr(
       kgFirstAndLastIncomplete, triple, Permutation::POS,
       pr(orExpr(gt(IntId(100)), le(IntId(10))), Variable{"?price"}),
@@ -45,6 +45,7 @@ std::vector<std::string> getAllIndexFilenames(
           indexBasename + ".index.patterns",
           indexBasename + ".meta-data.json",
           indexBasename + ".prefixes",
+          indexBasename + ".predicate-statistics",
           indexBasename + ".vocabulary.internal",
           indexBasename + ".vocabulary.external",
           indexBasename + ".vocabulary.external.offsets",